@@ -59,7 +59,7 @@ static bool ogg_convert(nikola::NBRAudio* audio, const nikola::FilePath& path) {
   if(frames == -1) {
     NIKOLA_LOG_ERROR("[NBR-ERROR]: Failed to read OGG file at \'%s\'", path.c_str());
    
-    nikola::memory_free(audio->samples);
+    free(audio->samples);
     return false;
   } 
 
@@ -98,8 +98,10 @@ bool audio_loader_load(nikola::NBRAudio* audio, const nikola::FilePath& path) {
 }
 
 void audio_loader_unload(nikola::NBRAudio& audio) {
+  // The samples were allocated by the decoders (dr_libs and stb_vorbis), 
+  // which use the standard allocator rather than the engine's.
   if(audio.samples) {
-    nikola::memory_free(audio.samples);
+    free(audio.samples);
   }
 }
 
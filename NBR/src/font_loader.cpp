@@ -19,7 +19,7 @@ static nikola::u8* load_font_data(const nikola::FilePath& path) {
   } 
 
   nikola::sizei data_size = nikola::filesystem_get_size(path);
-  nikola::u8* font_data   = (nikola::u8*)nikola::memory_allocate(data_size);
+  nikola::u8* font_data   = (nikola::u8*)NIKOLA_MEMORY_ALLOCATE(data_size, nikola::MEMORY_TAG_NBR);
   nikola::file_read_bytes(file, font_data, data_size); 
 
   return font_data;
@@ -140,7 +140,7 @@ bool font_loader_load(nikola::NBRFont* font, const nikola::FilePath& path) {
  
   // Apply the glyphs map onto the map
   font->glyphs_count = (nikola::u32)glyphs.size();
-  font->glyphs       = (nikola::NBRGlyph*)nikola::memory_allocate(sizeof(nikola::NBRGlyph) * font->glyphs_count);
+  font->glyphs       = (nikola::NBRGlyph*)NIKOLA_MEMORY_ALLOCATE(sizeof(nikola::NBRGlyph) * font->glyphs_count, nikola::MEMORY_TAG_NBR);
   
   nikola::u32 index = 0;
   for(auto& [key, value] : glyphs) {
@@ -158,7 +158,8 @@ void font_loader_unload(nikola::NBRFont& font) {
       continue;
     }
 
-    nikola::memory_free(font.glyphs[i].pixels);
+    // The bitmaps were allocated by STB, not by us.
+    stbtt_FreeBitmap(font.glyphs[i].pixels, nullptr);
   }
 
   nikola::memory_free(font.glyphs);
@@ -122,6 +122,11 @@ int main(int argc, char** argv) {
     return -1;
   }
   
+  // Initialize the library (mainly for the job system)
+  if(!nikola::init()) {
+    return -1;
+  }
+
   // Setting default values
   nbr::ListContext list; 
   list.parent_dir = nikola::filesystem_current_path();
@@ -129,9 +134,11 @@ int main(int argc, char** argv) {
 
   // Extract the command line arguments
   if (!lex_args(argc, argv, &list)) {
+    nikola::shutdown();
     return -1;
   }
  
+  nikola::shutdown();
   return 0;
 }
 /// Main function
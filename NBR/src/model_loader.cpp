@@ -109,13 +109,13 @@ static void load_node_mesh(aiMesh* mesh, nikola::NBRMesh* nbr_mesh) {
   // Allocate a new vertices array for the mesh
   nbr_mesh->vertices_count = vertices.size(); 
   bytes_size               = sizeof(nikola::f32) * nbr_mesh->vertices_count;
-  nbr_mesh->vertices       = (nikola::f32*)nikola::memory_allocate(bytes_size);
+  nbr_mesh->vertices       = (nikola::f32*)NIKOLA_MEMORY_ALLOCATE(bytes_size, nikola::MEMORY_TAG_NBR);
   nikola::memory_copy(nbr_mesh->vertices, vertices.data(), bytes_size);
   
   // Allocate a new indices array for the mesh
   nbr_mesh->indices_count = indices.size();
   bytes_size              = sizeof(nikola::u32) * nbr_mesh->indices_count;
-  nbr_mesh->indices       = (nikola::u32*)nikola::memory_allocate(bytes_size);
+  nbr_mesh->indices       = (nikola::u32*)NIKOLA_MEMORY_ALLOCATE(bytes_size, nikola::MEMORY_TAG_NBR);
   nikola::memory_copy(nbr_mesh->indices, indices.data(), bytes_size);
 }
 
@@ -230,7 +230,7 @@ bool model_loader_load(nikola::NBRModel* model, const nikola::FilePath& path) {
     .width    = 1, 
     .height   = 1, 
     .channels = 4, 
-    .pixels   = nikola::memory_allocate(4), // 4 = width * height * channels
+    .pixels   = NIKOLA_MEMORY_ALLOCATE(4, nikola::MEMORY_TAG_NBR), // 4 = width * height * channels
   };
   nikola::memory_set(data.default_texture.pixels, 1, 4);
   data.textures.push_back(data.default_texture); 
@@ -238,20 +238,23 @@ bool model_loader_load(nikola::NBRModel* model, const nikola::FilePath& path) {
   // Meshes init 
   load_scene_meshes(scene, &data, scene->mRootNode);
   model->meshes_count  = data.meshes.size();
-  model->meshes        = (nikola::NBRMesh*)nikola::memory_allocate(sizeof(nikola::NBRMesh) * model->meshes_count);
+  model->meshes        = (nikola::NBRMesh*)NIKOLA_MEMORY_ALLOCATE(sizeof(nikola::NBRMesh) * model->meshes_count, nikola::MEMORY_TAG_NBR);
   nikola::memory_copy(model->meshes, data.meshes.data(), data.meshes.size() * sizeof(nikola::NBRMesh));
   
   // Materials init
   load_scene_materials(scene, &data);  
   model->materials_count = data.materials.size();
-  model->materials       = (nikola::NBRMaterial*)nikola::memory_allocate(sizeof(nikola::NBRMaterial) * model->materials_count);
+  model->materials       = (nikola::NBRMaterial*)NIKOLA_MEMORY_ALLOCATE(sizeof(nikola::NBRMaterial) * model->materials_count, nikola::MEMORY_TAG_NBR);
   nikola::memory_copy(model->materials, data.materials.data(), data.materials.size() * sizeof(nikola::NBRMaterial));
 
   // Textures init
   model->textures_count = data.textures.size(); 
-  model->textures       = (nikola::NBRTexture*)nikola::memory_allocate(sizeof(nikola::NBRTexture) * model->textures_count);
+  model->textures       = (nikola::NBRTexture*)NIKOLA_MEMORY_ALLOCATE(sizeof(nikola::NBRTexture) * model->textures_count, nikola::MEMORY_TAG_NBR);
   nikola::memory_copy(model->textures, data.textures.data(), data.textures.size() * sizeof(nikola::NBRTexture));
 
+  // Bounds init (saved with the model, so the engine never has to compute them)
+  nikola::nbr_model_compute_bounds(model);
+
   return true;
 }
 
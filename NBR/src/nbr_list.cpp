@@ -170,7 +170,9 @@ static void iterate_resources(const nikola::FilePath& base_dir, const nikola::Fi
   convert_by_type(section, current_path);
 }
   
-static void load_resources(ListSection* section) {
+static void load_resources(void* user_data) {
+  ListSection* section = (ListSection*)user_data;
+
   // Check if all the paths are correct
   if(!check_section_dirs(*section)) {
     return;
@@ -207,8 +209,7 @@ void list_context_create(const nikola::FilePath& path, ListContext* list) {
 }
 
 void list_context_convert_by_type(ListContext* list, const nikola::ResourceType type) {
-  // @TODO (Threads): Substitute this for a thread pool/job queue 
-  nikola::DynamicArray<std::thread> threads;
+  nikola::JobCounter counter;
  
   for(auto& section : list->sections) {
     if(section.type != type) {
@@ -216,26 +217,21 @@ void list_context_convert_by_type(ListContext* list, const nikola::ResourceType
     }
 
     // Convert all the resource paths
-    threads.push_back(std::thread(load_resources, &section));
+    nikola::job_dispatch(load_resources, &section, &counter);
   }
   
-  for(auto& th : threads) {
-    th.join();
-  }
+  nikola::job_wait(counter);
 }
 
 void list_context_convert_all(ListContext* list) {
-  // @TODO (Threads): Substitute this for a thread pool/job queue 
-  nikola::DynamicArray<std::thread> threads;
+  nikola::JobCounter counter;
   
   for(auto& section : list->sections) {
     // Convert all the resource paths
-    threads.push_back(std::thread(load_resources, &section));
+    nikola::job_dispatch(load_resources, &section, &counter);
   }
   
-  for(auto& th : threads) {
-    th.join();
-  }
+  nikola::job_wait(counter);
 }
 
 /// List context functions 
@@ -48,11 +48,11 @@ bool shader_loader_load(nikola::NBRShader* shader, const nikola::FilePath& path)
   shader->pixel_length  = (nikola::u16)frag_src.size();
 
   // Setting the vertex source strings
-  shader->vertex_source = (nikola::i8*)nikola::memory_allocate(shader->vertex_length); 
+  shader->vertex_source = (nikola::i8*)NIKOLA_MEMORY_ALLOCATE(shader->vertex_length, nikola::MEMORY_TAG_NBR); 
   nikola::memory_copy(shader->vertex_source, vert_src.c_str(), shader->vertex_length);
 
   // Setting the pixel source strings
-  shader->pixel_source = (nikola::i8*)nikola::memory_allocate(shader->pixel_length); 
+  shader->pixel_source = (nikola::i8*)NIKOLA_MEMORY_ALLOCATE(shader->pixel_length, nikola::MEMORY_TAG_NBR); 
   nikola::memory_copy(shader->pixel_source, frag_src.c_str(), shader->pixel_length); // Copy the string
 
   return true;
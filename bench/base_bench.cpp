@@ -0,0 +1,125 @@
+#include "bench.h"
+
+#include <nikola/nikola.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace bench { // Start of bench
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The amount of listeners subscribed to the dispatched event.
+/// Roughly what a busy app ends up with on mouse or key events.
+const nikola::sizei EVENT_LISTENERS_COUNT = 8;
+
+/// The allocation sizes the memory benchmarks cycle through.
+static const nikola::sizei ALLOCATION_SIZES[] = {16, 64, 256, 1024, 4096, 65536};
+
+const nikola::sizei ALLOCATION_SIZES_COUNT = sizeof(ALLOCATION_SIZES) / sizeof(ALLOCATION_SIZES[0]);
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Callbacks
+
+static bool on_event(const nikola::Event& event, const void* dispatcher, const void* listener) {
+  nikola::sizei* counter = (nikola::sizei*)listener;
+  *counter              += (nikola::sizei)event.mouse_scroll_value;
+
+  return true;
+}
+
+/// Callbacks
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Benchmarks
+
+void base_bench_run() {
+  bench_begin_group("base");
+
+  // Events
+
+  nikola::sizei event_counter = 0;
+
+  nikola::EventListenerID listeners[EVENT_LISTENERS_COUNT];
+  for(nikola::sizei i = 0; i < EVENT_LISTENERS_COUNT; i++) {
+    listeners[i] = nikola::event_listen(nikola::EVENT_MOUSE_SCROLL_WHEEL, on_event, &event_counter);
+  }
+
+  bench_run("event_dispatch (8 listeners)", 1000000, [&](const nikola::sizei iterations) {
+    nikola::Event event = {
+      .type               = nikola::EVENT_MOUSE_SCROLL_WHEEL,
+      .mouse_scroll_value = 1.0f,
+    };
+
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::event_dispatch(event);
+    }
+
+    bench_do_not_optimize(event_counter);
+  });
+
+  // A frame's worth of posted events, where only every 64th one is not a mouse move
+  bench_run("event_post + event_process_queue (coalesced)", 1000000, [&](const nikola::sizei iterations) {
+    nikola::Event move_event = {
+      .type        = nikola::EVENT_MOUSE_MOVED,
+      .mouse_pos_x = 1.0f,
+    };
+
+    nikola::Event scroll_event = {
+      .type               = nikola::EVENT_MOUSE_SCROLL_WHEEL,
+      .mouse_scroll_value = 1.0f,
+    };
+
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::event_post((i % 64) == 0 ? scroll_event : move_event);
+
+      if((i % 1024) == 1023) {
+        nikola::event_process_queue();
+      }
+    }
+    nikola::event_process_queue();
+
+    bench_do_not_optimize(event_counter);
+  });
+
+  for(auto& id : listeners) {
+    nikola::event_unlisten(id);
+  }
+
+  // Memory
+
+  bench_run("memory_allocate_free", 1000000, [&](const nikola::sizei iterations) {
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      void* ptr = nikola::memory_allocate(ALLOCATION_SIZES[i % ALLOCATION_SIZES_COUNT]);
+      bench_do_not_optimize(ptr);
+
+      nikola::memory_free(ptr);
+    }
+  });
+
+  bench_run("memory_allocate_free (batched)", 100000, [&](const nikola::sizei iterations) {
+    void* ptrs[64];
+
+    for(nikola::sizei i = 0; i < iterations; i += 64) {
+      for(nikola::sizei j = 0; j < 64; j++) {
+        ptrs[j] = nikola::memory_allocate(ALLOCATION_SIZES[j % ALLOCATION_SIZES_COUNT]);
+      }
+      bench_do_not_optimize(ptrs);
+
+      for(nikola::sizei j = 0; j < 64; j++) {
+        nikola::memory_free(ptrs[j]);
+      }
+    }
+  });
+}
+
+/// Benchmarks
+/// ----------------------------------------------------------------------
+
+} // End of bench
+
+//////////////////////////////////////////////////////////////////////////
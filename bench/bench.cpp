@@ -0,0 +1,243 @@
+#include "bench.h"
+
+#include <nikola/nikola.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace bench { // Start of bench
+
+/// ----------------------------------------------------------------------
+/// BenchState
+struct BenchState {
+  nikola::String current_group = "default";
+  nikola::DynamicArray<BenchResult> results;
+};
+
+static BenchState s_bench;
+/// BenchState
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static nikola::String get_result_key(const nikola::String& group, const nikola::String& name) {
+  return group + "/" + name;
+}
+
+static void append_escaped(nikola::String& out, const nikola::String& str) {
+  for(auto ch : str) {
+    if(ch == '\"' || ch == '\\') {
+      out += '\\';
+    }
+
+    out += ch;
+  }
+}
+
+/// Find the value of the string `key` in `line`. This only understands 
+/// the flat objects written by `bench_write_json`, which is all the baseline ever is.
+static bool find_string_value(const nikola::String& line, const char* key, nikola::String* out_value) {
+  nikola::String pattern = nikola::String("\"") + key + "\":\"";
+
+  nikola::sizei start = line.find(pattern);
+  if(start == nikola::String::npos) {
+    return false;
+  }
+  start += pattern.size();
+
+  out_value->clear();
+  for(nikola::sizei i = start; i < line.size(); i++) {
+    if(line[i] == '\\' && (i + 1) < line.size()) {
+      *out_value += line[++i];
+      continue;
+    }
+    else if(line[i] == '\"') {
+      return true;
+    }
+
+    *out_value += line[i];
+  }
+
+  return false;
+}
+
+static bool find_number_value(const nikola::String& line, const char* key, nikola::f64* out_value) {
+  nikola::String pattern = nikola::String("\"") + key + "\":";
+
+  nikola::sizei start = line.find(pattern);
+  if(start == nikola::String::npos) {
+    return false;
+  }
+
+  *out_value = std::strtod(line.c_str() + start + pattern.size(), nullptr);
+  return true;
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Bench functions
+
+void bench_begin_group(const char* name) {
+  s_bench.current_group = name;
+}
+
+void bench_push_result(const char* name, const nikola::sizei iterations, nikola::f64* samples, const nikola::sizei samples_count) {
+  NIKOLA_ASSERT((samples_count > 0), "Cannot push a benchmark result without any samples");
+
+  std::sort(samples, samples + samples_count);
+
+  s_bench.results.push_back(BenchResult {
+    .group            = s_bench.current_group,
+    .name             = name,
+    .iterations       = iterations,
+    .median_ns_per_op = samples[samples_count / 2],
+    .min_ns_per_op    = samples[0],
+  });
+}
+
+void bench_print_results() {
+  // The table is the actual output of the benchmarks, so it goes straight to stdout instead of through 
+  // the (rate limited) logger. Anything still queued in the logger comes out first, to keep the order.
+  nikola::logger_flush();
+
+  printf("%-12s | %-44s | %12s | %12s\n", "Group", "Benchmark", "Median ns/op", "Min ns/op");
+  printf("-------------+----------------------------------------------+--------------+-------------\n");
+
+  for(auto& result : s_bench.results) {
+    printf("%-12s | %-44s | %12.2lf | %12.2lf\n",
+           result.group.c_str(),
+           result.name.c_str(),
+           result.median_ns_per_op,
+           result.min_ns_per_op);
+  }
+
+  fflush(stdout);
+}
+
+const nikola::DynamicArray<BenchResult>& bench_get_results() {
+  return s_bench.results;
+}
+
+const bool bench_write_json(const char* path) {
+  nikola::String out = "{\n\"samples\":" + std::to_string(BENCH_SAMPLES_COUNT) + ",\n\"results\":[\n";
+  char buffer[128];
+
+  // One result per line, which keeps the baseline readable in diffs
+  for(nikola::sizei i = 0; i < s_bench.results.size(); i++) {
+    const BenchResult& result = s_bench.results[i];
+
+    out += "{\"group\":\"";
+    append_escaped(out, result.group);
+    out += "\",\"name\":\"";
+    append_escaped(out, result.name);
+
+    snprintf(buffer, sizeof(buffer), 
+             "\",\"iterations\":%zu,\"median_ns_per_op\":%.4lf,\"min_ns_per_op\":%.4lf}", 
+             result.iterations, 
+             result.median_ns_per_op, 
+             result.min_ns_per_op);
+    out += buffer;
+
+    out += (i == (s_bench.results.size() - 1)) ? "\n" : ",\n";
+  }
+
+  out += "]\n}\n";
+
+  nikola::File file;
+  if(!nikola::file_open(&file, path, (nikola::i32)nikola::FILE_OPEN_WRITE)) {
+    NIKOLA_LOG_ERROR("Failed to open benchmark results file \'%s\'", path);
+    return false;
+  }
+
+  nikola::file_write_bytes(file, out);
+  nikola::file_close(file);
+
+  NIKOLA_LOG_INFO("Wrote %zu benchmark results to \'%s\'", s_bench.results.size(), path);
+  return true;
+}
+
+const nikola::i32 bench_compare_baseline(const char* path, const nikola::f64 tolerance) {
+  nikola::File file;
+  if(!nikola::file_open(&file, path, (nikola::i32)nikola::FILE_OPEN_READ)) {
+    NIKOLA_LOG_ERROR("Failed to open benchmark baseline file \'%s\'", path);
+    return -1;
+  }
+
+  // Gather the medians of the baseline
+  nikola::HashMap<nikola::String, nikola::f64> baseline;
+  nikola::String line; 
+
+  while(std::getline(file, line)) {
+    nikola::String group, name; 
+    nikola::f64 median = 0.0;
+
+    if(!find_string_value(line, "group", &group) || 
+       !find_string_value(line, "name", &name)   || 
+       !find_number_value(line, "median_ns_per_op", &median)) {
+      continue;
+    }
+
+    baseline[get_result_key(group, name)] = median;
+  }
+
+  nikola::file_close(file);
+
+  // An empty baseline would let everything pass
+  if(baseline.size() == 0) {
+    NIKOLA_LOG_ERROR("Benchmark baseline \'%s\' has no entries. Run with `--update-baseline` to record one", path);
+    return -1;
+  }
+
+  // Compare every result against the baseline
+  nikola::i32 regressions = 0;
+  nikola::i32 missing     = 0;
+
+  for(auto& result : s_bench.results) {
+    auto it = baseline.find(get_result_key(result.group, result.name));
+    if(it == baseline.end()) {
+      NIKOLA_LOG_ERROR("Benchmark \'%s/%s\' has no baseline", result.group.c_str(), result.name.c_str());
+      missing++;
+
+      continue;
+    }
+
+    nikola::f64 limit = it->second * (1.0 + tolerance);
+    if(result.median_ns_per_op <= limit) {
+      continue;
+    }
+
+    NIKOLA_LOG_ERROR("Benchmark \'%s/%s\' regressed: %.2lf ns/op (baseline = %.2lf ns/op, limit = %.2lf ns/op)", 
+                     result.group.c_str(), 
+                     result.name.c_str(), 
+                     result.median_ns_per_op, 
+                     it->second, 
+                     limit);
+    regressions++;
+  }
+
+  NIKOLA_LOG_INFO("Compared %zu benchmarks against %zu baseline entries with a %.1lf%% tolerance: %i regression(s), %i missing", 
+                  s_bench.results.size(), 
+                  baseline.size(), 
+                  tolerance * 100.0, 
+                  regressions, 
+                  missing);
+
+  if(missing > 0) {
+    NIKOLA_LOG_ERROR("Run with `--update-baseline` to record the missing benchmarks");
+  }
+
+  return regressions + missing;
+}
+
+/// Bench functions
+/// ----------------------------------------------------------------------
+
+} // End of bench
+
+//////////////////////////////////////////////////////////////////////////
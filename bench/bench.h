@@ -0,0 +1,124 @@
+#pragma once
+
+#include <nikola/nikola.h>
+
+#include <chrono>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace bench { // Start of bench
+
+/// ----------------------------------------------------------------------
+/// *** Bench ***
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The amount of timed samples taken for every benchmark. The median is reported.
+const nikola::sizei BENCH_SAMPLES_COUNT = 7;
+
+/// The default relative slowdown (10%) a benchmark is allowed before it counts as a regression.
+const nikola::f64 BENCH_DEFAULT_TOLERANCE = 0.10;
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// BenchResult
+struct BenchResult {
+  nikola::String group;
+  nikola::String name;
+
+  nikola::sizei iterations = 0;
+
+  nikola::f64 median_ns_per_op = 0.0;
+  nikola::f64 min_ns_per_op    = 0.0;
+};
+/// BenchResult
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Bench functions
+
+/// Start a new group of benchmarks named `name`. Every result
+/// pushed afterwards will belong to this group.
+void bench_begin_group(const char* name);
+
+/// Record the given `samples` (in nanoseconds per operation) of the benchmark `name`.
+void bench_push_result(const char* name, const nikola::sizei iterations, nikola::f64* samples, const nikola::sizei samples_count);
+
+/// Print all of the recorded results as a table to stdout.
+///
+/// @NOTE: The table skips the logger, so none of its rows ever get rate limited.
+void bench_print_results();
+
+/// Retrieve all of the recorded results so far.
+const nikola::DynamicArray<BenchResult>& bench_get_results();
+
+/// Write all of the recorded results as JSON into the file at `path`. 
+/// Returns `false` if the file could not be opened.
+const bool bench_write_json(const char* path);
+
+/// Compare the recorded results against the baseline JSON file at `path` (as written by `bench_write_json`),
+/// logging every benchmark whose median got slower than its baseline by more than `tolerance` (i.e, `0.1` is 10%).
+/// Returns the amount of failures found, or `-1` if the baseline could not be read or has no entries.
+///
+/// @NOTE: Benchmarks missing from the baseline count as failures as well. 
+/// Use `--update-baseline` to (re-)record the baseline instead.
+const nikola::i32 bench_compare_baseline(const char* path, const nikola::f64 tolerance);
+
+/// Make sure the compiler never optimizes away the computation of `value`.
+template<typename T>
+inline void bench_do_not_optimize(const T& value) {
+#if defined(_MSC_VER)
+  volatile const T* sink = &value;
+  (void)sink;
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/// Invoke `func(iterations)` once to warm up, and then `BENCH_SAMPLES_COUNT`
+/// times, recording the time of each call as the result of `name`.
+template<typename Func>
+inline void bench_run(const char* name, const nikola::sizei iterations, Func&& func) {
+  func(iterations);
+
+  nikola::f64 samples[BENCH_SAMPLES_COUNT];
+  for(nikola::sizei i = 0; i < BENCH_SAMPLES_COUNT; i++) {
+    auto start = std::chrono::steady_clock::now();
+    func(iterations);
+    auto end   = std::chrono::steady_clock::now();
+
+    nikola::f64 elapsed = (nikola::f64)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    samples[i]          = elapsed / (nikola::f64)iterations;
+  }
+
+  bench_push_result(name, iterations, samples, BENCH_SAMPLES_COUNT);
+}
+
+/// Bench functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Benchmarks
+
+void containers_bench_run();
+
+void math_bench_run();
+
+void base_bench_run();
+
+void resources_bench_run();
+
+void renderer_bench_run();
+
+/// Benchmarks
+/// ----------------------------------------------------------------------
+
+/// *** Bench ***
+/// ----------------------------------------------------------------------
+
+} // End of bench
+
+//////////////////////////////////////////////////////////////////////////
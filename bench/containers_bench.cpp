@@ -0,0 +1,249 @@
+#include "bench.h"
+
+#include <nikola/nikola.h>
+
+#include <unordered_map>
+#include <deque>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace bench { // Start of bench
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The uniform names a typical `ShaderContext` ends up caching.
+static const char* UNIFORM_NAMES[] = {
+  "u_model",
+  "u_material.color",
+  "u_material.shininess",
+  "u_material.diffuse_map",
+  "u_material.specular_map",
+  "u_dir_light.direction",
+  "u_dir_light.ambient",
+  "u_dir_light.diffuse",
+  "u_dir_light.specular",
+  "u_point_lights[0].position",
+  "u_point_lights[0].ambient",
+  "u_point_lights[0].diffuse",
+  "u_point_lights[0].specular",
+  "u_point_lights[1].position",
+  "u_point_lights[1].ambient",
+  "u_point_lights[1].diffuse",
+  "u_point_lights[1].specular",
+  "u_point_lights_count",
+  "u_spot_light.position",
+  "u_spot_light.direction",
+  "u_spot_light.cutoff",
+  "u_spot_light.outer_cutoff",
+  "u_gamma",
+  "u_exposure",
+};
+
+const nikola::sizei UNIFORMS_COUNT = sizeof(UNIFORM_NAMES) / sizeof(UNIFORM_NAMES[0]);
+
+/// The amount of physics bodies created in the body benchmarks.
+const nikola::sizei BODIES_COUNT = 4096;
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+template<typename Map>
+static void bench_uniforms_lookup(const char* name) {
+  // Using the same strings every frame, much like the renderer does
+  nikola::String names[UNIFORMS_COUNT];
+  Map map;
+
+  for(nikola::sizei i = 0; i < UNIFORMS_COUNT; i++) {
+    names[i]      = UNIFORM_NAMES[i];
+    map[names[i]] = (nikola::i32)i;
+  }
+
+  bench_run(name, 1000000, [&](const nikola::sizei iterations) {
+    nikola::i32 sum = 0;
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      auto it = map.find(names[i % UNIFORMS_COUNT]);
+      sum    += it->second;
+    }
+
+    bench_do_not_optimize(sum);
+  });
+}
+
+template<typename Map>
+static void bench_glyphs_lookup(const char* name) {
+  const nikola::String text = "The quick brown fox jumps over the lazy dog! 0123456789 (Nikola) {renders} [text].";
+  Map map;
+
+  // Every printable ASCII character
+  for(nikola::i8 ch = 32; ch < 127; ch++) {
+    map[ch] = nikola::Glyph{.unicode = ch};
+  }
+
+  bench_run(name, 1000000, [&](const nikola::sizei iterations) {
+    nikola::i32 sum = 0;
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      auto it = map.find(text[i % text.size()]);
+      sum    += it->second.unicode;
+    }
+
+    bench_do_not_optimize(sum);
+  });
+}
+
+template<typename Map>
+static void bench_textures_lookup(const char* name) {
+  // Fake texture handles. Only their addresses matter.
+  nikola::u64 textures_storage[16][8];
+  nikola::GfxTexture* textures[16];
+  Map map;
+
+  for(nikola::sizei i = 0; i < 16; i++) {
+    textures[i]      = (nikola::GfxTexture*)&textures_storage[i][0];
+    map[textures[i]] = (nikola::i32)i;
+  }
+
+  bench_run(name, 1000000, [&](const nikola::sizei iterations) {
+    nikola::i32 sum = 0;
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      auto it = map.find(textures[(i * 7) & 15]);
+      sum    += it->second;
+    }
+
+    bench_do_not_optimize(sum);
+  });
+}
+
+template<typename Map>
+static void bench_groups_lookup(const char* name) {
+  Map map;
+  for(nikola::ResourceGroupID i = 0; i < 8; i++) {
+    map[i] = i * 2;
+  }
+
+  bench_run(name, 1000000, [&](const nikola::sizei iterations) {
+    nikola::i32 sum = 0;
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      auto it = map.find((nikola::ResourceGroupID)(i & 7));
+      sum    += it->second;
+    }
+
+    bench_do_not_optimize(sum);
+  });
+}
+
+template<typename Map>
+static void bench_bodies_churn(const char* name) {
+  nikola::u64 ids[BODIES_COUNT];
+  for(nikola::sizei i = 0; i < BODIES_COUNT; i++) {
+    ids[i] = nikola::random_u64();
+  }
+
+  // Create, look up, and destroy every body, just like a physics world would
+  bench_run(name, BODIES_COUNT, [&](const nikola::sizei iterations) {
+    Map map;
+    map.reserve(16);
+
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      map[ids[i]] = (void*)&ids[i];
+    }
+
+    nikola::sizei found = 0;
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      found += map.find(ids[i]) != map.end();
+    }
+
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      map.erase(ids[i]);
+    }
+
+    bench_do_not_optimize(found);
+  });
+}
+
+template<typename Array>
+static void bench_small_arrays(const char* name) {
+  bench_run(name, 100000, [&](const nikola::sizei iterations) {
+    nikola::sizei sum = 0;
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      Array array;
+      for(nikola::sizei j = 0; j < 6; j++) {
+        array.push_back(i + j);
+      }
+
+      sum += array[i % 6];
+    }
+
+    bench_do_not_optimize(sum);
+  });
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Benchmarks
+
+void containers_bench_run() {
+  bench_begin_group("containers");
+
+  bench_uniforms_lookup<std::unordered_map<nikola::String, nikola::i32>>("uniforms_lookup (std::unordered_map)");
+  bench_uniforms_lookup<nikola::HashMap<nikola::String, nikola::i32>>("uniforms_lookup (HashMap)");
+
+  bench_glyphs_lookup<std::unordered_map<nikola::i8, nikola::Glyph>>("glyphs_lookup (std::unordered_map)");
+  bench_glyphs_lookup<nikola::HashMap<nikola::i8, nikola::Glyph>>("glyphs_lookup (HashMap)");
+
+  bench_textures_lookup<std::unordered_map<nikola::GfxTexture*, nikola::i32>>("textures_lookup (std::unordered_map)");
+  bench_textures_lookup<nikola::HashMap<nikola::GfxTexture*, nikola::i32>>("textures_lookup (HashMap)");
+
+  bench_groups_lookup<std::unordered_map<nikola::ResourceGroupID, nikola::i32>>("groups_lookup (std::unordered_map)");
+  bench_groups_lookup<nikola::HashMap<nikola::ResourceGroupID, nikola::i32>>("groups_lookup (HashMap)");
+
+  bench_bodies_churn<std::unordered_map<nikola::u64, void*>>("bodies_churn (std::unordered_map)");
+  bench_bodies_churn<nikola::HashMap<nikola::u64, void*>>("bodies_churn (HashMap)");
+
+  bench_small_arrays<nikola::DynamicArray<nikola::sizei>>("small_array_push (std::vector)");
+  bench_small_arrays<nikola::SmallArray<nikola::sizei, 8>>("small_array_push (SmallArray)");
+  bench_small_arrays<nikola::FixedArray<nikola::sizei, 8>>("small_array_push (FixedArray)");
+
+  // Ring buffer vs. deque
+  bench_run("fifo_push_pop (std::deque)", 1000000, [&](const nikola::sizei iterations) {
+    std::deque<nikola::sizei> queue;
+    nikola::sizei sum = 0;
+
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      queue.push_back(i);
+      if(queue.size() > 64) {
+        sum += queue.front();
+        queue.pop_front();
+      }
+    }
+
+    bench_do_not_optimize(sum);
+  });
+
+  bench_run("fifo_push_pop (RingBuffer)", 1000000, [&](const nikola::sizei iterations) {
+    nikola::RingBuffer<nikola::sizei> queue(128);
+    nikola::sizei sum = 0;
+
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      queue.push_back(i);
+      if(queue.size() > 64) {
+        sum += queue.front();
+        queue.pop_front();
+      }
+    }
+
+    bench_do_not_optimize(sum);
+  });
+}
+
+/// Benchmarks
+/// ----------------------------------------------------------------------
+
+} // End of bench
+
+//////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,70 @@
+#include "bench.h"
+
+#include <nikola/nikola.h>
+
+#include <cstring>
+#include <cstdlib>
+
+/// Usage: nikola_bench [--json <path>] [--baseline <path>] [--tolerance <value>] [--update-baseline]
+///
+/// `--json`            writes the results to `path`.
+/// `--baseline`        compares the results against `path`, exiting with `1` on any regression 
+///                     or any benchmark missing from the baseline.
+/// `--tolerance`       is the allowed relative slowdown before a result counts as a regression.
+/// `--update-baseline` writes the results over the `--baseline` file instead of comparing against it.
+int main(int argc, char** argv) {
+  const char* json_path     = nullptr;
+  const char* baseline_path = nullptr;
+  nikola::f64 tolerance     = bench::BENCH_DEFAULT_TOLERANCE;
+  bool update_baseline      = false;
+
+  for(int i = 1; i < argc; i++) {
+    bool has_value = (i + 1) < argc;
+
+    if(std::strcmp(argv[i], "--json") == 0 && has_value) {
+      json_path = argv[++i];
+    }
+    else if(std::strcmp(argv[i], "--baseline") == 0 && has_value) {
+      baseline_path = argv[++i];
+    }
+    else if(std::strcmp(argv[i], "--tolerance") == 0 && has_value) {
+      tolerance = std::strtod(argv[++i], nullptr);
+    }
+    else if(std::strcmp(argv[i], "--update-baseline") == 0) {
+      update_baseline = true;
+    }
+  }
+
+  // Initialze the library
+  if(!nikola::init()) {
+    return -1;
+  }
+
+  bench::containers_bench_run();
+  bench::math_bench_run();
+  bench::base_bench_run();
+  bench::resources_bench_run();
+  bench::renderer_bench_run();
+  bench::bench_print_results();
+
+  int exit_code = 0;
+
+  if(json_path && !bench::bench_write_json(json_path)) {
+    exit_code = -1;
+  }
+
+  if(baseline_path && update_baseline) {
+    exit_code = bench::bench_write_json(baseline_path) ? exit_code : -1;
+  }
+  else if(baseline_path && bench::bench_compare_baseline(baseline_path, tolerance) != 0) {
+    exit_code = 1;
+  }
+  else if(update_baseline) {
+    NIKOLA_LOG_ERROR("`--update-baseline` needs a `--baseline` file to write to");
+    exit_code = -1;
+  }
+
+  // De-initialze the library
+  nikola::shutdown();
+  return exit_code;
+}
@@ -0,0 +1,188 @@
+#include "bench.h"
+
+#include <nikola/nikola.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace bench { // Start of bench
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The amount of inputs every math benchmark cycles through, so the
+/// compiler cannot fold the computation into a constant.
+const nikola::sizei MATH_INPUTS_COUNT = 64;
+
+/// The amount of transforms rebuilt by every `transform_update_batch` call.
+const nikola::sizei TRANSFORMS_BATCH_COUNT = 10000;
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// MathInputs
+struct MathInputs {
+  nikola::Vec3 positions[MATH_INPUTS_COUNT];
+  nikola::Vec3 axes[MATH_INPUTS_COUNT];
+  nikola::f32 angles[MATH_INPUTS_COUNT];
+
+  nikola::Quat rotations[MATH_INPUTS_COUNT];
+  nikola::Mat4 matrices[MATH_INPUTS_COUNT];
+};
+/// MathInputs
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static void init_inputs(MathInputs& inputs) {
+  for(nikola::sizei i = 0; i < MATH_INPUTS_COUNT; i++) {
+    inputs.positions[i] = nikola::Vec3(nikola::random_f32(-100.0f, 100.0f),
+                                       nikola::random_f32(-100.0f, 100.0f),
+                                       nikola::random_f32(-100.0f, 100.0f));
+    inputs.axes[i]      = nikola::vec3_normalize(nikola::Vec3(nikola::random_f32(0.1f, 1.0f),
+                                                              nikola::random_f32(0.1f, 1.0f),
+                                                              nikola::random_f32(0.1f, 1.0f)));
+    inputs.angles[i]    = nikola::random_f32(0.0f, 6.28f);
+
+    inputs.rotations[i] = nikola::quat_angle_axis(inputs.axes[i], inputs.angles[i]);
+    inputs.matrices[i]  = nikola::mat4_translate(inputs.positions[i]) * nikola::quat_to_mat4(inputs.rotations[i]);
+  }
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Benchmarks
+
+void math_bench_run() {
+  bench_begin_group("math");
+
+  MathInputs inputs;
+  init_inputs(inputs);
+
+  // Mat4
+
+  bench_run("mat4_multiply", 1000000, [&](const nikola::sizei iterations) {
+    nikola::Mat4 result(1.0f);
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      result = inputs.matrices[i % MATH_INPUTS_COUNT] * inputs.matrices[(i + 1) % MATH_INPUTS_COUNT];
+      bench_do_not_optimize(result);
+    }
+  });
+
+  bench_run("mat4_inverse", 1000000, [&](const nikola::sizei iterations) {
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::Mat4 result = nikola::mat4_inverse(inputs.matrices[i % MATH_INPUTS_COUNT]);
+      bench_do_not_optimize(result);
+    }
+  });
+
+  bench_run("mat4_perspective", 1000000, [&](const nikola::sizei iterations) {
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::Mat4 result = nikola::mat4_perspective(inputs.angles[i % MATH_INPUTS_COUNT], 1.77f, 0.1f, 100.0f);
+      bench_do_not_optimize(result);
+    }
+  });
+
+  bench_run("mat4_look_at", 1000000, [&](const nikola::sizei iterations) {
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::Mat4 result = nikola::mat4_look_at(inputs.positions[i % MATH_INPUTS_COUNT], nikola::Vec3(0.0f), nikola::Vec3(0.0f, 1.0f, 0.0f));
+      bench_do_not_optimize(result);
+    }
+  });
+
+  // Quat
+
+  bench_run("quat_angle_axis", 1000000, [&](const nikola::sizei iterations) {
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::Quat result = nikola::quat_angle_axis(inputs.axes[i % MATH_INPUTS_COUNT], inputs.angles[i % MATH_INPUTS_COUNT]);
+      bench_do_not_optimize(result);
+    }
+  });
+
+  bench_run("quat_lerp", 1000000, [&](const nikola::sizei iterations) {
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::Quat result = nikola::quat_lerp(inputs.rotations[i % MATH_INPUTS_COUNT], inputs.rotations[(i + 1) % MATH_INPUTS_COUNT], 0.5f);
+      bench_do_not_optimize(result);
+    }
+  });
+
+  bench_run("quat_to_mat4", 1000000, [&](const nikola::sizei iterations) {
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::Mat4 result = nikola::quat_to_mat4(inputs.rotations[i % MATH_INPUTS_COUNT]);
+      bench_do_not_optimize(result);
+    }
+  });
+
+  // Transform
+
+  bench_run("transform_translate", 1000000, [&](const nikola::sizei iterations) {
+    nikola::Transform transform;
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::transform_translate(transform, inputs.positions[i % MATH_INPUTS_COUNT]);
+      bench_do_not_optimize(transform.transform);
+    }
+  });
+
+  bench_run("transform_rotate", 1000000, [&](const nikola::sizei iterations) {
+    nikola::Transform transform;
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::transform_rotate(transform, inputs.rotations[i % MATH_INPUTS_COUNT]);
+      bench_do_not_optimize(transform.transform);
+    }
+  });
+
+  bench_run("transform_scale", 1000000, [&](const nikola::sizei iterations) {
+    nikola::Transform transform;
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::transform_scale(transform, inputs.axes[i % MATH_INPUTS_COUNT]);
+      bench_do_not_optimize(transform.transform);
+    }
+  });
+
+  bench_run("transform_set_* + transform_update", 1000000, [&](const nikola::sizei iterations) {
+    nikola::Transform transform;
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::transform_set_position(transform, inputs.positions[i % MATH_INPUTS_COUNT]);
+      nikola::transform_set_rotation(transform, inputs.rotations[i % MATH_INPUTS_COUNT]);
+      nikola::transform_set_scale(transform, inputs.axes[i % MATH_INPUTS_COUNT]);
+      nikola::transform_update(transform);
+      bench_do_not_optimize(transform.transform);
+    }
+  });
+
+  nikola::DynamicArray<nikola::Transform> transforms(TRANSFORMS_BATCH_COUNT);
+  for(nikola::sizei i = 0; i < TRANSFORMS_BATCH_COUNT; i++) {
+    nikola::transform_set_position(transforms[i], inputs.positions[i % MATH_INPUTS_COUNT]);
+    nikola::transform_set_rotation(transforms[i], inputs.rotations[i % MATH_INPUTS_COUNT]);
+    nikola::transform_set_scale(transforms[i], inputs.axes[i % MATH_INPUTS_COUNT]);
+  }
+
+  bench_run("transform_update_batch (all dirty)", TRANSFORMS_BATCH_COUNT * 100, [&](const nikola::sizei iterations) {
+    for(nikola::sizei i = 0; i < iterations; i += TRANSFORMS_BATCH_COUNT) {
+      // Only the flag needs resetting, the inputs stay the same
+      for(auto& transform : transforms) {
+        transform.is_dirty = true;
+      }
+
+      nikola::transform_update_batch(transforms.data(), transforms.size());
+      bench_do_not_optimize(transforms.data());
+    }
+  });
+
+  bench_run("transform_update_batch (none dirty)", TRANSFORMS_BATCH_COUNT * 100, [&](const nikola::sizei iterations) {
+    for(nikola::sizei i = 0; i < iterations; i += TRANSFORMS_BATCH_COUNT) {
+      nikola::transform_update_batch(transforms.data(), transforms.size());
+      bench_do_not_optimize(transforms.data());
+    }
+  });
+}
+
+/// Benchmarks
+/// ----------------------------------------------------------------------
+
+} // End of bench
+
+//////////////////////////////////////////////////////////////////////////
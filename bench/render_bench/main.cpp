@@ -0,0 +1,260 @@
+#include "scenes.h"
+
+#include <nikola/nikola.h>
+
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+
+/// ----------------------------------------------------------------------
+/// RenderBenchDesc
+struct RenderBenchDesc {
+  nikola::i32 width  = 1280;
+  nikola::i32 height = 720;
+
+  nikola::sizei warmup_frames = 30;
+  nikola::sizei frames        = 300;
+
+  /// Only run the scene with this name, or all of them if `nullptr`.
+  const char* scene_name = nullptr;
+
+  /// Dump the last frame of every scene into this directory, if not `nullptr`.
+  const char* dump_dir = nullptr;
+};
+/// RenderBenchDesc
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// SceneReport
+struct SceneReport {
+  const char* name = nullptr;
+
+  nikola::f64 p50_ms = 0.0;
+  nikola::f64 p90_ms = 0.0;
+  nikola::f64 p99_ms = 0.0;
+  nikola::f64 max_ms = 0.0;
+
+  nikola::GfxCommandStats stats;
+  nikola::RendererStats renderer_stats;
+};
+/// SceneReport
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static RenderBenchDesc parse_args(int argc, char** argv) {
+  RenderBenchDesc desc;
+
+  for(int i = 1; i < argc; i++) {
+    bool has_value = (i + 1) < argc;
+
+    if(std::strcmp(argv[i], "--frames") == 0 && has_value) {
+      desc.frames = (nikola::sizei)std::strtoull(argv[++i], nullptr, 10);
+    }
+    else if(std::strcmp(argv[i], "--warmup") == 0 && has_value) {
+      desc.warmup_frames = (nikola::sizei)std::strtoull(argv[++i], nullptr, 10);
+    }
+    else if(std::strcmp(argv[i], "--width") == 0 && has_value) {
+      desc.width = (nikola::i32)std::strtol(argv[++i], nullptr, 10);
+    }
+    else if(std::strcmp(argv[i], "--height") == 0 && has_value) {
+      desc.height = (nikola::i32)std::strtol(argv[++i], nullptr, 10);
+    }
+    else if(std::strcmp(argv[i], "--scene") == 0 && has_value) {
+      desc.scene_name = argv[++i];
+    }
+    else if(std::strcmp(argv[i], "--dump-dir") == 0 && has_value) {
+      desc.dump_dir = argv[++i];
+    }
+  }
+
+  // There must be at least a frame to take percentiles of
+  desc.frames = desc.frames == 0 ? 1 : desc.frames;
+  return desc;
+}
+
+static nikola::f64 get_percentile(const nikola::DynamicArray<nikola::f64>& sorted_times, const nikola::f64 percentile) {
+  nikola::sizei index = (nikola::sizei)(percentile * (nikola::f64)(sorted_times.size() - 1) + 0.5);
+  return sorted_times[index];
+}
+
+static void dump_frame(nikola::GfxContext* gfx, const RenderBenchDesc& desc, const char* scene_name) {
+  nikola::sizei row_size = (nikola::sizei)desc.width * 4;
+  nikola::u8* pixels     = (nikola::u8*)nikola::memory_allocate(row_size * desc.height);
+  nikola::gfx_context_read_pixels(gfx, desc.width, desc.height, pixels);
+
+  // A binary PPM, flipped since OpenGL stores the rows bottom-to-top
+  nikola::String out = "P6\n" + std::to_string(desc.width) + " " + std::to_string(desc.height) + "\n255\n";
+  out.reserve(out.size() + (desc.width * desc.height * 3));
+
+  for(nikola::i32 y = desc.height - 1; y >= 0; y--) {
+    nikola::u8* row = pixels + (y * row_size);
+
+    for(nikola::i32 x = 0; x < desc.width; x++) {
+      out += (char)row[x * 4 + 0];
+      out += (char)row[x * 4 + 1];
+      out += (char)row[x * 4 + 2];
+    }
+  }
+
+  nikola::memory_free(pixels);
+
+  nikola::FilePath path = nikola::filepath_append(desc.dump_dir, nikola::String(scene_name) + ".ppm");
+
+  nikola::File file;
+  if(!nikola::file_open(&file, path, (nikola::i32)(nikola::FILE_OPEN_WRITE | nikola::FILE_OPEN_BINARY))) {
+    NIKOLA_LOG_ERROR("Failed to open frame dump file \'%s\'", path.c_str());
+    return;
+  }
+
+  nikola::file_write_bytes(file, out);
+  nikola::file_close(file);
+
+  NIKOLA_LOG_INFO("Dumped the last frame of \'%s\' to \'%s\'", scene_name, path.c_str());
+}
+
+static SceneReport run_scene(nikola::GfxContext* gfx, const RenderBenchDesc& desc, const bench::SceneType type, const nikola::FilePath& res_dir) {
+  bench::Scene scene;
+  bench::scene_init(&scene, type, res_dir, desc.width, desc.height);
+
+  nikola::sizei frame = 0;
+
+  // Warm up the driver's caches first
+  for(nikola::sizei i = 0; i < desc.warmup_frames; i++, frame++) {
+    bench::scene_render(scene, frame);
+    nikola::gfx_context_present(gfx);
+  }
+
+  // Time the CPU side of every frame, including the present (which is
+  // where software rasterizers end up doing most of the work)
+  nikola::DynamicArray<nikola::f64> frame_times;
+  frame_times.reserve(desc.frames);
+
+  for(nikola::sizei i = 0; i < desc.frames; i++, frame++) {
+    nikola::u64 start = nikola::profiler_get_time_ns();
+
+    bench::scene_render(scene, frame);
+    nikola::gfx_context_present(gfx);
+
+    frame_times.push_back((nikola::f64)(nikola::profiler_get_time_ns() - start) / 1000000.0);
+  }
+
+  // Count the draws in a seperate frame, so recording never skews the timings
+  nikola::GfxCommandLog* log = nikola::gfx_command_log_create();
+  nikola::gfx_context_set_command_log(gfx, log);
+
+  bench::scene_render(scene, frame);
+  if(desc.dump_dir) {
+    dump_frame(gfx, desc, scene.name);
+  }
+  nikola::gfx_context_present(gfx);
+
+  nikola::gfx_context_set_command_log(gfx, nullptr);
+
+  // Build the report
+  std::sort(frame_times.begin(), frame_times.end());
+
+  SceneReport report = {
+    .name   = scene.name,
+    .p50_ms = get_percentile(frame_times, 0.50),
+    .p90_ms = get_percentile(frame_times, 0.90),
+    .p99_ms = get_percentile(frame_times, 0.99),
+    .max_ms = frame_times.back(),
+    .stats  = nikola::gfx_command_log_get_stats(log),
+
+    .renderer_stats = nikola::renderer_get_stats(),
+  };
+
+  nikola::gfx_command_log_destroy(log);
+  bench::scene_shutdown(scene);
+
+  return report;
+}
+
+static void print_reports(const nikola::DynamicArray<SceneReport>& reports, const RenderBenchDesc& desc) {
+  // Same as `bench_print_results`. The table goes straight to stdout, after anything still queued in the logger.
+  nikola::logger_flush();
+
+  printf("%zu frames per scene at %ix%i\n", desc.frames, desc.width, desc.height);
+  printf("%-16s | %9s | %9s | %9s | %9s | %10s | %10s | %13s | %10s\n",
+         "Scene", "p50 ms", "p90 ms", "p99 ms", "max ms", "Draw calls", "Commands", "Bytes/frame", "Culled");
+  printf("-----------------+-----------+-----------+-----------+-----------+------------+------------+---------------+-----------\n");
+
+  for(auto& report : reports) {
+    printf("%-16s | %9.3lf | %9.3lf | %9.3lf | %9.3lf | %10zu | %10zu | %13zu | %10zu\n",
+           report.name,
+           report.p50_ms,
+           report.p90_ms,
+           report.p99_ms,
+           report.max_ms,
+           report.stats.draw_calls,
+           report.stats.commands_count,
+           report.stats.bytes_uploaded,
+           report.renderer_stats.meshes_culled);
+  }
+
+  fflush(stdout);
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// Usage: nikola_render_bench [--frames <n>] [--warmup <n>] [--width <w>] [--height <h>] [--scene <name>] [--dump-dir <dir>]
+int main(int argc, char** argv) {
+  RenderBenchDesc desc = parse_args(argc, argv);
+
+  // Initialze the library
+  if(!nikola::init()) {
+    return -1;
+  }
+
+  // Offscreen window init
+  nikola::Window* window = nikola::window_open("Nikola Render Bench", desc.width, desc.height, nikola::WINDOW_FLAGS_OFFSCREEN);
+  if(!window) {
+    NIKOLA_LOG_ERROR("Failed to create an offscreen OpenGL context (is OSMesa or EGL available?)");
+    nikola::shutdown();
+    return -1;
+  }
+
+  // Renderer init
+  nikola::resource_manager_init();
+  nikola::renderer_init(window);
+  nikola::batch_renderer_init();
+
+  nikola::GfxContext* gfx = nikola::renderer_get_context();
+
+  // Every generated resource lives here
+  nikola::FilePath res_dir = nikola::filepath_append(nikola::filesystem_current_path(), "render_bench_res");
+  nikola::filesystem_create_directories(res_dir);
+
+  if(desc.dump_dir) {
+    nikola::filesystem_create_directories(desc.dump_dir);
+  }
+
+  // Run the scenes
+  nikola::DynamicArray<SceneReport> reports;
+  for(nikola::sizei i = 0; i < bench::SCENES_MAX; i++) {
+    bench::SceneType type = (bench::SceneType)i;
+    if(desc.scene_name && std::strcmp(desc.scene_name, bench::scene_get_name(type)) != 0) {
+      continue;
+    }
+
+    reports.push_back(run_scene(gfx, desc, type, res_dir));
+  }
+
+  if(reports.empty()) {
+    NIKOLA_LOG_ERROR("No scene is called \'%s\'", desc.scene_name);
+  }
+  print_reports(reports, desc);
+
+  // De-initialze everything
+  nikola::batch_renderer_shutdown();
+  nikola::resource_manager_shutdown();
+  nikola::renderer_shutdown();
+  nikola::window_close(window);
+  nikola::shutdown();
+
+  return reports.empty() ? -1 : 0;
+}
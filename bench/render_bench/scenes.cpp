@@ -0,0 +1,280 @@
+#include "scenes.h"
+
+#include <nikola/nikola.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace bench { // Start of bench
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The distance between every generated cube.
+const nikola::f32 CUBES_SPACING = 2.5f;
+
+/// The amount of cubes lit by the point lights scene.
+const nikola::sizei LIGHTS_CUBES_COUNT = 2500;
+
+/// The amount of point lights in the point lights scene.
+///
+/// @NOTE: The renderer only shades the first 32 lights, but it still
+/// has to walk through all of them every frame.
+const nikola::sizei POINT_LIGHTS_COUNT = 1000;
+
+/// The amount of quads in the quads scene.
+const nikola::sizei QUADS_COUNT = 50000;
+
+/// The size (in pixels) of every glyph of the generated font.
+const nikola::u16 GLYPH_SIZE = 16;
+
+/// The amount of characters in every line of the text scene.
+const nikola::sizei TEXT_LINE_LENGTH = 160;
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static void init_camera(Scene* scene, const nikola::Vec3& position, const nikola::i32 width, const nikola::i32 height) {
+  nikola::CameraDesc cam_desc = {
+    .position     = position,
+    .target       = nikola::Vec3(0.0f, 0.0f, -1.0f),
+    .up_axis      = nikola::Vec3(0.0f, 1.0f, 0.0f),
+    .aspect_ratio = (nikola::f32)width / (nikola::f32)height,
+    .move_func    = nullptr,
+  };
+  nikola::camera_create(&scene->frame_data.camera, cam_desc);
+
+  // Big scenes need to be fully visible
+  scene->frame_data.camera.far = 1000.0f;
+}
+
+static void init_cubes(Scene* scene, const nikola::sizei count) {
+  scene->mesh_id = nikola::resources_push_mesh(scene->group_id, nikola::GEOMETRY_CUBE);
+  scene->transforms.reserve(count);
+
+  // Fill up a cube of cubes, starting right in front of the camera
+  nikola::sizei side = 1;
+  while((side * side * side) < count) {
+    side++;
+  }
+
+  nikola::f32 half_extent = (nikola::f32)side * CUBES_SPACING * 0.5f;
+  for(nikola::sizei i = 0; i < count; i++) {
+    nikola::Vec3 position((nikola::f32)(i % side) * CUBES_SPACING - half_extent,
+                          (nikola::f32)((i / side) % side) * CUBES_SPACING - half_extent,
+                          -(nikola::f32)(i / (side * side)) * CUBES_SPACING - 10.0f);
+
+    nikola::Transform transform;
+    nikola::transform_translate(transform, position);
+    nikola::transform_rotate(transform, nikola::Vec3(0.0f, 1.0f, 0.0f), (nikola::f32)i * 0.1f);
+    nikola::transform_scale(transform, nikola::Vec3(1.0f));
+
+    scene->transforms.push_back(transform);
+  }
+}
+
+static void init_point_lights(Scene* scene) {
+  // No randomness, so the dumped frames stay the same between runs
+  for(nikola::sizei i = 0; i < POINT_LIGHTS_COUNT; i++) {
+    nikola::f32 angle = (nikola::f32)i * 0.618f;
+
+    nikola::PointLight light = {
+      .position = nikola::Vec3((nikola::f32)nikola::cos(angle) * 60.0f,
+                               (nikola::f32)nikola::sin(angle) * 60.0f,
+                               -10.0f - (nikola::f32)(i % 128)),
+      .color    = nikola::Vec3((nikola::f32)(i % 7) / 7.0f, (nikola::f32)(i % 5) / 5.0f, (nikola::f32)(i % 3) / 3.0f),
+    };
+
+    scene->frame_data.point_lights.push_back(light);
+  }
+}
+
+static nikola::FilePath save_font(const nikola::FilePath& res_dir) {
+  // Solid blocks for every printable ASCII character. Only the amount of work matters here.
+  nikola::NBRGlyph glyphs[95];
+  for(nikola::i8 ch = 32; ch < 127; ch++) {
+    nikola::u8* pixels = (nikola::u8*)nikola::memory_allocate(GLYPH_SIZE * GLYPH_SIZE);
+    nikola::memory_set(pixels, (ch == ' ') ? 0 : 0xff, GLYPH_SIZE * GLYPH_SIZE);
+
+    glyphs[ch - 32] = nikola::NBRGlyph {
+      .unicode   = ch,
+      .width     = GLYPH_SIZE,
+      .height    = GLYPH_SIZE,
+      .right     = GLYPH_SIZE,
+      .bottom    = GLYPH_SIZE,
+      .offset_y  = -GLYPH_SIZE,
+      .advance_x = GLYPH_SIZE + 2,
+      .pixels    = pixels,
+    };
+  }
+
+  nikola::NBRFont font = {
+    .glyphs_count = 95,
+    .glyphs       = glyphs,
+    .ascent       = GLYPH_SIZE,
+    .descent      = 0,
+    .line_gap     = 2,
+  };
+
+  nikola::FilePath path = nikola::filepath_append(res_dir, "render_bench_font.nbrfont");
+
+  nikola::NBRFile nbr = {};
+  nikola::nbr_file_save(nbr, font, path);
+
+  for(nikola::u32 i = 0; i < font.glyphs_count; i++) {
+    nikola::memory_free(glyphs[i].pixels);
+  }
+  return path;
+}
+
+static void init_text(Scene* scene, const nikola::FilePath& res_dir) {
+  nikola::ResourceID font_id = nikola::resources_push_font(scene->group_id, save_font(res_dir));
+  scene->font                = nikola::resources_get_font(font_id);
+
+  const nikola::String pangram = "The quick brown fox jumps over the lazy dog! 0123456789 ";
+  while(scene->text.size() < TEXT_LINE_LENGTH) {
+    scene->text += pangram;
+  }
+  scene->text.resize(TEXT_LINE_LENGTH);
+}
+
+static void clear_frame() {
+  // The 3D renderer clears its own targets, but the batch renderer draws straight into the default one
+  nikola::GfxContext* gfx = nikola::renderer_get_context();
+
+  nikola::gfx_context_set_target(gfx, nullptr);
+  nikola::gfx_context_clear(gfx, 0.1f, 0.1f, 0.1f, 1.0f);
+}
+
+static void render_meshes(Scene& scene) {
+  nikola::camera_update(scene.frame_data.camera);
+
+  nikola::renderer_begin(scene.frame_data);
+  nikola::renderer_queue_mesh_instanced(scene.mesh_id, scene.transforms.data(), scene.transforms.size());
+  nikola::renderer_end();
+}
+
+static void render_quads(Scene& scene, const nikola::sizei frame) {
+  nikola::sizei width  = (nikola::sizei)scene.frame_size.x;
+  nikola::sizei height = (nikola::sizei)scene.frame_size.y;
+
+  clear_frame();
+  nikola::batch_renderer_begin();
+
+  for(nikola::sizei i = 0; i < QUADS_COUNT; i++) {
+    nikola::Vec2 position((nikola::f32)((i * 7 + frame) % width), (nikola::f32)((i * 13) % height));
+    nikola::Vec4 color((nikola::f32)(i % 255) / 255.0f, 0.5f, (nikola::f32)((i * 3) % 255) / 255.0f, 1.0f);
+
+    nikola::batch_render_quad(position, nikola::Vec2(8.0f), color);
+  }
+
+  nikola::batch_renderer_end();
+}
+
+static void render_text(Scene& scene, const nikola::sizei frame) {
+  clear_frame();
+  nikola::batch_renderer_begin();
+
+  nikola::f32 line_height = (nikola::f32)(GLYPH_SIZE + 2);
+  for(nikola::f32 y = line_height; y < scene.frame_size.y; y += line_height) {
+    nikola::Vec2 position((nikola::f32)(frame % 16), y);
+    nikola::batch_render_text(scene.font, scene.text, position, (nikola::f32)GLYPH_SIZE, nikola::Vec4(1.0f));
+  }
+
+  nikola::batch_renderer_end();
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Scene functions
+
+const char* scene_get_name(const SceneType type) {
+  switch(type) {
+    case SCENE_CUBES_10K:
+      return "cubes_10k";
+    case SCENE_CUBES_100K:
+      return "cubes_100k";
+    case SCENE_POINT_LIGHTS_1K:
+      return "point_lights_1k";
+    case SCENE_QUADS_50K:
+      return "quads_50k";
+    case SCENE_TEXT_HEAVY:
+      return "text_heavy";
+    default:
+      return "unknown";
+  }
+}
+
+void scene_init(Scene* scene, const SceneType type, const nikola::FilePath& res_dir, const nikola::i32 width, const nikola::i32 height) {
+  scene->type       = type;
+  scene->name       = scene_get_name(type);
+  scene->frame_size = nikola::Vec2(width, height);
+  scene->group_id   = nikola::resources_create_group(scene->name, res_dir);
+
+  init_camera(scene, nikola::Vec3(0.0f, 0.0f, 30.0f), width, height);
+
+  switch(type) {
+    case SCENE_CUBES_10K:
+      init_cubes(scene, 10000);
+      break;
+    case SCENE_CUBES_100K:
+      init_cubes(scene, 100000);
+      break;
+    case SCENE_POINT_LIGHTS_1K:
+      init_cubes(scene, LIGHTS_CUBES_COUNT);
+      init_point_lights(scene);
+      break;
+    case SCENE_QUADS_50K:
+      break;
+    case SCENE_TEXT_HEAVY:
+      init_text(scene, res_dir);
+      break;
+    default:
+      break;
+  }
+
+  NIKOLA_LOG_INFO("Generated scene \'%s\'", scene->name);
+}
+
+void scene_shutdown(Scene& scene) {
+  nikola::resources_destroy_group(scene.group_id);
+
+  scene.transforms.clear();
+  scene.frame_data.point_lights.clear();
+}
+
+void scene_render(Scene& scene, const nikola::sizei frame) {
+  switch(scene.type) {
+    case SCENE_POINT_LIGHTS_1K:
+      // Keep the lights moving so their uniforms change every frame
+      for(nikola::sizei i = 0; i < scene.frame_data.point_lights.size(); i++) {
+        scene.frame_data.point_lights[i].position.y += (nikola::f32)nikola::sin((nikola::f64)(frame + i) * 0.1) * 0.5f;
+      }
+
+      render_meshes(scene);
+      break;
+    case SCENE_CUBES_10K:
+    case SCENE_CUBES_100K:
+      render_meshes(scene);
+      break;
+    case SCENE_QUADS_50K:
+      render_quads(scene, frame);
+      break;
+    case SCENE_TEXT_HEAVY:
+      render_text(scene, frame);
+      break;
+    default:
+      break;
+  }
+}
+
+/// Scene functions
+/// ----------------------------------------------------------------------
+
+} // End of bench
+
+//////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <nikola/nikola.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace bench { // Start of bench
+
+/// ----------------------------------------------------------------------
+/// *** Scenes ***
+
+/// ----------------------------------------------------------------------
+/// SceneType
+enum SceneType {
+  SCENE_CUBES_10K = 0,
+  SCENE_CUBES_100K,
+  SCENE_POINT_LIGHTS_1K,
+  SCENE_QUADS_50K,
+  SCENE_TEXT_HEAVY,
+
+  SCENES_MAX,
+};
+/// SceneType
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Scene
+struct Scene {
+  SceneType type;
+  const char* name = nullptr;
+
+  nikola::Vec2 frame_size;
+
+  nikola::ResourceGroupID group_id = {};
+  nikola::FrameData frame_data;
+
+  nikola::ResourceID mesh_id = {};
+  nikola::DynamicArray<nikola::Transform> transforms;
+
+  nikola::Font* font = nullptr;
+  nikola::String text;
+};
+/// Scene
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Scene functions
+
+/// Retrieve the name of the scene `type` (i.e, "cubes_10k").
+const char* scene_get_name(const SceneType type);
+
+/// Generate the scene `type` into `scene`, saving any resources it needs into `res_dir`.
+/// The scene is rendered into a frame of `width` by `height`.
+void scene_init(Scene* scene, const SceneType type, const nikola::FilePath& res_dir, const nikola::i32 width, const nikola::i32 height);
+
+/// Free all of the resources of `scene`.
+void scene_shutdown(Scene& scene);
+
+/// Submit every draw of `scene` for the given `frame`.
+///
+/// @NOTE: This does not present the frame.
+void scene_render(Scene& scene, const nikola::sizei frame);
+
+/// Scene functions
+/// ----------------------------------------------------------------------
+
+/// *** Scenes ***
+/// ----------------------------------------------------------------------
+
+} // End of bench
+
+//////////////////////////////////////////////////////////////////////////
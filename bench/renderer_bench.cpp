@@ -0,0 +1,136 @@
+#include "bench.h"
+
+#include <nikola/nikola.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace bench { // Start of bench
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The size of the headless frame the renderer is initialized with.
+const nikola::i32 FRAME_WIDTH  = 1280;
+const nikola::i32 FRAME_HEIGHT = 720;
+
+/// The amount of shapes submitted between every `batch_renderer_begin` and `batch_renderer_end`.
+const nikola::sizei SHAPES_PER_FRAME = 20000;
+
+/// The uniforms the material pass of the renderer sets for every mesh.
+static const char* MATERIAL_UNIFORMS[] = {
+  "u_model",
+  "u_material.color",
+  "u_material.shininess",
+  "u_material.diffuse_map",
+  "u_material.specular_map",
+  "u_exposure",
+};
+
+const nikola::sizei MATERIAL_UNIFORMS_COUNT = sizeof(MATERIAL_UNIFORMS) / sizeof(MATERIAL_UNIFORMS[0]);
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+template<typename Func>
+static void bench_batch(const char* name, Func&& submit_fn) {
+  bench_run(name, SHAPES_PER_FRAME * 10, [&](const nikola::sizei iterations) {
+    for(nikola::sizei i = 0; i < iterations; i += SHAPES_PER_FRAME) {
+      nikola::batch_renderer_begin();
+
+      for(nikola::sizei j = 0; j < SHAPES_PER_FRAME; j++) {
+        submit_fn(j);
+      }
+
+      nikola::batch_renderer_end();
+    }
+  });
+}
+
+static void bench_uniforms() {
+  const nikola::i8* source = (const nikola::i8*)"#version 460 core\nvoid main() {}\n";
+
+  nikola::ResourceID shader_id      = nikola::resources_push_shader(nikola::RESOURCE_CACHE_ID, nikola::GfxShaderDesc{source, source});
+  nikola::ResourceID shader_ctx_id  = nikola::resources_push_shader_context(nikola::RESOURCE_CACHE_ID, shader_id);
+  nikola::ShaderContext* shader_ctx = nikola::resources_get_shader_context(shader_ctx_id);
+
+  nikola::String names[MATERIAL_UNIFORMS_COUNT];
+  nikola::StringID ids[MATERIAL_UNIFORMS_COUNT];
+
+  for(nikola::sizei i = 0; i < MATERIAL_UNIFORMS_COUNT; i++) {
+    names[i] = MATERIAL_UNIFORMS[i];
+    ids[i]   = nikola::string_id_intern(MATERIAL_UNIFORMS[i]);
+
+    nikola::shader_context_cache_uniform(shader_ctx, ids[i]);
+  }
+
+  nikola::Mat4 model(1.0f);
+
+  bench_run("shader_context_set_uniform (String)", 1000000, [&](const nikola::sizei iterations) {
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::shader_context_set_uniform(shader_ctx, names[i % MATERIAL_UNIFORMS_COUNT], model);
+    }
+  });
+
+  bench_run("shader_context_set_uniform (StringID)", 1000000, [&](const nikola::sizei iterations) {
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::shader_context_set_uniform(shader_ctx, ids[i % MATERIAL_UNIFORMS_COUNT], model);
+    }
+  });
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Benchmarks
+
+void renderer_bench_run() {
+  bench_begin_group("renderer");
+
+  // A headless renderer keeps the CPU side of every call while skipping the GPU,
+  // which is exactly what these benchmarks need to measure.
+  nikola::resource_manager_init();
+  nikola::renderer_init_headless(FRAME_WIDTH, FRAME_HEIGHT);
+  nikola::batch_renderer_init();
+
+  // Batch renderer
+
+  bench_batch("batch_render_quad", [](const nikola::sizei index) {
+    nikola::Vec2 position((nikola::f32)(index % FRAME_WIDTH), (nikola::f32)(index % FRAME_HEIGHT));
+    nikola::batch_render_quad(position, nikola::Vec2(16.0f), nikola::Vec4(1.0f, 0.5f, 0.25f, 1.0f));
+  });
+
+  nikola::GfxTexture* texture = nikola::renderer_get_defaults().texture;
+  bench_batch("batch_render_texture", [&](const nikola::sizei index) {
+    nikola::Vec2 position((nikola::f32)(index % FRAME_WIDTH), (nikola::f32)(index % FRAME_HEIGHT));
+    nikola::batch_render_texture(texture, position, nikola::Vec2(16.0f));
+  });
+
+  bench_batch("batch_render_circle", [](const nikola::sizei index) {
+    nikola::Vec2 center((nikola::f32)(index % FRAME_WIDTH), (nikola::f32)(index % FRAME_HEIGHT));
+    nikola::batch_render_circle(center, 8.0f, nikola::Vec4(1.0f));
+  });
+
+  bench_batch("batch_render_polygon (6 sides)", [](const nikola::sizei index) {
+    nikola::Vec2 center((nikola::f32)(index % FRAME_WIDTH), (nikola::f32)(index % FRAME_HEIGHT));
+    nikola::batch_render_polygon(center, 8.0f, 6, nikola::Vec4(1.0f));
+  });
+
+  // Shader contexts
+
+  bench_uniforms();
+
+  nikola::batch_renderer_shutdown();
+  nikola::resource_manager_shutdown();
+  nikola::renderer_shutdown();
+}
+
+/// Benchmarks
+/// ----------------------------------------------------------------------
+
+} // End of bench
+
+//////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,239 @@
+#include "bench.h"
+
+#include <nikola/nikola.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace bench { // Start of bench
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The directory the generated NBR files are saved into (relative to the working directory).
+static const char* RESOURCES_DIR = "bench_resources";
+
+/// The amount of meshes in the generated model.
+const nikola::u16 MODEL_MESHES_COUNT = 8;
+
+/// The amount of vertices in every mesh of the generated model.
+const nikola::u32 MESH_VERTICES_COUNT = 4096;
+
+/// The amount of floats in a single `VERTEX_TYPE_PNUV` vertex.
+const nikola::u32 PNUV_FLOATS_COUNT = 8;
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static nikola::u8* generate_pixels(const nikola::sizei size) {
+  nikola::u8* pixels = (nikola::u8*)nikola::memory_allocate(size);
+  for(nikola::sizei i = 0; i < size; i++) {
+    pixels[i] = (nikola::u8)(i * 31);
+  }
+
+  return pixels;
+}
+
+static nikola::FilePath save_texture(const nikola::FilePath& dir) {
+  nikola::NBRTexture texture = {
+    .width    = 512,
+    .height   = 512,
+    .channels = 4,
+  };
+  texture.pixels = generate_pixels(texture.width * texture.height * texture.channels);
+
+  nikola::FilePath path = nikola::filepath_append(dir, "texture.nbrtexture");
+
+  nikola::NBRFile nbr = {};
+  nikola::nbr_file_save(nbr, texture, path);
+
+  nikola::memory_free(texture.pixels);
+  return path;
+}
+
+static nikola::FilePath save_cubemap(const nikola::FilePath& dir) {
+  nikola::NBRCubemap cubemap = {
+    .width       = 256,
+    .height      = 256,
+    .channels    = 4,
+    .faces_count = nikola::CUBEMAP_FACES_MAX,
+  };
+
+  for(nikola::u8 i = 0; i < cubemap.faces_count; i++) {
+    cubemap.pixels[i] = generate_pixels(cubemap.width * cubemap.height * cubemap.channels);
+  }
+
+  nikola::FilePath path = nikola::filepath_append(dir, "cubemap.nbrcubemap");
+
+  nikola::NBRFile nbr = {};
+  nikola::nbr_file_save(nbr, cubemap, path);
+
+  for(nikola::u8 i = 0; i < cubemap.faces_count; i++) {
+    nikola::memory_free(cubemap.pixels[i]);
+  }
+  return path;
+}
+
+static nikola::FilePath save_shader(const nikola::FilePath& dir) {
+  // Roughly the size of the Blinn-Phong shader
+  nikola::String vertex_source(4096, 'v');
+  nikola::String pixel_source(8192, 'p');
+
+  nikola::NBRShader shader = {
+    .vertex_length = (nikola::u16)vertex_source.size(),
+    .vertex_source = (nikola::i8*)vertex_source.data(),
+    .pixel_length  = (nikola::u16)pixel_source.size(),
+    .pixel_source  = (nikola::i8*)pixel_source.data(),
+  };
+
+  nikola::FilePath path = nikola::filepath_append(dir, "shader.nbrshader");
+
+  nikola::NBRFile nbr = {};
+  nikola::nbr_file_save(nbr, shader, path);
+
+  return path;
+}
+
+static nikola::FilePath save_model(const nikola::FilePath& dir) {
+  nikola::NBRMesh meshes[MODEL_MESHES_COUNT];
+  for(nikola::u16 i = 0; i < MODEL_MESHES_COUNT; i++) {
+    meshes[i] = nikola::NBRMesh {
+      .vertex_type    = (nikola::u8)nikola::VERTEX_TYPE_PNUV,
+      .vertices_count = MESH_VERTICES_COUNT * PNUV_FLOATS_COUNT,
+      .vertices       = (nikola::f32*)generate_pixels(sizeof(nikola::f32) * MESH_VERTICES_COUNT * PNUV_FLOATS_COUNT),
+      .indices_count  = MESH_VERTICES_COUNT,
+      .indices        = (nikola::u32*)generate_pixels(sizeof(nikola::u32) * MESH_VERTICES_COUNT),
+      .material_index = 0,
+    };
+  }
+
+  nikola::NBRMaterial material = {
+    .ambient        = {1.0f, 1.0f, 1.0f},
+    .diffuse        = {1.0f, 1.0f, 1.0f},
+    .specular       = {1.0f, 1.0f, 1.0f},
+    .diffuse_index  = 0,
+    .specular_index = 0,
+  };
+
+  nikola::NBRTexture texture = {
+    .width    = 256,
+    .height   = 256,
+    .channels = 4,
+  };
+  texture.pixels = generate_pixels(texture.width * texture.height * texture.channels);
+
+  nikola::NBRModel model = {
+    .meshes_count    = MODEL_MESHES_COUNT,
+    .meshes          = meshes,
+    .materials_count = 1,
+    .materials       = &material,
+    .textures_count  = 1,
+    .textures        = &texture,
+  };
+
+  nikola::FilePath path = nikola::filepath_append(dir, "model.nbrmodel");
+
+  nikola::NBRFile nbr = {};
+  nikola::nbr_file_save(nbr, model, path);
+
+  for(nikola::u16 i = 0; i < MODEL_MESHES_COUNT; i++) {
+    nikola::memory_free(meshes[i].vertices);
+    nikola::memory_free(meshes[i].indices);
+  }
+  nikola::memory_free(texture.pixels);
+
+  return path;
+}
+
+static nikola::FilePath save_font(const nikola::FilePath& dir) {
+  // Every printable ASCII character
+  nikola::NBRGlyph glyphs[95];
+  for(nikola::i8 ch = 32; ch < 127; ch++) {
+    glyphs[ch - 32] = nikola::NBRGlyph {
+      .unicode   = ch,
+      .width     = 48,
+      .height    = 48,
+      .advance_x = 48,
+      .pixels    = generate_pixels(48 * 48),
+    };
+  }
+
+  nikola::NBRFont font = {
+    .glyphs_count = 95,
+    .glyphs       = glyphs,
+    .ascent       = 40,
+    .descent      = -8,
+    .line_gap     = 4,
+  };
+
+  nikola::FilePath path = nikola::filepath_append(dir, "font.nbrfont");
+
+  nikola::NBRFile nbr = {};
+  nikola::nbr_file_save(nbr, font, path);
+
+  for(nikola::u32 i = 0; i < font.glyphs_count; i++) {
+    nikola::memory_free(glyphs[i].pixels);
+  }
+  return path;
+}
+
+static nikola::FilePath save_audio(const nikola::FilePath& dir) {
+  // A second of 16-bit stereo
+  nikola::NBRAudio audio = {
+    .format      = (nikola::u8)nikola::AUDIO_BUFFER_FORMAT_I16,
+    .sample_rate = 44100,
+    .channels    = 2,
+    .size        = (nikola::u32)(44100 * 2 * sizeof(nikola::i16)),
+  };
+  audio.samples = (nikola::i16*)generate_pixels(audio.size);
+
+  nikola::FilePath path = nikola::filepath_append(dir, "audio.nbraudio");
+
+  nikola::NBRFile nbr = {};
+  nikola::nbr_file_save(nbr, audio, path);
+
+  nikola::memory_free(audio.samples);
+  return path;
+}
+
+static void bench_nbr_load(const char* name, const nikola::FilePath& path, const nikola::sizei count) {
+  bench_run(name, count, [&](const nikola::sizei iterations) {
+    for(nikola::sizei i = 0; i < iterations; i++) {
+      nikola::NBRFile nbr = {};
+      nikola::nbr_file_load(&nbr, path);
+      bench_do_not_optimize(nbr.body_data);
+
+      nikola::nbr_file_unload(nbr);
+    }
+  });
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Benchmarks
+
+void resources_bench_run() {
+  bench_begin_group("resources");
+
+  // Generate every resource type first, so the benchmarks only measure loading
+  nikola::FilePath dir = nikola::filepath_append(nikola::filesystem_current_path(), RESOURCES_DIR);
+  nikola::filesystem_create_directories(dir);
+
+  bench_nbr_load("nbr_file_load (texture)", save_texture(dir), 64);
+  bench_nbr_load("nbr_file_load (cubemap)", save_cubemap(dir), 16);
+  bench_nbr_load("nbr_file_load (shader)", save_shader(dir), 256);
+  bench_nbr_load("nbr_file_load (model)", save_model(dir), 32);
+  bench_nbr_load("nbr_file_load (font)", save_font(dir), 64);
+  bench_nbr_load("nbr_file_load (audio)", save_audio(dir), 64);
+}
+
+/// Benchmarks
+/// ----------------------------------------------------------------------
+
+} // End of bench
+
+//////////////////////////////////////////////////////////////////////////
@@ -15,3 +15,5 @@
 #include <nikola/nikola_timer.h>
 #include <nikola/nikola_ui.h>
 #include <nikola/nikola_physics.h>
+#include <nikola/nikola_jobs.h>
+#include <nikola/nikola_profiler.h>
@@ -39,6 +39,15 @@ namespace nikola { // Start of nikola
 /// ----------------------------------------------------------------------
 /// *** Engine ***
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Engine consts
+
+/// The maximum amount of frames the CPU can ever be ahead of the GPU.
+const u32 FRAMES_IN_FLIGHT_MAX = 4;
+
+/// Engine consts
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// App
 struct App;
@@ -63,6 +72,10 @@ using AppShutdownFn   = void(*)(App* app);
 /// A function callback to update a `App` struct, passing in the `delta_time`.
 using AppUpdateFn     = void(*)(App* app, const f64 delta_time);
 
+/// A function callback to render a `App` struct, passing in the interpolation `alpha` 
+/// (in the range of `[0, 1)`) between the last two fixed updates.
+using AppRenderFn     = void(*)(App* app, const f64 alpha);
+
 /// A function callback to render a `App` struct.
 using AppRenderPassFn = void(*)(App* app);
 
@@ -76,8 +89,12 @@ struct AppDesc {
   AppShutdownFn shutdown_fn = nullptr;
   AppUpdateFn update_fn     = nullptr;
   
-  AppRenderPassFn render_fn     = nullptr;
+  AppRenderFn render_fn         = nullptr;
   AppRenderPassFn render_gui_fn = nullptr;
+
+  /// Called `fixed_update_rate` times per second with a constant `delta_time`, 
+  /// right after every step of the physics world.
+  AppUpdateFn fixed_update_fn = nullptr;
  
   String window_title;
   i32 window_width, window_height;
@@ -85,6 +102,39 @@ struct AppDesc {
 
   char** args_values = nullptr; 
   i32 args_count     = 0;
+
+  /// The rate (in Hz) of `fixed_update_fn` as well as the physics world.
+  f64 fixed_update_rate = 60.0;
+
+  /// The maximum amount of fixed updates a single frame can run. 
+  /// Any time left over after that is dropped, so a slow frame cannot snowball into slower ones.
+  u32 fixed_updates_max = 8;
+
+  /// Cap the frame rate to `frame_rate_limit` frames per second. 
+  /// A value of `0` leaves the frame rate uncapped.
+  f64 frame_rate_limit = 0.0;
+
+  /// The maximum amount of frames the CPU can queue up before waiting on the GPU.
+  /// A value of `0` leaves it up to the driver.
+  ///
+  /// @NOTE: This is clamped to `FRAMES_IN_FLIGHT_MAX`.
+  u32 frames_in_flight = 2;
+
+  /// Run the app without a window, on top of a headless graphics context and a null audio device.
+  /// Physics, resources, and every callback still run as usual, just as fast as they can.
+  ///
+  /// @NOTE: `window_width` and `window_height` are still used as the size of the render passes, 
+  /// and `init_fn` will be given a `nullptr` window. Dispatch `EVENT_APP_QUIT` to stop the app.
+  bool is_headless = false;
+
+  /// Record the input of the whole session into this file, if not empty. 
+  String input_record_path;
+
+  /// Replay the input recorded into this file, if not empty. 
+  /// The app quits as soon as the replay is over, which makes for reproducible performance runs.
+  ///
+  /// @NOTE: See `input_replay_begin` for more details.
+  String input_replay_path;
 };
 /// App description 
 ///---------------------------------------------------------------------------------------------------------------------
@@ -99,6 +149,10 @@ NIKOLA_API void engine_init(const AppDesc& desc);
 
 /// Run a loop, updating and rendering the `App` struct allocated earlier 
 /// as well as any engine sub-systems.
+///
+/// @NOTE: The physics world and `fixed_update_fn` are stepped at a fixed rate, 
+/// independent of the frame rate. The time left over in the accumulator is passed 
+/// on to `render_fn` as an interpolation alpha.
 NIKOLA_API void engine_run();
 
 /// Free/reclaim and shutdown any and all engine sub-systems as well 
@@ -156,7 +156,10 @@ struct AudioListenerDesc {
 ///
 /// @NOTE: If `device_name` is set to `nullptr`, the audio device will choose the system's 
 /// default sound card.
-NIKOLA_API bool audio_device_init(const char* device_name);
+///
+/// @NOTE: If `is_null` is set to `true`, a null device will be initialized instead, which keeps 
+/// track of every buffer and source but never touches the sound card. This is useful for headless runs.
+NIKOLA_API bool audio_device_init(const char* device_name, const bool is_null = false);
 
 /// Shutdown the audio system, reclaiming any allocated memory.
 NIKOLA_API void audio_device_shutdown();
@@ -146,6 +146,66 @@ NIKOLA_API void shutdown();
 /// ----------------------------------------------------------------------
 /// *** Memory ***
 
+// Only keep track of individual blocks and their callsites on debug builds
+#if NIKOLA_BUILD_DEBUG == 1
+#define NIKOLA_MEMORY_TRACKING_ACTIVE 1
+#else 
+#define NIKOLA_MEMORY_TRACKING_ACTIVE 0
+#endif
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Memory consts
+
+/// The default capacity of the global frame arena (8 MiB). 
+const sizei MEMORY_FRAME_ARENA_CAPACITY = 8 * 1024 * 1024;
+
+/// The default alignment of any block pushed into a `MemoryArena`.
+const sizei MEMORY_DEFAULT_ALIGNMENT    = 16;
+
+/// Memory consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// MemoryTag
+
+/// Every allocation made through the memory functions is associated 
+/// with a tag, which is used to keep track of how much memory each 
+/// sub-system uses.
+enum MemoryTag {
+  /// Any allocation without a specific tag (i.e, `memory_allocate`).
+  MEMORY_TAG_GENERAL = 0,
+
+  MEMORY_TAG_GFX,
+  MEMORY_TAG_RESOURCES,
+  MEMORY_TAG_PHYSICS,
+  MEMORY_TAG_AUDIO,
+  MEMORY_TAG_NBR,
+  MEMORY_TAG_APP,
+
+  MEMORY_TAGS_MAX = MEMORY_TAG_APP + 1,
+};
+/// MemoryTag
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// MemoryTagStats
+struct MemoryTagStats {
+  /// The amount of bytes currently allocated with this tag.
+  sizei live_bytes = 0;
+
+  /// The highest amount of bytes ever allocated at once with this tag.
+  sizei peak_bytes = 0;
+
+  /// The maximum amount of bytes this tag should use. 
+  /// A budget of `0` means the tag has no budget.
+  sizei budget_bytes = 0;
+
+  /// The amount of blocks currently allocated with this tag.
+  sizei live_blocks = 0;
+};
+/// MemoryTagStats
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Memory callbacks
 
@@ -165,10 +225,22 @@ using FreeMemoryFn = void(*)(void* ptr);
 
 /// Allocate a memory block of size `size`.
 /// 
+/// @NOTE: This is equivalent to `memory_allocate_tagged(size, MEMORY_TAG_GENERAL)`.
+///
 /// @NOTE: This function will assert if there's no suffient memory left.
 NIKOLA_API void* memory_allocate(const sizei size);
 
-/// Re-allocate a block of memory `ptr` with a new size of `new_size`.
+/// Allocate a memory block of size `size`, accounted under `tag`. 
+/// The `file` and `line` of the callsite are only kept on debug builds, 
+/// and are used to report any leaked blocks. 
+///
+/// @NOTE: Prefer using the `NIKOLA_MEMORY_ALLOCATE` macro, which fills the callsite automatically.
+///
+/// @NOTE: This function will assert if there's no suffient memory left.
+NIKOLA_API void* memory_allocate_tagged(const sizei size, const MemoryTag tag, const char* file = nullptr, const u32 line = 0);
+
+/// Re-allocate a block of memory `ptr` with a new size of `new_size`, keeping its tag.
+/// The contents are kept up to the smaller of the two sizes, and any extra memory is left uninitialized.
 /// 
 /// @NOTE: This function will assert if `ptr` is a `nullptr`.
 NIKOLA_API void* memory_reallocate(void* ptr, const sizei new_size);
@@ -197,7 +269,8 @@ NIKOLA_API void* memory_copy(void* dest, const void* src, const sizei src_size);
 
 /// Free/reclaim the memory of the given `ptr`.
 /// 
-/// @NOTE: This function will assert if `ptr` is a `nullptr`.
+/// @NOTE: This function will assert if `ptr` is a `nullptr` or if 
+/// `ptr` was not allocated by any of the memory functions.
 NIKOLA_API void memory_free(void* ptr);
 
 /// Retrieve the amount of allocations made so far.
@@ -206,15 +279,333 @@ NIKOLA_API const sizei memory_get_allocations_count();
 /// Retrieve the amount of frees made so far. 
 NIKOLA_API const sizei memory_get_frees_count();
 
-/// Retrieve how many bytes have been allocated so far. 
+/// Retrieve how many bytes are currently allocated across all tags.
 NIKOLA_API const sizei memory_get_allocation_bytes();
 
+/// Set the memory budget of `tag` to `budget_bytes`. A warning will be 
+/// logged every time the tag goes over its budget.
+///
+/// @NOTE: A budget of `0` disables the budget of `tag`.
+NIKOLA_API void memory_set_budget(const MemoryTag tag, const sizei budget_bytes);
+
+/// Retrieve the current memory stats of `tag`.
+NIKOLA_API const MemoryTagStats memory_get_tag_stats(const MemoryTag tag);
+
+/// Retrieve a string representation of `tag`.
+NIKOLA_API const char* memory_tag_str(const MemoryTag tag);
+
+/// Log the memory usage of every tag, as well as any blocks that 
+/// were never freed (with their callsites on debug builds). 
+///
+/// @NOTE: This is called by `nikola::shutdown()`. 
+NIKOLA_API void memory_report();
+
 /// Memory functions 
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Memory macros
+
+/// Allocate a memory block of size `size` under `tag`, capturing the callsite on debug builds.
+#if NIKOLA_MEMORY_TRACKING_ACTIVE == 1
+  #define NIKOLA_MEMORY_ALLOCATE(size, tag) nikola::memory_allocate_tagged(size, tag, __FILE__, __LINE__)
+#else
+  #define NIKOLA_MEMORY_ALLOCATE(size, tag) nikola::memory_allocate_tagged(size, tag)
+#endif
+
+/// Memory macros
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// MemoryArena
+
+/// A linear (bump) allocator over a single, contiguous block of memory. 
+/// Pushing memory into the arena is just a pointer bump, and individual blocks 
+/// are never freed. Instead, the whole arena is reset at once.
+///
+/// @NOTE: Pushing into an arena is thread-safe. Resetting it is not.
+struct MemoryArena;
+/// MemoryArena
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// MemoryArenaTemp
+
+/// A snapshot of an arena's offset. Ending a temporary arena will rewind 
+/// the arena back to the snapshot, reclaiming every block pushed since.
+struct MemoryArenaTemp {
+  MemoryArena* arena = nullptr;
+  sizei offset       = 0;
+};
+/// MemoryArenaTemp
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// MemoryArenaStats
+struct MemoryArenaStats {
+  /// The total size of the arena in bytes.
+  sizei capacity = 0; 
+
+  /// The amount of bytes currently in use.
+  sizei used_bytes = 0;
+
+  /// The highest amount of bytes ever used at once (the high-water mark). 
+  /// Use this to size the arena appropriately.
+  sizei peak_bytes = 0;
+
+  /// The amount of blocks pushed since the last reset.
+  sizei allocations_count = 0;
+  
+  /// The amount of pushes that failed since the arena was created 
+  /// because the arena ran out of memory.
+  sizei overflows_count = 0;
+};
+/// MemoryArenaStats
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// MemoryArena functions
+
+/// Allocate and return a new arena that can hold up to `capacity` bytes, accounted under `tag`.
+NIKOLA_API MemoryArena* memory_arena_create(const sizei capacity, const MemoryTag tag = MEMORY_TAG_GENERAL);
+
+/// Free/reclaim the memory of the given `arena`.
+NIKOLA_API void memory_arena_destroy(MemoryArena* arena);
+
+/// Push a block of size `size` into `arena`, aligned to `alignment`.
+///
+/// @NOTE: The returned block is _not_ zero-initialized.
+///
+/// @NOTE: This function will return a `nullptr` if `arena` has no space left.
+NIKOLA_API void* memory_arena_push(MemoryArena* arena, const sizei size, const sizei alignment = MEMORY_DEFAULT_ALIGNMENT);
+
+/// Reclaim every block pushed into `arena` at once.
+NIKOLA_API void memory_arena_reset(MemoryArena* arena);
+
+/// Retrieve the current usage stats of `arena`.
+NIKOLA_API const MemoryArenaStats memory_arena_get_stats(const MemoryArena* arena);
+
+/// Take a snapshot of the current offset of `arena`.
+NIKOLA_API const MemoryArenaTemp memory_arena_temp_begin(MemoryArena* arena);
+
+/// Rewind the arena of `temp` back to the snapshot taken by `memory_arena_temp_begin`.
+///
+/// @NOTE: Temporary arenas must be ended in the reverse order they were started.
+NIKOLA_API void memory_arena_temp_end(const MemoryArenaTemp& temp);
+
+/// MemoryArena functions
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Frame arena functions
+
+/// Create the global frame arena with a capacity of `capacity`. 
+///
+/// @NOTE: This is called by `nikola::init()`. There is no need to call it yourself.
+NIKOLA_API void memory_frame_arena_init(const sizei capacity = MEMORY_FRAME_ARENA_CAPACITY);
+
+/// Free/reclaim the global frame arena.
+///
+/// @NOTE: This is called by `nikola::shutdown()`. There is no need to call it yourself.
+NIKOLA_API void memory_frame_arena_shutdown();
+
+/// Retrieve the global frame arena.
+NIKOLA_API MemoryArena* memory_frame_arena_get();
+
+/// Allocate a zero-initialized block of size `size` from the global frame arena. 
+/// The block only lives until the end of the current frame.
+///
+/// @NOTE: This function matches the `AllocateMemoryFn` signature. Hence, 
+/// it can be passed to any function that takes in an `AllocateMemoryFn`.
+NIKOLA_API void* memory_frame_allocate(const sizei size);
+
+/// Does nothing. Blocks allocated by `memory_frame_allocate` are reclaimed
+/// all at once by `memory_frame_reset`. 
+///
+/// @NOTE: This function matches the `FreeMemoryFn` signature. Hence, 
+/// it can be passed to any function that takes in a `FreeMemoryFn`.
+NIKOLA_API void memory_frame_free(void* ptr);
+
+/// Reclaim every block allocated from the global frame arena. 
+///
+/// @NOTE: The engine calls this at the end of every frame. Only call it 
+/// yourself if you do not use `engine_run`.
+NIKOLA_API void memory_frame_reset();
+
+/// Frame arena functions
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// MemoryPool
+
+/// A pool of fixed-size blocks, allocated in contiguous chunks. Freed blocks 
+/// are kept in a free list and handed out again on the next allocation, which 
+/// makes both allocating and freeing constant-time and keeps objects of the 
+/// same type close to each other in memory.
+///
+/// @NOTE: Allocating from and freeing into a pool is thread-safe.
+struct MemoryPool;
+/// MemoryPool
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// MemoryPoolStats
+struct MemoryPoolStats {
+  /// The size of each block in bytes (including any alignment padding).
+  sizei block_size = 0;
+
+  /// The total amount of blocks the pool can currently hold.
+  sizei blocks_count = 0;
+
+  /// The amount of blocks currently in use.
+  sizei used_blocks = 0; 
+
+  /// The highest amount of blocks ever used at once.
+  sizei peak_blocks = 0;
+
+  /// The amount of chunks allocated by the pool so far.
+  sizei chunks_count = 0;
+};
+/// MemoryPoolStats
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// MemoryPool functions
+
+/// Allocate and return a new pool of `block_size`-sized blocks. The pool will 
+/// grow by a chunk of `blocks_per_chunk` blocks every time it runs out of blocks.
+/// Every chunk the pool allocates is accounted under `tag`.
+NIKOLA_API MemoryPool* memory_pool_create(const sizei block_size, const sizei blocks_per_chunk, const MemoryTag tag = MEMORY_TAG_GENERAL);
+
+/// Free/reclaim the memory of the given `pool`, including every chunk it allocated.
+///
+/// @NOTE: Any blocks still in use will be invalid after this call.
+NIKOLA_API void memory_pool_destroy(MemoryPool* pool);
+
+/// Retrieve a zero-initialized block from `pool`.
+NIKOLA_API void* memory_pool_allocate(MemoryPool* pool);
+
+/// Return the block `ptr` back to `pool`.
+///
+/// @NOTE: This function will assert if `ptr` is a `nullptr`.
+NIKOLA_API void memory_pool_free(MemoryPool* pool, void* ptr);
+
+/// Retrieve the current usage stats of `pool`.
+NIKOLA_API const MemoryPoolStats memory_pool_get_stats(MemoryPool* pool);
+
+/// MemoryPool functions
+///---------------------------------------------------------------------------------------------------------------------
+
 /// *** Memory ***
 /// ----------------------------------------------------------------------
 
+/// ----------------------------------------------------------------------
+/// *** StringID ***
+
+///---------------------------------------------------------------------------------------------------------------------
+/// StringID consts
+
+/// The offset basis of the 64-bit FNV-1a hash.
+const u64 STRING_ID_FNV_OFFSET = 0xcbf29ce484222325ull;
+
+/// The prime of the 64-bit FNV-1a hash.
+const u64 STRING_ID_FNV_PRIME  = 0x100000001b3ull;
+
+/// StringID consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// StringID hash functions
+
+/// Hash the first `length` characters of `str` using FNV-1a. 
+///
+/// @NOTE: This function can be evaluated at compile time.
+constexpr u64 string_id_hash(const char* str, const sizei length) {
+  u64 hash = STRING_ID_FNV_OFFSET;
+  for(sizei i = 0; i < length; i++) {
+    hash ^= (u64)(u8)str[i];
+    hash *= STRING_ID_FNV_PRIME;
+  }
+
+  return hash;
+}
+
+/// Hash the null-terminated `str` using FNV-1a. 
+///
+/// @NOTE: This function can be evaluated at compile time.
+constexpr u64 string_id_hash(const char* str) {
+  u64 hash = STRING_ID_FNV_OFFSET;
+  for(; *str; str++) {
+    hash ^= (u64)(u8)*str;
+    hash *= STRING_ID_FNV_PRIME;
+  }
+
+  return hash;
+}
+
+/// StringID hash functions
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// StringID 
+
+/// A pre-hashed string. Two `StringID`s are equal if their hashes are equal, 
+/// which makes comparing and looking them up as cheap as comparing integers. 
+/// The original string is kept around in `str` for any APIs that still need it.
+///
+/// @NOTE: Use `string_id_literal` to hash string literals at compile time, 
+/// or `string_id_intern` for any strings built at runtime.
+struct StringID {
+  u64 hash        = 0;
+  const char* str = nullptr;
+
+  constexpr StringID() = default;
+
+  constexpr explicit StringID(const char* string)
+    :hash(string_id_hash(string)), str(string)
+  {}
+
+  constexpr StringID(const char* string, const sizei length)
+    :hash(string_id_hash(string, length)), str(string)
+  {}
+
+  constexpr bool operator==(const StringID& other) const {return hash == other.hash;}
+  constexpr bool operator!=(const StringID& other) const {return hash != other.hash;}
+};
+/// StringID 
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// StringID functions
+
+/// Hash the string literal `str` at compile time.
+consteval StringID string_id_literal(const char* str) {
+  return StringID(str);
+}
+
+/// Hash `str` and store a copy of it in the global intern table, 
+/// returning a `StringID` whose `str` stays valid until `string_id_shutdown`.
+///
+/// @NOTE: Interning a string that was already interned will not allocate anything.
+///
+/// @NOTE: On debug builds, this function will assert if two different strings share the same hash.
+NIKOLA_API StringID string_id_intern(const char* str);
+
+/// Retrieve the original string of `id`, using the intern table if `id` has no string.
+/// A placeholder string is returned if the string of `id` is unknown.
+NIKOLA_API const char* string_id_str(const StringID& id);
+
+/// Free every string in the global intern table.
+///
+/// @NOTE: This is called by `nikola::shutdown()`. There is no need to call it yourself.
+NIKOLA_API void string_id_shutdown();
+
+/// StringID functions
+///---------------------------------------------------------------------------------------------------------------------
+
+/// *** StringID ***
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// *** Logger ***
 
@@ -230,6 +621,38 @@ NIKOLA_API const sizei memory_get_allocation_bytes();
 #define NIKOLA_LOG_DEBUG_ACTIVE 1
 #endif
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Logger consts
+
+/// The maximum amount of messages that can wait in the logger's queue at once. 
+/// A thread logging into a full queue will wait for the writer thread to catch up.
+///
+/// @NOTE: This must be a power of 2.
+const u32 LOGGER_QUEUE_CAPACITY = 1024;
+
+/// The size of a message that can be queued without any extra allocations. 
+/// Longer messages will still be logged, but they will go through the heap.
+const sizei LOGGER_MESSAGE_MAX  = 512;
+
+/// The maximum amount of call sites the logger can rate limit at once. 
+/// Call sites that went quiet for a whole window make room for new ones.
+///
+/// @NOTE: This must be a power of 2.
+const u32 LOGGER_CALLSITES_MAX  = 1024;
+
+/// The amount of messages a single call site can log in one `LOGGER_RATE_WINDOW` 
+/// before any following messages get suppressed.
+const u32 LOGGER_RATE_BURST     = 8;
+
+/// The length of a rate limiting window in seconds.
+const f64 LOGGER_RATE_WINDOW    = 1.0;
+
+/// The maximum amount of file sinks that can be attached to the logger.
+const u32 LOGGER_SINKS_MAX      = 8;
+
+/// Logger consts
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Log level
 enum LogLevel {
@@ -246,10 +669,40 @@ enum LogLevel {
 ///---------------------------------------------------------------------------------------------------------------------
 /// Logger functions
 
-/// Log an assertion with the given information.
+/// Spawn the logger's writer thread. Any messages logged before this call (or after `logger_shutdown`)
+/// are written directly on the calling thread.
+///
+/// @NOTE: This is called by `nikola::init()`. There is no need to call it yourself.
+NIKOLA_API void logger_init();
+
+/// Write any queued messages, report any suppressed messages, join the writer thread, and close all file sinks.
+///
+/// @NOTE: This is called by `nikola::shutdown()`. There is no need to call it yourself.
+NIKOLA_API void logger_shutdown();
+
+/// Open the file at `path` and write every message with a level of `min_level` or above into it.
+/// Returns `false` if the file could not be opened or if `LOGGER_SINKS_MAX` was reached.
+///
+/// @NOTE: The file will be truncated if it already exists.
+NIKOLA_API const bool logger_attach_file(const char* path, const LogLevel min_level = LOG_LEVEL_TRACE);
+
+/// Block until every message queued so far has been written to the console and all of the file sinks.
+///
+/// @NOTE: This is called automatically on `LOG_LEVEL_FATAL` messages and failed assertions.
+NIKOLA_API void logger_flush();
+
+/// Flush the logger and log an assertion with the given information.
 NIKOLA_API void logger_log_assert(const char* expr, const char* msg, const char* file, const u32 line_num);
 
 /// Log a specific log level `lvl` with the given `msg` and any other parametars.
+///
+/// @NOTE: The message is only formatted on the calling thread. The actual writing happens on 
+/// the logger's writer thread. 
+///
+/// @NOTE: Messages are rate limited per call site (identified by the address and the text of `msg`), 
+/// before they get formatted. A call site that logs more than `LOGGER_RATE_BURST` messages in one `LOGGER_RATE_WINDOW` 
+/// gets suppressed until the next window, where the amount of suppressed messages gets reported. 
+/// `LOG_LEVEL_FATAL` messages are never suppressed.
 NIKOLA_API void logger_log(const LogLevel lvl, const char* msg, ...);
 
 /// Logger functions
@@ -338,6 +791,42 @@ NIKOLA_API void logger_log(const LogLevel lvl, const char* msg, ...);
 /// ---------------------------------------------------------------------
 /// *** Clock ***
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Clock consts
+
+/// The amount of frames kept in the frame time history of the clock.
+const sizei CLOCK_FRAME_HISTORY_MAX = 256;
+
+/// Any frame that takes longer than this (in seconds) is counted as a hitch, unless 
+/// it was changed with `niclock_set_hitch_threshold`.
+const f64 CLOCK_HITCH_THRESHOLD_DEFAULT = 1.0 / 30.0;
+
+/// Clock consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// FrameTimeStats
+struct FrameTimeStats {
+  /// Every frame time is in milliseconds.
+  f64 min_ms = 0.0;
+  f64 avg_ms = 0.0;
+  f64 p50_ms = 0.0;
+  f64 p95_ms = 0.0;
+  f64 p99_ms = 0.0;
+  f64 max_ms = 0.0;
+
+  /// The amount of frames these stats were taken from (up to `CLOCK_FRAME_HISTORY_MAX`).
+  sizei frames_count = 0;
+
+  /// The amount of hitches in the current history.
+  sizei hitches_count = 0;
+
+  /// The amount of hitches since the application was initialzed.
+  u64 total_hitches_count = 0;
+};
+/// FrameTimeStats
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Clock functions
 
@@ -357,6 +846,31 @@ NIKOLA_API const f64 niclock_get_fps();
 /// Retrieve the time passed between each frame. 
 NIKOLA_API const f64 niclock_get_delta_time();
 
+/// Force every following `niclock_update` to report a delta time of `delta_time` 
+/// instead of the time that actually passed, until `niclock_unlock_delta_time` is called.
+///
+/// @NOTE: This is used by the input replay to reproduce the timing of a recorded session.
+NIKOLA_API void niclock_lock_delta_time(const f64 delta_time);
+
+/// Let `niclock_update` go back to measuring the real delta time.
+NIKOLA_API void niclock_unlock_delta_time();
+
+/// Retrieve the statistics of the last `CLOCK_FRAME_HISTORY_MAX` frame times. 
+///
+/// @NOTE: The frame times are always the real time between every `niclock_update`, even 
+/// while the delta time is locked.
+NIKOLA_API const FrameTimeStats niclock_get_frame_stats();
+
+/// Retrieve the last `CLOCK_FRAME_HISTORY_MAX` frame times (in milliseconds), starting from the oldest at `out_offset` 
+/// and wrapping around the `out_count` frame times. This is the layout `ImGui::PlotLines` expects.
+NIKOLA_API void niclock_get_frame_history(const f32** out_frame_times, sizei* out_count, sizei* out_offset);
+
+/// Count any frame that takes longer than `threshold` (in seconds) as a hitch.
+NIKOLA_API void niclock_set_hitch_threshold(const f64 threshold);
+
+/// Returns `true` if the last frame was a hitch.
+NIKOLA_API const bool niclock_is_hitch();
+
 /// Clock functions
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "nikola_base.h"
 #include "nikola_pch.h"
 
+#include <new>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
 //////////////////////////////////////////////////////////////////////////
 
 namespace nikola { // Start of nikola
@@ -9,8 +15,6 @@ namespace nikola { // Start of nikola
 /// ----------------------------------------------------------------------
 /// *** Typedefs ***
 
-/// @TODO (Containers): Create your own data structures, you lazy bastard.
-
 /// An ASCII string
 using String       = std::string;
 
@@ -18,13 +22,939 @@ using String       = std::string;
 template<typename T>
 using DynamicArray = std::vector<T>;
 
-/// A key-value pair hash map
-template<typename K, typename V> 
-using HashMap      = std::unordered_map<K, V>;
-
 /// *** Typedefs ***
 /// ----------------------------------------------------------------------
 
+/// ----------------------------------------------------------------------
+/// *** Containers ***
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Container consts
+
+/// The minimum amount of slots a `HashMap` will allocate once it's used.
+const sizei HASH_MAP_MIN_CAPACITY = 16;
+
+/// Container consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Container private functions
+
+/// Scramble the bits of the given `hash` so that keys with poorly-distributed
+/// hashes (pointers and integers, where `std::hash` is the identity) spread
+/// evenly over a power-of-2 table.
+inline u64 hash_mix(u64 hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ull;
+  hash ^= hash >> 33;
+
+  return hash;
+}
+
+/// Container private functions
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// HashMap
+
+/// An open-addressing hash map that stores its entries in one flat array,
+/// using linear probing and backward-shift deletion (no tombstones).
+/// Every slot has a control byte holding a fragment of the key's hash,
+/// which avoids comparing most keys during a lookup.
+///
+/// @NOTE: Unlike `std::unordered_map`, inserting into or erasing from the map
+/// can move the entries around. Do _not_ keep pointers to the values across
+/// any insertions or erasures.
+///
+/// @NOTE: The memory of the map is allocated and freed using the given
+/// `AllocateMemoryFn` and `FreeMemoryFn` callbacks, which default
+/// to `memory_allocate` and `memory_free` respectively.
+template<typename K, typename V, typename Hash = std::hash<K>>
+struct HashMap {
+  using Entry = std::pair<K, V>;
+
+  /// An empty slot has a control byte of `0`. A full slot always
+  /// has the high bit set, with the 7 low bits being a fragment of the hash.
+  static const u8 SLOT_EMPTY = 0;
+
+  ///---------------------------------------------------------------------
+  /// Iterator
+  template<typename EntryType, typename MapType>
+  struct Iterator {
+    MapType* map = nullptr;
+    sizei index  = 0;
+
+    EntryType& operator*() const  {return map->entries[index];}
+    EntryType* operator->() const {return &map->entries[index];}
+
+    Iterator& operator++() {
+      index++;
+      skip_empty_slots();
+
+      return *this;
+    }
+
+    bool operator==(const Iterator& other) const {return index == other.index;}
+    bool operator!=(const Iterator& other) const {return index != other.index;}
+
+    void skip_empty_slots() {
+      while((index < map->capacity) && (map->controls[index] == SLOT_EMPTY)) {
+        index++;
+      }
+    }
+  };
+  /// Iterator
+  ///---------------------------------------------------------------------
+
+  using iterator       = Iterator<Entry, HashMap>;
+  using const_iterator = Iterator<const Entry, const HashMap>;
+
+  u8* controls    = nullptr;
+  Entry* entries  = nullptr;
+  sizei count     = 0;
+  sizei capacity  = 0;
+
+  AllocateMemoryFn alloc_fn = memory_allocate;
+  FreeMemoryFn free_fn      = memory_free;
+
+  ///---------------------------------------------------------------------
+  /// Constructors and destructor
+
+  HashMap() = default;
+
+  HashMap(const AllocateMemoryFn& alloc, const FreeMemoryFn& free)
+    :alloc_fn(alloc), free_fn(free)
+  {}
+
+  HashMap(const HashMap& other)
+    :alloc_fn(other.alloc_fn), free_fn(other.free_fn)
+  {
+    reserve(other.count);
+    for(const Entry& entry : other) {
+      emplace(entry.first, entry.second);
+    }
+  }
+
+  HashMap(HashMap&& other) noexcept {
+    steal(other);
+  }
+
+  HashMap& operator=(const HashMap& other) {
+    if(this != &other) {
+      HashMap temp(other);
+      destroy();
+      steal(temp);
+    }
+
+    return *this;
+  }
+
+  HashMap& operator=(HashMap&& other) noexcept {
+    if(this != &other) {
+      destroy();
+      steal(other);
+    }
+
+    return *this;
+  }
+
+  ~HashMap() {
+    destroy();
+  }
+
+  /// Constructors and destructor
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Iterators
+
+  iterator begin() {
+    iterator it = {this, 0};
+    it.skip_empty_slots();
+
+    return it;
+  }
+
+  iterator end() {
+    return iterator{this, capacity};
+  }
+
+  const_iterator begin() const {
+    const_iterator it = {this, 0};
+    it.skip_empty_slots();
+
+    return it;
+  }
+
+  const_iterator end() const {
+    return const_iterator{this, capacity};
+  }
+
+  /// Iterators
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Lookup
+
+  iterator find(const K& key) {
+    return iterator{this, find_index(key)};
+  }
+
+  const_iterator find(const K& key) const {
+    return const_iterator{this, find_index(key)};
+  }
+
+  bool contains(const K& key) const {
+    return find_index(key) != capacity;
+  }
+
+  /// Returns the value associated with `key`, inserting a
+  /// default-constructed value if `key` does not exist yet.
+  V& operator[](const K& key) {
+    // Only build a new value when it is actually needed
+    sizei index = find_index(key);
+    if(index != capacity) {
+      return entries[index].second;
+    }
+
+    return emplace(key, V{}).first->second;
+  }
+
+  /// Lookup
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Modifiers
+
+  /// Insert `value` under `key` if `key` does not exist yet. Returns an iterator
+  /// to the entry of `key`, and `true` only if a new entry was inserted.
+  template<typename KeyType, typename ValueType>
+  std::pair<iterator, bool> emplace(KeyType&& key, ValueType&& value) {
+    sizei index = find_index(key);
+    if(index != capacity) {
+      return {iterator{this, index}, false};
+    }
+
+    // Grow once the load factor goes above 7/8
+    if(((count + 1) * 8) > (capacity * 7)) {
+      rehash(capacity == 0 ? HASH_MAP_MIN_CAPACITY : (capacity * 2));
+    }
+
+    u64 hash   = hash_mix(Hash{}(key));
+    sizei mask = capacity - 1;
+    
+    index = hash & mask;
+    while(controls[index] != SLOT_EMPTY) {
+      index = (index + 1) & mask;
+    }
+
+    new (&entries[index]) Entry(std::forward<KeyType>(key), std::forward<ValueType>(value));
+    controls[index] = hash_to_control(hash);
+    count++;
+
+    return {iterator{this, index}, true};
+  }
+
+  std::pair<iterator, bool> insert(const Entry& entry) {
+    return emplace(entry.first, entry.second);
+  }
+
+  /// Erase the entry of `key`, returning the amount of erased entries (`0` or `1`).
+  sizei erase(const K& key) {
+    sizei index = find_index(key);
+    if(index == capacity) {
+      return 0;
+    }
+
+    // Shift back every entry after the erased one that is not
+    // in its ideal slot, so that no probe chain gets broken.
+    sizei mask = capacity - 1;
+    sizei hole = index;
+    sizei next = (hole + 1) & mask;
+
+    while(controls[next] != SLOT_EMPTY) {
+      sizei ideal = hash_mix(Hash{}(entries[next].first)) & mask;
+
+      // Only move the entry if the hole is between its ideal slot and its current slot (cyclically)
+      if(((next - ideal) & mask) >= ((next - hole) & mask)) {
+        entries[hole]  = std::move(entries[next]);
+        controls[hole] = controls[next];
+        hole           = next;
+      }
+
+      next = (next + 1) & mask;
+    }
+
+    entries[hole].~Entry();
+    controls[hole] = SLOT_EMPTY;
+    count--;
+
+    return 1;
+  }
+
+  /// Destroy all of the entries in the map while keeping the allocated slots.
+  void clear() {
+    for(sizei i = 0; i < capacity; i++) {
+      if(controls[i] != SLOT_EMPTY) {
+        entries[i].~Entry();
+        controls[i] = SLOT_EMPTY;
+      }
+    }
+
+    count = 0;
+  }
+
+  /// Destroy all of the entries in the map and free its memory.
+  void destroy() {
+    if(!entries) {
+      return;
+    }
+
+    clear();
+    free_fn(entries);
+
+    entries  = nullptr;
+    controls = nullptr;
+    capacity = 0;
+  }
+
+  /// Make sure the map can hold `new_count` entries without growing.
+  void reserve(const sizei new_count) {
+    sizei new_capacity = capacity == 0 ? HASH_MAP_MIN_CAPACITY : capacity;
+    while((new_count * 8) > (new_capacity * 7)) {
+      new_capacity *= 2;
+    }
+
+    if(new_capacity > capacity) {
+      rehash(new_capacity);
+    }
+  }
+
+  /// Modifiers
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Capacity
+
+  sizei size() const {
+    return count;
+  }
+
+  bool empty() const {
+    return count == 0;
+  }
+
+  /// Capacity
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Private functions
+
+  static u8 hash_to_control(const u64 hash) {
+    return (u8)(0x80 | (hash >> 57));
+  }
+
+  sizei find_index(const K& key) const {
+    if(count == 0) {
+      return capacity;
+    }
+
+    u64 hash    = hash_mix(Hash{}(key));
+    u8 control  = hash_to_control(hash);
+    sizei mask  = capacity - 1;
+    sizei index = hash & mask;
+
+    while(controls[index] != SLOT_EMPTY) {
+      if((controls[index] == control) && (entries[index].first == key)) {
+        return index;
+      }
+
+      index = (index + 1) & mask;
+    }
+
+    return capacity;
+  }
+
+  void rehash(const sizei new_capacity) {
+    u8* old_controls    = controls;
+    Entry* old_entries  = entries;
+    sizei old_capacity  = capacity;
+
+    // The controls are allocated right after the entries in a single block
+    u8* block = (u8*)alloc_fn((sizeof(Entry) * new_capacity) + new_capacity);
+    NIKOLA_ASSERT(block, "Could not allocate any more memory for a HashMap!");
+
+    entries  = (Entry*)block;
+    controls = block + (sizeof(Entry) * new_capacity);
+    capacity = new_capacity;
+    memory_zero(controls, new_capacity);
+
+    // Re-insert the old entries
+    sizei mask = capacity - 1;
+    for(sizei i = 0; i < old_capacity; i++) {
+      if(old_controls[i] == SLOT_EMPTY) {
+        continue;
+      }
+
+      sizei index = hash_mix(Hash{}(old_entries[i].first)) & mask;
+      while(controls[index] != SLOT_EMPTY) {
+        index = (index + 1) & mask;
+      }
+
+      new (&entries[index]) Entry(std::move(old_entries[i]));
+      controls[index] = old_controls[i];
+
+      old_entries[i].~Entry();
+    }
+
+    if(old_entries) {
+      free_fn(old_entries);
+    }
+  }
+
+  void steal(HashMap& other) {
+    controls = other.controls;
+    entries  = other.entries;
+    count    = other.count;
+    capacity = other.capacity;
+    alloc_fn = other.alloc_fn;
+    free_fn  = other.free_fn;
+
+    other.controls = nullptr;
+    other.entries  = nullptr;
+    other.count    = 0;
+    other.capacity = 0;
+  }
+
+  /// Private functions
+  ///---------------------------------------------------------------------
+};
+/// HashMap
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// SmallArray
+
+/// A dynamically-sized array that stores up to `N` elements inline,
+/// and only allocates memory on the heap once it grows past `N`.
+///
+/// @NOTE: The memory of the array is allocated and freed using the given
+/// `AllocateMemoryFn` and `FreeMemoryFn` callbacks, which default
+/// to `memory_allocate` and `memory_free` respectively.
+template<typename T, sizei N>
+struct SmallArray {
+  static_assert((N > 0), "A SmallArray must have an inline capacity of at least 1");
+
+  alignas(T) u8 inline_data[sizeof(T) * N];
+
+  T* data_ptr    = (T*)inline_data;
+  sizei count    = 0;
+  sizei capacity = N;
+
+  AllocateMemoryFn alloc_fn = memory_allocate;
+  FreeMemoryFn free_fn      = memory_free;
+
+  ///---------------------------------------------------------------------
+  /// Constructors and destructor
+
+  SmallArray() = default;
+
+  SmallArray(const AllocateMemoryFn& alloc, const FreeMemoryFn& free)
+    :alloc_fn(alloc), free_fn(free)
+  {}
+
+  SmallArray(const SmallArray& other)
+    :alloc_fn(other.alloc_fn), free_fn(other.free_fn)
+  {
+    reserve(other.count);
+    for(sizei i = 0; i < other.count; i++) {
+      new (&data_ptr[i]) T(other.data_ptr[i]);
+    }
+    count = other.count;
+  }
+
+  SmallArray(SmallArray&& other) noexcept
+    :alloc_fn(other.alloc_fn), free_fn(other.free_fn)
+  {
+    steal(other);
+  }
+
+  SmallArray& operator=(const SmallArray& other) {
+    if(this != &other) {
+      clear();
+      reserve(other.count);
+
+      for(sizei i = 0; i < other.count; i++) {
+        new (&data_ptr[i]) T(other.data_ptr[i]);
+      }
+      count = other.count;
+    }
+
+    return *this;
+  }
+
+  SmallArray& operator=(SmallArray&& other) noexcept {
+    if(this != &other) {
+      destroy();
+      steal(other);
+    }
+
+    return *this;
+  }
+
+  ~SmallArray() {
+    destroy();
+  }
+
+  /// Constructors and destructor
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Access
+
+  T& operator[](const sizei index) {
+    NIKOLA_ASSERT((index < count), "SmallArray index out of bounds");
+    return data_ptr[index];
+  }
+
+  const T& operator[](const sizei index) const {
+    NIKOLA_ASSERT((index < count), "SmallArray index out of bounds");
+    return data_ptr[index];
+  }
+
+  T& front()             {return data_ptr[0];}
+  const T& front() const {return data_ptr[0];}
+
+  T& back()             {return data_ptr[count - 1];}
+  const T& back() const {return data_ptr[count - 1];}
+
+  T* data()             {return data_ptr;}
+  const T* data() const {return data_ptr;}
+
+  T* begin()             {return data_ptr;}
+  T* end()               {return data_ptr + count;}
+  const T* begin() const {return data_ptr;}
+  const T* end() const   {return data_ptr + count;}
+
+  /// Access
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Modifiers
+
+  void push_back(const T& value) {
+    emplace_back(value);
+  }
+
+  void push_back(T&& value) {
+    emplace_back(std::move(value));
+  }
+
+  template<typename... Args>
+  T& emplace_back(Args&&... args) {
+    if(count == capacity) {
+      grow(capacity * 2);
+    }
+
+    T* elem = new (&data_ptr[count]) T(std::forward<Args>(args)...);
+    count++;
+
+    return *elem;
+  }
+
+  void pop_back() {
+    NIKOLA_ASSERT((count > 0), "Cannot pop from an empty SmallArray");
+
+    count--;
+    data_ptr[count].~T();
+  }
+
+  void resize(const sizei new_count) {
+    reserve(new_count);
+
+    for(sizei i = new_count; i < count; i++) {
+      data_ptr[i].~T();
+    }
+
+    for(sizei i = count; i < new_count; i++) {
+      new (&data_ptr[i]) T();
+    }
+
+    count = new_count;
+  }
+
+  void reserve(const sizei new_capacity) {
+    if(new_capacity > capacity) {
+      grow(new_capacity);
+    }
+  }
+
+  void clear() {
+    for(sizei i = 0; i < count; i++) {
+      data_ptr[i].~T();
+    }
+
+    count = 0;
+  }
+
+  /// Destroy all of the elements in the array and free any heap memory.
+  void destroy() {
+    clear();
+
+    if(!is_inline()) {
+      free_fn(data_ptr);
+    }
+
+    data_ptr = (T*)inline_data;
+    capacity = N;
+  }
+
+  /// Modifiers
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Capacity
+
+  sizei size() const {
+    return count;
+  }
+
+  bool empty() const {
+    return count == 0;
+  }
+
+  /// Returns `true` if the elements are still stored inline.
+  bool is_inline() const {
+    return data_ptr == (const T*)inline_data;
+  }
+
+  /// Capacity
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Private functions
+
+  void grow(const sizei new_capacity) {
+    T* new_data = (T*)alloc_fn(sizeof(T) * new_capacity);
+    NIKOLA_ASSERT(new_data, "Could not allocate any more memory for a SmallArray!");
+
+    for(sizei i = 0; i < count; i++) {
+      new (&new_data[i]) T(std::move(data_ptr[i]));
+      data_ptr[i].~T();
+    }
+
+    if(!is_inline()) {
+      free_fn(data_ptr);
+    }
+
+    data_ptr = new_data;
+    capacity = new_capacity;
+  }
+
+  void steal(SmallArray& other) {
+    // Inline elements have to be moved one by one
+    if(other.is_inline()) {
+      for(sizei i = 0; i < other.count; i++) {
+        new (&data_ptr[i]) T(std::move(other.data_ptr[i]));
+      }
+      count = other.count;
+
+      other.clear();
+      return;
+    }
+
+    data_ptr = other.data_ptr;
+    count    = other.count;
+    capacity = other.capacity;
+    alloc_fn = other.alloc_fn;
+    free_fn  = other.free_fn;
+
+    other.data_ptr = (T*)other.inline_data;
+    other.count    = 0;
+    other.capacity = N;
+  }
+
+  /// Private functions
+  ///---------------------------------------------------------------------
+};
+/// SmallArray
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// FixedArray
+
+/// An array that can hold up to `N` elements without ever allocating any memory.
+///
+/// @NOTE: Pushing into a full `FixedArray` will assert.
+template<typename T, sizei N>
+struct FixedArray {
+  static_assert((N > 0), "A FixedArray must have a capacity of at least 1");
+  static_assert(std::is_trivially_destructible_v<T>, "A FixedArray can only hold trivially destructible types");
+
+  T elements[N];
+  sizei count = 0;
+
+  ///---------------------------------------------------------------------
+  /// Access
+
+  T& operator[](const sizei index) {
+    NIKOLA_ASSERT((index < count), "FixedArray index out of bounds");
+    return elements[index];
+  }
+
+  const T& operator[](const sizei index) const {
+    NIKOLA_ASSERT((index < count), "FixedArray index out of bounds");
+    return elements[index];
+  }
+
+  T& front()             {return elements[0];}
+  const T& front() const {return elements[0];}
+
+  T& back()             {return elements[count - 1];}
+  const T& back() const {return elements[count - 1];}
+
+  T* data()             {return elements;}
+  const T* data() const {return elements;}
+
+  T* begin()             {return elements;}
+  T* end()               {return elements + count;}
+  const T* begin() const {return elements;}
+  const T* end() const   {return elements + count;}
+
+  /// Access
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Modifiers
+
+  void push_back(const T& value) {
+    NIKOLA_ASSERT((count < N), "Cannot push into a full FixedArray");
+
+    elements[count] = value;
+    count++;
+  }
+
+  void pop_back() {
+    NIKOLA_ASSERT((count > 0), "Cannot pop from an empty FixedArray");
+    count--;
+  }
+
+  /// Remove the element at `index` by swapping the last element into its place.
+  void swap_remove(const sizei index) {
+    NIKOLA_ASSERT((index < count), "FixedArray index out of bounds");
+
+    elements[index] = elements[count - 1];
+    count--;
+  }
+
+  void resize(const sizei new_count) {
+    NIKOLA_ASSERT((new_count <= N), "Cannot resize a FixedArray past its capacity");
+    count = new_count;
+  }
+
+  void clear() {
+    count = 0;
+  }
+
+  /// Modifiers
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Capacity
+
+  sizei size() const     {return count;}
+  sizei capacity() const {return N;}
+  bool empty() const     {return count == 0;}
+  bool full() const      {return count == N;}
+
+  /// Capacity
+  ///---------------------------------------------------------------------
+};
+/// FixedArray
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// RingBuffer
+
+/// A first-in-first-out queue with a fixed capacity, which wraps
+/// around its memory instead of ever moving any elements.
+///
+/// @NOTE: The capacity given to `create` is rounded up to the next power of 2.
+///
+/// @NOTE: The memory of the buffer is allocated and freed using the given
+/// `AllocateMemoryFn` and `FreeMemoryFn` callbacks, which default
+/// to `memory_allocate` and `memory_free` respectively.
+template<typename T>
+struct RingBuffer {
+  T* elements    = nullptr;
+  sizei head     = 0;
+  sizei tail     = 0;
+  sizei capacity = 0;
+
+  AllocateMemoryFn alloc_fn = memory_allocate;
+  FreeMemoryFn free_fn      = memory_free;
+
+  ///---------------------------------------------------------------------
+  /// Constructors and destructor
+
+  RingBuffer() = default;
+
+  RingBuffer(const sizei min_capacity,
+             const AllocateMemoryFn& alloc = memory_allocate,
+             const FreeMemoryFn& free      = memory_free)
+    :alloc_fn(alloc), free_fn(free)
+  {
+    create(min_capacity);
+  }
+
+  RingBuffer(const RingBuffer&)            = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  ~RingBuffer() {
+    destroy();
+  }
+
+  /// Constructors and destructor
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Lifetime
+
+  /// Allocate enough memory for at least `min_capacity` elements.
+  void create(const sizei min_capacity) {
+    NIKOLA_ASSERT(!elements, "Cannot create a RingBuffer more than once");
+    NIKOLA_ASSERT((min_capacity > 0), "Cannot create a RingBuffer with a capacity of 0");
+
+    capacity = 1;
+    while(capacity < min_capacity) {
+      capacity *= 2;
+    }
+
+    elements = (T*)alloc_fn(sizeof(T) * capacity);
+    NIKOLA_ASSERT(elements, "Could not allocate any more memory for a RingBuffer!");
+  }
+
+  void destroy() {
+    if(!elements) {
+      return;
+    }
+
+    clear();
+    free_fn(elements);
+
+    elements = nullptr;
+    capacity = 0;
+  }
+
+  /// Lifetime
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Access
+
+  /// Returns the element at `index`, where `0` is the oldest element.
+  T& operator[](const sizei index) {
+    NIKOLA_ASSERT((index < size()), "RingBuffer index out of bounds");
+    return elements[(head + index) & (capacity - 1)];
+  }
+
+  const T& operator[](const sizei index) const {
+    NIKOLA_ASSERT((index < size()), "RingBuffer index out of bounds");
+    return elements[(head + index) & (capacity - 1)];
+  }
+
+  T& front() {return (*this)[0];}
+  T& back()  {return (*this)[size() - 1];}
+
+  /// Access
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Modifiers
+
+  /// Push `value` to the back of the buffer. Returns `false` if the buffer is full.
+  bool push_back(const T& value) {
+    if(full()) {
+      return false;
+    }
+
+    new (&elements[tail & (capacity - 1)]) T(value);
+    tail++;
+
+    return true;
+  }
+
+  /// Push `value` to the back of the buffer, dropping the oldest element if the buffer is full.
+  void push_back_overwrite(const T& value) {
+    if(full()) {
+      pop_front();
+    }
+
+    push_back(value);
+  }
+
+  /// Pop the oldest element into `out_value`. Returns `false` if the buffer is empty.
+  bool pop_front(T* out_value) {
+    if(empty()) {
+      return false;
+    }
+
+    T& elem    = elements[head & (capacity - 1)];
+    *out_value = std::move(elem);
+    elem.~T();
+    head++;
+
+    return true;
+  }
+
+  /// Drop the oldest element.
+  void pop_front() {
+    NIKOLA_ASSERT(!empty(), "Cannot pop from an empty RingBuffer");
+
+    elements[head & (capacity - 1)].~T();
+    head++;
+  }
+
+  void clear() {
+    while(!empty()) {
+      pop_front();
+    }
+
+    head = 0;
+    tail = 0;
+  }
+
+  /// Modifiers
+  ///---------------------------------------------------------------------
+
+  ///---------------------------------------------------------------------
+  /// Capacity
+
+  sizei size() const {return tail - head;}
+  bool empty() const {return tail == head;}
+  bool full() const  {return size() == capacity;}
+
+  /// Capacity
+  ///---------------------------------------------------------------------
+};
+/// RingBuffer
+///---------------------------------------------------------------------------------------------------------------------
+
+/// *** Containers ***
+/// ----------------------------------------------------------------------
+
 } // End of nikola
 
 //////////////////////////////////////////////////////////////////////////
+
+/// Allows `StringID` to be used as a key in any hash map.
+template<>
+struct std::hash<nikola::StringID> {
+  std::size_t operator()(const nikola::StringID& id) const {
+    return (std::size_t)id.hash;
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////
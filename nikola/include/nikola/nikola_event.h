@@ -9,6 +9,19 @@ namespace nikola { // Start of nikola
 /// ---------------------------------------------------------------------
 /// *** Event ***
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Consts
+
+/// The maximum amount of events that can wait in the event queue between two `event_process_queue` calls. 
+/// Posting into a full queue drops the event.
+const sizei EVENT_QUEUE_CAPACITY = 4096;
+
+/// The default priority of listeners. Listeners with a higher priority get called first.
+const i32 EVENT_PRIORITY_DEFAULT = 0;
+
+/// Consts
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// EventType
 enum EventType {
@@ -107,6 +120,25 @@ using EventFireFn = bool(*)(const Event& event, const void* dispatcher, const vo
 /// Event callback
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// EventListenerID
+struct EventListenerID {
+  //
+  // @NOTE: These are internal variables and should NOT be changed!
+  //
+
+  /// The type of event the listener was attached to.
+  EventType _type = EVENTS_MAX;
+
+  /// The slot of the listener in its event pool.
+  u32 _slot = 0;
+
+  /// Incremented every time the slot is freed, which invalidates any old IDs.
+  u32 _generation = 0;
+};
+/// EventListenerID
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Event functions
 
@@ -117,12 +149,46 @@ NIKOLA_API void event_init();
 NIKOLA_API void event_shutdown();
 
 /// Attach the given `func` callback to an event of type `type`, passing in the `listener` as well.
-NIKOLA_API void event_listen(const EventType type, const EventFireFn& func, const void* listener = nullptr);
+/// Listeners with a higher `priority` get called first, while listeners with the same 
+/// `priority` get called in the order they were attached.
+/// Returns an ID which can be given to `event_unlisten` later.
+///
+/// @NOTE: A listener attached from inside a callback will only be called starting from the next dispatch.
+NIKOLA_API EventListenerID event_listen(const EventType type, 
+                                        const EventFireFn& func, 
+                                        const void* listener = nullptr, 
+                                        const i32 priority   = EVENT_PRIORITY_DEFAULT);
+
+/// Detach the listener `id` from its event, in constant time. 
+/// Detaching an already-detached listener does nothing.
+///
+/// @NOTE: It is safe to call this function from inside any callback, including the listener's own.
+NIKOLA_API void event_unlisten(const EventListenerID& id);
 
 /// Call all callbacks associated with `event.type` and pass in the given `event` and the `dispatcher`. 
 /// Returns `true` on success.
+///
+/// @NOTE: The callbacks are called immediately on the calling thread. Use `event_post` 
+/// to defer the event to the next `event_process_queue` instead.
 NIKOLA_API const bool event_dispatch(const Event& event, const void* dispatcher = nullptr);
 
+/// Queue the given `event` and its `dispatcher` to be dispatched on the next `event_process_queue`. 
+/// Returns `false` if the queue was full and the event had to be dropped.
+///
+/// @NOTE: This function is safe to call from any thread. 
+///
+/// @NOTE: Queuing an `EVENT_MOUSE_MOVED`, `EVENT_WINDOW_MOVED`, `EVENT_WINDOW_RESIZED`, or 
+/// `EVENT_WINDOW_FRAMEBUFFER_RESIZED` right after another event of the same type (and from the 
+/// same `dispatcher`) replaces the queued event instead, since only the latest state matters.
+NIKOLA_API const bool event_post(const Event& event, const void* dispatcher = nullptr);
+
+/// Dispatch every event that was queued with `event_post` before this call, in the order they were posted. 
+///
+/// @NOTE: Events posted while the queue is being processed wait for the next call.
+///
+/// @NOTE: This is called once per frame by `window_poll_events`, right after polling the window's events.
+NIKOLA_API void event_process_queue();
+
 /// Event functions
 ///---------------------------------------------------------------------------------------------------------------------
 
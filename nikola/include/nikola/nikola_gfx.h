@@ -30,9 +30,20 @@ const sizei UNIFORM_BUFFERS_MAX         = 16;
 /// The maximum number of elements a buffer's layout can have.
 const sizei LAYOUT_ELEMENTS_MAX         = 32;
 
+/// The first attribute location of any per-instance layout element 
+/// (i.e, any `GfxLayoutDesc` with an `instance_rate` above `0`). 
+///
+/// @NOTE: Per-vertex elements always start at location `0`, so shaders can 
+/// find the per-instance elements at the same location, no matter the vertex type.
+const u32 LAYOUT_INSTANCE_LOCATION      = 8;
+
 /// The maximum number of render targets to be bound at once.
 const sizei RENDER_TARGETS_MAX          = 8;
 
+/// The amount of frames a `GfxQuery` can be in flight for before its oldest result 
+/// gets overwritten. Results are read this many frames late, so reading them never stalls.
+const sizei QUERY_FRAMES_MAX            = 4;
+
 // Consts
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -212,6 +223,9 @@ enum GfxBufferType {
 
   /// A uniform buffer.
   GFX_BUFFER_UNIFORM = 4 << 2,
+
+  /// A buffer of `GfxDrawIndirectCommand`s, used by `gfx_pipeline_draw_indirect`.
+  GFX_BUFFER_DRAW_INDIRECT = 4 << 3,
 };
 /// GfxBufferType
 ///---------------------------------------------------------------------------------------------------------------------
@@ -234,6 +248,15 @@ enum GfxBufferUsage {
   /// Set the buffer to be statically read from.
   /// This will be used for reading from the buffer once or rarely.
   GFX_BUFFER_USAGE_STATIC_READ  = 5 << 3,
+
+  /// Set the buffer to be persistently mapped for writing. 
+  /// This will be used for streaming data every frame straight into the buffer's memory, 
+  /// using the pointer retrieved from `gfx_buffer_map`.
+  ///
+  /// @NOTE: The mapping is coherent, so any writes are visible to the GPU without flushing. 
+  /// However, it is up to the caller to not overwrite any data the GPU is still reading from 
+  /// (usually with a `GfxFence`).
+  GFX_BUFFER_USAGE_PERSISTENT_MAP = 5 << 4,
 };
 /// GfxBufferUsage
 ///---------------------------------------------------------------------------------------------------------------------
@@ -442,6 +465,76 @@ enum GfxShaderType {
 /// GfxShaderType
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxQueryType
+enum GfxQueryType {
+  /// Measure the time the GPU took to execute every command 
+  /// between `gfx_query_begin` and `gfx_query_end`.
+  GFX_QUERY_TIME_ELAPSED = 13 << 0, 
+
+  /// Record the time at which the GPU was done with every 
+  /// command before `gfx_query_timestamp`.
+  GFX_QUERY_TIMESTAMP    = 13 << 1,
+};
+/// GfxQueryType
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxCommandType
+enum GfxCommandType {
+  GFX_COMMAND_CONTEXT_SET_STATE = 0, 
+  GFX_COMMAND_CONTEXT_SET_TARGET, 
+  GFX_COMMAND_CONTEXT_CLEAR, 
+  GFX_COMMAND_CONTEXT_PRESENT, 
+
+  GFX_COMMAND_FRAMEBUFFER_CREATE, 
+  GFX_COMMAND_FRAMEBUFFER_DESTROY, 
+  GFX_COMMAND_FRAMEBUFFER_COPY, 
+  GFX_COMMAND_FRAMEBUFFER_UPDATE, 
+
+  GFX_COMMAND_BUFFER_CREATE, 
+  GFX_COMMAND_BUFFER_DESTROY, 
+  GFX_COMMAND_BUFFER_UPDATE, 
+  GFX_COMMAND_BUFFER_COPY, 
+
+  GFX_COMMAND_SHADER_CREATE, 
+  GFX_COMMAND_SHADER_DESTROY, 
+  GFX_COMMAND_SHADER_USE, 
+  GFX_COMMAND_SHADER_UPDATE, 
+  GFX_COMMAND_SHADER_ATTACH_UNIFORM, 
+  GFX_COMMAND_SHADER_UPLOAD_UNIFORM, 
+
+  GFX_COMMAND_TEXTURE_CREATE, 
+  GFX_COMMAND_TEXTURE_DESTROY, 
+  GFX_COMMAND_TEXTURE_USE, 
+  GFX_COMMAND_TEXTURE_UPDATE, 
+  GFX_COMMAND_TEXTURE_UPLOAD, 
+
+  GFX_COMMAND_CUBEMAP_CREATE, 
+  GFX_COMMAND_CUBEMAP_DESTROY, 
+  GFX_COMMAND_CUBEMAP_USE, 
+  GFX_COMMAND_CUBEMAP_UPDATE, 
+  GFX_COMMAND_CUBEMAP_UPLOAD, 
+
+  GFX_COMMAND_PIPELINE_CREATE, 
+  GFX_COMMAND_PIPELINE_DESTROY, 
+  GFX_COMMAND_PIPELINE_UPDATE, 
+  GFX_COMMAND_PIPELINE_DRAW_VERTEX, 
+  GFX_COMMAND_PIPELINE_DRAW_INDEX, 
+  GFX_COMMAND_PIPELINE_DRAW_INDEX_INSTANCED, 
+  GFX_COMMAND_PIPELINE_DRAW_INDIRECT, 
+
+  GFX_COMMAND_QUERY_BEGIN, 
+  GFX_COMMAND_QUERY_END, 
+  GFX_COMMAND_QUERY_TIMESTAMP, 
+
+  GFX_COMMAND_FENCE_INSERT, 
+
+  GFX_COMMANDS_MAX,
+};
+/// GfxCommandType
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// GfxContext
 struct GfxContext; 
@@ -484,6 +577,24 @@ struct GfxPipeline;
 /// GfxPipeline
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxQuery
+struct GfxQuery;
+/// GfxQuery
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxFence
+struct GfxFence;
+/// GfxFence
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxCommandLog
+struct GfxCommandLog;
+/// GfxCommandLog
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// GfxDepthDesc
 struct GfxDepthDesc {
@@ -589,7 +700,7 @@ struct GfxCullDesc {
 struct GfxContextDesc {
   /// A reference to the window.
   /// 
-  /// @NOTE: This _must_ be set to a valid value.
+  /// @NOTE: This _must_ be set to a valid value, unless `is_headless` is set to `true`.
   Window* window                = nullptr;
 
   /// A bitwise ORed value from `GfxStates` determining the 
@@ -632,6 +743,13 @@ struct GfxContextDesc {
   /// @NOTE: Check `GfxCullDesc` to know the default values
   /// of each member.
   GfxCullDesc cull_desc         = {};
+
+  /// When set to `true`, the context will not create any GPU resources or issue 
+  /// any draw calls. Every resource is still allocated and keeps its description, 
+  /// so anything built on top of the context behaves the same, just without any output.
+  ///
+  /// @NOTE: By default, this value is set to `false`.
+  bool is_headless              = false;
 };
 /// GfxContextDesc 
 ///---------------------------------------------------------------------------------------------------------------------
@@ -672,6 +790,40 @@ struct GfxBufferDesc {
 /// GfxBufferDesc
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxDrawIndirectCommand
+
+/// A single indexed draw, as read by `gfx_pipeline_draw_indirect` from a `GFX_BUFFER_DRAW_INDIRECT` buffer.
+///
+/// @NOTE: The layout of this struct is dictated by the GPU. Do not add anything to it.
+struct GfxDrawIndirectCommand {
+  /// The amount of indices to draw.
+  u32 indices_count   = 0;
+
+  /// The amount of instances to draw.
+  u32 instances_count = 0;
+
+  /// The first index to draw in the `index_buffer`.
+  u32 first_index     = 0;
+
+  /// A value added to every index before reading the `vertex_buffer`.
+  i32 base_vertex     = 0;
+
+  /// The first instance to read from the `instance_buffer`.
+  u32 base_instance   = 0;
+};
+/// GfxDrawIndirectCommand
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxQueryDesc
+struct GfxQueryDesc {
+  /// What the query will be measuring.
+  GfxQueryType type = GFX_QUERY_TIME_ELAPSED;
+};
+/// GfxQueryDesc
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// GfxShaderDesc
 struct GfxShaderDesc {
@@ -699,6 +851,10 @@ struct GfxLayoutDesc {
   /// be sent immediately to the shader. However, 
   /// if it is set to a value >= `1`, the layout 
   /// will be sent after the nth instance. 
+  ///
+  /// @NOTE: Per-instance elements are read from the `instance_buffer` of 
+  /// the `GfxPipelineDesc`, starting at `LAYOUT_INSTANCE_LOCATION`. 
+  /// Every per-instance element of a pipeline must share the same `instance_rate`.
   u32 instance_rate = 0;
 };
 /// GfxLayoutDesc
@@ -807,6 +963,11 @@ struct GfxPipelineDesc {
 
   /// The amount of indices in the `index_buffer` to be drawn.
   sizei indices_count                = 0;
+
+  /// The buffer holding every per-instance layout element in `layout`.
+  ///
+  /// @NOTE: This can be left as `nullptr` if the pipeline has no per-instance elements.
+  GfxBuffer* instance_buffer         = nullptr;
   
   /// Layout array up to `LAYOUT_ELEMENTS_MAX` describing each layout attribute.
   GfxLayoutDesc layout[LAYOUT_ELEMENTS_MAX];
@@ -838,6 +999,32 @@ struct GfxPipelineDesc {
 /// GfxPipelineDesc
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxCommandStats
+struct GfxCommandStats {
+  /// The amount of commands recorded of each `GfxCommandType`.
+  sizei counts[GFX_COMMANDS_MAX] = {};
+
+  /// The total amount of commands recorded.
+  sizei commands_count      = 0;
+
+  /// The amount of `gfx_pipeline_draw_*` commands.
+  sizei draw_calls          = 0;
+
+  /// The amount of commands that changed any bound state 
+  /// (states, render targets, shaders, textures, cubemaps, uniform buffers, and pipeline states).
+  sizei state_changes       = 0;
+
+  /// The amount of resources created and destroyed.
+  sizei resources_created   = 0;
+  sizei resources_destroyed = 0;
+
+  /// The amount of bytes sent through buffers and uniforms.
+  sizei bytes_uploaded      = 0;
+};
+/// GfxCommandStats
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Context functions 
 
@@ -891,9 +1078,81 @@ NIKOLA_API void gfx_context_clear(GfxContext* gfx, const f32 r, const f32 g, con
 /// @NOTE: This function will be affected by vsync. 
 NIKOLA_API void gfx_context_present(GfxContext* gfx);
 
+/// Read back the RGBA8 pixels of the default render target of `gfx` into `out_pixels`, 
+/// which must be at least `width * height * 4` bytes big. 
+///
+/// @NOTE: The rows are stored bottom-to-top, the way OpenGL stores them. 
+///
+/// @NOTE: This stalls until the GPU is done rendering, and it must be called before 
+/// `gfx_context_present`, since the back buffer is undefined afterwards.
+NIKOLA_API void gfx_context_read_pixels(GfxContext* gfx, const i32 width, const i32 height, void* out_pixels);
+
+/// Record every command issued through `gfx` (or any of its resources) into `log`. 
+/// Passing a `nullptr` for `log` stops the recording.
+///
+/// @NOTE: Recording works on a headless context as well, which can be used to 
+/// measure the CPU side of the renderer without any driver noise. 
+/// A log can only ever be attached to a single context.
+NIKOLA_API void gfx_context_set_command_log(GfxContext* gfx, GfxCommandLog* log);
+
 /// Context functions 
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Pool allocator functions
+
+/// @NOTE: Every resource type below has its own pool of fixed-size blocks. Each pair of functions 
+/// matches the `AllocateMemoryFn` and `FreeMemoryFn` signatures, and can be passed to the 
+/// `_create` and `_destroy` functions of the associated type. A resource created with a 
+/// pool allocator _must_ be destroyed with the associated pool free function.
+///
+/// @NOTE: The pools live as long as there is at least one valid `GfxContext`. 
+
+/// Allocate a block from the `GfxFramebuffer` pool.
+NIKOLA_API void* gfx_framebuffer_pool_allocate(const sizei size);
+
+/// Return the block `ptr` back to the `GfxFramebuffer` pool.
+NIKOLA_API void gfx_framebuffer_pool_free(void* ptr);
+
+/// Allocate a block from the `GfxBuffer` pool.
+NIKOLA_API void* gfx_buffer_pool_allocate(const sizei size);
+
+/// Return the block `ptr` back to the `GfxBuffer` pool.
+NIKOLA_API void gfx_buffer_pool_free(void* ptr);
+
+/// Allocate a block from the `GfxShader` pool.
+NIKOLA_API void* gfx_shader_pool_allocate(const sizei size);
+
+/// Return the block `ptr` back to the `GfxShader` pool.
+NIKOLA_API void gfx_shader_pool_free(void* ptr);
+
+/// Allocate a block from the `GfxTexture` pool.
+NIKOLA_API void* gfx_texture_pool_allocate(const sizei size);
+
+/// Return the block `ptr` back to the `GfxTexture` pool.
+NIKOLA_API void gfx_texture_pool_free(void* ptr);
+
+/// Allocate a block from the `GfxCubemap` pool.
+NIKOLA_API void* gfx_cubemap_pool_allocate(const sizei size);
+
+/// Return the block `ptr` back to the `GfxCubemap` pool.
+NIKOLA_API void gfx_cubemap_pool_free(void* ptr);
+
+/// Allocate a block from the `GfxPipeline` pool.
+NIKOLA_API void* gfx_pipeline_pool_allocate(const sizei size);
+
+/// Return the block `ptr` back to the `GfxPipeline` pool.
+NIKOLA_API void gfx_pipeline_pool_free(void* ptr);
+
+/// Allocate a block from the `GfxQuery` pool.
+NIKOLA_API void* gfx_query_pool_allocate(const sizei size);
+
+/// Return the block `ptr` back to the `GfxQuery` pool.
+NIKOLA_API void gfx_query_pool_free(void* ptr);
+
+/// Pool allocator functions
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Framebuffer functions
 
@@ -952,6 +1211,22 @@ NIKOLA_API GfxBufferDesc& gfx_buffer_get_desc(GfxBuffer* buffer);
 /// Update the contents of `buff` starting at `offset` with `data` of size `size`.
 NIKOLA_API void gfx_buffer_update(GfxBuffer* buff, const sizei offset, const sizei size, const void* data);
 
+/// Retrieve the persistently mapped memory of `buff`, which stays valid until `buff` is destroyed. 
+///
+/// @NOTE: Only buffers created with `GFX_BUFFER_USAGE_PERSISTENT_MAP` are mapped. 
+/// Any other buffer will return a `nullptr`.
+NIKOLA_API void* gfx_buffer_map(GfxBuffer* buff);
+
+/// Let the context know that `size` bytes starting at `offset` were written through the mapping of `buff`.
+///
+/// @NOTE: Writes to the mapped memory are otherwise invisible to an attached `GfxCommandLog`, which records 
+/// the range as a `GFX_COMMAND_BUFFER_UPDATE` (with its bytes). Without a log, this does nothing.
+NIKOLA_API void gfx_buffer_mark_written(GfxBuffer* buff, const sizei offset, const sizei size);
+
+/// Copy `size` bytes from `src` starting at `src_offset` into `dest` starting at `dest_offset`. 
+/// The data never leaves the GPU.
+NIKOLA_API void gfx_buffer_copy(GfxBuffer* dest, const sizei dest_offset, const GfxBuffer* src, const sizei src_offset, const sizei size);
+
 /// Buffer functions 
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -989,13 +1264,26 @@ NIKOLA_API void gfx_shader_attach_uniform(GfxShader* shader, const GfxShaderType
 
 /// Lookup the `uniform_name` in `shader` and retrieve its location. 
 ///
+/// @NOTE: The active uniforms of `shader` are reflected once it gets linked, so 
+/// this never has to ask the driver. Arrays can be found by their plain name (i.e, `u_values` 
+/// rather than `u_values[0]`).
+///
 /// @NOTE: If `uniform_name` does NOT exist in `shader`, the returned value will be `-1`.
 NIKOLA_API i32 gfx_shader_uniform_lookup(GfxShader* shader, const i8* uniform_name);
 
+/// Lookup the uniform block `block_name` in `shader` and retrieve its binding point. 
+///
+/// @NOTE: If `block_name` does NOT exist in `shader`, the returned value will be `-1`.
+NIKOLA_API i32 gfx_shader_uniform_block_lookup(GfxShader* shader, const i8* block_name);
+
 /// Upload a uniform array with `count` elements of type `type` with `data` at `location` to `shader`. 
+///
+/// @NOTE: The uniform goes straight to `shader`, which does _not_ get bound in the process.
 NIKOLA_API void gfx_shader_upload_uniform_array(GfxShader* shader, const i32 location, const sizei count, const GfxLayoutType type, const void* data);
 
 /// Upload a uniform of type `type` with `data` at `location` to `shader`. 
+///
+/// @NOTE: The uniform goes straight to `shader`, which does _not_ get bound in the process.
 NIKOLA_API void gfx_shader_upload_uniform(GfxShader* shader, const i32 location, const GfxLayoutType type, const void* data);
 
 /// Shader functions 
@@ -1108,6 +1396,10 @@ NIKOLA_API void gfx_pipeline_destroy(GfxPipeline* pipeline, const FreeMemoryFn&
 /// Retrieve the internal `GfxPipelineDesc` of `pipeline`
 NIKOLA_API GfxPipelineDesc& gfx_pipeline_get_desc(GfxPipeline* pipeline);
 
+/// Retrieve the size (in bytes) of a single vertex in the `vertex_buffer` of `desc`, 
+/// as described by its per-vertex layout elements.
+NIKOLA_API const sizei gfx_pipeline_get_vertex_stride(const GfxPipelineDesc& desc);
+
 /// Update the `pipeline`'s information from the given `desc`.
 NIKOLA_API void gfx_pipeline_update(GfxPipeline* pipeline, const GfxPipelineDesc& desc);
 
@@ -1117,9 +1409,129 @@ NIKOLA_API void gfx_pipeline_draw_vertex(GfxPipeline* pipeline);
 /// Draw the contents of the `vertex_buffer` using the `index_buffer` in `pipeline`.
 NIKOLA_API void gfx_pipeline_draw_index(GfxPipeline* pipeline);
 
+/// Draw `instances_count` instances of the contents of the `vertex_buffer` using the `index_buffer` in `pipeline`, 
+/// where the per-instance elements are read from the `instance_buffer` starting at `base_instance`.
+NIKOLA_API void gfx_pipeline_draw_index_instanced(GfxPipeline* pipeline, const sizei instances_count, const sizei base_instance = 0);
+
+/// Issue every one of the `draws_count` `GfxDrawIndirectCommand`s found in `commands` (starting at `offset` bytes) 
+/// as a single draw call, using the `vertex_buffer`, `index_buffer`, and `instance_buffer` of `pipeline`.
+///
+/// @NOTE: The `commands` buffer must be of type `GFX_BUFFER_DRAW_INDIRECT`.
+NIKOLA_API void gfx_pipeline_draw_indirect(GfxPipeline* pipeline, GfxBuffer* commands, const sizei draws_count, const sizei offset = 0);
+
 /// Pipeline functions 
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Query functions 
+
+/// Allocate using the `alloc_fn` callback and return a `GfxQuery` object, using the information in `desc`. 
+///
+/// @NOTE: Every query holds `QUERY_FRAMES_MAX` underlying queries which are cycled through,
+/// so a query can be re-issued every frame without waiting on the GPU to finish the previous ones.
+///
+/// @NOTE: The `alloc_fn` uses the default memory allocater.
+NIKOLA_API GfxQuery* gfx_query_create(GfxContext* gfx, const GfxQueryDesc& desc, const AllocateMemoryFn& alloc_fn = memory_allocate);
+
+/// Free/reclaim any memory taken by `query` using the `free_fn` callback.
+///
+/// @NOTE: The `free_fn` uses the default memory allocater.
+NIKOLA_API void gfx_query_destroy(GfxQuery* query, const FreeMemoryFn& free_fn = memory_free);
+
+/// Retrieve the internal `GfxQueryDesc` of `query`
+NIKOLA_API GfxQueryDesc& gfx_query_get_desc(GfxQuery* query);
+
+/// Start measuring the GPU time of any following commands.
+///
+/// @NOTE: Only one `GFX_QUERY_TIME_ELAPSED` query can be active at a time.
+NIKOLA_API void gfx_query_begin(GfxQuery* query);
+
+/// Stop measuring the GPU time started by `gfx_query_begin`.
+NIKOLA_API void gfx_query_end(GfxQuery* query);
+
+/// Record the GPU time once every previous command is done.
+///
+/// @NOTE: This is only valid for `GFX_QUERY_TIMESTAMP` queries.
+NIKOLA_API void gfx_query_timestamp(GfxQuery* query);
+
+/// Read back any results of `query` the GPU is done with, and return the latest one in nanoseconds. 
+/// Returns `0` if no result has been made available yet.
+///
+/// @NOTE: This function never waits on the GPU. The returned result is usually a few frames old.
+NIKOLA_API const u64 gfx_query_get_result(GfxQuery* query);
+
+/// Query functions 
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Fence functions 
+
+/// Allocate using the `alloc_fn` callback and return an unsignaled `GfxFence` object.
+///
+/// @NOTE: The `alloc_fn` uses the default memory allocater.
+NIKOLA_API GfxFence* gfx_fence_create(GfxContext* gfx, const AllocateMemoryFn& alloc_fn = memory_allocate);
+
+/// Free/reclaim any memory taken by `fence` using the `free_fn` callback.
+///
+/// @NOTE: The `free_fn` uses the default memory allocater.
+NIKOLA_API void gfx_fence_destroy(GfxFence* fence, const FreeMemoryFn& free_fn = memory_free);
+
+/// Insert `fence` after every command issued so far. 
+/// The fence will be signaled once the GPU is done with all of those commands.
+///
+/// @NOTE: Inserting a fence that was already inserted replaces the previous one.
+NIKOLA_API void gfx_fence_insert(GfxFence* fence);
+
+/// Wait on the CPU for up to `timeout_ns` nanoseconds for `fence` to be signaled. 
+/// Returns `true` if the fence was signaled (or was never inserted), and `false` if the wait timed out.
+///
+/// @NOTE: A `timeout_ns` of `0` will only check the fence without waiting.
+NIKOLA_API const bool gfx_fence_wait(GfxFence* fence, const u64 timeout_ns);
+
+/// Fence functions 
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Command log functions 
+
+/// Allocate using the `alloc_fn` callback and return an empty `GfxCommandLog` object.
+///
+/// @NOTE: The `alloc_fn` uses the default memory allocater.
+NIKOLA_API GfxCommandLog* gfx_command_log_create(const AllocateMemoryFn& alloc_fn = memory_allocate);
+
+/// Free/reclaim any memory taken by `log` using the `free_fn` callback.
+///
+/// @NOTE: The `free_fn` uses the default memory allocater.
+NIKOLA_API void gfx_command_log_destroy(GfxCommandLog* log, const FreeMemoryFn& free_fn = memory_free);
+
+/// Throw away every command recorded in `log` and reset its stats.
+NIKOLA_API void gfx_command_log_clear(GfxCommandLog* log);
+
+/// Retrieve the stats of every command recorded in `log` so far.
+NIKOLA_API const GfxCommandStats& gfx_command_log_get_stats(GfxCommandLog* log);
+
+/// Write every command recorded in `log` as text into the file at `path`, 
+/// one command per line. Returns `false` if the file could not be opened.
+///
+/// @NOTE: Resources are written as the order in which they first appeared in the log 
+/// rather than their addresses, so the dumps of two runs can be diffed against each other.
+NIKOLA_API const bool gfx_command_log_dump(GfxCommandLog* log, const char* path);
+
+/// Issue every command recorded in `log` again, in order, on `gfx`, which has to be 
+/// the same (live) context the log was recorded on. If another log is attached to `gfx`, 
+/// the replayed commands get recorded into it.
+///
+/// @NOTE: The log only holds pointers to the resources it used, not their contents. 
+/// Any commands that create, destroy, redefine, or upload to resources (besides buffer updates), 
+/// as well as presenting, are therefore only recorded and never replayed. Every resource 
+/// referenced by the log must still be alive when replaying, which makes replaying good for 
+/// re-issuing captured frames on the same context, but not for capturing them on one context 
+/// (or run) and replaying them on another.
+NIKOLA_API void gfx_command_log_replay(GfxCommandLog* log, GfxContext* gfx);
+
+/// Command log functions 
+///---------------------------------------------------------------------------------------------------------------------
+
 /// *** Graphics ***
 /// ---------------------------------------------------------------------
 
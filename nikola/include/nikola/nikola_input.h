@@ -248,7 +248,9 @@ enum GamepadButton {
 NIKOLA_API void input_init();
 
 /// Update the internal state of the input system.
-NIKOLA_API void input_update(); 
+///
+/// @NOTE: The gamepads are polled through the window's backend, so they are left at rest if `is_headless` is set.
+NIKOLA_API void input_update(const bool is_headless = false); 
 
 /// Returns `true` if `key` was pressed this frame.
 NIKOLA_API const bool input_key_pressed(const Key key);
@@ -318,6 +320,45 @@ NIKOLA_API const char* input_gamepad_get_name(const JoystickID id);
 /// Input functions 
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Input recording functions
+
+/// Stop any recording or replay that is still going and close its file.
+///
+/// @NOTE: This is called by `nikola::shutdown()`. There is no need to call it yourself.
+NIKOLA_API void input_shutdown();
+
+/// Start recording every key, mouse, and gamepad event as well as the delta time 
+/// of every frame into the file at `path`. 
+/// Returns `false` if the file could not be opened or if a recording or a replay is already going.
+///
+/// @NOTE: The file will be truncated if it already exists.
+NIKOLA_API const bool input_record_begin(const char* path);
+
+/// Stop the current recording and flush the rest of it into its file.
+NIKOLA_API void input_record_end();
+
+/// Returns `true` if the input is currently being recorded.
+NIKOLA_API const bool input_is_recording();
+
+/// Start replaying the input recorded into the file at `path`, one recorded frame per `input_update`. 
+/// Any live input is ignored, and `niclock_get_delta_time` reports the recorded delta times until the replay is over.
+/// Returns `false` if the file could not be read or if a recording or a replay is already going.
+///
+/// @NOTE: The replay starts from a clean input state, so recordings should start with no keys or buttons held down. 
+///
+/// @NOTE: Only the input system ignores the live input. Any other listener will still receive both.
+NIKOLA_API const bool input_replay_begin(const char* path);
+
+/// Stop the current replay early.
+NIKOLA_API void input_replay_end();
+
+/// Returns `true` if a replay is still going. 
+NIKOLA_API const bool input_is_replaying();
+
+/// Input recording functions
+///---------------------------------------------------------------------------------------------------------------------
+
 /// *** Input ***
 /// ---------------------------------------------------------------------
 
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "nikola_base.h"
+
+#include <atomic>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace nikola { // Start of nikola
+
+/// ----------------------------------------------------------------------
+/// *** Jobs ***
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Job consts
+
+/// The maximum amount of worker threads the job system can spawn.
+const u32 JOBS_WORKERS_MAX    = 64;
+
+/// The maximum amount of jobs that can be queued in a single worker's queue at once.
+///
+/// @NOTE: This must be a power of 2.
+const u32 JOBS_QUEUE_CAPACITY = 4096;
+
+/// Job consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Job function pointers
+
+/// A function callback to be invoked by a worker thread, passing in the given `user_data`.
+using JobFn = void(*)(void* user_data);
+
+/// A function callback to be invoked by a worker thread over the index range `[begin, end)`,
+/// passing in the given `user_data`.
+using JobRangeFn = void(*)(const sizei begin, const sizei end, void* user_data);
+
+/// Job function pointers
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// JobCounter
+
+/// A fence that keeps track of how many dispatched jobs are still in flight.
+/// Every job dispatched with a counter will increment it, and decrement it once
+/// the job is done. A counter that reaches zero is considered "signaled".
+///
+/// @NOTE: A counter must outlive all of the jobs it was dispatched with.
+struct JobCounter {
+  std::atomic<i32> value = 0;
+};
+/// JobCounter
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// JobDesc
+struct JobDesc {
+  /// The function to be invoked by the worker.
+  JobFn func      = nullptr;
+
+  /// Any user data to be passed to `func`.
+  void* user_data = nullptr;
+};
+/// JobDesc
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Job system functions
+
+/// Initialize the global job system, spawning `workers_count` worker threads.
+/// Each worker owns its own queue, and idle workers will steal jobs from busy ones.
+///
+/// @NOTE: If `workers_count` is `0`, the job system will spawn a worker for every
+/// hardware thread except the calling thread.
+///
+/// @NOTE: This is called by `nikola::init()`. There is no need to call it yourself.
+NIKOLA_API void job_system_init(const u32 workers_count = 0);
+
+/// Wait for any pending jobs, stop, and join all of the worker threads.
+///
+/// @NOTE: This is called by `nikola::shutdown()`. There is no need to call it yourself.
+NIKOLA_API void job_system_shutdown();
+
+/// Retrieve the amount of worker threads currently spawned by the job system.
+NIKOLA_API const u32 job_system_get_workers_count();
+
+/// Dispatch a job that will invoke `func` with `user_data` on any available worker.
+/// If `counter` is valid, it will be incremented now and decremented once the job is done.
+///
+/// @NOTE: If the job system has no workers, `func` will be invoked immediately on the calling thread.
+NIKOLA_API void job_dispatch(const JobFn& func, void* user_data, JobCounter* counter = nullptr);
+
+/// Dispatch `jobs_count` jobs from the `jobs` array, all signaling the same `counter`.
+NIKOLA_API void job_dispatch_batch(const JobDesc* jobs, const sizei jobs_count, JobCounter* counter = nullptr);
+
+/// Returns `true` if all the jobs associated with `counter` are done.
+NIKOLA_API const bool job_counter_is_done(const JobCounter& counter);
+
+/// Block the calling thread until all the jobs associated with `counter` are done.
+///
+/// @NOTE: While waiting, the calling thread will execute other pending jobs rather than
+/// sleep, which makes it safe to wait on a counter from inside another job.
+NIKOLA_API void job_wait(JobCounter& counter);
+
+/// Split the index range `[0, count)` into chunks of `batch_size` and invoke `func`
+/// on every chunk across the workers, passing in `user_data`.
+///
+/// @NOTE: This function will only return once every chunk has been processed.
+///
+/// @NOTE: If `batch_size` is `0`, the range will be split evenly across all the workers.
+NIKOLA_API void job_parallel_for(const sizei count, const sizei batch_size, const JobRangeFn& func, void* user_data);
+
+/// Job system functions
+///---------------------------------------------------------------------------------------------------------------------
+
+/// *** Jobs ***
+/// ----------------------------------------------------------------------
+
+} // End of nikola
+
+//////////////////////////////////////////////////////////////////////////
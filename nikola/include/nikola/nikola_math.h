@@ -121,10 +121,41 @@ struct Transform {
   Vec3 scale     = Vec3(1.0f);
   Quat rotation  = Quat(0.0f, 0.0f, 0.0f, 0.0f);
   Mat4 transform = Mat4(1.0f);
+
+  /// Set when the position, scale, or rotation changed without rebuilding `transform`.
+  bool is_dirty = false;
 };
 /// Transform
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// AABB (Axis-Aligned Bounding Box)
+struct AABB {
+  Vec3 min = Vec3(0.0f);
+  Vec3 max = Vec3(0.0f);
+};
+/// AABB (Axis-Aligned Bounding Box)
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// BoundingSphere
+struct BoundingSphere {
+  Vec3 center = Vec3(0.0f);
+  f32 radius  = 0.0f;
+};
+/// BoundingSphere
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Frustum
+struct Frustum {
+  /// The left, right, bottom, top, near, and far planes (in that order), where 
+  /// `xyz` is the normalized inward-facing normal and `w` is the distance.
+  Vec4 planes[6];
+};
+/// Frustum
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Vertex3D_PNUV (Position, Normal, U/V texture coords)
 struct Vertex3D_PNUV {
@@ -480,9 +511,65 @@ NIKOLA_API void transform_rotate(Transform& trans, const Vec3& axis, const f32 a
 /// Scale the given `trans` by `scale`
 NIKOLA_API void transform_scale(Transform& trans, const Vec3& scale);
 
+/// Set the position of `trans` to `pos`, only marking its matrix as dirty instead of rebuilding it.
+NIKOLA_API void transform_set_position(Transform& trans, const Vec3& pos);
+
+/// Set the rotation of `trans` to `rot`, only marking its matrix as dirty instead of rebuilding it.
+///
+/// @NOTE: Internally, the given `rot` quaternion is normalized for better precision.
+NIKOLA_API void transform_set_rotation(Transform& trans, const Quat& rot);
+
+/// Set the scale of `trans` to `scale`, only marking its matrix as dirty instead of rebuilding it.
+NIKOLA_API void transform_set_scale(Transform& trans, const Vec3& scale);
+
+/// Rebuild the matrix of `trans` if it is dirty.
+NIKOLA_API void transform_update(Transform& trans);
+
+/// Rebuild the matrices of every dirty transform in the `transforms` array of `count` transforms, 
+/// several of them at a time when SIMD is available. Transforms that are not dirty are skipped entirely.
+NIKOLA_API void transform_update_batch(Transform* transforms, const sizei count);
+
 /// Transform functions
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Bounds functions
+
+/// Return the tightest `AABB` around the given `vertices` array of `floats_count` floats, where every 
+/// vertex is `stride` floats long and starts with its position.
+NIKOLA_API const AABB aabb_from_vertices(const f32* vertices, const sizei floats_count, const sizei stride);
+
+/// Return an `AABB` that encloses both `a` and `b`.
+NIKOLA_API const AABB aabb_merge(const AABB& a, const AABB& b);
+
+/// Return the `AABB` around `aabb` after being transformed by `matrix`. 
+NIKOLA_API const AABB aabb_transform(const AABB& aabb, const Mat4& matrix);
+
+/// Return a `BoundingSphere` around the given `vertices` array of `floats_count` floats, centered at the center 
+/// of their `AABB`, where every vertex is `stride` floats long and starts with its position.
+NIKOLA_API const BoundingSphere bounding_sphere_from_vertices(const f32* vertices, const sizei floats_count, const sizei stride);
+
+/// Return a `BoundingSphere` that encloses both `a` and `b`.
+NIKOLA_API const BoundingSphere bounding_sphere_merge(const BoundingSphere& a, const BoundingSphere& b);
+
+/// Extract the 6 planes of the frustum of the given `view_projection` matrix.
+///
+/// @NOTE: The matrix is expected to map into OpenGL's `[-1, 1]` clip space depth.
+NIKOLA_API const Frustum frustum_from_matrix(const Mat4& view_projection);
+
+/// Returns `true` if any part of `aabb` is inside of `frustum`.
+NIKOLA_API const bool frustum_intersects_aabb(const Frustum& frustum, const AABB& aabb);
+
+/// Test the `aabbs` array of `count` boxes against `frustum`, setting every entry of `out_visible` 
+/// to `1` if the box at the same index is inside of `frustum` or `0` otherwise. 
+/// Returns the amount of visible boxes.
+///
+/// @NOTE: When SIMD is available, the boxes are tested several at a time.
+NIKOLA_API const sizei frustum_cull_aabbs(const Frustum& frustum, const AABB* aabbs, const sizei count, u8* out_visible);
+
+/// Bounds functions
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Vertex functions
 
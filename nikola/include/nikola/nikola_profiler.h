@@ -0,0 +1,118 @@
+#pragma once
+
+#include "nikola_base.h"
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace nikola { // Start of nikola
+
+/// ----------------------------------------------------------------------
+/// *** Profiler ***
+
+/// The profiler is always active on debug builds. On release builds, it
+/// can be activated by defining `NIKOLA_PROFILER_ENABLED` (see the `NIKOLA_BUILD_PROFILER` CMake option).
+#if NIKOLA_BUILD_DEBUG == 1 || defined(NIKOLA_PROFILER_ENABLED)
+#define NIKOLA_PROFILER_ACTIVE 1
+#else
+#define NIKOLA_PROFILER_ACTIVE 0
+#endif
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Profiler consts
+
+/// The amount of events each thread can record before the oldest events start getting overwritten.
+///
+/// @NOTE: This must be a power of 2.
+const u32 PROFILER_EVENTS_PER_THREAD = 16384;
+
+/// The maximum amount of threads the profiler can keep track of.
+const u32 PROFILER_THREADS_MAX       = 128;
+
+/// Profiler consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ProfileZone
+
+/// A scoped zone that records the time between its construction and its destruction
+/// into the calling thread's buffer. Zones nest naturally, the same way scopes do.
+///
+/// @NOTE: Use `NIKOLA_PROFILE_SCOPE` instead of creating zones directly, so they compile out
+/// when the profiler is not active.
+struct ProfileZone {
+  const char* name = nullptr;
+  u64 begin_ns     = 0;
+
+  NIKOLA_API ProfileZone(const char* zone_name);
+  NIKOLA_API ~ProfileZone();
+
+  ProfileZone(const ProfileZone&)            = delete;
+  ProfileZone& operator=(const ProfileZone&) = delete;
+};
+/// ProfileZone
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Profiler functions
+
+/// Record a zone called `name` that started at `begin_ns` and ended at `end_ns` on the calling thread.
+///
+/// @NOTE: `name` must outlive the profiler. String literals are the safest bet.
+NIKOLA_API void profiler_record_zone(const char* name, const u64 begin_ns, const u64 end_ns);
+
+/// Mark the start of a new frame.
+NIKOLA_API void profiler_frame_mark();
+
+/// Give the calling thread a `name` to be shown in the trace.
+///
+/// @NOTE: `name` is copied.
+NIKOLA_API void profiler_set_thread_name(const char* name);
+
+/// Retrieve the current time of the profiler in nanoseconds.
+NIKOLA_API const u64 profiler_get_time_ns();
+
+/// Write every recorded event into a Chrome trace JSON file at `path`, which
+/// can be opened with `chrome://tracing` or Perfetto. Returns `false` if the file could not be opened.
+///
+/// @NOTE: Threads keep recording while dumping, so it is best to
+/// dump when no other threads are busy (i.e, between frames or on shutdown).
+NIKOLA_API const bool profiler_dump(const char* path);
+
+/// Throw away every recorded event.
+NIKOLA_API void profiler_clear();
+
+/// Free the buffers of every thread.
+///
+/// @NOTE: This is called by `nikola::shutdown()`. There is no need to call it yourself.
+NIKOLA_API void profiler_shutdown();
+
+/// Profiler functions
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Macros
+
+#define NIKOLA_PROFILE_CONCAT_IMPL(a, b) a##b
+#define NIKOLA_PROFILE_CONCAT(a, b)      NIKOLA_PROFILE_CONCAT_IMPL(a, b)
+
+#if NIKOLA_PROFILER_ACTIVE == 1
+  #define NIKOLA_PROFILE_SCOPE(name)  nikola::ProfileZone NIKOLA_PROFILE_CONCAT(_nikola_profile_zone_, __LINE__)(name)
+  #define NIKOLA_PROFILE_FUNCTION()   NIKOLA_PROFILE_SCOPE(__func__)
+  #define NIKOLA_PROFILE_FRAME()      nikola::profiler_frame_mark()
+  #define NIKOLA_PROFILE_THREAD(name) nikola::profiler_set_thread_name(name)
+#else
+  #define NIKOLA_PROFILE_SCOPE(name)
+  #define NIKOLA_PROFILE_FUNCTION()
+  #define NIKOLA_PROFILE_FRAME()
+  #define NIKOLA_PROFILE_THREAD(name)
+#endif
+
+/// Macros
+///---------------------------------------------------------------------------------------------------------------------
+
+/// *** Profiler ***
+/// ----------------------------------------------------------------------
+
+} // End of nikola
+
+//////////////////////////////////////////////////////////////////////////
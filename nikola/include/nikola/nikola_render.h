@@ -100,6 +100,9 @@ struct RendererDefaults {
   
   Material* material         = nullptr;
   Mesh* cube_mesh            = nullptr;
+
+  /// The persistently mapped buffer every per-instance matrix and color gets streamed into.
+  GfxBuffer* instance_buffer = nullptr;
 };
 /// RendererDefaults 
 ///---------------------------------------------------------------------------------------------------------------------
@@ -124,6 +127,9 @@ struct RenderPassDesc {
   
   ResourceID shader_context_id = {};
   DynamicArray<RenderTarget> targets;
+
+  /// The name of the pass, as reported by `renderer_get_timings`.
+  String name = "";
 };
 /// RenderPassDesc
 ///---------------------------------------------------------------------------------------------------------------------
@@ -185,6 +191,39 @@ struct Rect {
 /// Rect
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// RenderTiming 
+struct RenderTiming {
+  /// The name of the timed section (i.e, the name of a render pass).
+  String name = "";
+
+  /// The time the GPU took to execute the section in milliseconds.
+  ///
+  /// @NOTE: This is read back from the GPU without waiting on it, 
+  /// so it is usually a few frames behind.
+  f64 gpu_time = 0.0;
+};
+/// RenderTiming 
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// RendererStats 
+struct RendererStats {
+  /// The amount of meshes that were queued last frame.
+  sizei meshes_queued = 0;
+
+  /// The amount of queued meshes that were found outside of 
+  /// the camera's frustum last frame, and were never drawn.
+  ///
+  /// @NOTE: Debug meshes are never culled, and they are not counted here.
+  sizei meshes_culled = 0;
+
+  /// The amount of bytes (vertices and indices) taken by live meshes across every geometry pool.
+  sizei geometry_pools_used = 0;
+};
+/// RendererStats 
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// RenderPassFn 
 using RenderPassFn = void(*)(const RenderPass* previous, RenderPass* current, void* user_data);
@@ -215,7 +254,16 @@ NIKOLA_API void camera_update(Camera& cam);
 /// Initialize the global renderer using the given `window` for dimensions.
 NIKOLA_API void renderer_init(Window* window);
 
+/// Initialize the global renderer on top of a headless graphics context, 
+/// where every render pass will be `width` by `height` in size.
+///
+/// @NOTE: Nothing will actually be rendered. Check `GfxContextDesc::is_headless` for more details.
+NIKOLA_API void renderer_init_headless(const i32 width, const i32 height);
+
 /// Free/reclaim any memory consumed by the global renderer
+///
+/// @NOTE: This shuts down the graphics context as well, which takes every `Gfx*` handle with it. 
+/// Therefore, `resource_manager_shutdown` _must_ be called before this function.
 NIKOLA_API void renderer_shutdown();
 
 /// Retrieve the internal `GfxContext` of the global renderer.
@@ -224,6 +272,24 @@ NIKOLA_API GfxContext* renderer_get_context();
 /// Retrieve the internal default values of the renderer.
 NIKOLA_API const RendererDefaults& renderer_get_defaults();
 
+/// Add the renderer's per-instance layout elements (a model matrix and a color) to the given `desc`, 
+/// and set its `instance_buffer` to the renderer's instance buffer. 
+///
+/// @NOTE: Every mesh gets this automatically, so it can be drawn as part of an instanced draw call.
+NIKOLA_API void renderer_attach_instance_layout(GfxPipelineDesc& desc);
+
+/// Copy the geometry of `mesh` into the renderer's geometry pool of its vertex format, 
+/// so every mesh in that pool can be drawn as part of the same multi-draw indirect call.
+///
+/// @NOTE: Every mesh gets this automatically after its pipeline is created. Meshes that do not fit 
+/// into their pool anymore are still drawn, just on their own.
+NIKOLA_API void renderer_share_mesh_geometry(Mesh* mesh);
+
+/// Give the space `mesh` took in its geometry pool back, so the next meshes of the same vertex format can reuse it.
+///
+/// @NOTE: Every mesh gets this automatically when its resource group is destroyed.
+NIKOLA_API void renderer_release_mesh_geometry(Mesh* mesh);
+
 /// Set renderer's clear color to the given `clear_color`.
 NIKOLA_API void renderer_set_clear_color(const Vec4& clear_color);
 
@@ -240,6 +306,17 @@ NIKOLA_API void renderer_push_pass(const RenderPassDesc& desc, const RenderPassF
 /// renderer to use the default material and the default shader context.
 NIKOLA_API void renderer_queue_mesh(const ResourceID& mesh_id, const Transform& transform, const ResourceID& mat_id = {}, const ResourceID& shader_context_id = {});
 
+/// Queue `count` mesh rendering commands of the same `mesh_id`, one for each of the given `transforms`, 
+/// using the given `mat_id` and `shader_context_id`. 
+///
+/// @NOTE: Any queued commands sharing the same mesh, material, and shader context (whichever function queued them) 
+/// are grouped into a single instanced draw call. However, meshes using a custom shader context are still 
+/// drawn one at a time, since only the renderer's own shaders read the per-instance data.
+///
+/// @NOTE: Both `mat_id` and `shader_context_id` are set to `RESOURCE_INVALID` by default, which will prompt the 
+/// renderer to use the default material and the default shader context.
+NIKOLA_API void renderer_queue_mesh_instanced(const ResourceID& mesh_id, const Transform* transforms, const sizei count, const ResourceID& mat_id = {}, const ResourceID& shader_context_id = {});
+
 /// Queue a mesh rendering command using the given `mesh_id`, `transform`, and `shader_context_id`. 
 ///
 /// @NOTE: Both `mat_id` and `shader_context_id` are set to `RESOURCE_INVALID` by default, which will prompt the 
@@ -265,8 +342,19 @@ NIKOLA_API void renderer_debug_collider(const Collider* coll, const Vec3& color
 NIKOLA_API void renderer_begin(FrameData& data);
 
 /// Start the render passes chain, flushing the given `RenderQueue` in the process. 
+///
+/// @NOTE: Any queued mesh whose bounds lie completely outside of the 
+/// camera's frustum is culled before anything gets drawn. See `renderer_get_stats`.
+///
+/// @NOTE: The GPU time of every render pass is measured automatically. See `renderer_get_timings`.
 NIKOLA_API void renderer_end();
 
+/// Retrieve the latest GPU timings of every render pass, in the order they were pushed.
+NIKOLA_API const DynamicArray<RenderTiming>& renderer_get_timings();
+
+/// Retrieve the culling stats of the latest `renderer_end` call.
+NIKOLA_API const RendererStats& renderer_get_stats();
+
 /// Renderer functions
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -283,8 +371,13 @@ NIKOLA_API void batch_renderer_shutdown();
 NIKOLA_API void batch_renderer_begin();
 
 /// Sumbit the results of the batch renderer to the screen.
+///
+/// @NOTE: The GPU time of every submitted batch is measured automatically. See `batch_renderer_get_timing`.
 NIKOLA_API void batch_renderer_end();
 
+/// Retrieve the latest GPU timing of `batch_renderer_end`.
+NIKOLA_API const RenderTiming& batch_renderer_get_timing();
+
 /// Source the given `texture` at `src` and render into `dest`, tinted with `tint`.
 ///
 /// @NOTE: By default, `tint` is set to `Vec4(1.0f)`.
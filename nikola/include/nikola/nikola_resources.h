@@ -25,7 +25,13 @@ const u8 NBR_VALID_IDENTIFIER     = 107;
 const i16 NBR_VALID_MAJOR_VERSION = 0;
 
 /// The currently valid minor version of any `.nbr` file
-const i16 NBR_VALID_MINOR_VERSION = 1;
+const i16 NBR_VALID_MINOR_VERSION = 2;
+
+/// The first minor version where `.nbrmodel` files carry the 
+/// precomputed bounds of their meshes. 
+///
+/// @NOTE: The bounds of any older model get computed from its vertices when loaded.
+const i16 NBR_BOUNDS_MINOR_VERSION = 2;
 
 /// NBR consts
 ///---------------------------------------------------------------------------------------------------------------------
@@ -132,6 +138,14 @@ struct NBRMesh {
   /// @NOTE: This value will be `0` if no materials are present 
   /// in this mesh. 
   u8 material_index = 0;
+
+  /// The minimum and maximum corners of the box bounding `vertices`.
+  f32 aabb_min[3];
+  f32 aabb_max[3];
+
+  /// The center and radius of the sphere bounding `vertices`.
+  f32 sphere_center[3];
+  f32 sphere_radius;
 };
 /// NBRMesh 
 ///---------------------------------------------------------------------------------------------------------------------
@@ -156,6 +170,14 @@ struct NBRModel {
 
   /// An array of all the possible textures.
   NBRTexture* textures;
+
+  /// The minimum and maximum corners of the box bounding every mesh in `meshes`.
+  f32 aabb_min[3];
+  f32 aabb_max[3];
+
+  /// The center and radius of the sphere bounding every mesh in `meshes`.
+  f32 sphere_center[3];
+  f32 sphere_radius;
 };
 /// NBRModel 
 ///---------------------------------------------------------------------------------------------------------------------
@@ -296,6 +318,13 @@ NIKOLA_API void nbr_file_save(NBRFile& nbr, const NBRFont& font, const FilePath&
 /// Save the given `audio` at `path` using `nbr`'s information.
 NIKOLA_API void nbr_file_save(NBRFile& nbr, const NBRAudio& audio, const FilePath& path);
 
+/// Compute the bounds of every mesh in the given `model` from its vertices, 
+/// as well as the bounds of all of the meshes combined.
+///
+/// @NOTE: This is meant to be called once when converting a model, so 
+/// the bounds get saved with it and loading never has to go through the vertices.
+NIKOLA_API void nbr_model_compute_bounds(NBRModel* model);
+
 /// NBR file functions
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -335,6 +364,9 @@ const u32 MATERIAL_UNIFORMS_MAX          = 4;
 /// The name of the model transform uniform in materials. 
 #define MATERIAL_UNIFORM_MODEL_MATRIX "u_model" 
 
+/// A value to indicate a uniform that could not be resolved.
+const i32 UNIFORM_HANDLE_INVALID         = -1;
+
 /// Resources consts
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -454,6 +486,23 @@ struct Mesh {
 
   GfxPipeline* pipe         = nullptr;
   GfxPipelineDesc pipe_desc = {};
+
+  /// The bounds of the mesh's vertices in model space.
+  AABB bounds                  = {};
+  BoundingSphere bounds_sphere = {};
+
+  /// The renderer's geometry pool holding a copy of the mesh, and where in that pool it starts. 
+  /// Meshes that did not make it into any pool keep `geometry_pool` at `-1`.
+  ///
+  /// @NOTE: See `renderer_share_mesh_geometry` for more information.
+  i32 geometry_pool = -1;
+  u32 first_index   = 0;
+  i32 base_vertex   = 0;
+
+  /// The amount of bytes the pool gave the vertices and the indices of the mesh, 
+  /// which are given back once the mesh is destroyed.
+  sizei pool_vertices_size = 0;
+  sizei pool_indices_size  = 0;
 };
 /// Mesh 
 ///---------------------------------------------------------------------------------------------------------------------
@@ -470,13 +519,29 @@ struct Material {
 /// Material 
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// UniformHandle
+
+/// A uniform of a `ShaderContext`, resolved once using `shader_context_resolve_uniform`. 
+/// Setting a uniform through its handle goes straight to the shader, without any lookups.
+///
+/// @NOTE: A handle goes stale once the `generation` of its `ShaderContext` changes 
+/// (like when the shader gets hot-reloaded), and has to be resolved again.
+using UniformHandle = i32;
+
+/// UniformHandle
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// ShaderContext
 struct ShaderContext {
   GfxShader* shader = nullptr; 
   GfxBuffer* uniform_buffers[SHADER_UNIFORM_BUFFERS_MAX];
 
-  HashMap<String, i32> uniforms_cache;
+  HashMap<StringID, i32> uniforms_cache;
+
+  /// Incremented every time the cached uniforms get invalidated.
+  u32 generation = 0;
 };
 /// ShaderContext
 ///---------------------------------------------------------------------------------------------------------------------
@@ -498,6 +563,10 @@ struct Model {
   DynamicArray<Mesh*> meshes;
   DynamicArray<Material*> materials;
   DynamicArray<u8> material_indices;
+
+  /// The bounds of all of the model's meshes combined in model space.
+  AABB bounds                  = {};
+  BoundingSphere bounds_sphere = {};
 };
 /// Model 
 ///---------------------------------------------------------------------------------------------------------------------
@@ -532,7 +601,12 @@ struct Font {
 /// Cache the location of the uniform with the name `uniform_name` to the given `ctx`.
 /// 
 /// @NOTE: If the uniform's name is not found within the context, the function will throw a warning. 
-NIKOLA_API void shader_context_cache_uniform(ShaderContext* ctx, const i8* uniform_name);
+NIKOLA_API void shader_context_cache_uniform(ShaderContext* ctx, const String& uniform_name);
+
+/// Cache the location of the uniform with the pre-hashed name `uniform_name` to the given `ctx`.
+/// 
+/// @NOTE: If the uniform's name is not found within the context, the function will throw a warning. 
+NIKOLA_API void shader_context_cache_uniform(ShaderContext* ctx, const StringID& uniform_name);
 
 /// Set a uniform of type `i32` with the name `uniform_name` in `ctx` to the given `value`. 
 NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const i32 value);
@@ -552,6 +626,37 @@ NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const String& uni
 /// Set a uniform of type `Mat4` with the name `uniform_name` in `ctx` to the given `value`. 
 NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const Mat4& value);
 
+/// The `StringID` variants of `shader_context_set_uniform`. Prefer these in hot paths, since 
+/// `uniform_name` can be hashed at compile time using `string_id_literal`.
+///
+/// @NOTE: Any uniforms that do not exist in the shader of `ctx` are only looked up (and warned about) once.
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const StringID& uniform_name, const i32 value);
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const StringID& uniform_name, const f32 value);
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const StringID& uniform_name, const Vec2& value);
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const StringID& uniform_name, const Vec3& value);
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const StringID& uniform_name, const Vec4& value);
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const StringID& uniform_name, const Mat4& value);
+
+/// Resolve the uniform with the pre-hashed name `uniform_name` in `ctx` into a `UniformHandle`.
+///
+/// @NOTE: If the uniform's name is not found within the context, the function will throw a warning 
+/// (only once) and return `UNIFORM_HANDLE_INVALID`. Setting an invalid handle does nothing.
+NIKOLA_API UniformHandle shader_context_resolve_uniform(ShaderContext* ctx, const StringID& uniform_name);
+
+/// The `UniformHandle` variants of `shader_context_set_uniform`. These skip any lookups, 
+/// which makes them the best fit for uniforms that get set every frame.
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const UniformHandle handle, const i32 value);
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const UniformHandle handle, const f32 value);
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const UniformHandle handle, const Vec2& value);
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const UniformHandle handle, const Vec3& value);
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const UniformHandle handle, const Vec4& value);
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const UniformHandle handle, const Mat4& value);
+
+/// Forget every cached uniform of `ctx`, and bump its `generation` so any resolved `UniformHandle`s can be told apart.
+///
+/// @NOTE: This is called on every context of a shader once it gets hot-reloaded, since its uniforms can move around.
+NIKOLA_API void shader_context_invalidate_uniforms(ShaderContext* ctx);
+
 /// Set the data of the uniform buffer at `index` of the associated shader in `ctx` to `buffer`
 NIKOLA_API void shader_context_set_uniform_buffer(ShaderContext* ctx, const sizei index, const GfxBuffer* buffer);
 
@@ -608,6 +713,8 @@ NIKOLA_API void nbr_import_audio(NBRAudio* nbr, const ResourceGroupID& group_id,
 NIKOLA_API void resource_manager_init();
 
 /// Free/reclaim any memory consumed by the global resource manager.
+///
+/// @NOTE: This must be called _before_ `renderer_shutdown`, since every resource still needs the graphics context.
 NIKOLA_API void resource_manager_shutdown();
 
 /// Create and return a new resource group (a.k.a `unsigned short`) with `name` and `parent_dir`. 
@@ -734,7 +841,11 @@ NIKOLA_API void resources_push_dir(const ResourceGroupID& group_id, const FilePa
 
 /// Search and retrieve the ID of the resource `filename` in `group_id`. 
 /// If `filename` was not found in `group_id`, a default `ResourceID` will be returned. 
-NIKOLA_API ResourceID& resources_get_id(const ResourceGroupID& group_id, const String& filename);
+NIKOLA_API ResourceID resources_get_id(const ResourceGroupID& group_id, const String& filename);
+
+/// Search and retrieve the ID of the resource with the pre-hashed name `filename` in `group_id`. 
+/// If `filename` was not found in `group_id`, a default `ResourceID` will be returned. 
+NIKOLA_API ResourceID resources_get_id(const ResourceGroupID& group_id, const StringID& filename);
 
 /// Retrieve `GfxBuffer` identified by `id` in `group`. 
 ///
@@ -49,6 +49,10 @@ enum WindowFlags {
 
   /// Set the window to be fullscreen on creation. 
   WINDOW_FLAGS_FULLSCREEN          = 1 << 9,
+
+  /// Create an invisible window without a display, rendering through a 
+  /// software OpenGL context (OSMesa, falling back to surfaceless EGL). 
+  WINDOW_FLAGS_OFFSCREEN           = 1 << 10,
 };
 /// WindowFlags
 ///---------------------------------------------------------------------------------------------------------------------
@@ -74,13 +78,17 @@ enum WindowFlags {
 ///   - `WINDOW_FLAGS_CENTER_MOUSE`        = Center the mouse position relative to the screen on startup.
 ///   - `WINDOW_FLAGS_HIDE_CURSOR`         = Hide the cursor at creation. The cursos will be shown by default.
 ///   - `WINDOW_FLAGS_FULLSCREEN`          = Set the window to be fullscreen on creation. 
+///   - `WINDOW_FLAGS_OFFSCREEN`           = Create an invisible window with a software OpenGL context that needs no display.
 /// 
 NIKOLA_API Window* window_open(const char* title, const i32 width, const i32 height, i32 flags);
 
 /// Closes the `window` context and clears up any memory.
 NIKOLA_API void window_close(Window* window);
 
-/// Poll events from the `window` context.
+/// Poll events from the `window` context, then dispatch every event queued with `event_post`.
+///
+/// @NOTE: The keyboard and mouse events are queued, so they all get dispatched in order once polling is done. 
+/// The window's own events (moves, resizes, focus, and so on) are still dispatched right away.
 NIKOLA_API void window_poll_events(Window* window);
 
 /// Swap the internal buffer of the `window` context every `interval` count. 
@@ -131,6 +139,11 @@ NIKOLA_API void window_get_position(const Window* window, i32* x, i32* y);
 /// Set the given `window` as the current active context.
 NIKOLA_API void window_set_current_context(Window* window);
 
+/// Retrieve the address of the graphics API function `name` from the current context.
+/// 
+/// @NOTE: This works for any kind of context the window was created with, including offscreen ones. 
+NIKOLA_API void* window_get_proc_address(const char* name);
+
 /// Either disable or enable fullscreen mode on the `window` context.
 NIKOLA_API void window_set_fullscreen(Window* window, const bool fullscreen);
 
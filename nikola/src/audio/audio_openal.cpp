@@ -22,6 +22,10 @@ struct AudioState {
   HashMap<AudioSourceID, AudioSourceDesc> sources;
 
   AudioListenerDesc listener;
+
+  /// A null device makes no OpenAL calls and only keeps track of the resources.
+  bool is_null_device = false;
+  u32 null_ids        = 0;
 };
 
 static AudioState s_audio = {};
@@ -31,6 +35,10 @@ static AudioState s_audio = {};
 ///---------------------------------------------------------------------------------------------------------------------
 /// Private functions
 
+static bool is_device_active() {
+  return s_audio.al_device || s_audio.is_null_device;
+}
+
 static const char* get_al_error_string(ALenum error) {
   switch(error) {
     case AL_INVALID_NAME:
@@ -101,7 +109,16 @@ static ALenum get_al_format(const AudioBufferFormat format, const u32 channels,
 ///---------------------------------------------------------------------------------------------------------------------
 /// AudioContext functions
 
-bool audio_device_init(const char* device_name) {
+bool audio_device_init(const char* device_name, const bool is_null) {
+  // A null device does not need OpenAL at all
+  if(is_null) {
+    s_audio.is_null_device = true;
+    s_audio.null_ids       = 0;
+
+    NIKOLA_LOG_INFO("A null audio device was successfully initialized");
+    return true;
+  }
+
   // Init OpenAL device
   s_audio.al_device = alcOpenDevice(device_name);
   NIKOLA_ASSERT(s_audio.al_device, "Could not open an OpenAL audio device!");
@@ -124,6 +141,15 @@ bool audio_device_init(const char* device_name) {
 }
 
 void audio_device_shutdown() {
+  if(s_audio.is_null_device) {
+    s_audio.buffers.destroy();
+    s_audio.sources.destroy();
+    s_audio.is_null_device = false;
+
+    NIKOLA_LOG_INFO("The null audio device was successfully destroyed");
+    return;
+  }
+
   // This should be called otherwise we'll have a problem
   alcMakeContextCurrent(nullptr); 
 
@@ -131,6 +157,9 @@ void audio_device_shutdown() {
   alcDestroyContext(s_audio.al_context);
   alcCloseDevice(s_audio.al_device);
 
+  s_audio.buffers.destroy();
+  s_audio.sources.destroy();
+
   NIKOLA_LOG_INFO("The audio device was successfully destroyed");
 }
 
@@ -141,10 +170,16 @@ void audio_device_shutdown() {
 /// AudioBuffer functions
 
 AudioBufferID audio_buffer_create(const AudioBufferDesc& desc) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
 
   AudioBufferID id;
 
+  if(s_audio.is_null_device) {
+    id                  = ++s_audio.null_ids;
+    s_audio.buffers[id] = desc;
+    return id;
+  }
+
   // Generate the ID
   alGenBuffers(1, &id); 
   check_al_error("alGenBuffers");
@@ -162,6 +197,10 @@ AudioBufferID audio_buffer_create(const AudioBufferDesc& desc) {
 }
 
 void audio_buffer_destroy(AudioBufferID buffer) {
+  if(s_audio.is_null_device) {
+    return;
+  }
+
   alDeleteBuffers(1, &buffer);
 }
 
@@ -171,6 +210,9 @@ AudioBufferDesc& audio_buffer_get_desc(AudioBufferID buffer) {
 
 void audio_buffer_update(AudioBufferID buffer, const AudioBufferDesc& desc) {
   s_audio.buffers[buffer] = desc;
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alBufferi(buffer, AL_FREQUENCY, desc.sample_rate);
   alBufferi(buffer, AL_CHANNELS, desc.channels);
@@ -184,10 +226,16 @@ void audio_buffer_update(AudioBufferID buffer, const AudioBufferDesc& desc) {
 /// AudioSource functions
 
 AudioSourceID audio_source_create(const AudioSourceDesc& desc) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
 
   AudioSourceID id; 
 
+  if(s_audio.is_null_device) {
+    id                  = ++s_audio.null_ids;
+    s_audio.sources[id] = desc;
+    return id;
+  }
+
   // Generate the source's ID
   alGenSources(1, &id);
   check_al_error("alGenSources");
@@ -211,6 +259,10 @@ AudioSourceID audio_source_create(const AudioSourceDesc& desc) {
 }
 
 void audio_source_destroy(AudioSourceID source) {
+  if(s_audio.is_null_device) {
+    return;
+  }
+
   alDeleteSources(1, &source);
 }
 
@@ -219,40 +271,58 @@ AudioSourceDesc& audio_source_get_desc(AudioSourceID source) {
 }
 
 void audio_source_start(AudioSourceID source) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
+
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alSourcePlay(source);
   check_al_error("alPlaySource");
 }
 
 void audio_source_stop(AudioSourceID source) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
+
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alSourceStop(source);
   check_al_error("alStopSource");
 }
 
 void audio_source_restart(AudioSourceID source) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
+
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alSourceRewind(source);
   check_al_error("alRewindSource");
 }
 
 void audio_source_pause(AudioSourceID source) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
+
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alSourcePause(source);
   check_al_error("alPauseSource");
 }
 
 void audio_source_queue_buffers(AudioSourceID source, const AudioBufferID* buffers, const sizei count) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
   NIKOLA_ASSERT(buffers, "Invalid AudioBuffer array given to audio_source_queue_buffers");
  
   // Queue the buffers
-  alSourceQueueBuffers(source, count, &buffers[0]);
-  check_al_error("alSourceQueueBuffers");
+  if(!s_audio.is_null_device) {
+    alSourceQueueBuffers(source, count, &buffers[0]);
+    check_al_error("alSourceQueueBuffers");
+  }
 
   // Update the internal queue
   s_audio.sources[source].buffers_count = count;
@@ -262,7 +332,12 @@ void audio_source_queue_buffers(AudioSourceID source, const AudioBufferID* buffe
 }
 
 bool audio_source_is_playing(AudioSourceID source) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
+
+  // Nothing ever plays on a null device
+  if(s_audio.is_null_device) {
+    return false;
+  }
 
   i32 state;
   alGetSourcei(source, AL_SOURCE_STATE, &state);
@@ -273,59 +348,81 @@ bool audio_source_is_playing(AudioSourceID source) {
 void audio_source_set_buffer(AudioSourceID source, const AudioBufferID buffer) {
   NIKOLA_ASSERT(source, "Invalid AudioSource given to audio_source_set_buffer");
 
+  if(s_audio.is_null_device) {
+    return;
+  }
+
   alSourcei(source, AL_BUFFER, buffer);
   check_al_error("alSourcei(AL_BUFFER)");
 }
 
 void audio_source_set_volume(AudioSourceID source, const f32 volume) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
 
   s_audio.sources[source].volume = volume;
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alSourcef(source, AL_GAIN, s_audio.sources[source].volume);
   check_al_error("alSourcef(AL_GAIN)");
 }
 
 void audio_source_set_pitch(AudioSourceID source, const f32 pitch) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
 
   s_audio.sources[source].pitch = pitch;
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alSourcef(source, AL_PITCH, s_audio.sources[source].pitch);
   check_al_error("alSourcef(AL_PITCH)");
 }
 
 void audio_source_set_looping(AudioSourceID source, const bool looping) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
 
   s_audio.sources[source].is_looping = looping;
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alSourcei(source, AL_LOOPING, looping);
   check_al_error("alSourcei(AL_LOOPING)");
 }
 
 void audio_source_set_position(AudioSourceID source, const Vec3& position) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
   
   s_audio.sources[source].position = position;
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alSourcefv(source, AL_POSITION, &position[0]);
   check_al_error("alSource3f(AL_POSITION)");
 }
 
 void audio_source_set_velocity(AudioSourceID source, const Vec3& velocity) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
 
   s_audio.sources[source].velocity = velocity;
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alSourcefv(source, AL_VELOCITY, &velocity[0]);
   check_al_error("alSource3f(AL_VELOCITY)");
 }
 
 void audio_source_set_direction(AudioSourceID source, const Vec3& direction) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
 
   s_audio.sources[source].direction = direction;
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alSourcefv(source, AL_DIRECTION, &direction[0]);
   check_al_error("alSource3f(AL_DIRECTION)");
@@ -338,9 +435,12 @@ void audio_source_set_direction(AudioSourceID source, const Vec3& direction) {
 /// AudioListener functions
 
 void audio_listener_init(const AudioListenerDesc& desc) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
 
   s_audio.listener = desc;
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alListenerf(AL_GAIN, desc.volume);
   alListenerfv(AL_POSITION, &desc.position[0]);
@@ -353,27 +453,36 @@ AudioListenerDesc& audio_listener_get_desc() {
 }
 
 void audio_listener_set_volume(const f32 volume) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
 
   s_audio.listener.volume = volume;
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alListenerf(AL_GAIN, volume);
   check_al_error("alListenerfv");
 }
 
 void audio_listener_set_position(const Vec3& position) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
 
   s_audio.listener.position = position;
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alListenerfv(AL_POSITION, &position[0]);
   check_al_error("alListenerfv");
 }
 
 void audio_listener_set_velocity(const Vec3& velocity) {
-  NIKOLA_ASSERT(s_audio.al_device, "The audio device was not initialized for this operation to continue");
+  NIKOLA_ASSERT(is_device_active(), "The audio device was not initialized for this operation to continue");
 
   s_audio.listener.velocity = velocity;
+  if(s_audio.is_null_device) {
+    return;
+  }
 
   alListenerfv(AL_VELOCITY, &velocity[0]);
   check_al_error("alListenerfv");
@@ -1,4 +1,8 @@
 #include "nikola/nikola_event.h"
+#include "nikola/nikola_containers.h"
+
+#include <algorithm>
+#include <mutex>
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -7,8 +11,11 @@ namespace nikola { // Start of nikola
 /// ---------------------------------------------------------------------
 /// EventEntry
 struct EventEntry {
-  EventFireFn func; 
+  EventFireFn func;
   void* listener;
+
+  i32 priority;
+  u32 generation;
 };
 /// EventEntry
 /// ---------------------------------------------------------------------
@@ -16,18 +23,43 @@ struct EventEntry {
 /// ---------------------------------------------------------------------
 /// EventPool
 struct EventPool {
-  EventEntry* entries;
-  sizei size;
-  sizei capacity;
+  /// Every listener lives in a stable slot, so an `EventListenerID`
+  /// can point straight to it.
+  DynamicArray<EventEntry> entries;
+
+  /// The slots of the listeners, sorted by priority. This is the order of dispatch.
+  DynamicArray<u32> order;
+
+  /// Slots which were attached while dispatching and are still not in `order`.
+  DynamicArray<u32> pending;
+
+  DynamicArray<u32> free_slots;
+
+  /// The amount of detached listeners which are still in `order`.
+  sizei removed_count = 0;
 };
 /// EventPool
 /// ---------------------------------------------------------------------
 
+/// ---------------------------------------------------------------------
+/// QueuedEvent
+struct QueuedEvent {
+  Event event;
+  const void* dispatcher;
+};
+/// QueuedEvent
+/// ---------------------------------------------------------------------
+
 /// ---------------------------------------------------------------------
 /// EventState
 struct EventState {
   EventPool event_pool[EVENTS_MAX];
-  sizei events_count = 0;
+
+  /// How deep into nested `event_dispatch` calls we currently are.
+  sizei dispatch_depth = 0;
+
+  RingBuffer<QueuedEvent> queue;
+  std::mutex queue_mutex;
 };
 
 static EventState s_state;
@@ -35,29 +67,64 @@ static EventState s_state;
 /// ---------------------------------------------------------------------
 
 /// ---------------------------------------------------------------------
-/// Private functions 
+/// Private functions
 
-static void create_pool(EventType type, const sizei capacity) {
-  EventPool* pool = &s_state.event_pool[type]; 
+static bool is_coalesced_event(const EventType type) {
+  switch(type) {
+    case EVENT_MOUSE_MOVED:
+    case EVENT_WINDOW_MOVED:
+    case EVENT_WINDOW_RESIZED:
+    case EVENT_WINDOW_FRAMEBUFFER_RESIZED:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static void insert_ordered(EventPool* pool, const u32 slot) {
+  i32 priority = pool->entries[slot].priority;
 
-  pool->size     = 0; 
-  pool->capacity = capacity;  
-  pool->entries  = (EventEntry*)memory_allocate(sizeof(EventEntry) * capacity);
+  // Go past every listener with the same priority, so they keep getting called in the order they were attached
+  auto it = std::upper_bound(pool->order.begin(), pool->order.end(), priority, [&](const i32 prio, const u32 other) {
+    return prio > pool->entries[other].priority;
+  });
+
+  pool->order.insert(it, slot);
 }
 
-static void append_event(const EventType type, const EventEntry& entry) {
-  EventPool* pool = &s_state.event_pool[type];
+static void refresh_pool(EventPool* pool) {
+  // Take out any detached listeners and finally free their slots
+  if(pool->removed_count > 0) {
+    sizei new_size = 0;
 
-  pool->size++;
-  if(pool->size >= pool->capacity) {
-    pool->capacity += (pool->capacity / 2);
-    pool->entries   = (EventEntry*)memory_allocate(sizeof(EventEntry) * pool->capacity);
+    for(sizei i = 0; i < pool->order.size(); i++) {
+      u32 slot = pool->order[i];
+
+      if(pool->entries[slot].func) {
+        pool->order[new_size++] = slot;
+        continue;
+      }
+
+      pool->free_slots.push_back(slot);
+    }
+
+    pool->order.resize(new_size);
+    pool->removed_count = 0;
   }
 
-  pool->entries[pool->size - 1] = entry;
+  // Listeners attached while dispatching can now join in
+  for(auto& slot : pool->pending) {
+    if(pool->entries[slot].func) {
+      insert_ordered(pool, slot);
+    }
+    else {
+      pool->free_slots.push_back(slot);
+    }
+  }
+  pool->pending.clear();
 }
 
-/// Private functions 
+/// Private functions
 /// ---------------------------------------------------------------------
 
 /// ---------------------------------------------------------------------
@@ -65,36 +132,162 @@ static void append_event(const EventType type, const EventEntry& entry) {
 
 void event_init() {
   for(sizei i = 0; i < EVENTS_MAX; i++) {
-    create_pool((EventType)i, 16);
+    s_state.event_pool[i].entries.reserve(16);
+    s_state.event_pool[i].order.reserve(16);
   }
 
+  s_state.queue.create(EVENT_QUEUE_CAPACITY);
+
   NIKOLA_LOG_INFO("Event system was successfully initialized");
 }
 
 void event_shutdown() {
   for(sizei i = 0; i < EVENTS_MAX; i++) {
-    memory_free(s_state.event_pool[i].entries);
+    EventPool* pool = &s_state.event_pool[i];
+
+    pool->entries.clear();
+    pool->order.clear();
+    pool->pending.clear();
+    pool->free_slots.clear();
+    pool->removed_count = 0;
   }
 
+  s_state.queue.destroy();
+
   NIKOLA_LOG_INFO("Event system was successfully shutdown");
 }
 
-void event_listen(const EventType type, const EventFireFn& func, const void* listener) {
-  append_event(type, EventEntry{func, (void*)listener});
+EventListenerID event_listen(const EventType type, const EventFireFn& func, const void* listener, const i32 priority) {
+  NIKOLA_ASSERT((type < EVENTS_MAX), "Cannot listen to an invalid event type");
+  NIKOLA_ASSERT(func, "Cannot listen to an event with an invalid callback");
+
+  EventPool* pool = &s_state.event_pool[type];
+
+  // Re-use a freed slot if there is any
+  u32 slot = 0;
+  if(!pool->free_slots.empty()) {
+    slot = pool->free_slots.back();
+    pool->free_slots.pop_back();
+  }
+  else {
+    slot = (u32)pool->entries.size();
+    pool->entries.push_back(EventEntry{});
+  }
+
+  EventEntry* entry = &pool->entries[slot];
+  entry->func       = func;
+  entry->listener   = (void*)listener;
+  entry->priority   = priority;
+
+  // The order of dispatch cannot change while it is being walked through
+  if(s_state.dispatch_depth > 0) {
+    pool->pending.push_back(slot);
+  }
+  else {
+    refresh_pool(pool);
+    insert_ordered(pool, slot);
+  }
+
+  return EventListenerID {
+    ._type       = type,
+    ._slot       = slot,
+    ._generation = entry->generation,
+  };
+}
+
+void event_unlisten(const EventListenerID& id) {
+  if(id._type >= EVENTS_MAX) {
+    return;
+  }
+
+  EventPool* pool = &s_state.event_pool[id._type];
+  if(id._slot >= pool->entries.size()) {
+    return;
+  }
+
+  // The listener was already detached
+  EventEntry* entry = &pool->entries[id._slot];
+  if(entry->generation != id._generation || !entry->func) {
+    return;
+  }
+
+  // The slot itself only gets freed the next time the pool is refreshed,
+  // since it might still be in the middle of a dispatch.
+  entry->func     = nullptr;
+  entry->listener = nullptr;
+  entry->generation++;
+
+  pool->removed_count++;
 }
 
 const bool event_dispatch(const Event& event, const void* dispatcher) {
-  for(sizei i = 0; i < s_state.event_pool[event.type].size; i++) {
-    // Calling all of the callbacks with the same `event.type` 
-    EventEntry* entry = &s_state.event_pool[event.type].entries[i];
+  EventPool* pool = &s_state.event_pool[event.type];
+
+  if(s_state.dispatch_depth == 0) {
+    refresh_pool(pool);
+  }
+
+  s_state.dispatch_depth++;
+
+  bool result = true;
+  for(sizei i = 0; i < pool->order.size(); i++) {
+    // Calling all of the callbacks with the same `event.type`
+    EventEntry* entry = &pool->entries[pool->order[i]];
+    if(!entry->func) {
+      continue;
+    }
+
     if(!entry->func(event, dispatcher, entry->listener)) {
-      return false;
+      result = false;
+      break;
     }
   }
 
+  s_state.dispatch_depth--;
+  return result;
+}
+
+const bool event_post(const Event& event, const void* dispatcher) {
+  std::lock_guard<std::mutex> lock(s_state.queue_mutex);
+
+  // Only the latest state of these events matters
+  if(is_coalesced_event(event.type) && !s_state.queue.empty()) {
+    QueuedEvent& last = s_state.queue.back();
+
+    if(last.event.type == event.type && last.dispatcher == dispatcher) {
+      last.event = event;
+      return true;
+    }
+  }
+
+  if(!s_state.queue.push_back(QueuedEvent{event, dispatcher})) {
+    NIKOLA_LOG_WARN("Event queue is full. Dropping an event of type %i", (i32)event.type);
+    return false;
+  }
+
   return true;
 }
 
+void event_process_queue() {
+  // Only the events that were already posted get processed,
+  // so callbacks posting more events can never keep us here forever.
+  sizei count = 0;
+  {
+    std::lock_guard<std::mutex> lock(s_state.queue_mutex);
+    count = s_state.queue.size();
+  }
+
+  for(sizei i = 0; i < count; i++) {
+    QueuedEvent queued;
+    {
+      std::lock_guard<std::mutex> lock(s_state.queue_mutex);
+      s_state.queue.pop_front(&queued);
+    }
+
+    event_dispatch(queued.event, queued.dispatcher);
+  }
+}
+
 /// Event functions
 /// ---------------------------------------------------------------------
 
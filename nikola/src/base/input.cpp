@@ -1,5 +1,7 @@
 #include "nikola/nikola_input.h"
 #include "nikola/nikola_event.h"
+#include "nikola/nikola_containers.h"
+#include "nikola/nikola_file.h"
 
 #include <GLFW/glfw3.h>
 
@@ -7,6 +9,52 @@
 
 namespace nikola { // Start of nikola
 
+/// ---------------------------------------------------------------------
+/// Consts
+
+/// Identifies an input recording ("NINP").
+const u32 INPUT_RECORD_MAGIC   = 0x504e494e;
+
+/// Bumped every time the layout of the recordings change.
+const u16 INPUT_RECORD_VERSION = 1;
+
+/// The amount of axes every gamepad has (both sticks and both triggers).
+const sizei GAMEPAD_AXES_MAX   = 6;
+
+/// Consts
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// InputRecorder
+struct InputRecorder {
+  File file;
+
+  /// Everything recorded since the last `input_update`.
+  DynamicArray<u8> frame_data;
+  u16 frame_events_count  = 0;
+  u16 frame_gamepads_mask = 0;
+
+  /// Set on the first `input_update`, since there is no frame to write before it.
+  bool has_frame = false;
+
+  /// The last recorded state of every gamepad, so only the changes get written.
+  u16 gamepad_buttons[JOYSTICK_ID_LAST + 1];
+  f32 gamepad_axes[JOYSTICK_ID_LAST + 1][GAMEPAD_AXES_MAX];
+};
+/// InputRecorder
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// InputReplay
+struct InputReplay {
+  bool is_active = false;
+
+  DynamicArray<u8> data;
+  sizei cursor = 0;
+};
+/// InputReplay
+/// ---------------------------------------------------------------------
+
 /// InputState
 struct InputState {
   // Keyboard state
@@ -27,13 +75,279 @@ struct InputState {
   bool connected_joysticks[JOYSTICK_ID_LAST + 1];
   bool current_gamepad_state[JOYSTICK_ID_LAST + 1][GAMEPAD_BUTTONS_MAX];
   bool previous_gamepad_state[JOYSTICK_ID_LAST + 1][GAMEPAD_BUTTONS_MAX];
+  f32 gamepad_axes[JOYSTICK_ID_LAST + 1][GAMEPAD_AXES_MAX];
+
+  InputRecorder recorder;
+  InputReplay replay;
 };
 
 static InputState s_state;
 /// InputState
 
+/// ---------------------------------------------------------------------
+/// Private functions
+
+template<typename T>
+static void write_value(DynamicArray<u8>& data, const T& value) {
+  const u8* bytes = (const u8*)&value;
+  data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+static bool read_value(InputReplay& replay, T* out_value) {
+  if((replay.cursor + sizeof(T)) > replay.data.size()) {
+    return false;
+  }
+
+  memory_copy(out_value, replay.data.data() + replay.cursor, sizeof(T));
+  replay.cursor += sizeof(T);
+
+  return true;
+}
+
+static bool is_live_event(const void* dispatcher) {
+  // Only the replayed events count while replaying
+  return !s_state.replay.is_active || dispatcher == &s_state.replay;
+}
+
+static void record_event(const Event& event) {
+  InputRecorder& recorder = s_state.recorder;
+  if(!file_is_open(recorder.file)) {
+    return;
+  }
+
+  // Every event is a type and a code, followed by values only some types need
+  write_value(recorder.frame_data, (u8)event.type);
+
+  switch(event.type) {
+    case EVENT_KEY_PRESSED:
+      write_value(recorder.frame_data, (i16)event.key_pressed);
+      break;
+    case EVENT_KEY_RELEASED:
+      write_value(recorder.frame_data, (i16)event.key_released);
+      break;
+    case EVENT_MOUSE_BUTTON_PRESSED:
+      write_value(recorder.frame_data, (i16)event.mouse_button_pressed);
+      break;
+    case EVENT_MOUSE_BUTTON_RELEASED:
+      write_value(recorder.frame_data, (i16)event.mouse_button_released);
+      break;
+    case EVENT_JOYSTICK_CONNECTED:
+    case EVENT_JOYSTICK_DISCONNECTED:
+      write_value(recorder.frame_data, (i16)event.joystick_id);
+      break;
+    case EVENT_MOUSE_MOVED:
+      write_value(recorder.frame_data, event.mouse_pos_x);
+      write_value(recorder.frame_data, event.mouse_pos_y);
+      write_value(recorder.frame_data, event.mouse_offset_x);
+      write_value(recorder.frame_data, event.mouse_offset_y);
+      break;
+    case EVENT_MOUSE_SCROLL_WHEEL:
+      write_value(recorder.frame_data, event.mouse_scroll_value);
+      break;
+    default: // Enter and leave events need nothing else
+      break;
+  }
+
+  recorder.frame_events_count++;
+}
+
+static void record_gamepads() {
+  InputRecorder& recorder = s_state.recorder;
+
+  // Only the gamepads that changed since the last recorded frame get written
+  for(sizei i = 0; i <= JOYSTICK_ID_LAST; i++) {
+    u16 buttons = 0;
+    for(sizei j = 0; j < GAMEPAD_BUTTONS_MAX; j++) {
+      buttons |= s_state.current_gamepad_state[i][j] ? (1 << j) : 0;
+    }
+
+    bool has_changed = buttons != recorder.gamepad_buttons[i];
+    for(sizei j = 0; j < GAMEPAD_AXES_MAX; j++) {
+      has_changed = has_changed || (s_state.gamepad_axes[i][j] != recorder.gamepad_axes[i][j]);
+    }
+
+    if(!has_changed) {
+      continue;
+    }
+
+    recorder.gamepad_buttons[i] = buttons;
+    memory_copy(recorder.gamepad_axes[i], s_state.gamepad_axes[i], sizeof(recorder.gamepad_axes[i]));
+
+    recorder.frame_gamepads_mask |= (1 << i);
+  }
+}
+
+static void flush_recorded_frame() {
+  InputRecorder& recorder = s_state.recorder;
+  if(!recorder.has_frame) {
+    return;
+  }
+
+  // Frame header
+  f64 delta_time = niclock_get_delta_time();
+  file_write_bytes(recorder.file, &delta_time, sizeof(delta_time));
+  file_write_bytes(recorder.file, &recorder.frame_events_count, sizeof(recorder.frame_events_count));
+  file_write_bytes(recorder.file, &recorder.frame_gamepads_mask, sizeof(recorder.frame_gamepads_mask));
+
+  // Events
+  if(!recorder.frame_data.empty()) {
+    file_write_bytes(recorder.file, recorder.frame_data.data(), recorder.frame_data.size());
+  }
+
+  // Gamepads
+  for(sizei i = 0; i <= JOYSTICK_ID_LAST; i++) {
+    if((recorder.frame_gamepads_mask & (1 << i)) == 0) {
+      continue;
+    }
+
+    file_write_bytes(recorder.file, &recorder.gamepad_buttons[i], sizeof(u16));
+    file_write_bytes(recorder.file, recorder.gamepad_axes[i], sizeof(f32) * GAMEPAD_AXES_MAX);
+  }
+
+  recorder.frame_data.clear();
+  recorder.frame_events_count  = 0;
+  recorder.frame_gamepads_mask = 0;
+}
+
+static bool has_event_code(const EventType type) {
+  switch(type) {
+    case EVENT_KEY_PRESSED:
+    case EVENT_KEY_RELEASED:
+    case EVENT_MOUSE_BUTTON_PRESSED:
+    case EVENT_MOUSE_BUTTON_RELEASED:
+    case EVENT_JOYSTICK_CONNECTED:
+    case EVENT_JOYSTICK_DISCONNECTED:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static bool replay_event(InputReplay& replay) {
+  u8 type; 
+  if(!read_value(replay, &type)) {
+    return false;
+  }
+
+  Event event = {.type = (EventType)type};
+
+  i16 code = 0;
+  if(has_event_code(event.type) && !read_value(replay, &code)) {
+    return false;
+  }
+
+  bool is_valid = true;
+  switch(event.type) {
+    case EVENT_KEY_PRESSED:
+      event.key_pressed = code;
+      break;
+    case EVENT_KEY_RELEASED:
+      event.key_released = code;
+      break;
+    case EVENT_MOUSE_BUTTON_PRESSED:
+      event.mouse_button_pressed = code;
+      break;
+    case EVENT_MOUSE_BUTTON_RELEASED:
+      event.mouse_button_released = code;
+      break;
+    case EVENT_JOYSTICK_CONNECTED:
+    case EVENT_JOYSTICK_DISCONNECTED:
+      event.joystick_id = code;
+      break;
+    case EVENT_MOUSE_MOVED:
+      is_valid = read_value(replay, &event.mouse_pos_x)    && 
+                 read_value(replay, &event.mouse_pos_y)    && 
+                 read_value(replay, &event.mouse_offset_x) && 
+                 read_value(replay, &event.mouse_offset_y);
+      break;
+    case EVENT_MOUSE_SCROLL_WHEEL:
+      is_valid = read_value(replay, &event.mouse_scroll_value);
+      break;
+    case EVENT_MOUSE_ENTER:
+    case EVENT_MOUSE_LEAVE:
+      break;
+    default:
+      is_valid = false;
+      break;
+  }
+
+  if(!is_valid) {
+    return false;
+  }
+
+  // Everyone gets to see the replayed events, not just the input system
+  event_dispatch(event, &replay);
+  return true;
+}
+
+static bool replay_frame() {
+  InputReplay& replay = s_state.replay;
+
+  // The recording is over
+  f64 delta_time;
+  u16 events_count, gamepads_mask;
+
+  if(!read_value(replay, &delta_time) || !read_value(replay, &events_count) || !read_value(replay, &gamepads_mask)) {
+    return false;
+  }
+
+  // The next `niclock_update` is going to be this frame's
+  niclock_lock_delta_time(delta_time);
+
+  for(u16 i = 0; i < events_count; i++) {
+    if(!replay_event(replay)) {
+      NIKOLA_LOG_ERROR("Corrupted input recording");
+      return false;
+    }
+  }
+
+  for(sizei i = 0; i <= JOYSTICK_ID_LAST; i++) {
+    if((gamepads_mask & (1 << i)) == 0) {
+      continue;
+    }
+
+    u16 buttons;
+    if(!read_value(replay, &buttons) || !read_value(replay, &s_state.gamepad_axes[i])) {
+      NIKOLA_LOG_ERROR("Corrupted input recording");
+      return false;
+    }
+
+    for(sizei j = 0; j < GAMEPAD_BUTTONS_MAX; j++) {
+      s_state.current_gamepad_state[i][j] = (buttons & (1 << j)) != 0;
+    }
+  }
+
+  return true;
+}
+
+static void poll_gamepads() {
+  for(i32 i = 0; i <= JOYSTICK_ID_LAST; i++) {
+    // Disconnected joysticks (and non-gamepad ones) just stay at rest
+    GLFWgamepadstate gamepad_state;
+    if(!glfwGetGamepadState(i, &gamepad_state)) {
+      memory_zero(&gamepad_state, sizeof(gamepad_state));
+    }
+
+    // Check for every button press/release
+    for(i32 j = 0; j < GAMEPAD_BUTTONS_MAX; j++) {
+      s_state.current_gamepad_state[i][j] = gamepad_state.buttons[j] == GLFW_PRESS; 
+    }
+
+    memory_copy(s_state.gamepad_axes[i], gamepad_state.axes, sizeof(s_state.gamepad_axes[i]));
+  }
+}
+
+/// Private functions
+/// ---------------------------------------------------------------------
+
 /// Callbacks
 static bool key_callback(const Event& event, const void* dispatcher, const void* listener) {
+  if(!is_live_event(dispatcher)) {
+    return true;
+  }
+  record_event(event);
+
   switch(event.type) {
     case EVENT_KEY_PRESSED: 
       s_state.current_key_state[event.key_pressed] = true;
@@ -47,6 +361,11 @@ static bool key_callback(const Event& event, const void* dispatcher, const void*
 }
 
 static bool mouse_callback(const Event& event, const void* dispatcher, const void* listener) {
+  if(!is_live_event(dispatcher)) {
+    return true;
+  }
+  record_event(event);
+
   switch(event.type) {
     case EVENT_MOUSE_MOVED:
       s_state.mouse_position_x = event.mouse_pos_x;
@@ -76,6 +395,11 @@ static bool mouse_callback(const Event& event, const void* dispatcher, const voi
 }
 
 static bool joystick_callback(const Event& event, const void* dispatcher, const void* listener) {
+  if(!is_live_event(dispatcher)) {
+    return true;
+  }
+  record_event(event);
+
   switch(event.type) {
     case EVENT_JOYSTICK_CONNECTED: 
       s_state.connected_joysticks[event.joystick_id] = true;
@@ -112,26 +436,36 @@ void input_init() {
   NIKOLA_LOG_INFO("Input system successfully initialized");
 }
 
-void input_update() {
+void input_update(const bool is_headless) {
   // Updating the input states 
   memory_copy(s_state.previous_key_state, s_state.current_key_state, sizeof(s_state.current_key_state)); 
   memory_copy(s_state.previous_mouse_state, s_state.current_mouse_state, sizeof(s_state.current_mouse_state)); 
   memory_copy(s_state.previous_gamepad_state, s_state.current_gamepad_state, sizeof(s_state.current_gamepad_state)); 
-  
-  // Checking for joystick input every frame to set the current state
-  for(i32 i = 0; i < JOYSTICK_ID_LAST; i++) {
-    // We don't care about non-gamepad joysticks
-    if(!glfwJoystickIsGamepad(i)) {
+ 
+  // Everything recorded so far belongs to the frame that just ended
+  if(file_is_open(s_state.recorder.file)) {
+    flush_recorded_frame();
+    s_state.recorder.has_frame = true;
+  }
 
+  // The replay takes the place of both the events and the gamepads
+  if(s_state.replay.is_active) {
+    if(!replay_frame()) {
+      NIKOLA_LOG_INFO("Input replay is over");
+      input_replay_end();
     }
 
-    // Check for every button press/release
-    for(i32 j = 0; j < GAMEPAD_BUTTONS_MAX; j++) {
-      GLFWgamepadstate gamepad_state;
-      glfwGetGamepadState(i, &gamepad_state);
-      
-      s_state.current_gamepad_state[i][j] = gamepad_state.buttons[j] == GLFW_PRESS; 
-    }
+    return;
+  }
+
+  // Checking for joystick input every frame to set the current state. 
+  // Without a window, GLFW was never initialized, so the gamepads just stay at rest.
+  if(!is_headless) {
+    poll_gamepads();
+  }
+
+  if(file_is_open(s_state.recorder.file)) {
+    record_gamepads();
   }
 } 
 
@@ -197,11 +531,8 @@ const bool input_gamepad_connected(const JoystickID id) {
 }
 
 void input_gamepad_axis_value(const JoystickID id, const GamepadAxis axis, f32* x, f32* y) {
-  GLFWgamepadstate gamepad_state; 
-  glfwGetGamepadState(id, &gamepad_state);
-  
-  *x = gamepad_state.axes[axis];
-  *y = gamepad_state.axes[axis + 1];
+  *x = s_state.gamepad_axes[id][axis];
+  *y = s_state.gamepad_axes[id][axis + 1];
 }
 
 const bool input_gamepad_button_pressed(const JoystickID id, const GamepadButton button) {
@@ -227,6 +558,130 @@ const char* input_gamepad_get_name(const JoystickID id) {
 /// Input functions
 /// ---------------------------------------------------------------------
 
+/// ---------------------------------------------------------------------
+/// Input recording functions
+
+void input_shutdown() {
+  input_record_end();
+  input_replay_end();
+}
+
+const bool input_record_begin(const char* path) {
+  InputRecorder& recorder = s_state.recorder;
+  if(file_is_open(recorder.file) || s_state.replay.is_active) {
+    NIKOLA_LOG_WARN("Cannot record the input while another recording or replay is going");
+    return false;
+  }
+
+  if(!file_open(&recorder.file, path, (i32)(FILE_OPEN_WRITE | FILE_OPEN_BINARY))) {
+    NIKOLA_LOG_ERROR("Failed to open input recording file \'%s\'", path);
+    return false;
+  }
+
+  // Header
+  u16 reserved = 0;
+  file_write_bytes(recorder.file, &INPUT_RECORD_MAGIC, sizeof(INPUT_RECORD_MAGIC));
+  file_write_bytes(recorder.file, &INPUT_RECORD_VERSION, sizeof(INPUT_RECORD_VERSION));
+  file_write_bytes(recorder.file, &reserved, sizeof(reserved));
+
+  recorder.has_frame           = false;
+  recorder.frame_events_count  = 0;
+  recorder.frame_gamepads_mask = 0;
+  recorder.frame_data.clear();
+
+  // Every gamepad starts at rest
+  memory_zero(recorder.gamepad_buttons, sizeof(recorder.gamepad_buttons));
+  memory_zero(recorder.gamepad_axes, sizeof(recorder.gamepad_axes));
+
+  NIKOLA_LOG_INFO("Started recording the input into \'%s\'", path);
+  return true;
+}
+
+void input_record_end() {
+  InputRecorder& recorder = s_state.recorder;
+  if(!file_is_open(recorder.file)) {
+    return;
+  }
+
+  flush_recorded_frame();
+  file_close(recorder.file);
+}
+
+const bool input_is_recording() {
+  return file_is_open(s_state.recorder.file);
+}
+
+const bool input_replay_begin(const char* path) {
+  if(file_is_open(s_state.recorder.file) || s_state.replay.is_active) {
+    NIKOLA_LOG_WARN("Cannot replay the input while another recording or replay is going");
+    return false;
+  }
+
+  File file;
+  if(!file_open(&file, path, (i32)(FILE_OPEN_READ | FILE_OPEN_BINARY))) {
+    NIKOLA_LOG_ERROR("Failed to open input recording file \'%s\'", path);
+    return false;
+  }
+
+  // The whole recording gets read up front, so the replay never waits on the disk
+  InputReplay& replay = s_state.replay;
+  replay.data.resize(filesystem_get_size(path));
+  replay.cursor = 0;
+
+  file_read_bytes(file, replay.data.data(), replay.data.size());
+  file_close(file);
+
+  // Header
+  u32 magic;
+  u16 version, reserved;
+  if(!read_value(replay, &magic) || !read_value(replay, &version) || !read_value(replay, &reserved) || magic != INPUT_RECORD_MAGIC) {
+    NIKOLA_LOG_ERROR("Invalid input recording file \'%s\'", path);
+    return false;
+  }
+
+  if(version != INPUT_RECORD_VERSION) {
+    NIKOLA_LOG_ERROR("Unsupported input recording version %i in \'%s\'", (i32)version, path);
+    return false;
+  }
+
+  // Start from the same clean state as the recording
+  memory_zero(s_state.current_key_state, sizeof(s_state.current_key_state));
+  memory_zero(s_state.current_mouse_state, sizeof(s_state.current_mouse_state));
+  memory_zero(s_state.current_gamepad_state, sizeof(s_state.current_gamepad_state));
+  memory_zero(s_state.gamepad_axes, sizeof(s_state.gamepad_axes));
+
+  s_state.mouse_position_x = 0.0f;
+  s_state.mouse_position_y = 0.0f;
+  s_state.mouse_offset_x   = 0.0f;
+  s_state.mouse_offset_y   = 0.0f;
+  s_state.scroll_value     = 0.0f;
+
+  replay.is_active = true;
+
+  NIKOLA_LOG_INFO("Started replaying the input from \'%s\'", path);
+  return true;
+}
+
+void input_replay_end() {
+  InputReplay& replay = s_state.replay;
+  if(!replay.is_active) {
+    return;
+  }
+
+  replay.is_active = false;
+  replay.data.clear();
+  replay.cursor = 0;
+
+  niclock_unlock_delta_time();
+}
+
+const bool input_is_replaying() {
+  return s_state.replay.is_active;
+}
+
+/// Input recording functions
+/// ---------------------------------------------------------------------
+
 } // End of nikola
 
 //////////////////////////////////////////////////////////////////////////
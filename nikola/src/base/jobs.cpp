@@ -0,0 +1,357 @@
+#include "nikola/nikola_jobs.h"
+#include "nikola/nikola_base.h"
+#include "nikola/nikola_profiler.h"
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdio>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace nikola { // Start of nikola
+
+/// ---------------------------------------------------------------------
+/// Job
+struct Job {
+  JobFn func            = nullptr;
+  JobRangeFn range_func = nullptr;
+  void* user_data       = nullptr;
+
+  sizei begin = 0;
+  sizei end   = 0;
+
+  JobCounter* counter = nullptr;
+};
+/// Job
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// JobQueue
+
+/// A double-ended queue owned by a single worker. The owner pushes and pops
+/// from the back (LIFO, which keeps the caches warm), while any other worker
+/// steals from the front (FIFO, which steals the oldest and usually biggest work).
+struct JobQueue {
+  std::mutex mutex;
+
+  Job* jobs  = nullptr;
+  sizei head = 0;
+  sizei tail = 0;
+};
+/// JobQueue
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// JobSystem
+struct JobSystem {
+  /// Queue `0` is owned by the main thread (and any thread that is not
+  /// a worker). Queues `[1, workers_count]` are owned by the workers.
+  JobQueue queues[JOBS_WORKERS_MAX + 1];
+  std::thread workers[JOBS_WORKERS_MAX];
+  u32 workers_count = 0;
+
+  std::mutex wake_mutex;
+  std::condition_variable wake_cond;
+
+  std::atomic<i32> pending_jobs = 0;
+  std::atomic<bool> is_running  = false;
+};
+
+static JobSystem s_jobs;
+
+/// The index of the queue that belongs to the current thread.
+static thread_local u32 s_queue_index = 0;
+/// JobSystem
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// Private functions
+
+static void execute_job(Job& job) {
+  NIKOLA_PROFILE_SCOPE("Job");
+
+  if(job.range_func) {
+    job.range_func(job.begin, job.end, job.user_data);
+  }
+  else {
+    job.func(job.user_data);
+  }
+
+  if(job.counter) {
+    job.counter->value.fetch_sub(1, std::memory_order_acq_rel);
+  }
+}
+
+static bool queue_push(JobQueue& queue, const Job& job) {
+  std::lock_guard<std::mutex> lock(queue.mutex);
+
+  // The queue is full
+  if((queue.tail - queue.head) >= JOBS_QUEUE_CAPACITY) {
+    return false;
+  }
+
+  queue.jobs[queue.tail & (JOBS_QUEUE_CAPACITY - 1)] = job;
+  queue.tail++;
+
+  return true;
+}
+
+static bool queue_pop(JobQueue& queue, Job* out_job) {
+  std::lock_guard<std::mutex> lock(queue.mutex);
+
+  if(queue.tail == queue.head) {
+    return false;
+  }
+
+  queue.tail--;
+  *out_job = queue.jobs[queue.tail & (JOBS_QUEUE_CAPACITY - 1)];
+
+  return true;
+}
+
+static bool queue_steal(JobQueue& queue, Job* out_job) {
+  // Don't bother waiting on a busy queue. There are other queues to steal from.
+  std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+  if(!lock.owns_lock() || (queue.tail == queue.head)) {
+    return false;
+  }
+
+  *out_job = queue.jobs[queue.head & (JOBS_QUEUE_CAPACITY - 1)];
+  queue.head++;
+
+  return true;
+}
+
+static bool find_job(const u32 queue_index, Job* out_job) {
+  // Always check our own queue first
+  if(queue_pop(s_jobs.queues[queue_index], out_job)) {
+    s_jobs.pending_jobs.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Steal from the other queues, starting with our neighbour to
+  // avoid every worker hammering the same victim.
+  u32 queues_count = s_jobs.workers_count + 1;
+  for(u32 i = 1; i < queues_count; i++) {
+    u32 victim = (queue_index + i) % queues_count;
+
+    if(queue_steal(s_jobs.queues[victim], out_job)) {
+      s_jobs.pending_jobs.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void submit_job(const Job& job) {
+  if(job.counter) {
+    job.counter->value.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // No workers to give the job to... just do it yourself.
+  if(s_jobs.workers_count == 0) {
+    Job temp_job = job;
+    execute_job(temp_job);
+    return;
+  }
+
+  s_jobs.pending_jobs.fetch_add(1, std::memory_order_release);
+
+  // The queue is full, so the job will have to be executed right here
+  if(!queue_push(s_jobs.queues[s_queue_index], job)) {
+    s_jobs.pending_jobs.fetch_sub(1, std::memory_order_relaxed);
+
+    Job temp_job = job;
+    execute_job(temp_job);
+    return;
+  }
+
+  // Wake up a sleeping worker
+  { std::lock_guard<std::mutex> lock(s_jobs.wake_mutex); }
+  s_jobs.wake_cond.notify_one();
+}
+
+static void worker_loop(const u32 queue_index) {
+  s_queue_index = queue_index;
+
+  char thread_name[32];
+  snprintf(thread_name, sizeof(thread_name), "Job worker %u", queue_index);
+  NIKOLA_PROFILE_THREAD(thread_name);
+
+  while(true) {
+    Job job;
+    if(find_job(queue_index, &job)) {
+      execute_job(job);
+      continue;
+    }
+
+    // Sleep until there's more work to be done (or until the system is shutting down)
+    std::unique_lock<std::mutex> lock(s_jobs.wake_mutex);
+    s_jobs.wake_cond.wait(lock, []() {
+      return !s_jobs.is_running.load(std::memory_order_acquire) ||
+             (s_jobs.pending_jobs.load(std::memory_order_acquire) > 0);
+    });
+
+    if(!s_jobs.is_running.load(std::memory_order_acquire) && (s_jobs.pending_jobs.load(std::memory_order_acquire) <= 0)) {
+      break;
+    }
+  }
+}
+
+/// Private functions
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// Job system functions
+
+void job_system_init(const u32 workers_count) {
+  NIKOLA_ASSERT(!s_jobs.is_running, "Cannot initialize the job system more than once");
+
+  // Use every hardware thread except the current one by default
+  u32 count = workers_count;
+  if(count == 0) {
+    u32 hardware_threads = std::thread::hardware_concurrency();
+    count                = hardware_threads > 1 ? (hardware_threads - 1) : 0;
+  }
+
+  if(count > JOBS_WORKERS_MAX) {
+    NIKOLA_LOG_WARN("Cannot spawn more than %u job workers. Clamping %u to %u...", JOBS_WORKERS_MAX, count, JOBS_WORKERS_MAX);
+    count = JOBS_WORKERS_MAX;
+  }
+
+  // Allocate the queues (including the main thread's queue)
+  for(u32 i = 0; i <= count; i++) {
+    s_jobs.queues[i].jobs = (Job*)memory_allocate(sizeof(Job) * JOBS_QUEUE_CAPACITY);
+    s_jobs.queues[i].head = 0;
+    s_jobs.queues[i].tail = 0;
+  }
+
+  s_queue_index        = 0;
+  s_jobs.pending_jobs  = 0;
+  s_jobs.workers_count = count;
+  s_jobs.is_running    = true;
+
+  // Spawn the workers
+  for(u32 i = 0; i < count; i++) {
+    s_jobs.workers[i] = std::thread(worker_loop, i + 1);
+  }
+
+  NIKOLA_LOG_INFO("Successfully initialized the job system with %u workers", count);
+}
+
+void job_system_shutdown() {
+  if(!s_jobs.is_running) {
+    return;
+  }
+
+  // Help finish any leftover jobs
+  Job job;
+  while(find_job(s_queue_index, &job)) {
+    execute_job(job);
+  }
+
+  // Let the workers know it's time to go home
+  {
+    std::lock_guard<std::mutex> lock(s_jobs.wake_mutex);
+    s_jobs.is_running = false;
+  }
+  s_jobs.wake_cond.notify_all();
+
+  for(u32 i = 0; i < s_jobs.workers_count; i++) {
+    s_jobs.workers[i].join();
+  }
+
+  // Free the queues
+  for(u32 i = 0; i <= s_jobs.workers_count; i++) {
+    memory_free(s_jobs.queues[i].jobs);
+    s_jobs.queues[i].jobs = nullptr;
+  }
+
+  s_jobs.workers_count = 0;
+  NIKOLA_LOG_INFO("Job system was successfully shutdown");
+}
+
+const u32 job_system_get_workers_count() {
+  return s_jobs.workers_count;
+}
+
+void job_dispatch(const JobFn& func, void* user_data, JobCounter* counter) {
+  NIKOLA_ASSERT(func, "Cannot dispatch an invalid job function");
+
+  Job job = {
+    .func      = func,
+    .user_data = user_data,
+    .counter   = counter,
+  };
+  submit_job(job);
+}
+
+void job_dispatch_batch(const JobDesc* jobs, const sizei jobs_count, JobCounter* counter) {
+  NIKOLA_ASSERT(jobs, "Cannot dispatch an invalid array of jobs");
+
+  for(sizei i = 0; i < jobs_count; i++) {
+    job_dispatch(jobs[i].func, jobs[i].user_data, counter);
+  }
+}
+
+const bool job_counter_is_done(const JobCounter& counter) {
+  return counter.value.load(std::memory_order_acquire) <= 0;
+}
+
+void job_wait(JobCounter& counter) {
+  // Instead of sleeping, help out the workers until the counter is signaled
+  while(!job_counter_is_done(counter)) {
+    Job job;
+    if(find_job(s_queue_index, &job)) {
+      execute_job(job);
+      continue;
+    }
+
+    std::this_thread::yield();
+  }
+}
+
+void job_parallel_for(const sizei count, const sizei batch_size, const JobRangeFn& func, void* user_data) {
+  NIKOLA_ASSERT(func, "Cannot dispatch an invalid parallel for function");
+
+  if(count == 0) {
+    return;
+  }
+
+  // Split the range evenly between the workers and the calling thread
+  sizei batch = batch_size;
+  if(batch == 0) {
+    sizei threads_count = s_jobs.workers_count + 1;
+    batch               = (count + threads_count - 1) / threads_count;
+  }
+
+  // Not worth it to dispatch anything
+  if(s_jobs.workers_count == 0 || batch >= count) {
+    func(0, count, user_data);
+    return;
+  }
+
+  JobCounter counter;
+  for(sizei begin = 0; begin < count; begin += batch) {
+    Job job = {
+      .range_func = func,
+      .user_data  = user_data,
+      .begin      = begin,
+      .end        = (begin + batch) < count ? (begin + batch) : count,
+      .counter    = &counter,
+    };
+    submit_job(job);
+  }
+
+  job_wait(counter);
+}
+
+/// Job system functions
+/// ---------------------------------------------------------------------
+
+} // End of nikola
+
+//////////////////////////////////////////////////////////////////////////
@@ -1,44 +1,466 @@
 #include "nikola/nikola_base.h"
 #include "nikola/nikola_event.h"
+#include "nikola/nikola_containers.h"
 
 #include <cstdio>
 #include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
 
 //////////////////////////////////////////////////////////////////////////
 
 namespace nikola { // Start of nikola
 
+/// ---------------------------------------------------------------------
+/// Consts
+
+static const char* LOG_PREFIXES[] = {"[NIKOLA-TRACE]: ", "[NIKOLA-DEBUG]: ", "[NIKOLA-INFO]: ", "[NIKOLA-WARN]: ", "[NIKOLA-ERROR]: ", "[NIKOLA-FATAL]: "};
+static const char* LOG_COLORS[]   = {"1;94", "1;96", "1;92", "1;93", "1;91", "1;2;31;40"};
+
+/// Consts
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// LogEntry
+struct LogEntry {
+  /// Used to hand the entry over between the producers and the writer thread.
+  std::atomic<u64> sequence = 0;
+
+  LogLevel level = LOG_LEVEL_TRACE;
+
+  /// The amount of messages from the same call site that were 
+  /// suppressed in the previous window before this one got logged.
+  u32 suppressed_count = 0;
+
+  /// Only set if the message did not fit into `message`.
+  char* long_message = nullptr;
+  char message[LOGGER_MESSAGE_MAX];
+};
+/// LogEntry
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// LogCallsite
+
+/// A single call site being rate limited, identified by the address 
+/// _and_ the text of its format.
+struct LogCallsite {
+  /// A `0` key marks an empty slot.
+  std::atomic<u64> key            = 0;
+  std::atomic<const char*> format = nullptr;
+
+  std::atomic<i64> window_start     = 0;
+  std::atomic<u32> window_count     = 0;
+  std::atomic<u32> suppressed_count = 0;
+};
+/// LogCallsite
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// LogSink
+struct LogSink {
+  FILE* file         = nullptr;
+  LogLevel min_level = LOG_LEVEL_TRACE;
+};
+/// LogSink
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// Logger
+
+/// A bounded MPSC queue. Any thread can push messages into it, but only
+/// the writer thread pops messages out of it.
+struct Logger {
+  LogEntry entries[LOGGER_QUEUE_CAPACITY];
+  std::atomic<u64> enqueue_pos = 0;
+  u64 dequeue_pos              = 0;
+
+  /// The amount of messages written so far. Used to flush the logger.
+  std::atomic<u64> written_count = 0;
+
+  /// Incremented with every pushed message to wake up the writer thread.
+  std::atomic<u32> signal = 0;
+
+  std::thread writer;
+  std::atomic<bool> is_running = false;
+
+  LogCallsite callsites[LOGGER_CALLSITES_MAX];
+
+  std::mutex sinks_mutex;
+  LogSink sinks[LOGGER_SINKS_MAX];
+  u32 sinks_count = 0;
+};
+
+static Logger s_logger;
+/// Logger
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// Private functions
+
+static i64 get_time_ns() {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+static u64 get_callsite_key(const char* format) {
+  // Never `0`, since that is an empty slot
+  u64 key = hash_mix((u64)format) ^ string_id_hash(format, strlen(format));
+  return key == 0 ? 1 : key;
+}
+
+static bool is_stale_callsite(LogCallsite* site, const i64 now, const i64 window_ns) {
+  // Went quiet for a whole window, with nothing left to report
+  return (now - site->window_start.load(std::memory_order_relaxed)) >= window_ns && 
+         site->suppressed_count.load(std::memory_order_relaxed) == 0;
+}
+
+static LogCallsite* find_callsite(const u64 key, const char* format, const i64 now, const i64 window_ns) {
+  u32 index = (u32)hash_mix(key) & (LOGGER_CALLSITES_MAX - 1);
+  LogCallsite* stale_site = nullptr;
+
+  for(u32 i = 0; i < LOGGER_CALLSITES_MAX; i++) {
+    LogCallsite* site = &s_logger.callsites[(index + i) & (LOGGER_CALLSITES_MAX - 1)];
+    u64 site_key      = site->key.load(std::memory_order_acquire);
+
+    if(site_key == key) {
+      return site;
+    }
+
+    // Claim an empty slot. Another thread might beat us to it with the same call site, though.
+    if(site_key == 0) {
+      if(site->key.compare_exchange_strong(site_key, key, std::memory_order_acq_rel)) {
+        site->format.store(format, std::memory_order_release);
+        return site;
+      }
+      else if(site_key == key) {
+        return site;
+      }
+
+      continue;
+    }
+
+    if(!stale_site && is_stale_callsite(site, now, window_ns)) {
+      stale_site = site;
+    }
+  }
+
+  // Out of slots. Take over one that went quiet, so one-off call sites cannot fill the table up for good.
+  if(stale_site) {
+    u64 stale_key = stale_site->key.load(std::memory_order_acquire);
+
+    if(stale_site->key.compare_exchange_strong(stale_key, key, std::memory_order_acq_rel)) {
+      stale_site->format.store(format, std::memory_order_release);
+      stale_site->window_start.store(now, std::memory_order_relaxed);
+      stale_site->window_count.store(0, std::memory_order_relaxed);
+
+      return stale_site;
+    }
+  }
+
+  // Just let the message through
+  return nullptr;
+}
+
+static bool callsite_should_log(LogCallsite* site, const i64 now, const i64 window_ns, u32* out_suppressed) {
+  // A new window
+  i64 window_start = site->window_start.load(std::memory_order_relaxed);
+  if((now - window_start) >= window_ns) {
+    if(site->window_start.compare_exchange_strong(window_start, now, std::memory_order_relaxed)) {
+      site->window_count.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  if(site->window_count.fetch_add(1, std::memory_order_relaxed) < LOGGER_RATE_BURST) {
+    *out_suppressed = site->suppressed_count.exchange(0, std::memory_order_relaxed);
+    return true;
+  }
+
+  site->suppressed_count.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+static void write_message(const LogLevel lvl, const char* msg, const u32 suppressed_count) {
+  char suffix[64] = "";
+  if(suppressed_count > 0) {
+    snprintf(suffix, sizeof(suffix), " (%u similar messages suppressed)", suppressed_count);
+  }
+
+  // Printing the log message using different colors depending on the log level.
+  // @NOTE: This currently only works on Linux. Windows implementation coming in the future.
+  FILE* console = lvl == LOG_LEVEL_ERROR || lvl == LOG_LEVEL_FATAL ? stderr : stdout;
+  fprintf(console, "\033[%sm%s%s%s\033[0m\n", LOG_COLORS[lvl], LOG_PREFIXES[lvl], msg, suffix);
+
+  for(u32 i = 0; i < s_logger.sinks_count; i++) {
+    LogSink& sink = s_logger.sinks[i];
+    if(lvl >= sink.min_level) {
+      fprintf(sink.file, "%s%s%s\n", LOG_PREFIXES[lvl], msg, suffix);
+    }
+  }
+}
+
+static void flush_sinks() {
+  fflush(stdout);
+  fflush(stderr);
+
+  for(u32 i = 0; i < s_logger.sinks_count; i++) {
+    fflush(s_logger.sinks[i].file);
+  }
+}
+
+static void push_entry(const LogLevel lvl, const char* msg, char* long_msg, const u32 suppressed_count) {
+  // The writer is not around. Write it ourselves.
+  if(!s_logger.is_running.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(s_logger.sinks_mutex);
+    write_message(lvl, long_msg ? long_msg : msg, suppressed_count);
+
+    free(long_msg);
+    return;
+  }
+
+  // Claim a slot in the queue, waiting for the writer if the queue is full
+  LogEntry* entry = nullptr;
+  u64 pos         = s_logger.enqueue_pos.load(std::memory_order_relaxed);
+
+  while(true) {
+    entry    = &s_logger.entries[pos & (LOGGER_QUEUE_CAPACITY - 1)];
+    u64 seq  = entry->sequence.load(std::memory_order_acquire);
+    i64 diff = (i64)seq - (i64)pos;
+
+    if(diff == 0) {
+      if(s_logger.enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    else if(diff < 0) {
+      std::this_thread::yield();
+      pos = s_logger.enqueue_pos.load(std::memory_order_relaxed);
+    }
+    else {
+      pos = s_logger.enqueue_pos.load(std::memory_order_relaxed);
+    }
+  }
+
+  entry->level            = lvl;
+  entry->suppressed_count = suppressed_count;
+  entry->long_message     = long_msg;
+  if(!long_msg) {
+    memory_copy(entry->message, msg, strlen(msg) + 1);
+  }
+
+  // Hand the entry over to the writer
+  entry->sequence.store(pos + 1, std::memory_order_release);
+
+  s_logger.signal.fetch_add(1, std::memory_order_release);
+  s_logger.signal.notify_one();
+}
+
+static bool drain_queue() {
+  bool has_written = false;
+  std::lock_guard<std::mutex> lock(s_logger.sinks_mutex);
+
+  while(true) {
+    u64 pos         = s_logger.dequeue_pos;
+    LogEntry* entry = &s_logger.entries[pos & (LOGGER_QUEUE_CAPACITY - 1)];
+
+    // Nothing left (or the next entry is not fully pushed yet)
+    if(entry->sequence.load(std::memory_order_acquire) != (pos + 1)) {
+      break;
+    }
+
+    write_message(entry->level, entry->long_message ? entry->long_message : entry->message, entry->suppressed_count);
+
+    free(entry->long_message);
+    entry->long_message = nullptr;
+
+    // Give the slot back to the producers
+    entry->sequence.store(pos + LOGGER_QUEUE_CAPACITY, std::memory_order_release);
+    s_logger.dequeue_pos++;
+    s_logger.written_count.store(s_logger.dequeue_pos, std::memory_order_release);
+
+    has_written = true;
+  }
+
+  if(has_written) {
+    flush_sinks();
+  }
+
+  return has_written;
+}
+
+static void writer_loop() {
+  while(true) {
+    u32 signal = s_logger.signal.load(std::memory_order_acquire);
+    if(drain_queue()) {
+      continue;
+    }
+
+    if(!s_logger.is_running.load(std::memory_order_acquire)) {
+      break;
+    }
+
+    // Sleep until someone pushes a new message
+    s_logger.signal.wait(signal, std::memory_order_acquire);
+  }
+}
+
+static void report_suppressed_callsites() {
+  std::lock_guard<std::mutex> lock(s_logger.sinks_mutex);
+
+  for(u32 i = 0; i < LOGGER_CALLSITES_MAX; i++) {
+    LogCallsite& site = s_logger.callsites[i];
+
+    const char* format = site.format.load(std::memory_order_acquire);
+    u32 count          = site.suppressed_count.exchange(0, std::memory_order_relaxed);
+    if(!format || count == 0) {
+      continue;
+    }
+
+    char msg[LOGGER_MESSAGE_MAX];
+    snprintf(msg, sizeof(msg), "Suppressed %u messages of \"%s\"", count, format);
+    write_message(LOG_LEVEL_WARN, msg, 0);
+  }
+
+  flush_sinks();
+}
+
+/// Private functions
+/// ---------------------------------------------------------------------
+
 /// ---------------------------------------------------------------------
 /// Logger functions
 
+void logger_init() {
+  for(u32 i = 0; i < LOGGER_QUEUE_CAPACITY; i++) {
+    s_logger.entries[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  s_logger.enqueue_pos.store(0, std::memory_order_relaxed);
+  s_logger.dequeue_pos = 0;
+  s_logger.written_count.store(0, std::memory_order_relaxed);
+
+  s_logger.is_running.store(true, std::memory_order_release);
+  s_logger.writer = std::thread(writer_loop);
+}
+
+void logger_shutdown() {
+  if(s_logger.is_running.exchange(false, std::memory_order_acq_rel)) {
+    s_logger.signal.fetch_add(1, std::memory_order_release);
+    s_logger.signal.notify_one();
+
+    s_logger.writer.join();
+
+    // Anything that got pushed while the writer was on its way out
+    drain_queue();
+  }
+
+  report_suppressed_callsites();
+
+  std::lock_guard<std::mutex> lock(s_logger.sinks_mutex);
+  for(u32 i = 0; i < s_logger.sinks_count; i++) {
+    fclose(s_logger.sinks[i].file);
+  }
+  s_logger.sinks_count = 0;
+}
+
+const bool logger_attach_file(const char* path, const LogLevel min_level) {
+  NIKOLA_ASSERT(path, "Invalid path given to logger_attach_file");
+
+  std::lock_guard<std::mutex> lock(s_logger.sinks_mutex);
+
+  if(s_logger.sinks_count >= LOGGER_SINKS_MAX) {
+    fprintf(stderr, "[NIKOLA-LOGGER]: Cannot attach \'%s\'. Too many file sinks\n", path);
+    return false;
+  }
+
+  FILE* file = fopen(path, "w");
+  if(!file) {
+    fprintf(stderr, "[NIKOLA-LOGGER]: Failed to open log file \'%s\'\n", path);
+    return false;
+  }
+
+  s_logger.sinks[s_logger.sinks_count++] = LogSink{file, min_level};
+  return true;
+}
+
+void logger_flush() {
+  if(s_logger.is_running.load(std::memory_order_acquire)) {
+    // Wait for the writer to get through everything pushed up until now
+    u64 target = s_logger.enqueue_pos.load(std::memory_order_acquire);
+    while(s_logger.written_count.load(std::memory_order_acquire) < target) {
+      s_logger.signal.fetch_add(1, std::memory_order_release);
+      s_logger.signal.notify_one();
+
+      std::this_thread::yield();
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(s_logger.sinks_mutex);
+  flush_sinks();
+}
+
 void logger_log_assert(const char* expr, const char* msg, const char* file, const u32 line_num) {
-  fprintf(stderr, "[NIKOLA ASSERTION FAILED]: %s\n", msg); 
-  fprintf(stderr, "[EXPR]: %s\n", expr); 
-  fprintf(stderr, "[FILE]: %s\n", file); 
-  fprintf(stderr, "[LINE]: %i\n", line_num); 
+  // We are most likely about to crash. Get everything out first.
+  logger_flush();
+
+  std::lock_guard<std::mutex> lock(s_logger.sinks_mutex);
+
+  fprintf(stderr, "[NIKOLA ASSERTION FAILED]: %s\n", msg);
+  fprintf(stderr, "[EXPR]: %s\n", expr);
+  fprintf(stderr, "[FILE]: %s\n", file);
+  fprintf(stderr, "[LINE]: %i\n", line_num);
+
+  for(u32 i = 0; i < s_logger.sinks_count; i++) {
+    fprintf(s_logger.sinks[i].file, "[NIKOLA ASSERTION FAILED]: %s\n[EXPR]: %s\n[FILE]: %s\n[LINE]: %i\n", msg, expr, file, line_num);
+  }
+
+  flush_sinks();
 }
 
 void logger_log(const LogLevel lvl, const char* msg, ...) {
-  // Getting the correct log level text  
-  const char* log_prefix[] = {"[NIKOLA-TRACE]: ", "[NIKOLA-DEBUG]: ", "[NIKOLA-INFO]: ", "[NIKOLA-WARN]: ", "[NIKOLA-ERROR]: ", "[NIKOLA-FATAL]: "};
+  // Too many messages from the same place. This is checked before anything gets 
+  // formatted, so a suppressed message costs next to nothing.
+  u32 suppressed_count = 0;
+  if(lvl != LOG_LEVEL_FATAL) {
+    const i64 window_ns = (i64)(LOGGER_RATE_WINDOW * 1000000000.0);
+    i64 now             = get_time_ns();
+
+    LogCallsite* site = find_callsite(get_callsite_key(msg), msg, now, window_ns);
+    if(site && !callsite_should_log(site, now, window_ns, &suppressed_count)) {
+      return;
+    }
+  }
 
   // Trying to unpack the veriadic arguments to add them to the string
-  char out_msg[32000]; // @TODO: A limited size message will not suffice here for long
-  va_list list; 
+  char out_msg[LOGGER_MESSAGE_MAX];
+  char* long_msg = nullptr;
+  va_list list, list_copy;
 
   // Some arg magic...
   va_start(list, msg);
-  vsnprintf(out_msg, sizeof(out_msg), msg, list);
+  va_copy(list_copy, list);
+
+  i32 length = vsnprintf(out_msg, sizeof(out_msg), msg, list);
+
+  // The message did not fit. Take it to the heap.
+  // @NOTE: Using `malloc` directly here since the memory functions might log themselves.
+  if(length >= (i32)sizeof(out_msg)) {
+    long_msg = (char*)malloc(length + 1);
+    vsnprintf(long_msg, length + 1, msg, list_copy);
+  }
+
+  va_end(list_copy);
   va_end(list);
 
-  // Printing the log message using different colors depending on the log level.
-  // @NOTE: This currently only works on Linux. Windows implementation coming in the future.
-  FILE* console = lvl == LOG_LEVEL_ERROR || lvl == LOG_LEVEL_FATAL ? stderr : stdout; 
-  const char* colors[] = {"1;94", "1;96", "1;92", "1;93", "1;91", "1;2;31;40"};
-  fprintf(console, "\033[%sm%s%s\033[0m\n", colors[lvl], log_prefix[lvl], out_msg);
+  push_entry(lvl, out_msg, long_msg, suppressed_count);
 
   // Can't keep going with a log level of `FATAL`
   if(lvl == LOG_LEVEL_FATAL) {
+    logger_flush();
     event_dispatch(Event{.type = EVENT_APP_QUIT});
   }
 }
@@ -1,6 +1,8 @@
 #include "nikola/nikola_base.h"
 #include "nikola/nikola_event.h"
 #include "nikola/nikola_input.h"
+#include "nikola/nikola_jobs.h"
+#include "nikola/nikola_profiler.h"
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -10,14 +12,30 @@ namespace nikola { // Start of nikola
 /// Nikol init functions
 
 const bool init() {
+  logger_init();
+  memory_frame_arena_init();
   event_init();
   input_init();
+  job_system_init();
+
+  NIKOLA_PROFILE_THREAD("Main thread");
 
   return true;
 }
 
 void shutdown() {
+  job_system_shutdown();
+  input_shutdown();
+  memory_frame_arena_shutdown();
   event_shutdown();
+  string_id_shutdown();
+  profiler_shutdown();
+
+  // Anything still alive at this point is a leak
+  memory_report();
+
+  // Keep the logger around until the very end
+  logger_shutdown();
 }
 
 /// Nikol init functions
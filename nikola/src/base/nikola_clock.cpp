@@ -1,6 +1,7 @@
 #include "nikola/nikola_base.h"
 
-#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -12,22 +13,77 @@ struct ClockState {
 
   f64 last_frame_time, delta_time; 
   f64 fps, previous_time, current_time;
+
+  bool is_delta_locked = false;
+  f64 locked_delta_time;
+
+  /// A ring of the last frame times (in milliseconds), where `history_head` is the oldest one.
+  f32 frame_history[CLOCK_FRAME_HISTORY_MAX];
+  sizei history_count = 0;
+  sizei history_head  = 0;
+
+  f64 hitch_threshold = CLOCK_HITCH_THRESHOLD_DEFAULT;
+  bool is_hitch       = false;
+  u64 total_hitches   = 0;
+
+  /// The very first frame includes the whole initialization, so it never counts.
+  bool has_first_frame = false;
+
+  /// Kept away from GLFW, so the clock still ticks when no window was ever opened.
+  std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
 };
 
 static ClockState s_state;
 /// ClockState
 
+/// ---------------------------------------------------------------------
+/// Private functions
+
+static void push_frame_time(const f64 frame_time) {
+  s_state.is_hitch = frame_time > s_state.hitch_threshold;
+  s_state.total_hitches += s_state.is_hitch ? 1 : 0;
+
+  f32 frame_ms = (f32)(frame_time * 1000.0);
+
+  if(s_state.history_count < CLOCK_FRAME_HISTORY_MAX) {
+    s_state.frame_history[s_state.history_count++] = frame_ms;
+    return;
+  }
+
+  // Overwrite the oldest frame
+  s_state.frame_history[s_state.history_head] = frame_ms;
+  s_state.history_head                        = (s_state.history_head + 1) % CLOCK_FRAME_HISTORY_MAX;
+}
+
+static f64 get_percentile(const f32* sorted_times, const sizei count, const f64 percentile) {
+  sizei index = (sizei)(percentile * (f64)(count - 1) + 0.5);
+  return (f64)sorted_times[index];
+}
+
+/// Private functions
+/// ---------------------------------------------------------------------
+
 /// ---------------------------------------------------------------------
 /// Clock functions
 
 void niclock_update() {
   // Calculating the delta time 
-  s_state.delta_time      = glfwGetTime() - s_state.last_frame_time; // TODO: Maybe don't have a refrence to GLFW?
-  s_state.last_frame_time = glfwGetTime();
+  f64 time = niclock_get_time();
+
+  f64 frame_time = time - s_state.last_frame_time;
+
+  s_state.delta_time      = s_state.is_delta_locked ? s_state.locked_delta_time : frame_time;
+  s_state.last_frame_time = time;
+
+  // Keep track of the real frame times
+  if(s_state.has_first_frame) {
+    push_frame_time(frame_time);
+  }
+  s_state.has_first_frame = true;
 
   // Calculating the FPS 
   s_state.frame_count++;
-  s_state.current_time = glfwGetTime();
+  s_state.current_time = time;
 
   if((s_state.current_time - s_state.previous_time) >= 1.0f) {
     s_state.fps           = s_state.frame_count;
@@ -37,7 +93,8 @@ void niclock_update() {
 }
 
 const f64 niclock_get_time() {
-  return glfwGetTime();
+  std::chrono::duration<f64> time = std::chrono::steady_clock::now() - s_state.epoch;
+  return time.count();
 }
 
 const f64 niclock_get_fps() {
@@ -48,6 +105,63 @@ const f64 niclock_get_delta_time() {
   return s_state.delta_time;
 }
 
+void niclock_lock_delta_time(const f64 delta_time) {
+  s_state.is_delta_locked   = true;
+  s_state.locked_delta_time = delta_time;
+}
+
+void niclock_unlock_delta_time() {
+  s_state.is_delta_locked = false;
+}
+
+const FrameTimeStats niclock_get_frame_stats() {
+  FrameTimeStats stats = {
+    .frames_count        = s_state.history_count,
+    .total_hitches_count = s_state.total_hitches,
+  };
+
+  if(s_state.history_count == 0) {
+    return stats;
+  }
+
+  // The order doesn't matter for any of the stats, so the ring can be sorted as is
+  f32 sorted_times[CLOCK_FRAME_HISTORY_MAX];
+  memory_copy(sorted_times, s_state.frame_history, sizeof(f32) * s_state.history_count);
+  std::sort(sorted_times, sorted_times + s_state.history_count);
+
+  f64 hitch_ms = s_state.hitch_threshold * 1000.0;
+  f64 total_ms = 0.0;
+
+  for(sizei i = 0; i < s_state.history_count; i++) {
+    total_ms            += sorted_times[i];
+    stats.hitches_count += sorted_times[i] > hitch_ms ? 1 : 0;
+  }
+
+  stats.min_ms = sorted_times[0];
+  stats.avg_ms = total_ms / (f64)s_state.history_count;
+  stats.p50_ms = get_percentile(sorted_times, s_state.history_count, 0.50);
+  stats.p95_ms = get_percentile(sorted_times, s_state.history_count, 0.95);
+  stats.p99_ms = get_percentile(sorted_times, s_state.history_count, 0.99);
+  stats.max_ms = sorted_times[s_state.history_count - 1];
+
+  return stats;
+}
+
+void niclock_get_frame_history(const f32** out_frame_times, sizei* out_count, sizei* out_offset) {
+  *out_frame_times = s_state.frame_history;
+  *out_count       = s_state.history_count;
+  *out_offset      = s_state.history_head;
+}
+
+void niclock_set_hitch_threshold(const f64 threshold) {
+  NIKOLA_ASSERT((threshold > 0.0), "The hitch threshold must be greater than zero");
+  s_state.hitch_threshold = threshold;
+}
+
+const bool niclock_is_hitch() {
+  return s_state.is_hitch;
+}
+
 /// Clock functions
 /// ---------------------------------------------------------------------
 
@@ -2,53 +2,231 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <atomic>
+#include <mutex>
 
 //////////////////////////////////////////////////////////////////////////
 
 namespace nikola { // Start of nikola
 
+/// MemoryHeader
+
+/// Every block allocated by the memory functions is prefixed with this header, 
+/// which is how `memory_free` knows the size and tag of each block.
+struct MemoryHeader {
+#if NIKOLA_MEMORY_TRACKING_ACTIVE == 1
+  /// All the live blocks are linked together to report leaks.
+  MemoryHeader* prev = nullptr;
+  MemoryHeader* next = nullptr;
+
+  /// The callsite of the allocation.
+  const char* file = nullptr;
+  sizei line       = 0;
+#endif
+
+  sizei size = 0;
+  u32 tag    = 0;
+  u32 magic  = 0;
+};
+
+/// Used to catch any pointers that were not allocated by the memory functions.
+const u32 MEMORY_HEADER_MAGIC = 0x4E494B4F; // "NIKO"
+
+static_assert((sizeof(MemoryHeader) % MEMORY_DEFAULT_ALIGNMENT) == 0, "MemoryHeader must keep the blocks aligned");
+/// MemoryHeader
+
+/// MemoryTagState
+struct MemoryTagState {
+  std::atomic<sizei> live_bytes   = 0;
+  std::atomic<sizei> peak_bytes   = 0;
+  std::atomic<sizei> budget_bytes = 0;
+  std::atomic<sizei> live_blocks  = 0;
+};
+/// MemoryTagState
+
 /// MemoryState
 struct MemoryState {
-  sizei alloc_count = 0; 
-  sizei free_count  = 0;
+  std::atomic<sizei> alloc_count = 0; 
+  std::atomic<sizei> free_count  = 0;
 
-  sizei alloc_total_bytes = 0;
+  MemoryTagState tags[MEMORY_TAGS_MAX];
+
+#if NIKOLA_MEMORY_TRACKING_ACTIVE == 1
+  std::mutex blocks_mutex;
+  MemoryHeader* blocks_head = nullptr;
+#endif
 };
 
 static MemoryState s_state;
 /// MemoryState
 
+/// MemoryArena
+struct MemoryArena {
+  u8* data       = nullptr;
+  sizei capacity = 0;
+
+  std::atomic<sizei> offset            = 0;
+  std::atomic<sizei> peak_bytes        = 0;
+  std::atomic<sizei> allocations_count = 0;
+  std::atomic<sizei> overflows_count   = 0;
+};
+
+static MemoryArena* s_frame_arena = nullptr;
+/// MemoryArena
+
+/// MemoryPool
+struct MemoryPool {
+  std::mutex mutex;
+
+  sizei block_size       = 0;
+  sizei blocks_per_chunk = 0;
+  MemoryTag tag          = MEMORY_TAG_GENERAL;
+
+  /// Every chunk begins with a pointer to the previous chunk.
+  u8* chunks      = nullptr; 
+  
+  /// Every free block begins with a pointer to the next free block.
+  void* free_list = nullptr;
+
+  sizei blocks_count = 0;
+  sizei used_blocks  = 0;
+  sizei peak_blocks  = 0;
+  sizei chunks_count = 0;
+};
+/// MemoryPool
+
+/// ---------------------------------------------------------------------
+/// Private functions
+
+static MemoryHeader* get_header(void* ptr) {
+  MemoryHeader* header = (MemoryHeader*)((u8*)ptr - sizeof(MemoryHeader));
+  NIKOLA_ASSERT((header->magic == MEMORY_HEADER_MAGIC), "Cannot free a block that was not allocated by the memory functions!");
+
+  return header;
+}
+
+static void add_live_bytes(MemoryHeader* header, const sizei size) {
+  MemoryTagState& tag = s_state.tags[header->tag];
+
+  // Keep track of the high-water mark
+  sizei live = tag.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+  sizei peak = tag.peak_bytes.load(std::memory_order_relaxed);
+  while((live > peak) && !tag.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+  // Only warn once when crossing the budget
+  sizei budget = tag.budget_bytes.load(std::memory_order_relaxed);
+  if((budget > 0) && (live > budget) && ((live - size) <= budget)) {
+    NIKOLA_LOG_WARN("Memory tag \'%s\' went over its budget (%zu/%zu bytes)", memory_tag_str((MemoryTag)header->tag), live, budget);
+  }
+}
+
+static void link_block(MemoryHeader* header) {
+#if NIKOLA_MEMORY_TRACKING_ACTIVE == 1
+  std::lock_guard<std::mutex> lock(s_state.blocks_mutex);
+
+  header->prev = nullptr;
+  header->next = s_state.blocks_head;
+  if(s_state.blocks_head) {
+    s_state.blocks_head->prev = header;
+  }
+  s_state.blocks_head = header;
+#endif
+}
+
+static void unlink_block(MemoryHeader* header) {
+#if NIKOLA_MEMORY_TRACKING_ACTIVE == 1
+  std::lock_guard<std::mutex> lock(s_state.blocks_mutex);
+
+  if(header->prev) {
+    header->prev->next = header->next;
+  }
+  else {
+    s_state.blocks_head = header->next;
+  }
+
+  if(header->next) {
+    header->next->prev = header->prev;
+  }
+#endif
+}
+
+static void track_block(MemoryHeader* header) {
+  s_state.alloc_count.fetch_add(1, std::memory_order_relaxed);
+  s_state.tags[header->tag].live_blocks.fetch_add(1, std::memory_order_relaxed);
+
+  add_live_bytes(header, header->size);
+  link_block(header);
+}
+
+static void untrack_block(MemoryHeader* header) {
+  MemoryTagState& tag = s_state.tags[header->tag];
+
+  s_state.alloc_count.fetch_sub(1, std::memory_order_relaxed);
+  s_state.free_count.fetch_add(1, std::memory_order_relaxed);
+
+  tag.live_blocks.fetch_sub(1, std::memory_order_relaxed);
+  tag.live_bytes.fetch_sub(header->size, std::memory_order_relaxed);
+
+  unlink_block(header);
+}
+
+/// Private functions
+/// ---------------------------------------------------------------------
+
 /// ---------------------------------------------------------------------
 /// Memory functions
 
 void* memory_allocate(const sizei size) {
-  NIKOLA_ASSERT((size >= 0), "Cannot allocate a memory block of size 0");
+  return memory_allocate_tagged(size, MEMORY_TAG_GENERAL);
+}
 
-  void* ptr = malloc(size);
-  NIKOLA_ASSERT(ptr, "Could not allocate any more memory!");
+void* memory_allocate_tagged(const sizei size, const MemoryTag tag, const char* file, const u32 line) {
+  NIKOLA_ASSERT(((tag >= MEMORY_TAG_GENERAL) && (tag < MEMORY_TAGS_MAX)), "Invalid MemoryTag given to memory_allocate_tagged");
 
-  // Initialize the memory to zero for convenience
-  memory_zero(ptr, size);
+  MemoryHeader* header = (MemoryHeader*)malloc(sizeof(MemoryHeader) + size);
+  NIKOLA_ASSERT(header, "Could not allocate any more memory!");
 
-  s_state.alloc_count++;
-  s_state.alloc_total_bytes += size;
+  header->size  = size;
+  header->tag   = (u32)tag;
+  header->magic = MEMORY_HEADER_MAGIC;
 
-  return ptr;
+#if NIKOLA_MEMORY_TRACKING_ACTIVE == 1
+  header->file = file;
+  header->line = line;
+#endif
+
+  track_block(header);
+  
+  // Initialize the memory to zero for convenience
+  void* ptr = (u8*)header + sizeof(MemoryHeader);
+  return memory_zero(ptr, size);
 }
 
 void* memory_reallocate(void* ptr, const sizei new_size) {
-  void* temp_ptr = realloc(ptr, new_size);
+  NIKOLA_ASSERT(ptr, "Cannot reallocate an invalid pointer!");
+  
+  MemoryHeader* header = get_header(ptr);
+  sizei old_size       = header->size;
 
-  NIKOLA_ASSERT(temp_ptr, "Could not allocate any more memory!");
-  ptr = temp_ptr;
+  // The block might move, so it cannot stay in the list of live blocks in the meantime
+  unlink_block(header);
 
-  // Initialize the memory to zero for convenience
-  memory_zero(ptr, new_size);
-  
-  s_state.alloc_count++;
-  s_state.alloc_total_bytes += new_size;
+  MemoryHeader* temp_header = (MemoryHeader*)realloc(header, sizeof(MemoryHeader) + new_size);
+  NIKOLA_ASSERT(temp_header, "Could not allocate any more memory!");
   
-  return ptr;
+  header       = temp_header;
+  header->size = new_size;
+  link_block(header);
+
+  // Still the same block, only with a different size
+  if(new_size >= old_size) {
+    add_live_bytes(header, new_size - old_size);
+  }
+  else {
+    s_state.tags[header->tag].live_bytes.fetch_sub(old_size - new_size, std::memory_order_relaxed);
+  }
+
+  return (u8*)header + sizeof(MemoryHeader);
 }
 
 void* memory_set(void* ptr, const i32 value, const sizei ptr_size) {
@@ -63,16 +241,7 @@ void* memory_zero(void* ptr, const sizei ptr_size) {
 }
 
 void* memory_blocks_allocate(const sizei count, const sizei block_size) {
-  void* ptr = calloc(count, block_size);
-  NIKOLA_ASSERT(ptr, "Could not allocate any more memory!");
-  
-  // Initialize the memory to zero for convenience
-  memory_zero(ptr, count * block_size);
-
-  s_state.alloc_count++;
-  s_state.alloc_total_bytes += (count * block_size);
-
-  return ptr;
+  return memory_allocate_tagged(count * block_size, MEMORY_TAG_GENERAL);
 }
 
 void* memory_copy(void* dest, const void* src, const sizei src_size) {
@@ -86,10 +255,13 @@ void* memory_copy(void* dest, const void* src, const sizei src_size) {
 
 void memory_free(void* ptr) {
   NIKOLA_ASSERT(ptr, "Cannot free an invalid pointer!");
-  free(ptr);
+ 
+  MemoryHeader* header = get_header(ptr);
+  untrack_block(header);
 
-  s_state.alloc_count--;
-  s_state.free_count++;
+  // Poison the magic number to catch double frees
+  header->magic = 0;
+  free(header);
 }
 
 const sizei memory_get_allocations_count() {
@@ -101,12 +273,328 @@ const sizei memory_get_frees_count() {
 }
 
 const sizei memory_get_allocation_bytes() {
-  return s_state.alloc_total_bytes;
+  sizei total = 0;
+  for(sizei i = 0; i < MEMORY_TAGS_MAX; i++) {
+    total += s_state.tags[i].live_bytes.load(std::memory_order_relaxed);
+  }
+
+  return total;
+}
+
+void memory_set_budget(const MemoryTag tag, const sizei budget_bytes) {
+  NIKOLA_ASSERT(((tag >= MEMORY_TAG_GENERAL) && (tag < MEMORY_TAGS_MAX)), "Invalid MemoryTag given to memory_set_budget");
+  s_state.tags[tag].budget_bytes = budget_bytes;
+}
+
+const MemoryTagStats memory_get_tag_stats(const MemoryTag tag) {
+  NIKOLA_ASSERT(((tag >= MEMORY_TAG_GENERAL) && (tag < MEMORY_TAGS_MAX)), "Invalid MemoryTag given to memory_get_tag_stats");
+  MemoryTagState& state = s_state.tags[tag];
+
+  return MemoryTagStats {
+    .live_bytes   = state.live_bytes.load(std::memory_order_relaxed),
+    .peak_bytes   = state.peak_bytes.load(std::memory_order_relaxed),
+    .budget_bytes = state.budget_bytes.load(std::memory_order_relaxed),
+    .live_blocks  = state.live_blocks.load(std::memory_order_relaxed),
+  };
+}
+
+const char* memory_tag_str(const MemoryTag tag) {
+  switch(tag) {
+    case MEMORY_TAG_GENERAL:
+      return "GENERAL";
+    case MEMORY_TAG_GFX:
+      return "GFX";
+    case MEMORY_TAG_RESOURCES:
+      return "RESOURCES";
+    case MEMORY_TAG_PHYSICS:
+      return "PHYSICS";
+    case MEMORY_TAG_AUDIO:
+      return "AUDIO";
+    case MEMORY_TAG_NBR:
+      return "NBR";
+    case MEMORY_TAG_APP:
+      return "APP";
+    default:
+      return "INVALID MEMORY TAG";
+  }
+}
+
+void memory_report() {
+  NIKOLA_LOG_INFO("Memory report:");
+  
+  for(sizei i = 0; i < MEMORY_TAGS_MAX; i++) {
+    MemoryTagStats stats = memory_get_tag_stats((MemoryTag)i);
+    NIKOLA_LOG_INFO("     %-9s = %zu live bytes in %zu blocks (peak = %zu bytes, budget = %zu bytes)", 
+                    memory_tag_str((MemoryTag)i), stats.live_bytes, stats.live_blocks, stats.peak_bytes, stats.budget_bytes);
+  }
+
+#if NIKOLA_MEMORY_TRACKING_ACTIVE == 1
+  std::lock_guard<std::mutex> lock(s_state.blocks_mutex);
+
+  // Don't flood the logs. A few leaks should be enough to find the culprit. 
+  // Any more than that would get rate limited by the logger anyway.
+  const sizei max_reported = LOGGER_RATE_BURST;
+  sizei leaks_count        = 0;
+
+  for(MemoryHeader* header = s_state.blocks_head; header; header = header->next) {
+    if(leaks_count < max_reported) {
+      NIKOLA_LOG_WARN("Unfreed block of %zu bytes (%s) allocated at \'%s:%zu\'", 
+                      header->size, 
+                      memory_tag_str((MemoryTag)header->tag), 
+                      header->file ? header->file : "unknown", 
+                      header->line);
+    }
+
+    leaks_count++;
+  }
+
+  if(leaks_count > max_reported) {
+    NIKOLA_LOG_WARN("...and %zu more unfreed blocks", leaks_count - max_reported);
+  }
+#endif
 }
 
 /// Memory functions
 /// ---------------------------------------------------------------------
 
+/// ---------------------------------------------------------------------
+/// MemoryArena functions
+
+MemoryArena* memory_arena_create(const sizei capacity, const MemoryTag tag) {
+  NIKOLA_ASSERT((capacity > 0), "Cannot create a MemoryArena with a capacity of 0");
+
+  MemoryArena* arena = new MemoryArena();
+  arena->data        = (u8*)memory_allocate_tagged(capacity, tag);
+  arena->capacity    = capacity;
+
+  return arena;
+}
+
+void memory_arena_destroy(MemoryArena* arena) {
+  NIKOLA_ASSERT(arena, "Cannot destroy an invalid MemoryArena");
+
+  memory_free(arena->data);
+  delete arena;
+}
+
+void* memory_arena_push(MemoryArena* arena, const sizei size, const sizei alignment) {
+  NIKOLA_ASSERT(arena, "Cannot push into an invalid MemoryArena");
+  NIKOLA_ASSERT(((alignment & (alignment - 1)) == 0), "MemoryArena alignment must be a power of 2");
+
+  sizei offset = arena->offset.load(std::memory_order_relaxed);
+  sizei start, end;
+
+  // Bump the offset. Another thread might have bumped it in the meantime, 
+  // which is why this has to be retried until it succeeds.
+  do {
+    start = (offset + (alignment - 1)) & ~(alignment - 1);
+    end   = start + size;
+
+    if(end > arena->capacity) {
+      arena->overflows_count.fetch_add(1, std::memory_order_relaxed);
+      NIKOLA_LOG_ERROR("MemoryArena ran out of memory. Requested %zu bytes with %zu/%zu bytes in use", size, offset, arena->capacity);
+
+      return nullptr;
+    }
+  } while(!arena->offset.compare_exchange_weak(offset, end, std::memory_order_relaxed));
+
+  arena->allocations_count.fetch_add(1, std::memory_order_relaxed);
+
+  // Keep track of the high-water mark
+  sizei peak = arena->peak_bytes.load(std::memory_order_relaxed);
+  while((end > peak) && !arena->peak_bytes.compare_exchange_weak(peak, end, std::memory_order_relaxed)) {}
+
+  return arena->data + start;
+}
+
+void memory_arena_reset(MemoryArena* arena) {
+  NIKOLA_ASSERT(arena, "Cannot reset an invalid MemoryArena");
+
+  arena->offset            = 0;
+  arena->allocations_count = 0;
+}
+
+const MemoryArenaStats memory_arena_get_stats(const MemoryArena* arena) {
+  NIKOLA_ASSERT(arena, "Cannot retrieve the stats of an invalid MemoryArena");
+
+  return MemoryArenaStats {
+    .capacity          = arena->capacity, 
+    .used_bytes        = arena->offset.load(std::memory_order_relaxed),
+    .peak_bytes        = arena->peak_bytes.load(std::memory_order_relaxed),
+    .allocations_count = arena->allocations_count.load(std::memory_order_relaxed),
+    .overflows_count   = arena->overflows_count.load(std::memory_order_relaxed),
+  };
+}
+
+const MemoryArenaTemp memory_arena_temp_begin(MemoryArena* arena) {
+  NIKOLA_ASSERT(arena, "Cannot begin a temporary arena from an invalid MemoryArena");
+
+  return MemoryArenaTemp {
+    .arena  = arena, 
+    .offset = arena->offset.load(std::memory_order_relaxed),
+  };
+}
+
+void memory_arena_temp_end(const MemoryArenaTemp& temp) {
+  NIKOLA_ASSERT(temp.arena, "Cannot end a temporary arena with an invalid MemoryArena");
+  NIKOLA_ASSERT((temp.offset <= temp.arena->offset), "Temporary arenas must be ended in the reverse order they were started");
+
+  temp.arena->offset = temp.offset;
+}
+
+/// MemoryArena functions
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// Frame arena functions
+
+void memory_frame_arena_init(const sizei capacity) {
+  NIKOLA_ASSERT(!s_frame_arena, "Cannot initialize the frame arena more than once");
+  s_frame_arena = memory_arena_create(capacity);
+}
+
+void memory_frame_arena_shutdown() {
+  if(!s_frame_arena) {
+    return;
+  }
+
+  MemoryArenaStats stats = memory_arena_get_stats(s_frame_arena);
+  NIKOLA_LOG_DEBUG("Frame arena peaked at %zu/%zu bytes", stats.peak_bytes, stats.capacity);
+
+  memory_arena_destroy(s_frame_arena);
+  s_frame_arena = nullptr;
+}
+
+MemoryArena* memory_frame_arena_get() {
+  return s_frame_arena;
+}
+
+void* memory_frame_allocate(const sizei size) {
+  NIKOLA_ASSERT(s_frame_arena, "Cannot allocate from an uninitialized frame arena");
+
+  void* ptr = memory_arena_push(s_frame_arena, size);
+  NIKOLA_ASSERT(ptr, "The frame arena ran out of memory!");
+
+  // Initialize the memory to zero for convenience (just like `memory_allocate`)
+  return memory_zero(ptr, size);
+}
+
+void memory_frame_free([[maybe_unused]] void* ptr) {
+  // Blocks from the frame arena get reclaimed in `memory_frame_reset`
+}
+
+void memory_frame_reset() {
+  NIKOLA_ASSERT(s_frame_arena, "Cannot reset an uninitialized frame arena");
+  memory_arena_reset(s_frame_arena);
+}
+
+/// Frame arena functions
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// MemoryPool functions
+
+MemoryPool* memory_pool_create(const sizei block_size, const sizei blocks_per_chunk, const MemoryTag tag) {
+  NIKOLA_ASSERT((block_size > 0), "Cannot create a MemoryPool with a block size of 0");
+  NIKOLA_ASSERT((blocks_per_chunk > 0), "Cannot create a MemoryPool with 0 blocks per chunk");
+
+  MemoryPool* pool = new MemoryPool();
+
+  // Every block must be able to hold the free list pointer and stay aligned
+  sizei size             = block_size < sizeof(void*) ? sizeof(void*) : block_size;
+  pool->block_size       = (size + (MEMORY_DEFAULT_ALIGNMENT - 1)) & ~(MEMORY_DEFAULT_ALIGNMENT - 1);
+  pool->blocks_per_chunk = blocks_per_chunk;
+  pool->tag              = tag;
+
+  return pool;
+}
+
+void memory_pool_destroy(MemoryPool* pool) {
+  NIKOLA_ASSERT(pool, "Cannot destroy an invalid MemoryPool");
+
+  if(pool->used_blocks > 0) {
+    NIKOLA_LOG_WARN("Destroying a MemoryPool with %zu blocks still in use", pool->used_blocks);
+  }
+
+  // Free all the chunks
+  u8* chunk = pool->chunks;
+  while(chunk) {
+    u8* prev = *(u8**)chunk;
+    memory_free(chunk);
+
+    chunk = prev;
+  }
+
+  delete pool;
+}
+
+void* memory_pool_allocate(MemoryPool* pool) {
+  NIKOLA_ASSERT(pool, "Cannot allocate from an invalid MemoryPool");
+  
+  std::lock_guard<std::mutex> lock(pool->mutex);
+
+  // Out of blocks. Time to grow.
+  if(!pool->free_list) {
+    // The chunk header is padded so that the blocks stay aligned
+    sizei header_size = MEMORY_DEFAULT_ALIGNMENT;
+    u8* chunk         = (u8*)memory_allocate_tagged(header_size + (pool->block_size * pool->blocks_per_chunk), pool->tag);
+
+    *(u8**)chunk = pool->chunks;
+    pool->chunks = chunk;
+
+    // Thread the new blocks into the free list (in order, for better locality)
+    u8* blocks = chunk + header_size;
+    for(sizei i = 0; i < pool->blocks_per_chunk; i++) {
+      void* next = (i + 1) < pool->blocks_per_chunk ? (blocks + ((i + 1) * pool->block_size)) : nullptr;
+      *(void**)(blocks + (i * pool->block_size)) = next;
+    }
+
+    pool->free_list     = blocks;
+    pool->blocks_count += pool->blocks_per_chunk;
+    pool->chunks_count++;
+  }
+
+  // Pop a block from the free list
+  void* block     = pool->free_list;
+  pool->free_list = *(void**)block;
+
+  pool->used_blocks++;
+  pool->peak_blocks = pool->used_blocks > pool->peak_blocks ? pool->used_blocks : pool->peak_blocks;
+
+  // Initialize the memory to zero for convenience
+  return memory_zero(block, pool->block_size);
+}
+
+void memory_pool_free(MemoryPool* pool, void* ptr) {
+  NIKOLA_ASSERT(pool, "Cannot free into an invalid MemoryPool");
+  NIKOLA_ASSERT(ptr, "Cannot free an invalid pointer!");
+  
+  std::lock_guard<std::mutex> lock(pool->mutex);
+
+  // Push the block back into the free list
+  *(void**)ptr    = pool->free_list;
+  pool->free_list = ptr;
+
+  pool->used_blocks--;
+}
+
+const MemoryPoolStats memory_pool_get_stats(MemoryPool* pool) {
+  NIKOLA_ASSERT(pool, "Cannot retrieve the stats of an invalid MemoryPool");
+  
+  std::lock_guard<std::mutex> lock(pool->mutex);
+
+  return MemoryPoolStats {
+    .block_size   = pool->block_size, 
+    .blocks_count = pool->blocks_count, 
+    .used_blocks  = pool->used_blocks, 
+    .peak_blocks  = pool->peak_blocks, 
+    .chunks_count = pool->chunks_count,
+  };
+}
+
+/// MemoryPool functions
+/// ---------------------------------------------------------------------
+
 } // End of nikola
 
 //////////////////////////////////////////////////////////////////////////
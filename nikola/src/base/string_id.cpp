@@ -0,0 +1,87 @@
+#include "nikola/nikola_base.h"
+#include "nikola/nikola_containers.h"
+
+#include <cstring>
+#include <mutex>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace nikola { // Start of nikola
+
+/// ---------------------------------------------------------------------
+/// StringTable
+struct StringTable {
+  std::mutex mutex;
+  HashMap<u64, char*> strings;
+};
+
+static StringTable s_table;
+/// StringTable
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// StringID functions
+
+StringID string_id_intern(const char* str) {
+  NIKOLA_ASSERT(str, "Cannot intern an invalid string");
+
+  sizei length = strlen(str);
+  u64 hash     = string_id_hash(str, length);
+
+  std::lock_guard<std::mutex> lock(s_table.mutex);
+
+  // Already interned
+  auto entry = s_table.strings.find(hash);
+  if(entry != s_table.strings.end()) {
+    NIKOLA_ASSERT((strcmp(entry->second, str) == 0), "StringID collision. Two different strings share the same hash!");
+
+    StringID id;
+    id.hash = hash;
+    id.str  = entry->second;
+
+    return id;
+  }
+
+  // Keep our own copy of the string around
+  char* copy = (char*)memory_allocate(length + 1);
+  memory_copy(copy, str, length);
+
+  s_table.strings[hash] = copy;
+
+  StringID id;
+  id.hash = hash;
+  id.str  = copy;
+
+  return id;
+}
+
+const char* string_id_str(const StringID& id) {
+  if(id.str) {
+    return id.str;
+  }
+
+  std::lock_guard<std::mutex> lock(s_table.mutex);
+
+  auto entry = s_table.strings.find(id.hash);
+  if(entry != s_table.strings.end()) {
+    return entry->second;
+  }
+
+  return "<unknown StringID>";
+}
+
+void string_id_shutdown() {
+  std::lock_guard<std::mutex> lock(s_table.mutex);
+
+  for(auto& [hash, str] : s_table.strings) {
+    memory_free(str);
+  }
+  s_table.strings.destroy();
+}
+
+/// StringID functions
+/// ---------------------------------------------------------------------
+
+} // End of nikola
+
+//////////////////////////////////////////////////////////////////////////
@@ -45,6 +45,11 @@ static void error_callback(int err_code, const char* desc) {
   NIKOLA_LOG_FATAL("%s", desc);
 }
 
+static void offscreen_error_callback(int err_code, const char* desc) {
+  // Failing to create one kind of offscreen context is fine as long as the fallback works
+  NIKOLA_LOG_WARN("%s", desc);
+}
+
 static void window_pos_callback(GLFWwindow* handle, int xpos, int ypos) {
   Window* window = (Window*)glfwGetWindowUserPointer(handle);
 
@@ -110,14 +115,15 @@ static void window_close_callback(GLFWwindow* window) {
 }
 
 static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+  // Every input event goes through the queue, so it keeps its order with the (coalesced) cursor moves
   if(action == GLFW_PRESS) {
-    event_dispatch(Event {
+    event_post(Event {
       .type = EVENT_KEY_PRESSED, 
       .key_pressed = key,
     });
   }
   else if(action == GLFW_RELEASE) {
-    event_dispatch(Event {
+    event_post(Event {
       .type = EVENT_KEY_RELEASED, 
       .key_released = key,
     });
@@ -126,13 +132,13 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
 
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
   if(action == GLFW_PRESS) {
-    event_dispatch(Event {
+    event_post(Event {
       .type = EVENT_MOUSE_BUTTON_PRESSED, 
       .mouse_button_pressed = button,
     });
   }
   else if(action == GLFW_RELEASE) {
-    event_dispatch(Event {
+    event_post(Event {
       .type = EVENT_MOUSE_BUTTON_RELEASED, 
       .mouse_button_released = button,
     });
@@ -154,7 +160,8 @@ void cursor_pos_callback(GLFWwindow* handle, double xpos, double ypos) {
   window->mouse_offset_x += offset_x;
   window->mouse_offset_y += offset_y;
 
-  event_dispatch(Event {
+  // The cursor can move many times in a single poll, so these get coalesced in the queue
+  event_post(Event {
     .type = EVENT_MOUSE_MOVED, 
     .mouse_pos_x = (f32)window->mouse_position_x, 
     .mouse_pos_y = (f32)window->mouse_position_y, 
@@ -165,13 +172,13 @@ void cursor_pos_callback(GLFWwindow* handle, double xpos, double ypos) {
 }
 
 void cursor_enter_callback(GLFWwindow* window, int entered) {
-  event_dispatch(Event {
+  event_post(Event {
     .type = entered == GLFW_TRUE ? EVENT_MOUSE_ENTER : EVENT_MOUSE_LEAVE,
   });
 }
 
 void scroll_wheel_callback(GLFWwindow* window, double xoffset, double yoffset) {
-  event_dispatch(Event {
+  event_post(Event {
     .type = EVENT_MOUSE_SCROLL_WHEEL, 
     .mouse_scroll_value = (f32)yoffset,
   });
@@ -271,14 +278,48 @@ static void set_window_hints(Window* window) {
   if(IS_BIT_SET(window->flags, WINDOW_FLAGS_FULLSCREEN)) {
     window->is_fullscreen = true; 
   }
+
+  if(IS_BIT_SET(window->flags, WINDOW_FLAGS_OFFSCREEN)) {
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_SAMPLES, 0); 
+    
+    // Software rasterizers (i.e, llvmpipe) top out at OpenGL 4.5
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+
+    window->is_fullscreen   = false; 
+    window->is_cursor_shown = true;
+  }
+}
+
+static void create_offscreen_handle(Window* window, const char* title) {
+  // Try OSMesa first, since it works on CPU-only Mesa installs
+  glfwSetErrorCallback(offscreen_error_callback); 
+  window->handle = glfwCreateWindow(window->width, window->height, title, nullptr, nullptr);
+  
+  // Otherwise, surfaceless EGL
+  if(!window->handle) {
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+    
+    glfwSetErrorCallback(error_callback); 
+    window->handle = glfwCreateWindow(window->width, window->height, title, nullptr, nullptr);
+  }
+
+  glfwSetErrorCallback(error_callback); 
 }
 
 static void create_glfw_handle(Window* window, const char* title) {
   // Creating the window
-  window->handle = glfwCreateWindow(window->width, window->height, title, nullptr, nullptr);
+  if(IS_BIT_SET(window->flags, WINDOW_FLAGS_OFFSCREEN)) {
+    create_offscreen_handle(window, title);
+  }
+  else {
+    window->handle = glfwCreateWindow(window->width, window->height, title, nullptr, nullptr);
+  }
 
   // Setting the new refresh rate
-  window->refresh_rate = glfwGetVideoMode(glfwGetPrimaryMonitor())->refreshRate;
+  GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+  window->refresh_rate = monitor ? glfwGetVideoMode(monitor)->refreshRate : 60.0f;
 }
 
 static void set_window_callbacks(Window* window) {
@@ -320,6 +361,11 @@ Window* window_open(const char* title, const i32 width, const i32 height, i32 fl
   window->flags  = (WindowFlags)flags;
 
   // GLFW init and setup 
+  // 
+  // An offscreen window does not need (nor might have) a display to connect to
+  if(IS_BIT_SET(window->flags, WINDOW_FLAGS_OFFSCREEN)) {
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+  }
   glfwInit();
   set_window_hints(window);
   create_glfw_handle(window, title);
@@ -380,6 +426,9 @@ void window_poll_events(Window* window) {
 
   // Poll for events
   glfwPollEvents();
+
+  // Dispatch anything posted since the last frame
+  event_process_queue();
 }
 
 void window_swap_buffers(Window* window, const i32 interval) {
@@ -444,6 +493,10 @@ void window_set_current_context(Window* window) {
   glfwMakeContextCurrent(window->handle);
 }
 
+void* window_get_proc_address(const char* name) {
+  return (void*)glfwGetProcAddress(name);
+}
+
 void window_set_fullscreen(Window* window, const bool fullscreen) {
   window->is_fullscreen = fullscreen; 
   const GLFWvidmode* video_mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
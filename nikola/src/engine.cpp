@@ -1,9 +1,16 @@
 #include "nikola/nikola_app.h"
 #include "nikola/nikola_base.h"
+#include "nikola/nikola_event.h"
+#include "nikola/nikola_input.h"
 #include "nikola/nikola_render.h"
 #include "nikola/nikola_resources.h"
 #include "nikola/nikola_timer.h"
 #include "nikola/nikola_physics.h"
+#include "nikola/nikola_profiler.h"
+
+#include <cmath>
+#include <thread>
+#include <chrono>
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -18,6 +25,13 @@ struct Engine {
   Window* window;
   GfxContext* gfx_context;
 
+  f64 fixed_delta_time = 0.0;
+  f64 accumulator      = 0.0;
+
+  GfxFence* frame_fences[FRAMES_IN_FLIGHT_MAX];
+  u32 frames_in_flight = 0;
+  u64 frame_index      = 0;
+
   bool is_running;
 };
 
@@ -33,6 +47,121 @@ static Engine s_engine;
 /// Macros
 /// ----------------------------------------------------------------------
 
+/// ----------------------------------------------------------------------
+/// Callbacks
+
+static bool quit_app_callback(const Event& event, const void* dispatcher, const void* listener) {
+  if(event.type != EVENT_APP_QUIT) {
+    return false;
+  }
+
+  s_engine.is_running = false;
+  return true;
+}
+
+/// Callbacks
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static bool is_engine_running() {
+  if(s_engine.app_desc.is_headless) {
+    return s_engine.is_running;
+  }
+
+  return s_engine.is_running && window_is_open(s_engine.window);
+}
+
+static void poll_events() {
+  // Without a window, only the internal systems need an update
+  if(s_engine.app_desc.is_headless) {
+    input_update(true);
+    niclock_update();
+    event_process_queue();
+  }
+  else {
+    window_poll_events(s_engine.window);
+  }
+
+  // A replayed session is over as soon as its input is
+  if(!s_engine.app_desc.input_replay_path.empty() && !input_is_replaying()) {
+    event_dispatch(Event{.type = EVENT_APP_QUIT});
+  }
+}
+
+static void wait_for_frame_fence() {
+  if(s_engine.frames_in_flight == 0) {
+    return;
+  }
+
+  NIKOLA_PROFILE_SCOPE("Wait for GPU");
+
+  // Wait on the frame that was using this slot `frames_in_flight` frames ago
+  GfxFence* fence = s_engine.frame_fences[s_engine.frame_index % s_engine.frames_in_flight];
+  if(!gfx_fence_wait(fence, 1000000000)) {
+    NIKOLA_LOG_WARN("The GPU took more than a second to finish a frame");
+  }
+}
+
+static void insert_frame_fence() {
+  if(s_engine.frames_in_flight == 0) {
+    return;
+  }
+
+  gfx_fence_insert(s_engine.frame_fences[s_engine.frame_index % s_engine.frames_in_flight]);
+}
+
+static void limit_frame_rate(const f64 frame_start) {
+  if(s_engine.app_desc.frame_rate_limit <= 0.0) {
+    return;
+  }
+
+  NIKOLA_PROFILE_SCOPE("Frame limiter");
+
+  f64 target_time = frame_start + (1.0 / s_engine.app_desc.frame_rate_limit);
+  f64 remaining   = target_time - niclock_get_time();
+
+  // Sleeping is not very accurate, so sleep for most of the 
+  // remaining time and then spin the rest of the way.
+  const f64 spin_time = 0.002;
+  if(remaining > spin_time) {
+    std::this_thread::sleep_for(std::chrono::duration<f64>(remaining - spin_time));
+  }
+
+  while(niclock_get_time() < target_time) {
+    std::this_thread::yield();
+  }
+}
+
+static f64 run_fixed_updates() {
+  s_engine.accumulator += niclock_get_delta_time();
+
+  u32 steps = 0;
+  while(s_engine.accumulator >= s_engine.fixed_delta_time) {
+    // Too far behind. Drop the rest of the time instead of trying to catch up.
+    if(steps >= s_engine.app_desc.fixed_updates_max) {
+      s_engine.accumulator = fmod(s_engine.accumulator, s_engine.fixed_delta_time);
+      break;
+    }
+
+    // Physics step
+    physics_world_step(); 
+
+    // App fixed update
+    CHECK_VALID_CALLBACK(s_engine.app_desc.fixed_update_fn, s_engine.app, s_engine.fixed_delta_time);
+
+    s_engine.accumulator -= s_engine.fixed_delta_time;
+    steps++;
+  }
+
+  // How far along we are between the last fixed update and the next one
+  return s_engine.accumulator / s_engine.fixed_delta_time;
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// Engine functions
 
@@ -44,28 +173,47 @@ void engine_init(const AppDesc& desc) {
   s_engine.app_desc   = desc; 
   s_engine.is_running = true;
 
+  NIKOLA_ASSERT((desc.fixed_update_rate > 0.0), "The fixed update rate must be greater than zero");
+  s_engine.fixed_delta_time = 1.0 / desc.fixed_update_rate;
+  s_engine.accumulator      = 0.0;
+
   // Library init 
   NIKOLA_ASSERT(init(), "Failed to initialize Nikola");
  
   // Window init 
-  s_engine.window = window_open(desc.window_title.c_str(), desc.window_width, desc.window_height, desc.window_flags);
-  NIKOLA_ASSERT(s_engine.window, "Failed to open a window");
+  s_engine.window = nullptr;
+  if(!desc.is_headless) {
+    s_engine.window = window_open(desc.window_title.c_str(), desc.window_width, desc.window_height, desc.window_flags);
+    NIKOLA_ASSERT(s_engine.window, "Failed to open a window");
+  }
+  event_listen(EVENT_APP_QUIT, quit_app_callback);
 
   // Audio init
-  audio_device_init(nullptr);
+  audio_device_init(nullptr, desc.is_headless);
 
   // Resource manager init 
   resource_manager_init();
 
   // Renderer init 
-  renderer_init(s_engine.window);
+  if(desc.is_headless) {
+    renderer_init_headless(desc.window_width, desc.window_height);
+  }
+  else {
+    renderer_init(s_engine.window);
+  }
   s_engine.gfx_context = renderer_get_context();
 
+  // Frame fences init
+  s_engine.frames_in_flight = desc.frames_in_flight > FRAMES_IN_FLIGHT_MAX ? FRAMES_IN_FLIGHT_MAX : desc.frames_in_flight;
+  for(u32 i = 0; i < s_engine.frames_in_flight; i++) {
+    s_engine.frame_fences[i] = gfx_fence_create(s_engine.gfx_context);
+  }
+
   // Batch renderer init
   batch_renderer_init();
 
   // Physics world init
-  physics_world_init(Vec3(0.0f, -9.81f, 0.0f), 1 / 60.0f);
+  physics_world_init(Vec3(0.0f, -9.81f, 0.0f), (f32)s_engine.fixed_delta_time);
 
   // Check for any command line arguments
   Args cli_args; 
@@ -80,41 +228,91 @@ void engine_init(const AppDesc& desc) {
   s_engine.app = s_engine.app_desc.init_fn(cli_args, s_engine.window);
   NIKOLA_PERF_TIMER_END(timer, "app_init");
 
+  // Input recording/replay
+  if(!desc.input_record_path.empty()) {
+    input_record_begin(desc.input_record_path.c_str());
+  }
+
+  if(!desc.input_replay_path.empty() && !input_replay_begin(desc.input_replay_path.c_str())) {
+    s_engine.is_running = false;
+  }
+
   NIKOLA_LOG_INFO("Successfully initialized the application \'%s\'", desc.window_title.c_str());
 }
 
 void engine_run() {
-  while(window_is_open(s_engine.window)) {
-    // Physics step
-    physics_world_step(); 
+  while(is_engine_running()) {
+    NIKOLA_PROFILE_FRAME();
+    NIKOLA_PROFILE_SCOPE("Frame");
+
+    f64 frame_start = niclock_get_time();
+
+    // Fixed updates (physics included)
+    f64 alpha = 0.0;
+    {
+      NIKOLA_PROFILE_SCOPE("Fixed updates");
+      alpha = run_fixed_updates();
+    }
 
     // App update
-    CHECK_VALID_CALLBACK(s_engine.app_desc.update_fn, s_engine.app, niclock_get_delta_time());
+    {
+      NIKOLA_PROFILE_SCOPE("App update");
+      CHECK_VALID_CALLBACK(s_engine.app_desc.update_fn, s_engine.app, niclock_get_delta_time());
+    }
+
+    // Don't get too far ahead of the GPU
+    wait_for_frame_fence();
 
     // App render
-    CHECK_VALID_CALLBACK(s_engine.app_desc.render_fn, s_engine.app);
+    {
+      NIKOLA_PROFILE_SCOPE("App render");
+      CHECK_VALID_CALLBACK(s_engine.app_desc.render_fn, s_engine.app, alpha);
+    }
 
     // App render GUI 
-    CHECK_VALID_CALLBACK(s_engine.app_desc.render_gui_fn, s_engine.app);
+    {
+      NIKOLA_PROFILE_SCOPE("App render GUI");
+      CHECK_VALID_CALLBACK(s_engine.app_desc.render_gui_fn, s_engine.app);
+    }
 
     // Present to the backbuffer
-    gfx_context_present(s_engine.gfx_context); 
+    {
+      NIKOLA_PROFILE_SCOPE("Present");
+      gfx_context_present(s_engine.gfx_context); 
+    }
+    insert_frame_fence();
+
+    // Keep the frame rate in check
+    limit_frame_rate(frame_start);
 
     // Poll for window events
-    window_poll_events(s_engine.window);
+    {
+      NIKOLA_PROFILE_SCOPE("Poll events");
+      poll_events();
+    }
+
+    // Reclaim anything allocated for this frame
+    memory_frame_reset();
+    s_engine.frame_index++;
   }
 }
 
 void engine_shutdown() {
   CHECK_VALID_CALLBACK(s_engine.app_desc.shutdown_fn, s_engine.app);
 
+  for(u32 i = 0; i < s_engine.frames_in_flight; i++) {
+    gfx_fence_destroy(s_engine.frame_fences[i]);
+  }
+
   physics_world_shutdown();
   batch_renderer_shutdown();
-  renderer_shutdown();
   resource_manager_shutdown();
+  renderer_shutdown();
   audio_device_shutdown();
 
-  window_close(s_engine.window);
+  if(s_engine.window) {
+    window_close(s_engine.window);
+  }
   shutdown();
   
   NIKOLA_LOG_INFO("Appication \'%s\' was successfully shutdown", s_engine.app_desc.window_title.c_str());
@@ -320,9 +320,10 @@ void file_read_bytes(File& file, Transform* transform) {
   f32 raw_data[10];
   file_read_bytes(file, raw_data, sizeof(raw_data));
 
-  transform_translate(*transform, Vec3(raw_data[0], raw_data[1], raw_data[2]));
-  transform_scale(*transform, Vec3(raw_data[3], raw_data[4], raw_data[5]));
-  transform_rotate(*transform, Quat(raw_data[9], raw_data[6], raw_data[7], raw_data[8]));
+  transform_set_position(*transform, Vec3(raw_data[0], raw_data[1], raw_data[2]));
+  transform_set_scale(*transform, Vec3(raw_data[3], raw_data[4], raw_data[5]));
+  transform_set_rotation(*transform, Quat(raw_data[9], raw_data[6], raw_data[7], raw_data[8]));
+  transform_update(*transform);
 }
 
 void file_read_bytes(File& file, Camera* camera) {
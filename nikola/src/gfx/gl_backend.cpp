@@ -1,5 +1,7 @@
 #include "nikola/nikola_gfx.h"
 #include "nikola/nikola_event.h"
+#include "nikola/nikola_containers.h"
+#include "nikola/nikola_file.h"
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -38,6 +40,21 @@ namespace nikola { // Start of nikola
 /// Macros
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Consts
+
+/// The vertex array binding of the per-vertex elements of a pipeline.
+const u32 VERTEX_BUFFER_BINDING   = 0;
+
+/// The vertex array binding of the per-instance elements of a pipeline.
+const u32 INSTANCE_BUFFER_BINDING = 1;
+
+/// The longest uniform (or uniform block) name the shader reflection can read.
+const sizei SHADER_RESOURCE_NAME_MAX = 256;
+
+/// Consts
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// GfxContext
 struct GfxContext {
@@ -48,6 +65,8 @@ struct GfxContext {
 
   u32 default_clear_flags = 0;
   u32 current_clear_flags = 0;
+
+  GfxCommandLog* command_log = nullptr;
 };
 /// GfxContext
 ///---------------------------------------------------------------------------------------------------------------------
@@ -56,6 +75,7 @@ struct GfxContext {
 /// GfxFramebuffer
 struct GfxFramebuffer {
   GfxFramebufferDesc desc = {};
+  GfxContext* gfx         = nullptr;
   
   u32 clear_flags;
   u32 id;
@@ -76,17 +96,38 @@ struct GfxBuffer {
 
   GLenum gl_buff_type; 
   GLenum gl_buff_usage;
+
+  /// Only valid with `GFX_BUFFER_USAGE_PERSISTENT_MAP`.
+  void* mapped;
 };
 /// GfxBuffer  
 ///---------------------------------------------------------------------------------------------------------------------
 
 ///---------------------------------------------------------------------------------------------------------------------
 /// GfxShader
+struct ShaderResource {
+  StringID name; 
+
+  /// The location of a uniform, or the binding point of a uniform block.
+  i32 location;
+
+  /// The amount of elements if the uniform is an array, or `1` otherwise.
+  i32 count;
+};
+
 struct GfxShader {
   GfxContext* gfx    = nullptr;
   GfxShaderDesc desc = {};
 
   u32 id, vert_id, frag_id;
+
+  /// Every active uniform (outside of a uniform block) and uniform block, 
+  /// reflected once the program gets linked.
+  ShaderResource* uniforms = nullptr;
+  sizei uniforms_count     = 0;
+
+  ShaderResource* blocks = nullptr;
+  sizei blocks_count     = 0;
 };
 /// GfxShader
 ///---------------------------------------------------------------------------------------------------------------------
@@ -127,11 +168,153 @@ struct GfxPipeline {
   GfxBuffer* index_buffer  = nullptr; 
   sizei index_count        = 0;
 
+  GfxBuffer* instance_buffer = nullptr;
+  sizei instance_stride      = 0;
+
   GfxDrawMode draw_mode;
 };
 /// GfxPipeline
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxQuery
+struct GfxQuery {
+  GfxQueryDesc desc = {};
+  GfxContext* gfx   = nullptr;
+
+  u32 ids[QUERY_FRAMES_MAX];
+  GLenum gl_target;
+
+  /// Every issued query bumps `write_index`, and every 
+  /// result read back bumps `read_index`.
+  sizei write_index = 0;
+  sizei read_index  = 0;
+
+  u64 result = 0;
+};
+/// GfxQuery
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxFence
+struct GfxFence {
+  GfxContext* gfx = nullptr;
+  GLsync sync     = nullptr;
+};
+/// GfxFence
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxCommand
+struct GfxCommand {
+  GfxCommandType type;
+  const void* resource = nullptr;
+
+  /// Where the arguments of the command live in the payload of the log.
+  sizei payload_offset = 0;
+  sizei payload_size   = 0;
+};
+/// GfxCommand
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxCommandLog
+struct GfxCommandLog {
+  DynamicArray<GfxCommand> commands;
+  DynamicArray<u8> payload;
+
+  GfxCommandStats stats = {};
+
+  /// The context the log is attached to. Every resource in the log belongs to it.
+  GfxContext* gfx = nullptr;
+
+  /// Commands issued while replaying are not recorded back into the log.
+  bool is_replaying = false;
+};
+/// GfxCommandLog
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Command payloads
+
+struct SetStatePayload {
+  GfxStates state;
+  bool value;
+};
+
+struct FramebufferCopyPayload {
+  GfxFramebuffer* dest_frame;
+
+  i32 src_x, src_y, src_width, src_height;
+  i32 dest_x, dest_y, dest_width, dest_height;
+  i32 buffer_mask;
+};
+
+struct BufferUpdatePayload {
+  sizei offset;
+  sizei size;
+};
+
+struct BufferCopyPayload {
+  const GfxBuffer* src;
+
+  sizei dest_offset;
+  sizei src_offset;
+  sizei size;
+};
+
+struct AttachUniformPayload {
+  GfxShaderType type;
+  GfxBuffer* buffer;
+  u32 bind_point;
+};
+
+struct UploadUniformPayload {
+  i32 location;
+  sizei count;
+  GfxLayoutType type;
+};
+
+struct DrawInstancedPayload {
+  sizei instances_count;
+  sizei base_instance;
+};
+
+struct DrawIndirectPayload {
+  GfxBuffer* commands;
+
+  sizei draws_count;
+  sizei offset;
+};
+
+struct TextureUploadPayload {
+  i32 width, height, depth;
+};
+
+/// Command payloads
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxPools
+struct GfxPools {
+  MemoryPool* framebuffers = nullptr; 
+  MemoryPool* buffers      = nullptr; 
+  MemoryPool* shaders      = nullptr; 
+  MemoryPool* textures     = nullptr; 
+  MemoryPool* cubemaps     = nullptr; 
+  MemoryPool* pipelines    = nullptr; 
+  MemoryPool* queries      = nullptr; 
+
+  u32 contexts_count = 0;
+};
+
+static GfxPools s_pools;
+
+/// How many blocks each pool will grow by when it runs out.
+const sizei GFX_POOL_BLOCKS_PER_CHUNK = 256;
+/// GfxPools
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Callbacks 
 
@@ -151,6 +334,276 @@ static bool framebuffer_resize(const Event& event, const void* disp, const void*
 ///---------------------------------------------------------------------------------------------------------------------
 /// Private functions 
 
+static bool is_headless(const GfxContext* gfx) {
+  return gfx->desc.is_headless;
+}
+
+static void count_command(GfxCommandStats& stats, const GfxCommand& command, const u8* payload, const sizei data_size) {
+  stats.bytes_uploaded += data_size;
+  stats.counts[command.type]++;
+  stats.commands_count++;
+
+  switch(command.type) {
+    case GFX_COMMAND_PIPELINE_DRAW_VERTEX:
+    case GFX_COMMAND_PIPELINE_DRAW_INDEX:
+    case GFX_COMMAND_PIPELINE_DRAW_INDEX_INSTANCED:
+    case GFX_COMMAND_PIPELINE_DRAW_INDIRECT:
+      stats.draw_calls++;
+      break;
+    case GFX_COMMAND_CONTEXT_SET_STATE:
+    case GFX_COMMAND_CONTEXT_SET_TARGET:
+    case GFX_COMMAND_SHADER_USE:
+    case GFX_COMMAND_SHADER_ATTACH_UNIFORM:
+    case GFX_COMMAND_TEXTURE_USE:
+    case GFX_COMMAND_CUBEMAP_USE:
+    case GFX_COMMAND_PIPELINE_UPDATE:
+      stats.state_changes++;
+      break;
+    case GFX_COMMAND_FRAMEBUFFER_CREATE:
+    case GFX_COMMAND_SHADER_CREATE:
+    case GFX_COMMAND_TEXTURE_CREATE:
+    case GFX_COMMAND_CUBEMAP_CREATE:
+    case GFX_COMMAND_PIPELINE_CREATE:
+      stats.resources_created++;
+      break;
+    case GFX_COMMAND_BUFFER_CREATE:
+      stats.resources_created++;
+      stats.bytes_uploaded += *(const sizei*)payload;
+      break;
+    case GFX_COMMAND_FRAMEBUFFER_DESTROY:
+    case GFX_COMMAND_BUFFER_DESTROY:
+    case GFX_COMMAND_SHADER_DESTROY:
+    case GFX_COMMAND_TEXTURE_DESTROY:
+    case GFX_COMMAND_CUBEMAP_DESTROY:
+    case GFX_COMMAND_PIPELINE_DESTROY:
+      stats.resources_destroyed++;
+      break;
+    default:
+      break;
+  }
+}
+
+/// Append a command to the log of `gfx` (if it has one). The `args` are copied first, 
+/// followed by `data`, which is anything that was uploaded by the command.
+static void record_command(GfxContext* gfx, 
+                           const GfxCommandType type, 
+                           const void* resource, 
+                           const void* args = nullptr, const sizei args_size = 0, 
+                           const void* data = nullptr, const sizei data_size = 0) {
+  GfxCommandLog* log = gfx->command_log;
+  if(!log || log->is_replaying) {
+    return;
+  }
+
+  // Keep every payload aligned, since they are read back in place
+  log->payload.resize((log->payload.size() + 7) & ~(sizei)7);
+
+  GfxCommand command = {
+    .type           = type, 
+    .resource       = resource,
+    .payload_offset = log->payload.size(), 
+    .payload_size   = args_size + data_size,
+  };
+
+  const u8* args_bytes = (const u8*)args;
+  const u8* data_bytes = (const u8*)data;
+  log->payload.insert(log->payload.end(), args_bytes, args_bytes + args_size);
+  log->payload.insert(log->payload.end(), data_bytes, data_bytes + data_size);
+
+  log->commands.push_back(command);
+  count_command(log->stats, command, log->payload.data() + command.payload_offset, data_size);
+}
+
+static const char* get_command_name(const GfxCommandType type) {
+  switch(type) {
+    case GFX_COMMAND_CONTEXT_SET_STATE:
+      return "CONTEXT_SET_STATE";
+    case GFX_COMMAND_CONTEXT_SET_TARGET:
+      return "CONTEXT_SET_TARGET";
+    case GFX_COMMAND_CONTEXT_CLEAR:
+      return "CONTEXT_CLEAR";
+    case GFX_COMMAND_CONTEXT_PRESENT:
+      return "CONTEXT_PRESENT";
+    case GFX_COMMAND_FRAMEBUFFER_CREATE:
+      return "FRAMEBUFFER_CREATE";
+    case GFX_COMMAND_FRAMEBUFFER_DESTROY:
+      return "FRAMEBUFFER_DESTROY";
+    case GFX_COMMAND_FRAMEBUFFER_COPY:
+      return "FRAMEBUFFER_COPY";
+    case GFX_COMMAND_FRAMEBUFFER_UPDATE:
+      return "FRAMEBUFFER_UPDATE";
+    case GFX_COMMAND_BUFFER_CREATE:
+      return "BUFFER_CREATE";
+    case GFX_COMMAND_BUFFER_DESTROY:
+      return "BUFFER_DESTROY";
+    case GFX_COMMAND_BUFFER_UPDATE:
+      return "BUFFER_UPDATE";
+    case GFX_COMMAND_BUFFER_COPY:
+      return "BUFFER_COPY";
+    case GFX_COMMAND_SHADER_CREATE:
+      return "SHADER_CREATE";
+    case GFX_COMMAND_SHADER_DESTROY:
+      return "SHADER_DESTROY";
+    case GFX_COMMAND_SHADER_USE:
+      return "SHADER_USE";
+    case GFX_COMMAND_SHADER_UPDATE:
+      return "SHADER_UPDATE";
+    case GFX_COMMAND_SHADER_ATTACH_UNIFORM:
+      return "SHADER_ATTACH_UNIFORM";
+    case GFX_COMMAND_SHADER_UPLOAD_UNIFORM:
+      return "SHADER_UPLOAD_UNIFORM";
+    case GFX_COMMAND_TEXTURE_CREATE:
+      return "TEXTURE_CREATE";
+    case GFX_COMMAND_TEXTURE_DESTROY:
+      return "TEXTURE_DESTROY";
+    case GFX_COMMAND_TEXTURE_USE:
+      return "TEXTURE_USE";
+    case GFX_COMMAND_TEXTURE_UPDATE:
+      return "TEXTURE_UPDATE";
+    case GFX_COMMAND_TEXTURE_UPLOAD:
+      return "TEXTURE_UPLOAD";
+    case GFX_COMMAND_CUBEMAP_CREATE:
+      return "CUBEMAP_CREATE";
+    case GFX_COMMAND_CUBEMAP_DESTROY:
+      return "CUBEMAP_DESTROY";
+    case GFX_COMMAND_CUBEMAP_USE:
+      return "CUBEMAP_USE";
+    case GFX_COMMAND_CUBEMAP_UPDATE:
+      return "CUBEMAP_UPDATE";
+    case GFX_COMMAND_CUBEMAP_UPLOAD:
+      return "CUBEMAP_UPLOAD";
+    case GFX_COMMAND_PIPELINE_CREATE:
+      return "PIPELINE_CREATE";
+    case GFX_COMMAND_PIPELINE_DESTROY:
+      return "PIPELINE_DESTROY";
+    case GFX_COMMAND_PIPELINE_UPDATE:
+      return "PIPELINE_UPDATE";
+    case GFX_COMMAND_PIPELINE_DRAW_VERTEX:
+      return "PIPELINE_DRAW_VERTEX";
+    case GFX_COMMAND_PIPELINE_DRAW_INDEX:
+      return "PIPELINE_DRAW_INDEX";
+    case GFX_COMMAND_PIPELINE_DRAW_INDEX_INSTANCED:
+      return "PIPELINE_DRAW_INDEX_INSTANCED";
+    case GFX_COMMAND_PIPELINE_DRAW_INDIRECT:
+      return "PIPELINE_DRAW_INDIRECT";
+    case GFX_COMMAND_QUERY_BEGIN:
+      return "QUERY_BEGIN";
+    case GFX_COMMAND_QUERY_END:
+      return "QUERY_END";
+    case GFX_COMMAND_QUERY_TIMESTAMP:
+      return "QUERY_TIMESTAMP";
+    case GFX_COMMAND_FENCE_INSERT:
+      return "FENCE_INSERT";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+/// Resources are named by the order they first show up in, since their addresses change between runs.
+static String get_resource_name(HashMap<const void*, u32>& names, const void* resource) {
+  if(!resource) {
+    return "-";
+  }
+
+  auto it = names.find(resource);
+  if(it == names.end()) {
+    u32 name = (u32)names.size() + 1;
+    names[resource] = name;
+
+    return "#" + std::to_string(name);
+  }
+
+  return "#" + std::to_string(it->second);
+}
+
+static void append_command(String& out, HashMap<const void*, u32>& names, const sizei index, const GfxCommand& command, const u8* payload) {
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer), "%06zu %-24s %s", index, get_command_name(command.type), get_resource_name(names, command.resource).c_str());
+  out += buffer;
+
+  switch(command.type) {
+    case GFX_COMMAND_CONTEXT_SET_STATE: {
+      const SetStatePayload* args = (const SetStatePayload*)payload;
+      snprintf(buffer, sizeof(buffer), " state=0x%x value=%i", (u32)args->state, (i32)args->value);
+      out += buffer;
+    } break;
+    case GFX_COMMAND_CONTEXT_CLEAR: {
+      const f32* color = (const f32*)payload;
+      snprintf(buffer, sizeof(buffer), " color=(%.3f, %.3f, %.3f, %.3f)", color[0], color[1], color[2], color[3]);
+      out += buffer;
+    } break;
+    case GFX_COMMAND_FRAMEBUFFER_COPY: {
+      const FramebufferCopyPayload* args = (const FramebufferCopyPayload*)payload;
+      snprintf(buffer, sizeof(buffer), " dest=%s mask=0x%x", get_resource_name(names, args->dest_frame).c_str(), (u32)args->buffer_mask);
+      out += buffer;
+    } break;
+    case GFX_COMMAND_BUFFER_CREATE:
+      snprintf(buffer, sizeof(buffer), " size=%zu", *(const sizei*)payload);
+      out += buffer;
+      break;
+    case GFX_COMMAND_BUFFER_UPDATE: {
+      const BufferUpdatePayload* args = (const BufferUpdatePayload*)payload;
+      u64 hash                        = string_id_hash((const char*)(payload + sizeof(BufferUpdatePayload)), args->size);
+
+      snprintf(buffer, sizeof(buffer), " offset=%zu size=%zu hash=%016llx", args->offset, args->size, (unsigned long long)hash);
+      out += buffer;
+    } break;
+    case GFX_COMMAND_BUFFER_COPY: {
+      const BufferCopyPayload* args = (const BufferCopyPayload*)payload;
+      snprintf(buffer, sizeof(buffer), " src=%s src_offset=%zu dest_offset=%zu size=%zu", get_resource_name(names, args->src).c_str(), args->src_offset, args->dest_offset, args->size);
+      out += buffer;
+    } break;
+    case GFX_COMMAND_SHADER_ATTACH_UNIFORM: {
+      const AttachUniformPayload* args = (const AttachUniformPayload*)payload;
+      snprintf(buffer, sizeof(buffer), " buffer=%s bind_point=%u", get_resource_name(names, args->buffer).c_str(), args->bind_point);
+      out += buffer;
+    } break;
+    case GFX_COMMAND_SHADER_UPLOAD_UNIFORM: {
+      const UploadUniformPayload* args = (const UploadUniformPayload*)payload;
+      sizei size                       = command.payload_size - sizeof(UploadUniformPayload);
+      u64 hash                         = string_id_hash((const char*)(payload + sizeof(UploadUniformPayload)), size);
+
+      snprintf(buffer, sizeof(buffer), " location=%i count=%zu type=0x%x hash=%016llx", args->location, args->count, (u32)args->type, (unsigned long long)hash);
+      out += buffer;
+    } break;
+    case GFX_COMMAND_TEXTURE_USE:
+    case GFX_COMMAND_CUBEMAP_USE: {
+      const void* const* resources = (const void* const*)payload;
+      sizei count                  = command.payload_size / sizeof(void*);
+
+      out += " [";
+      for(sizei i = 0; i < count; i++) {
+        out += (i == 0 ? "" : " ") + get_resource_name(names, resources[i]);
+      }
+      out += "]";
+    } break;
+    case GFX_COMMAND_TEXTURE_UPLOAD: {
+      const TextureUploadPayload* args = (const TextureUploadPayload*)payload;
+      snprintf(buffer, sizeof(buffer), " size=%ix%ix%i", args->width, args->height, args->depth);
+      out += buffer;
+    } break;
+    case GFX_COMMAND_PIPELINE_UPDATE: {
+      const GfxPipelineDesc* desc = (const GfxPipelineDesc*)payload;
+      snprintf(buffer, sizeof(buffer), " depth_mask=%i stencil_ref=%u", (i32)desc->depth_mask, desc->stencil_ref);
+      out += buffer;
+    } break;
+    case GFX_COMMAND_PIPELINE_DRAW_INDEX_INSTANCED: {
+      const DrawInstancedPayload* args = (const DrawInstancedPayload*)payload;
+      snprintf(buffer, sizeof(buffer), " instances=%zu base=%zu", args->instances_count, args->base_instance);
+      out += buffer;
+    } break;
+    case GFX_COMMAND_PIPELINE_DRAW_INDIRECT: {
+      const DrawIndirectPayload* args = (const DrawIndirectPayload*)payload;
+      snprintf(buffer, sizeof(buffer), " commands=%s draws=%zu offset=%zu", get_resource_name(names, args->commands).c_str(), args->draws_count, args->offset);
+      out += buffer;
+    } break;
+    default:
+      break;
+  }
+
+  out += '\n';
+}
+
 static void check_supported_gl_version(const i32 major, const i32 minor) {
   NIKOLA_ASSERT((major >= NIKOLA_GL_MINIMUM_MAJOR_VERSION) && (minor >= NIKOLA_GL_MINIMUM_MINOR_VERSION), 
                "OpenGL versions less than 4.2 are not supported");
@@ -466,6 +919,8 @@ static GLenum get_buffer_type(const GfxBufferType type) {
       return GL_ELEMENT_ARRAY_BUFFER;
     case GFX_BUFFER_UNIFORM:
       return GL_UNIFORM_BUFFER;
+    case GFX_BUFFER_DRAW_INDIRECT:
+      return GL_DRAW_INDIRECT_BUFFER;
   } 
 }
 
@@ -479,11 +934,32 @@ static GLenum get_buffer_usage(const GfxBufferUsage usage) {
       return GL_STATIC_DRAW;
     case GFX_BUFFER_USAGE_STATIC_READ:
       return GL_STATIC_READ;
+    case GFX_BUFFER_USAGE_PERSISTENT_MAP: // Immutable storage has no usage hint
+    default:
+      return 0;
+  }
+}
+
+static GLenum get_query_target(const GfxQueryType type) {
+  switch(type) {
+    case GFX_QUERY_TIME_ELAPSED:
+      return GL_TIME_ELAPSED;
+    case GFX_QUERY_TIMESTAMP:
+      return GL_TIMESTAMP;
     default:
       return 0;
   }
 }
 
+static void advance_query(GfxQuery* query) {
+  query->write_index++;
+
+  // Any result that did not get read in time is lost
+  if((query->write_index - query->read_index) > QUERY_FRAMES_MAX) {
+    query->read_index = query->write_index - QUERY_FRAMES_MAX;
+  }
+}
+
 static GLenum get_draw_mode(const GfxDrawMode mode) {
   switch(mode) {
     case GFX_DRAW_MODE_POINT:
@@ -615,23 +1091,13 @@ static sizei get_semantic_size(const GfxLayoutType layout) {
   }
 }
 
-static sizei calc_stride(const GfxLayoutDesc* layout, const sizei count) {
-  sizei stride = 0; 
-
-  for(sizei i = 0; i < count; i++) {
-    stride += get_layout_size(layout[i].type);
-  }
-
-  return stride;
-}
-
 static bool is_semantic_attrib(const GfxLayoutType layout) {
   return layout == GFX_LAYOUT_MAT2 || 
          layout == GFX_LAYOUT_MAT3 || 
          layout == GFX_LAYOUT_MAT4;
 }
 
-static void set_vertex_attrib(const u32 vao, const GfxLayoutDesc& layout, const sizei index, sizei* offset) {
+static void set_vertex_attrib(const u32 vao, const GfxLayoutDesc& layout, const sizei index, const u32 binding, sizei* offset) {
   glEnableVertexArrayAttrib(vao, index);
 
   GLenum gl_comp_type = get_layout_type(layout.type);
@@ -639,13 +1105,12 @@ static void set_vertex_attrib(const u32 vao, const GfxLayoutDesc& layout, const
   sizei size          = get_layout_size(layout.type);
 
   glVertexArrayAttribFormat(vao, index, comp_count, gl_comp_type, false, *offset);
-  glVertexArrayBindingDivisor(vao, index, layout.instance_rate);
-  glVertexArrayAttribBinding(vao, index, 0);
+  glVertexArrayAttribBinding(vao, index, binding);
 
   *offset += size;
 }
 
-static sizei set_semantic_attrib(const u32 vao, const GfxLayoutDesc& layout, const sizei index, sizei* offset) {
+static sizei set_semantic_attrib(const u32 vao, const GfxLayoutDesc& layout, const sizei index, const u32 binding, sizei* offset) {
   sizei semantic_count = get_semantic_count(layout.type);  
   sizei semantic_size  = get_semantic_size(layout.type); 
   sizei semantic_index = 0;
@@ -659,8 +1124,7 @@ static sizei set_semantic_attrib(const u32 vao, const GfxLayoutDesc& layout, con
     glEnableVertexArrayAttrib(vao, semantic_index);
   
     glVertexArrayAttribFormat(vao, semantic_index, comp_count, gl_comp_type, false, *offset);
-    glVertexArrayBindingDivisor(vao, semantic_index, layout.instance_rate);
-    glVertexArrayAttribBinding(vao, semantic_index, 0);
+    glVertexArrayAttribBinding(vao, semantic_index, binding);
 
     *offset += semantic_size;
   }
@@ -668,29 +1132,48 @@ static sizei set_semantic_attrib(const u32 vao, const GfxLayoutDesc& layout, con
   return semantic_index;
 }
 
-static sizei set_buffer_layout(const u32 vao, const GfxLayoutDesc* layout, const sizei layout_count) {
-  sizei stride         = calc_stride(layout, layout_count);
-  sizei offset         = 0;
-  sizei semantic_index = 0;
+static sizei set_buffer_layout(const u32 vao, const GfxLayoutDesc* layout, const sizei layout_count, sizei* instance_stride) {
+  // Per-vertex and per-instance elements live in different buffers, 
+  // so each gets its own binding, offsets, and locations.
+  sizei vertex_offset   = 0;
+  sizei instance_offset = 0;
+  
+  sizei vertex_index   = 0;
+  sizei instance_index = LAYOUT_INSTANCE_LOCATION;
+  u32 instance_rate    = 0;
 
   for(sizei i = 0; i < layout_count; i++) {
     /// @NOTE: A "semantic" is the inner value of an attribute. 
     /// For example, the semantic of a 'Mat4' is just a `Vec4` or, rather, 
     /// 4 `Vec4`s. In that case `semantic_count` would be `4` and `semantic_size`
     /// would be `16` since it's just a `FLOAT4` under the hood.
-    
+   
+    bool is_instanced = layout[i].instance_rate > 0;
+    u32 binding       = is_instanced ? INSTANCE_BUFFER_BINDING : VERTEX_BUFFER_BINDING;
+    sizei* offset     = is_instanced ? &instance_offset : &vertex_offset;
+    sizei* index      = is_instanced ? &instance_index : &vertex_index;
+
+    if(is_instanced) {
+      NIKOLA_ASSERT((instance_rate == 0 || instance_rate == layout[i].instance_rate), "Every per-instance layout element must have the same instance rate");
+      instance_rate = layout[i].instance_rate;
+    }
+
     // Different configuration if the current layout is a semantic or not
     if(is_semantic_attrib(layout[i].type)) {
-      semantic_index = set_semantic_attrib(vao, layout[i], semantic_index, &offset); 
+      *index = set_semantic_attrib(vao, layout[i], *index, binding, offset); 
     }
     else {
-      set_vertex_attrib(vao, layout[i], semantic_index, &offset);
+      set_vertex_attrib(vao, layout[i], *index, binding, offset);
     }
 
-    semantic_index += 1;
+    *index += 1;
   }
+
+  // The rate is per binding and not per attribute
+  glVertexArrayBindingDivisor(vao, INSTANCE_BUFFER_BINDING, instance_rate);
   
-  return stride;
+  *instance_stride = instance_offset;
+  return vertex_offset;
 }
 
 static void check_shader_compile_error(const sizei shader) {
@@ -717,6 +1200,96 @@ static void check_shader_linker_error(const GfxShader* shader) {
   }
 }
 
+static void free_shader_resources(GfxShader* shader) {
+  if(shader->uniforms) {
+    memory_free(shader->uniforms);
+  }
+
+  if(shader->blocks) {
+    memory_free(shader->blocks);
+  }
+
+  shader->uniforms       = nullptr;
+  shader->uniforms_count = 0;
+  shader->blocks         = nullptr;
+  shader->blocks_count   = 0;
+}
+
+static void strip_array_suffix(i8* name) {
+  // Arrays are reported as `name[0]`, but they should be found by their plain name
+  sizei length = strlen(name);
+  if(length > 3 && strcmp(&name[length - 3], "[0]") == 0) {
+    name[length - 3] = 0;
+  }
+}
+
+static void reflect_shader_resources(GfxShader* shader) {
+  free_shader_resources(shader);
+
+  i8 name[SHADER_RESOURCE_NAME_MAX];
+
+  // Uniforms
+  i32 uniforms_count = 0;
+  glGetProgramInterfaceiv(shader->id, GL_UNIFORM, GL_ACTIVE_RESOURCES, &uniforms_count);
+
+  if(uniforms_count > 0) {
+    shader->uniforms = (ShaderResource*)NIKOLA_MEMORY_ALLOCATE(sizeof(ShaderResource) * uniforms_count, MEMORY_TAG_GFX);
+  }
+
+  const GLenum uniform_props[] = {GL_BLOCK_INDEX, GL_LOCATION, GL_ARRAY_SIZE};
+  for(i32 i = 0; i < uniforms_count; i++) {
+    i32 values[3];
+    glGetProgramResourceiv(shader->id, GL_UNIFORM, i, 3, uniform_props, 3, nullptr, values);
+
+    // Anything inside a uniform block is set through its buffer instead
+    if(values[0] != -1) {
+      continue;
+    }
+
+    glGetProgramResourceName(shader->id, GL_UNIFORM, i, sizeof(name), nullptr, name);
+    strip_array_suffix(name);
+
+    shader->uniforms[shader->uniforms_count++] = ShaderResource {
+      .name     = string_id_intern(name), 
+      .location = values[1], 
+      .count    = values[2],
+    };
+  }
+
+  // Uniform blocks
+  i32 blocks_count = 0;
+  glGetProgramInterfaceiv(shader->id, GL_UNIFORM_BLOCK, GL_ACTIVE_RESOURCES, &blocks_count);
+
+  if(blocks_count > 0) {
+    shader->blocks = (ShaderResource*)NIKOLA_MEMORY_ALLOCATE(sizeof(ShaderResource) * blocks_count, MEMORY_TAG_GFX);
+  }
+
+  const GLenum block_props[] = {GL_BUFFER_BINDING};
+  for(i32 i = 0; i < blocks_count; i++) {
+    i32 binding = 0;
+    glGetProgramResourceiv(shader->id, GL_UNIFORM_BLOCK, i, 1, block_props, 1, nullptr, &binding);
+    glGetProgramResourceName(shader->id, GL_UNIFORM_BLOCK, i, sizeof(name), nullptr, name);
+
+    shader->blocks[shader->blocks_count++] = ShaderResource {
+      .name     = string_id_intern(name), 
+      .location = binding, 
+      .count    = 1,
+    };
+  }
+}
+
+static const ShaderResource* find_shader_resource(const ShaderResource* resources, const sizei count, const i8* name) {
+  StringID id(name);
+
+  for(sizei i = 0; i < count; i++) {
+    if(resources[i].name == id) {
+      return &resources[i];
+    }
+  }
+
+  return nullptr;
+}
+
 static void get_texture_gl_format(const GfxTextureFormat format, GLenum* in_format, GLenum* gl_format, GLenum* gl_type) {
   switch(format) {
     case GFX_TEXTURE_FORMAT_R8:
@@ -960,6 +1533,60 @@ static void update_gl_texture_storage(GfxTexture* texture, GLenum in_format) {
   }
 }
 
+static void write_buffer(GfxBuffer* buff, const sizei offset, const sizei size, const void* data) {
+  BufferUpdatePayload args = {offset, size};
+  record_command(buff->gfx, GFX_COMMAND_BUFFER_UPDATE, buff, &args, sizeof(args), data, size);
+
+  // Immutable storage can only be written through its mapping
+  if(buff->mapped) {
+    memory_copy((u8*)buff->mapped + offset, data, size);
+    return;
+  }
+
+  if(is_headless(buff->gfx)) {
+    return;
+  }
+
+  glNamedBufferSubData(buff->id, offset, size, data);
+}
+
+static GfxContext* get_resource_context(const GfxCommand& command) {
+  if(!command.resource) {
+    return nullptr;
+  }
+
+  switch(command.type) {
+    case GFX_COMMAND_CONTEXT_SET_TARGET:
+    case GFX_COMMAND_FRAMEBUFFER_COPY:
+      return ((const GfxFramebuffer*)command.resource)->gfx;
+    case GFX_COMMAND_BUFFER_UPDATE:
+    case GFX_COMMAND_BUFFER_COPY:
+      return ((const GfxBuffer*)command.resource)->gfx;
+    case GFX_COMMAND_SHADER_USE:
+    case GFX_COMMAND_SHADER_ATTACH_UNIFORM:
+    case GFX_COMMAND_SHADER_UPLOAD_UNIFORM:
+      return ((const GfxShader*)command.resource)->gfx;
+    case GFX_COMMAND_TEXTURE_USE:
+      return ((const GfxTexture*)command.resource)->gfx;
+    case GFX_COMMAND_CUBEMAP_USE:
+      return ((const GfxCubemap*)command.resource)->gfx;
+    case GFX_COMMAND_PIPELINE_UPDATE:
+    case GFX_COMMAND_PIPELINE_DRAW_VERTEX:
+    case GFX_COMMAND_PIPELINE_DRAW_INDEX:
+    case GFX_COMMAND_PIPELINE_DRAW_INDEX_INSTANCED:
+    case GFX_COMMAND_PIPELINE_DRAW_INDIRECT:
+      return ((const GfxPipeline*)command.resource)->gfx;
+    case GFX_COMMAND_QUERY_BEGIN:
+    case GFX_COMMAND_QUERY_END:
+    case GFX_COMMAND_QUERY_TIMESTAMP:
+      return ((const GfxQuery*)command.resource)->gfx;
+    case GFX_COMMAND_FENCE_INSERT:
+      return ((const GfxFence*)command.resource)->gfx;
+    default:
+      return nullptr;
+  }
+}
+
 /// Private functions 
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -967,15 +1594,36 @@ static void update_gl_texture_storage(GfxTexture* texture, GLenum in_format) {
 /// Context functions 
 
 GfxContext* gfx_context_init(const GfxContextDesc& desc) {
-  GfxContext* gfx = (GfxContext*)memory_allocate(sizeof(GfxContext));
+  GfxContext* gfx = (GfxContext*)NIKOLA_MEMORY_ALLOCATE(sizeof(GfxContext), MEMORY_TAG_GFX);
   memory_zero(gfx, sizeof(GfxContext)); 
+ 
+  // The pools are shared between all the contexts
+  if(s_pools.contexts_count == 0) {
+    s_pools.framebuffers = memory_pool_create(sizeof(GfxFramebuffer), GFX_POOL_BLOCKS_PER_CHUNK, MEMORY_TAG_GFX);
+    s_pools.buffers      = memory_pool_create(sizeof(GfxBuffer), GFX_POOL_BLOCKS_PER_CHUNK, MEMORY_TAG_GFX);
+    s_pools.shaders      = memory_pool_create(sizeof(GfxShader), GFX_POOL_BLOCKS_PER_CHUNK, MEMORY_TAG_GFX);
+    s_pools.textures     = memory_pool_create(sizeof(GfxTexture), GFX_POOL_BLOCKS_PER_CHUNK, MEMORY_TAG_GFX);
+    s_pools.cubemaps     = memory_pool_create(sizeof(GfxCubemap), GFX_POOL_BLOCKS_PER_CHUNK, MEMORY_TAG_GFX);
+    s_pools.pipelines    = memory_pool_create(sizeof(GfxPipeline), GFX_POOL_BLOCKS_PER_CHUNK, MEMORY_TAG_GFX);
+    s_pools.queries      = memory_pool_create(sizeof(GfxQuery), GFX_POOL_BLOCKS_PER_CHUNK, MEMORY_TAG_GFX);
+  }
+  s_pools.contexts_count++;
   
   gfx->desc                = desc;
   gfx->default_clear_flags = GL_COLOR_BUFFER_BIT;
   gfx->current_clear_flags = gfx->default_clear_flags;
+  gfx->states              = (GfxStates)desc.states;
+
+  // A headless context keeps track of its resources without ever talking to OpenGL
+  if(is_headless(gfx)) {
+    NIKOLA_LOG_INFO("A headless graphics context was successfully created");
+    return gfx;
+  }
 
   // Glad init
-  if(!gladLoadGL()) {
+  //
+  // @NOTE: Loading through the window works for offscreen (OSMesa/EGL) contexts as well
+  if(!gladLoadGLLoader((GLADloadproc)window_get_proc_address)) {
     NIKOLA_LOG_FATAL("Could not create an OpenGL instance");
     return nullptr;
   }
@@ -995,7 +1643,6 @@ GfxContext* gfx_context_init(const GfxContextDesc& desc) {
   glViewport(0, 0, width, height);
 
   // Setting the flags
-  gfx->states = (GfxStates)desc.states;
   set_gfx_states(gfx);
 
   // Listening to events 
@@ -1027,6 +1674,20 @@ void gfx_context_shutdown(GfxContext* gfx) {
     return;
   }
 
+  // Only destroy the pools once every context is gone
+  s_pools.contexts_count--;
+  if(s_pools.contexts_count == 0) {
+    memory_pool_destroy(s_pools.framebuffers);
+    memory_pool_destroy(s_pools.buffers);
+    memory_pool_destroy(s_pools.shaders);
+    memory_pool_destroy(s_pools.textures);
+    memory_pool_destroy(s_pools.cubemaps);
+    memory_pool_destroy(s_pools.pipelines);
+    memory_pool_destroy(s_pools.queries);
+
+    s_pools = {};
+  }
+
   NIKOLA_LOG_INFO("The graphics context was successfully destroyed");
   memory_free(gfx);
 }
@@ -1039,11 +1700,20 @@ GfxContextDesc& gfx_context_get_desc(GfxContext* gfx) {
 
 void gfx_context_set_state(GfxContext* gfx, const GfxStates state, const bool value) {
   NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
+
+  SetStatePayload args = {state, value};
+  record_command(gfx, GFX_COMMAND_CONTEXT_SET_STATE, nullptr, &args, sizeof(args));
+
+  if(is_headless(gfx)) {
+    return;
+  }
+
   set_state(gfx, state, value);
 }
 
 void gfx_context_set_target(GfxContext* gfx, GfxFramebuffer* framebuffer) {
   NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
+  record_command(gfx, GFX_COMMAND_CONTEXT_SET_TARGET, framebuffer);
 
   // Set the default values for when binding to the default framebuffer
   gfx->current_clear_flags = gfx->default_clear_flags;
@@ -1053,6 +1723,10 @@ void gfx_context_set_target(GfxContext* gfx, GfxFramebuffer* framebuffer) {
     gfx->current_clear_flags = framebuffer->clear_flags;
     gfx->current_target      = framebuffer->id; 
 
+    if(is_headless(gfx)) {
+      return;
+    }
+
     // Set the number render targets to draw to
     glNamedFramebufferDrawBuffers(framebuffer->id, framebuffer->color_buffers_count, framebuffer->targets);
   }
@@ -1061,6 +1735,13 @@ void gfx_context_set_target(GfxContext* gfx, GfxFramebuffer* framebuffer) {
 void gfx_context_clear(GfxContext* gfx, const f32 r, const f32 g, const f32 b, const f32 a) {
   NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
 
+  f32 color[4] = {r, g, b, a};
+  record_command(gfx, GFX_COMMAND_CONTEXT_CLEAR, nullptr, color, sizeof(color));
+
+  if(is_headless(gfx)) {
+    return;
+  }
+
   glBindFramebuffer(GL_FRAMEBUFFER, gfx->current_target);
   glClear(gfx->current_clear_flags);
   glClearColor(r, g, b, a);
@@ -1068,12 +1749,136 @@ void gfx_context_clear(GfxContext* gfx, const f32 r, const f32 g, const f32 b, c
 
 void gfx_context_present(GfxContext* gfx) {
   NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
+  record_command(gfx, GFX_COMMAND_CONTEXT_PRESENT, nullptr);
+
+  if(is_headless(gfx)) {
+    return;
+  }
+
   window_swap_buffers(gfx->desc.window, gfx->desc.has_vsync);
 }
 
+void gfx_context_read_pixels(GfxContext* gfx, const i32 width, const i32 height, void* out_pixels) {
+  NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
+  NIKOLA_ASSERT(out_pixels, "Cannot read pixels into an invalid buffer");
+
+  // There is nothing to read back from a headless context
+  if(is_headless(gfx)) {
+    memory_zero(out_pixels, (sizei)(width * height * 4));
+    return;
+  }
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, out_pixels);
+}
+
+void gfx_context_set_command_log(GfxContext* gfx, GfxCommandLog* log) {
+  NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
+  gfx->command_log = log;
+
+  if(!log) {
+    return;
+  }
+
+  // The resources in a log are only meaningful to the context that created them
+  NIKOLA_ASSERT((!log->gfx || log->gfx == gfx), "A GfxCommandLog cannot be attached to more than one GfxContext");
+  log->gfx = gfx;
+}
+
 /// Context functions 
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Pool allocator functions
+
+void* gfx_framebuffer_pool_allocate(const sizei size) {
+  NIKOLA_ASSERT(s_pools.framebuffers, "Cannot allocate from the GfxFramebuffer pool without a valid GfxContext");
+  NIKOLA_ASSERT((size <= sizeof(GfxFramebuffer)), "Cannot allocate a block bigger than a GfxFramebuffer from the GfxFramebuffer pool");
+
+  return memory_pool_allocate(s_pools.framebuffers);
+}
+
+void gfx_framebuffer_pool_free(void* ptr) {
+  NIKOLA_ASSERT(s_pools.framebuffers, "Cannot free into the GfxFramebuffer pool without a valid GfxContext");
+  memory_pool_free(s_pools.framebuffers, ptr);
+}
+
+void* gfx_buffer_pool_allocate(const sizei size) {
+  NIKOLA_ASSERT(s_pools.buffers, "Cannot allocate from the GfxBuffer pool without a valid GfxContext");
+  NIKOLA_ASSERT((size <= sizeof(GfxBuffer)), "Cannot allocate a block bigger than a GfxBuffer from the GfxBuffer pool");
+
+  return memory_pool_allocate(s_pools.buffers);
+}
+
+void gfx_buffer_pool_free(void* ptr) {
+  NIKOLA_ASSERT(s_pools.buffers, "Cannot free into the GfxBuffer pool without a valid GfxContext");
+  memory_pool_free(s_pools.buffers, ptr);
+}
+
+void* gfx_shader_pool_allocate(const sizei size) {
+  NIKOLA_ASSERT(s_pools.shaders, "Cannot allocate from the GfxShader pool without a valid GfxContext");
+  NIKOLA_ASSERT((size <= sizeof(GfxShader)), "Cannot allocate a block bigger than a GfxShader from the GfxShader pool");
+
+  return memory_pool_allocate(s_pools.shaders);
+}
+
+void gfx_shader_pool_free(void* ptr) {
+  NIKOLA_ASSERT(s_pools.shaders, "Cannot free into the GfxShader pool without a valid GfxContext");
+  memory_pool_free(s_pools.shaders, ptr);
+}
+
+void* gfx_texture_pool_allocate(const sizei size) {
+  NIKOLA_ASSERT(s_pools.textures, "Cannot allocate from the GfxTexture pool without a valid GfxContext");
+  NIKOLA_ASSERT((size <= sizeof(GfxTexture)), "Cannot allocate a block bigger than a GfxTexture from the GfxTexture pool");
+
+  return memory_pool_allocate(s_pools.textures);
+}
+
+void gfx_texture_pool_free(void* ptr) {
+  NIKOLA_ASSERT(s_pools.textures, "Cannot free into the GfxTexture pool without a valid GfxContext");
+  memory_pool_free(s_pools.textures, ptr);
+}
+
+void* gfx_cubemap_pool_allocate(const sizei size) {
+  NIKOLA_ASSERT(s_pools.cubemaps, "Cannot allocate from the GfxCubemap pool without a valid GfxContext");
+  NIKOLA_ASSERT((size <= sizeof(GfxCubemap)), "Cannot allocate a block bigger than a GfxCubemap from the GfxCubemap pool");
+
+  return memory_pool_allocate(s_pools.cubemaps);
+}
+
+void gfx_cubemap_pool_free(void* ptr) {
+  NIKOLA_ASSERT(s_pools.cubemaps, "Cannot free into the GfxCubemap pool without a valid GfxContext");
+  memory_pool_free(s_pools.cubemaps, ptr);
+}
+
+void* gfx_pipeline_pool_allocate(const sizei size) {
+  NIKOLA_ASSERT(s_pools.pipelines, "Cannot allocate from the GfxPipeline pool without a valid GfxContext");
+  NIKOLA_ASSERT((size <= sizeof(GfxPipeline)), "Cannot allocate a block bigger than a GfxPipeline from the GfxPipeline pool");
+
+  return memory_pool_allocate(s_pools.pipelines);
+}
+
+void gfx_pipeline_pool_free(void* ptr) {
+  NIKOLA_ASSERT(s_pools.pipelines, "Cannot free into the GfxPipeline pool without a valid GfxContext");
+  memory_pool_free(s_pools.pipelines, ptr);
+}
+
+void* gfx_query_pool_allocate(const sizei size) {
+  NIKOLA_ASSERT(s_pools.queries, "Cannot allocate from the GfxQuery pool without a valid GfxContext");
+  NIKOLA_ASSERT((size <= sizeof(GfxQuery)), "Cannot allocate a block bigger than a GfxQuery from the GfxQuery pool");
+
+  return memory_pool_allocate(s_pools.queries);
+}
+
+void gfx_query_pool_free(void* ptr) {
+  NIKOLA_ASSERT(s_pools.queries, "Cannot free into the GfxQuery pool without a valid GfxContext");
+  memory_pool_free(s_pools.queries, ptr);
+}
+
+/// Pool allocator functions
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Framebuffer functions
 
@@ -1083,7 +1888,14 @@ GfxFramebuffer* gfx_framebuffer_create(GfxContext* gfx, const GfxFramebufferDesc
   GfxFramebuffer* buff = (GfxFramebuffer*)alloc_fn(sizeof(GfxFramebuffer));
 
   buff->desc        = desc; 
+  buff->gfx         = gfx;
   buff->clear_flags = get_gl_clear_flags(desc.clear_flags);
+  buff->id          = 0;
+
+  record_command(gfx, GFX_COMMAND_FRAMEBUFFER_CREATE, buff);
+  if(is_headless(gfx)) {
+    return buff;
+  }
 
   glCreateFramebuffers(1, &buff->id);
 
@@ -1100,7 +1912,10 @@ void gfx_framebuffer_destroy(GfxFramebuffer* framebuffer, const FreeMemoryFn& fr
     return;
   }
 
-  glDeleteFramebuffers(1, &framebuffer->id);
+  record_command(framebuffer->gfx, GFX_COMMAND_FRAMEBUFFER_DESTROY, framebuffer);
+  if(!is_headless(framebuffer->gfx)) {
+    glDeleteFramebuffers(1, &framebuffer->id);
+  }
   free_fn(framebuffer);
 }
 
@@ -1113,6 +1928,26 @@ void gfx_framebuffer_copy(const GfxFramebuffer* src_frame,
                           i32 buffer_mask) {
   NIKOLA_ASSERT((src_frame || dest_frame), "Cannot have both framebuffers as NULL in copy operation");
 
+  FramebufferCopyPayload args = {
+    .dest_frame  = dest_frame, 
+    .src_x       = src_x, 
+    .src_y       = src_y, 
+    .src_width   = src_width, 
+    .src_height  = src_height, 
+    .dest_x      = dest_x, 
+    .dest_y      = dest_y, 
+    .dest_width  = dest_width, 
+    .dest_height = dest_height, 
+    .buffer_mask = buffer_mask,
+  };
+
+  const GfxFramebuffer* frame = src_frame ? src_frame : dest_frame;
+  record_command(frame->gfx, GFX_COMMAND_FRAMEBUFFER_COPY, src_frame, &args, sizeof(args));
+
+  if(is_headless(frame->gfx)) {
+    return;
+  }
+
   u32 src_id   = src_frame ? src_frame->id : 0;
   u32 dest_id  = dest_frame ? dest_frame->id : 0;
   u32 gl_masks = get_gl_clear_flags(buffer_mask);
@@ -1138,7 +1973,12 @@ void gfx_framebuffer_update(GfxFramebuffer* framebuffer, const GfxFramebufferDes
   framebuffer->desc        = desc; 
   framebuffer->clear_flags = get_gl_clear_flags(desc.clear_flags);
 
-  // Attach all of the given attachments
+  record_command(framebuffer->gfx, GFX_COMMAND_FRAMEBUFFER_UPDATE, framebuffer);
+  if(is_headless(framebuffer->gfx)) {
+    return;
+  }
+
+  // Attach all of the given attachments
   for(sizei i = 0; i < desc.attachments_count; i++) {
     framebuffer_attach(framebuffer, desc.attachments[i]);
   }
@@ -1159,9 +1999,35 @@ GfxBuffer* gfx_buffer_create(GfxContext* gfx, const GfxBufferDesc& desc, const A
   buff->gfx           = gfx; 
   buff->gl_buff_type  = get_buffer_type(desc.type);
   buff->gl_buff_usage = get_buffer_usage(desc.usage);
+  buff->id            = 0;
+  buff->mapped        = nullptr;
+
+  record_command(gfx, GFX_COMMAND_BUFFER_CREATE, buff, &desc.size, sizeof(desc.size));
+  if(is_headless(gfx)) {
+    // There is still somewhere to write to, even if nothing ever reads it
+    if(desc.usage == GFX_BUFFER_USAGE_PERSISTENT_MAP) {
+      buff->mapped = memory_allocate(desc.size);
+
+      // Same as the storage of a real buffer, the mapping starts out with the given data
+      if(desc.data) {
+        memory_copy(buff->mapped, desc.data, desc.size);
+      }
+    }
+
+    return buff;
+  }
 
   glCreateBuffers(1, &buff->id);
-  glNamedBufferData(buff->id, desc.size, desc.data, buff->gl_buff_usage);
+
+  if(desc.usage == GFX_BUFFER_USAGE_PERSISTENT_MAP) {
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glNamedBufferStorage(buff->id, desc.size, desc.data, flags);
+    buff->mapped = glMapNamedBufferRange(buff->id, 0, desc.size, flags);
+  }
+  else {
+    glNamedBufferData(buff->id, desc.size, desc.data, buff->gl_buff_usage);
+  }
   
   buff->desc = desc;
   return buff;
@@ -1172,7 +2038,19 @@ void gfx_buffer_destroy(GfxBuffer* buff, const FreeMemoryFn& free_fn) {
     return;
   }
 
-  glDeleteBuffers(1, &buff->id);
+  record_command(buff->gfx, GFX_COMMAND_BUFFER_DESTROY, buff);
+  if(is_headless(buff->gfx)) {
+    if(buff->mapped) {
+      memory_free(buff->mapped);
+    }
+  }
+  else {
+    if(buff->mapped) {
+      glUnmapNamedBuffer(buff->id);
+    }
+
+    glDeleteBuffers(1, &buff->id);
+  }
   free_fn(buff);
 }
 
@@ -1186,10 +2064,51 @@ void gfx_buffer_update(GfxBuffer* buff, const sizei offset, const sizei size, co
   NIKOLA_ASSERT(buff->gfx, "Invalid GfxContext struct passed");
   NIKOLA_ASSERT(buff, "Invalid GfxBuffer struct passed");
 
-  buff->desc.size = size;
-  buff->desc.data = (void*)data;
+  // The storage of a mapped buffer never changes size
+  if(!buff->mapped) {
+    buff->desc.size = size;
+    buff->desc.data = (void*)data;
+  }
 
-  glNamedBufferSubData(buff->id, offset, size, data);
+  write_buffer(buff, offset, size, data);
+}
+
+void* gfx_buffer_map(GfxBuffer* buff) {
+  NIKOLA_ASSERT(buff, "Invalid GfxBuffer struct passed");
+
+  return buff->mapped;
+}
+
+void gfx_buffer_mark_written(GfxBuffer* buff, const sizei offset, const sizei size) {
+  NIKOLA_ASSERT(buff, "Invalid GfxBuffer struct passed");
+  NIKOLA_ASSERT(buff->mapped, "Only a mapped GfxBuffer can be written to directly");
+  NIKOLA_ASSERT(((offset + size) <= buff->desc.size), "Writing past the end of the mapped buffer");
+
+  // Nothing went through `gfx_buffer_update`, so the log gets the written bytes as an update instead. 
+  // Replaying it will then put the exact same bytes back into the mapping.
+  BufferUpdatePayload args = {offset, size};
+  record_command(buff->gfx, GFX_COMMAND_BUFFER_UPDATE, buff, &args, sizeof(args), (u8*)buff->mapped + offset, size);
+}
+
+void gfx_buffer_copy(GfxBuffer* dest, const sizei dest_offset, const GfxBuffer* src, const sizei src_offset, const sizei size) {
+  NIKOLA_ASSERT(dest, "Invalid destination GfxBuffer struct passed");
+  NIKOLA_ASSERT(src, "Invalid source GfxBuffer struct passed");
+  NIKOLA_ASSERT(((dest_offset + size) <= dest->desc.size), "Copying past the end of the destination buffer");
+  NIKOLA_ASSERT(((src_offset + size) <= src->desc.size), "Copying past the end of the source buffer");
+
+  BufferCopyPayload args = {
+    .src         = src, 
+    .dest_offset = dest_offset,
+    .src_offset  = src_offset, 
+    .size        = size,
+  };
+
+  record_command(dest->gfx, GFX_COMMAND_BUFFER_COPY, dest, &args, sizeof(args));
+  if(is_headless(dest->gfx)) {
+    return;
+  }
+
+  glCopyNamedBufferSubData(src->id, dest->id, src_offset, dest_offset, size);
 }
 
 /// Buffer functions 
@@ -1208,6 +2127,20 @@ GfxShader* gfx_shader_create(GfxContext* gfx, const GfxShaderDesc& desc, const A
   shader->gfx  = gfx;
   shader->desc = desc;
 
+  shader->uniforms       = nullptr;
+  shader->uniforms_count = 0;
+  shader->blocks         = nullptr;
+  shader->blocks_count   = 0;
+
+  record_command(gfx, GFX_COMMAND_SHADER_CREATE, shader);
+  if(is_headless(gfx)) {
+    shader->id      = 0;
+    shader->vert_id = 0;
+    shader->frag_id = 0;
+
+    return shader;
+  }
+
   i32 vert_src_len = strlen(shader->desc.vertex_source);
   i32 frag_src_len = strlen(shader->desc.pixel_source);
 
@@ -1234,6 +2167,9 @@ GfxShader* gfx_shader_create(GfxContext* gfx, const GfxShaderDesc& desc, const A
   glDetachShader(shader->id, shader->vert_id);
   glDetachShader(shader->id, shader->frag_id);
 
+  // Reflection
+  reflect_shader_resources(shader);
+
   return shader;
 }
 
@@ -1242,7 +2178,12 @@ void gfx_shader_destroy(GfxShader* shader, const FreeMemoryFn& free_fn) {
     return;
   }
   
-  glDeleteProgram(shader->id);
+  record_command(shader->gfx, GFX_COMMAND_SHADER_DESTROY, shader);
+  if(!is_headless(shader->gfx)) {
+    glDeleteProgram(shader->id);
+  }
+
+  free_shader_resources(shader);
   free_fn(shader);
 }
 
@@ -1254,6 +2195,11 @@ void gfx_shader_use(GfxShader* shader) {
   NIKOLA_ASSERT(shader->gfx, "Invalid GfxContext struct passed");
   NIKOLA_ASSERT(shader, "Invalid GfxShader struct passed");
 
+  record_command(shader->gfx, GFX_COMMAND_SHADER_USE, shader);
+  if(is_headless(shader->gfx)) {
+    return;
+  }
+
   glUseProgram(shader->id);
 }
 
@@ -1265,6 +2211,11 @@ void gfx_shader_update(GfxShader* shader, const GfxShaderDesc& desc) {
 
   shader->desc = desc;
   
+  record_command(shader->gfx, GFX_COMMAND_SHADER_UPDATE, shader);
+  if(is_headless(shader->gfx)) {
+    return;
+  }
+
   i32 vert_src_len = strlen(shader->desc.vertex_source);
   i32 frag_src_len = strlen(shader->desc.pixel_source);
   
@@ -1287,19 +2238,55 @@ void gfx_shader_update(GfxShader* shader, const GfxShaderDesc& desc) {
   // Detaching
   glDetachShader(shader->id, shader->vert_id);
   glDetachShader(shader->id, shader->frag_id);
+
+  // The locations might have changed with the new sources
+  reflect_shader_resources(shader);
 }
 
 void gfx_shader_attach_uniform(GfxShader* shader, const GfxShaderType type, GfxBuffer* buffer, const u32 bind_point) {
   NIKOLA_ASSERT(shader->gfx, "Invalid GfxContext struct passed");
   NIKOLA_ASSERT(shader, "Invalid GfxShader struct passed");
    
+  AttachUniformPayload args = {type, buffer, bind_point};
+  record_command(shader->gfx, GFX_COMMAND_SHADER_ATTACH_UNIFORM, shader, &args, sizeof(args));
+
+  if(is_headless(shader->gfx)) {
+    return;
+  }
+
   glBindBufferBase(GL_UNIFORM_BUFFER, bind_point, buffer->id);
 }
 
 i32 gfx_shader_uniform_lookup(GfxShader* shader, const i8* uniform_name) {
   NIKOLA_ASSERT(shader, "Invalid GfxShader struct passed");
   
-  return glGetUniformLocation(shader->id, uniform_name);
+  // Every uniform "exists" on a headless context, so nothing complains about missing locations
+  if(is_headless(shader->gfx)) {
+    return 0;
+  }
+
+  const ShaderResource* uniform = find_shader_resource(shader->uniforms, shader->uniforms_count, uniform_name);
+  if(uniform) {
+    return uniform->location;
+  }
+
+  // Single elements of an array (like `u_values[3]`) are not reflected on their own
+  if(strchr(uniform_name, '[')) {
+    return glGetUniformLocation(shader->id, uniform_name);
+  }
+
+  return -1;
+}
+
+i32 gfx_shader_uniform_block_lookup(GfxShader* shader, const i8* block_name) {
+  NIKOLA_ASSERT(shader, "Invalid GfxShader struct passed");
+  
+  if(is_headless(shader->gfx)) {
+    return 0;
+  }
+
+  const ShaderResource* block = find_shader_resource(shader->blocks, shader->blocks_count, block_name);
+  return block ? block->location : -1;
 }
 
 void gfx_shader_upload_uniform_array(GfxShader* shader, const i32 location, const sizei count, const GfxLayoutType type, const void* data) {
@@ -1311,53 +2298,59 @@ void gfx_shader_upload_uniform_array(GfxShader* shader, const i32 location, cons
     return;
   }
 
-  glUseProgram(shader->id);
+  UploadUniformPayload args = {location, count, type};
+  record_command(shader->gfx, GFX_COMMAND_SHADER_UPLOAD_UNIFORM, shader, &args, sizeof(args), data, get_layout_size(type) * count);
 
+  if(is_headless(shader->gfx)) {
+    return;
+  }
+
+  // Straight to the program, without binding it
   switch(type) {
     case GFX_LAYOUT_FLOAT1:
-      glUniform1fv(location, count, (f32*)data);
+      glProgramUniform1fv(shader->id, location, count, (f32*)data);
       break;
     case GFX_LAYOUT_FLOAT2:
-      glUniform2fv(location, count, (f32*)data);
+      glProgramUniform2fv(shader->id, location, count, (f32*)data);
       break;
     case GFX_LAYOUT_FLOAT3:
-      glUniform3fv(location, count, (f32*)data);
+      glProgramUniform3fv(shader->id, location, count, (f32*)data);
       break;
     case GFX_LAYOUT_FLOAT4:
-      glUniform4fv(location, count, (f32*)data);
+      glProgramUniform4fv(shader->id, location, count, (f32*)data);
       break;
     case GFX_LAYOUT_INT1:
-      glUniform1iv(location, count, (i32*)data);
+      glProgramUniform1iv(shader->id, location, count, (i32*)data);
       break;
     case GFX_LAYOUT_INT2:
-      glUniform2iv(location, count, (i32*)data);
+      glProgramUniform2iv(shader->id, location, count, (i32*)data);
       break;
     case GFX_LAYOUT_INT3:
-      glUniform3iv(location, count, (i32*)data);
+      glProgramUniform3iv(shader->id, location, count, (i32*)data);
       break;
     case GFX_LAYOUT_INT4:
-      glUniform4iv(location, count, (i32*)data);
+      glProgramUniform4iv(shader->id, location, count, (i32*)data);
       break;
     case GFX_LAYOUT_UINT1:
-      glUniform1uiv(location, count, (u32*)data);
+      glProgramUniform1uiv(shader->id, location, count, (u32*)data);
       break;
     case GFX_LAYOUT_UINT2:
-      glUniform2uiv(location, count, (u32*)data);
+      glProgramUniform2uiv(shader->id, location, count, (u32*)data);
       break;
     case GFX_LAYOUT_UINT3:
-      glUniform3uiv(location, count, (u32*)data);
+      glProgramUniform3uiv(shader->id, location, count, (u32*)data);
       break;
     case GFX_LAYOUT_UINT4:
-      glUniform4uiv(location, count, (u32*)data);
+      glProgramUniform4uiv(shader->id, location, count, (u32*)data);
       break;
     case GFX_LAYOUT_MAT2:
-      glUniformMatrix2fv(location, count, GL_FALSE, (f32*)data);
+      glProgramUniformMatrix2fv(shader->id, location, count, GL_FALSE, (f32*)data);
       break;
     case GFX_LAYOUT_MAT3:
-      glUniformMatrix3fv(location, count, GL_FALSE, (f32*)data);
+      glProgramUniformMatrix3fv(shader->id, location, count, GL_FALSE, (f32*)data);
       break;
     case GFX_LAYOUT_MAT4:
-      glUniformMatrix4fv(location, count, GL_FALSE, (f32*)data);
+      glProgramUniformMatrix4fv(shader->id, location, count, GL_FALSE, (f32*)data);
       break;
   }
 }
@@ -1379,6 +2372,12 @@ GfxTexture* gfx_texture_create(GfxContext* gfx, const GfxTextureDesc& desc, cons
  
   texture->desc = desc;
   texture->gfx  = gfx;
+  texture->id   = 0;
+
+  record_command(gfx, GFX_COMMAND_TEXTURE_CREATE, texture);
+  if(is_headless(gfx)) {
+    return texture;
+  }
   
   // Getting the appropriate GL pixel format
   GLenum in_format, gl_format, gl_pixel_type;
@@ -1418,13 +2417,21 @@ void gfx_texture_destroy(GfxTexture* texture, const FreeMemoryFn& free_fn) {
     return;
   }
   
-  glDeleteTextures(1, &texture->id);
+  record_command(texture->gfx, GFX_COMMAND_TEXTURE_DESTROY, texture);
+  if(!is_headless(texture->gfx)) {
+    glDeleteTextures(1, &texture->id);
+  }
   free_fn(texture);
 }
 
 void gfx_texture_use(GfxTexture* texture) {
   NIKOLA_ASSERT(texture, "Invalid GfxTexture passed to gfx_texture_use");
   
+  record_command(texture->gfx, GFX_COMMAND_TEXTURE_USE, texture, &texture, sizeof(GfxTexture*));
+  if(is_headless(texture->gfx)) {
+    return;
+  }
+
   glBindTextures(0, 1, &texture->id);
 }
 
@@ -1432,6 +2439,15 @@ void gfx_texture_use(GfxTexture** textures, const sizei count) {
   NIKOLA_ASSERT(textures, "Invalid GfxTexture array passed to gfx_texture_use");
   NIKOLA_ASSERT(((count >= 0) && (count <= TEXTURES_MAX)), "The count parametar in gfx_texture_use is invalid");
   
+  if(count == 0) {
+    return;
+  }
+
+  record_command(textures[0]->gfx, GFX_COMMAND_TEXTURE_USE, textures[0], textures, sizeof(GfxTexture*) * count);
+  if(is_headless(textures[0]->gfx)) {
+    return;
+  }
+
   u32 gl_textures[TEXTURES_MAX];
   for(sizei i = 0; i < count; i++) {
     gl_textures[i] = textures[i]->id;
@@ -1452,6 +2468,11 @@ void gfx_texture_update(GfxTexture* texture, const GfxTextureDesc& desc) {
  
   texture->desc = desc;
 
+  record_command(texture->gfx, GFX_COMMAND_TEXTURE_UPDATE, texture);
+  if(is_headless(texture->gfx)) {
+    return;
+  }
+
   // Updating the formats
   GLenum in_format, gl_format, gl_pixel_type;
   get_texture_gl_format(desc.format, &in_format, &gl_format, &gl_pixel_type);
@@ -1487,6 +2508,13 @@ void gfx_texture_upload_data(GfxTexture* texture,
   texture->desc.depth  = depth; 
   texture->desc.data   = (void*)data; 
 
+  TextureUploadPayload args = {width, height, depth};
+  record_command(texture->gfx, GFX_COMMAND_TEXTURE_UPLOAD, texture, &args, sizeof(args));
+
+  if(is_headless(texture->gfx)) {
+    return;
+  }
+
   // Updating the internal texture pixels
   update_gl_texture_storage(texture, in_format);
   update_gl_texture_pixels(texture, gl_format, gl_pixel_type);
@@ -1508,6 +2536,12 @@ GfxCubemap* gfx_cubemap_create(GfxContext* gfx, const GfxCubemapDesc& desc, cons
 
   cubemap->gfx  = gfx;
   cubemap->desc = desc;
+  cubemap->id   = 0;
+
+  record_command(gfx, GFX_COMMAND_CUBEMAP_CREATE, cubemap);
+  if(is_headless(gfx)) {
+    return cubemap;
+  }
   
   // Getting the appropriate GL pixel format
   GLenum in_format, gl_format, gl_pixel_type;
@@ -1550,13 +2584,21 @@ void gfx_cubemap_destroy(GfxCubemap* cubemap, const FreeMemoryFn& free_fn) {
     return;
   }
   
-  glDeleteTextures(1, &cubemap->id);
+  record_command(cubemap->gfx, GFX_COMMAND_CUBEMAP_DESTROY, cubemap);
+  if(!is_headless(cubemap->gfx)) {
+    glDeleteTextures(1, &cubemap->id);
+  }
   free_fn(cubemap);
 }
 
 void gfx_cubemap_use(GfxCubemap* cubemap) {
   NIKOLA_ASSERT(cubemap, "Invalid GfxCubemap to gfx_cubemap_use");
 
+  record_command(cubemap->gfx, GFX_COMMAND_CUBEMAP_USE, cubemap, &cubemap, sizeof(GfxCubemap*));
+  if(is_headless(cubemap->gfx)) {
+    return;
+  }
+
   glBindTextures(0, 1, &cubemap->id);
 }
 
@@ -1564,6 +2606,15 @@ void gfx_cubemap_use(GfxCubemap** cubemaps, const sizei count) {
   NIKOLA_ASSERT(cubemaps, "Invalid GfxCubemap array passed to gfx_cubemap_use");
   NIKOLA_ASSERT(((count >= 0) && (count <= CUBEMAPS_MAX)), "The count parametar in gfx_cubemap_use is invalid");
 
+  if(count == 0) {
+    return;
+  }
+
+  record_command(cubemaps[0]->gfx, GFX_COMMAND_CUBEMAP_USE, cubemaps[0], cubemaps, sizeof(GfxCubemap*) * count);
+  if(is_headless(cubemaps[0]->gfx)) {
+    return;
+  }
+
   u32 gl_cubemaps[CUBEMAPS_MAX];
   for(sizei i = 0; i < count; i++) {
     gl_cubemaps[i] = cubemaps[i]->id;
@@ -1584,6 +2635,11 @@ void gfx_cubemap_update(GfxCubemap* cubemap, const GfxCubemapDesc& desc) {
   
   cubemap->desc = desc;
   
+  record_command(cubemap->gfx, GFX_COMMAND_CUBEMAP_UPDATE, cubemap);
+  if(is_headless(cubemap->gfx)) {
+    return;
+  }
+
   // Updating the format
   GLenum in_format, gl_format, gl_pixel_type;
   get_texture_gl_format(desc.format, &in_format, &gl_format, &gl_pixel_type);
@@ -1620,6 +2676,17 @@ void gfx_cubemap_upload_data(GfxCubemap* cubemap,
   cubemap->desc.width       = width;
   cubemap->desc.height      = height;
 
+  TextureUploadPayload args = {width, height, (i32)count};
+  record_command(cubemap->gfx, GFX_COMMAND_CUBEMAP_UPLOAD, cubemap, &args, sizeof(args));
+
+  if(is_headless(cubemap->gfx)) {
+    for(sizei i = 0; i < count; i++) {
+      cubemap->desc.data[i] = (void*)faces[i];
+    }
+
+    return;
+  }
+
   // Updating the faces
   glTextureStorage2D(cubemap->id, cubemap->desc.mips, in_format, width, height);
   for(sizei i = 0; i < count; i++) {
@@ -1648,18 +2715,45 @@ GfxPipeline* gfx_pipeline_create(GfxContext* gfx, const GfxPipelineDesc& desc, c
   pipe->desc = desc;
   pipe->gfx  = gfx;
 
+  record_command(gfx, GFX_COMMAND_PIPELINE_CREATE, pipe);
+
+  // Only keep track of the buffers and the counts on a headless context
+  if(is_headless(gfx)) {
+    NIKOLA_ASSERT(desc.vertex_buffer, "Must have a vertex buffer to create a GfxPipeline struct");
+
+    pipe->vertex_array  = 0;
+    pipe->vertex_buffer = desc.vertex_buffer; 
+    pipe->vertex_count  = desc.vertices_count; 
+    pipe->index_buffer  = desc.index_buffer;
+    pipe->index_count   = desc.index_buffer ? desc.indices_count : 0;
+    pipe->draw_mode     = desc.draw_mode;
+
+    pipe->instance_buffer = desc.instance_buffer;
+    pipe->instance_stride = 0;
+
+    return pipe;
+  }
+
   // VAO init
   glCreateVertexArrays(1, &pipe->vertex_array);
 
   // Layout init 
-  sizei stride = set_buffer_layout(pipe->vertex_array, desc.layout, desc.layout_count); 
+  sizei stride = set_buffer_layout(pipe->vertex_array, desc.layout, desc.layout_count, &pipe->instance_stride); 
   NIKOLA_ASSERT(desc.vertex_buffer, "Must have a vertex buffer to create a GfxPipeline struct");
 
   // VBO init
   pipe->vertex_buffer = desc.vertex_buffer; 
   pipe->vertex_count  = desc.vertices_count; 
 
-  glVertexArrayVertexBuffer(pipe->vertex_array, 0, pipe->vertex_buffer->id, 0, stride);
+  glVertexArrayVertexBuffer(pipe->vertex_array, VERTEX_BUFFER_BINDING, pipe->vertex_buffer->id, 0, stride);
+
+  // Instance buffer init
+  if(desc.instance_buffer) {
+    NIKOLA_ASSERT((pipe->instance_stride > 0), "Must have at least one per-instance layout element to use an instance buffer");
+    
+    pipe->instance_buffer = desc.instance_buffer;
+    glVertexArrayVertexBuffer(pipe->vertex_array, INSTANCE_BUFFER_BINDING, pipe->instance_buffer->id, 0, pipe->instance_stride);
+  }
 
   // EBO init
   if(desc.index_buffer) {
@@ -1678,8 +2772,12 @@ GfxPipeline* gfx_pipeline_create(GfxContext* gfx, const GfxPipelineDesc& desc, c
 void gfx_pipeline_destroy(GfxPipeline* pipeline, const FreeMemoryFn& free_fn) {
   NIKOLA_ASSERT(pipeline, "Attempting to free an invalid GfxPipeline");
 
+  record_command(pipeline->gfx, GFX_COMMAND_PIPELINE_DESTROY, pipeline);
+
   // Deleting the buffers
-  glDeleteVertexArrays(1, &pipeline->vertex_array);
+  if(!is_headless(pipeline->gfx)) {
+    glDeleteVertexArrays(1, &pipeline->vertex_array);
+  }
 
   // Free the pipeline
   free_fn(pipeline);
@@ -1691,12 +2789,39 @@ GfxPipelineDesc& gfx_pipeline_get_desc(GfxPipeline* pipeline) {
   return pipeline->desc;
 }
 
+const sizei gfx_pipeline_get_vertex_stride(const GfxPipelineDesc& desc) {
+  sizei stride = 0;
+
+  for(sizei i = 0; i < desc.layout_count; i++) {
+    // Per-instance elements live in the `instance_buffer` instead
+    if(desc.layout[i].instance_rate == 0) {
+      stride += get_layout_size(desc.layout[i].type);
+    }
+  }
+
+  return stride;
+}
+
 void gfx_pipeline_update(GfxPipeline* pipeline, const GfxPipelineDesc& desc) {
   NIKOLA_ASSERT(pipeline, "Invalid GfxPipeline struct passed to gfx_pipeline_update");
   
   // Update the internal desc
   pipeline->desc = desc;
   
+  record_command(pipeline->gfx, GFX_COMMAND_PIPELINE_UPDATE, pipeline, &desc, sizeof(desc));
+  if(is_headless(pipeline->gfx)) {
+    pipeline->instance_buffer = desc.instance_buffer;
+    return;
+  }
+
+  // Re-bind the instance buffer (only if it changed)
+  if(desc.instance_buffer && desc.instance_buffer != pipeline->instance_buffer) {
+    NIKOLA_ASSERT((pipeline->instance_stride > 0), "Must have at least one per-instance layout element to use an instance buffer");
+
+    pipeline->instance_buffer = desc.instance_buffer;
+    glVertexArrayVertexBuffer(pipeline->vertex_array, INSTANCE_BUFFER_BINDING, pipeline->instance_buffer->id, 0, pipeline->instance_stride);
+  }
+
   // Setting the depth mask state of the pipeline 
   glDepthMask(pipeline->desc.depth_mask);
 
@@ -1713,6 +2838,11 @@ void gfx_pipeline_draw_vertex(GfxPipeline* pipeline) {
   NIKOLA_ASSERT(pipeline, "Invalid GfxPipeline struct passed");
   NIKOLA_ASSERT(pipeline->vertex_buffer, "Must have a valid vertex buffer to draw");
 
+  record_command(pipeline->gfx, GFX_COMMAND_PIPELINE_DRAW_VERTEX, pipeline);
+  if(is_headless(pipeline->gfx)) {
+    return;
+  }
+
   // Bind the vertex array
   glBindVertexArray(pipeline->vertex_array);
 
@@ -1730,6 +2860,11 @@ void gfx_pipeline_draw_index(GfxPipeline* pipeline) {
   NIKOLA_ASSERT(pipeline->vertex_buffer, "Must have a valid vertex buffer to draw");
   NIKOLA_ASSERT(pipeline->index_buffer, "Must have a valid index buffer to draw");
 
+  record_command(pipeline->gfx, GFX_COMMAND_PIPELINE_DRAW_INDEX, pipeline);
+  if(is_headless(pipeline->gfx)) {
+    return;
+  }
+
   // Bind the vertex array
   glBindVertexArray(pipeline->vertex_array);
 
@@ -1741,9 +2876,409 @@ void gfx_pipeline_draw_index(GfxPipeline* pipeline) {
   glBindVertexArray(0);
 }
 
+void gfx_pipeline_draw_index_instanced(GfxPipeline* pipeline, const sizei instances_count, const sizei base_instance) {
+  NIKOLA_ASSERT(pipeline->gfx, "Invalid GfxContext struct passed");
+  NIKOLA_ASSERT(pipeline, "Invalid GfxPipeline struct passed");
+  NIKOLA_ASSERT(pipeline->vertex_buffer, "Must have a valid vertex buffer to draw");
+  NIKOLA_ASSERT(pipeline->index_buffer, "Must have a valid index buffer to draw");
+  NIKOLA_ASSERT(pipeline->instance_buffer, "Must have a valid instance buffer to draw instances");
+
+  DrawInstancedPayload payload = {
+    .instances_count = instances_count, 
+    .base_instance   = base_instance,
+  };
+
+  record_command(pipeline->gfx, GFX_COMMAND_PIPELINE_DRAW_INDEX_INSTANCED, pipeline, &payload, sizeof(payload));
+  if(is_headless(pipeline->gfx)) {
+    return;
+  }
+
+  // Bind the vertex array
+  glBindVertexArray(pipeline->vertex_array);
+
+  // Draw the indices of every instance
+  GLenum draw_mode = get_draw_mode(pipeline->desc.draw_mode); 
+  glDrawElementsInstancedBaseInstance(draw_mode, 
+                                      pipeline->desc.indices_count, 
+                                      GL_UNSIGNED_INT, 
+                                      0, 
+                                      (GLsizei)instances_count, 
+                                      (GLuint)base_instance);
+  
+  // Unbind the vertex array for debugging purposes
+  glBindVertexArray(0);
+}
+
+void gfx_pipeline_draw_indirect(GfxPipeline* pipeline, GfxBuffer* commands, const sizei draws_count, const sizei offset) {
+  NIKOLA_ASSERT(pipeline->gfx, "Invalid GfxContext struct passed");
+  NIKOLA_ASSERT(pipeline, "Invalid GfxPipeline struct passed");
+  NIKOLA_ASSERT(pipeline->vertex_buffer, "Must have a valid vertex buffer to draw");
+  NIKOLA_ASSERT(pipeline->index_buffer, "Must have a valid index buffer to draw");
+  NIKOLA_ASSERT(commands, "Must have a valid commands buffer to draw indirectly");
+  NIKOLA_ASSERT((commands->desc.type == GFX_BUFFER_DRAW_INDIRECT), "The commands buffer of an indirect draw must be of type GFX_BUFFER_DRAW_INDIRECT");
+
+  DrawIndirectPayload payload = {
+    .commands    = commands,
+    .draws_count = draws_count, 
+    .offset      = offset,
+  };
+
+  record_command(pipeline->gfx, GFX_COMMAND_PIPELINE_DRAW_INDIRECT, pipeline, &payload, sizeof(payload));
+  if(is_headless(pipeline->gfx) || draws_count == 0) {
+    return;
+  }
+
+  // Bind the vertex array and the commands
+  glBindVertexArray(pipeline->vertex_array);
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands->id);
+
+  // Every command is its own draw, but the driver only sees one call
+  GLenum draw_mode = get_draw_mode(pipeline->desc.draw_mode); 
+  glMultiDrawElementsIndirect(draw_mode, 
+                              GL_UNSIGNED_INT, 
+                              (const void*)offset, 
+                              (GLsizei)draws_count, 
+                              sizeof(GfxDrawIndirectCommand));
+  
+  // Unbind everything for debugging purposes
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+  glBindVertexArray(0);
+}
+
 /// Pipeline functions 
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Query functions 
+
+GfxQuery* gfx_query_create(GfxContext* gfx, const GfxQueryDesc& desc, const AllocateMemoryFn& alloc_fn) {
+  NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
+
+  GfxQuery* query = (GfxQuery*)alloc_fn(sizeof(GfxQuery));
+
+  query->desc        = desc;
+  query->gfx         = gfx;
+  query->gl_target   = get_query_target(desc.type);
+  query->write_index = 0;
+  query->read_index  = 0;
+  query->result      = 0;
+
+  if(is_headless(gfx)) {
+    return query;
+  }
+
+  glCreateQueries(query->gl_target, QUERY_FRAMES_MAX, query->ids);
+  return query;
+}
+
+void gfx_query_destroy(GfxQuery* query, const FreeMemoryFn& free_fn) {
+  if(!query) {
+    return;
+  }
+
+  if(!is_headless(query->gfx)) {
+    glDeleteQueries(QUERY_FRAMES_MAX, query->ids);
+  }
+  free_fn(query);
+}
+
+GfxQueryDesc& gfx_query_get_desc(GfxQuery* query) {
+  NIKOLA_ASSERT(query, "Invalid GfxQuery struct passed");
+
+  return query->desc;
+}
+
+void gfx_query_begin(GfxQuery* query) {
+  NIKOLA_ASSERT(query, "Invalid GfxQuery struct passed");
+  NIKOLA_ASSERT((query->desc.type == GFX_QUERY_TIME_ELAPSED), "Only GFX_QUERY_TIME_ELAPSED queries can be started");
+
+  record_command(query->gfx, GFX_COMMAND_QUERY_BEGIN, query);
+  if(is_headless(query->gfx)) {
+    return;
+  }
+
+  glBeginQuery(query->gl_target, query->ids[query->write_index % QUERY_FRAMES_MAX]);
+}
+
+void gfx_query_end(GfxQuery* query) {
+  NIKOLA_ASSERT(query, "Invalid GfxQuery struct passed");
+  NIKOLA_ASSERT((query->desc.type == GFX_QUERY_TIME_ELAPSED), "Only GFX_QUERY_TIME_ELAPSED queries can be ended");
+
+  record_command(query->gfx, GFX_COMMAND_QUERY_END, query);
+  if(is_headless(query->gfx)) {
+    return;
+  }
+
+  glEndQuery(query->gl_target);
+  advance_query(query);
+}
+
+void gfx_query_timestamp(GfxQuery* query) {
+  NIKOLA_ASSERT(query, "Invalid GfxQuery struct passed");
+  NIKOLA_ASSERT((query->desc.type == GFX_QUERY_TIMESTAMP), "Only GFX_QUERY_TIMESTAMP queries can record timestamps");
+
+  record_command(query->gfx, GFX_COMMAND_QUERY_TIMESTAMP, query);
+  if(is_headless(query->gfx)) {
+    return;
+  }
+
+  glQueryCounter(query->ids[query->write_index % QUERY_FRAMES_MAX], GL_TIMESTAMP);
+  advance_query(query);
+}
+
+const u64 gfx_query_get_result(GfxQuery* query) {
+  NIKOLA_ASSERT(query, "Invalid GfxQuery struct passed");
+
+  // Read everything the GPU is done with, stopping at the first result that is still pending
+  while(query->read_index < query->write_index) {
+    u32 id = query->ids[query->read_index % QUERY_FRAMES_MAX];
+
+    i32 is_available = 0;
+    glGetQueryObjectiv(id, GL_QUERY_RESULT_AVAILABLE, &is_available);
+    if(!is_available) {
+      break;
+    }
+
+    glGetQueryObjectui64v(id, GL_QUERY_RESULT, &query->result);
+    query->read_index++;
+  }
+
+  return query->result;
+}
+
+/// Query functions 
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Fence functions 
+
+GfxFence* gfx_fence_create(GfxContext* gfx, const AllocateMemoryFn& alloc_fn) {
+  NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
+
+  GfxFence* fence = (GfxFence*)alloc_fn(sizeof(GfxFence));
+  fence->gfx      = gfx;
+  fence->sync     = nullptr;
+
+  return fence;
+}
+
+void gfx_fence_destroy(GfxFence* fence, const FreeMemoryFn& free_fn) {
+  if(!fence) {
+    return;
+  }
+
+  if(fence->sync) {
+    glDeleteSync(fence->sync);
+  }
+  free_fn(fence);
+}
+
+void gfx_fence_insert(GfxFence* fence) {
+  NIKOLA_ASSERT(fence, "Invalid GfxFence struct passed");
+
+  record_command(fence->gfx, GFX_COMMAND_FENCE_INSERT, fence);
+
+  // Headless fences never hold a sync object, so waiting on them always succeeds
+  if(is_headless(fence->gfx)) {
+    return;
+  }
+
+  if(fence->sync) {
+    glDeleteSync(fence->sync);
+  }
+  fence->sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+const bool gfx_fence_wait(GfxFence* fence, const u64 timeout_ns) {
+  NIKOLA_ASSERT(fence, "Invalid GfxFence struct passed");
+
+  // Nothing to wait on
+  if(!fence->sync) {
+    return true;
+  }
+
+  // Flushing to make sure the fence actually reaches the GPU, or else we might wait forever
+  GLenum result = glClientWaitSync(fence->sync, GL_SYNC_FLUSH_COMMANDS_BIT, timeout_ns);
+  if(result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+    return false;
+  }
+
+  glDeleteSync(fence->sync);
+  fence->sync = nullptr;
+
+  return true;
+}
+
+/// Fence functions 
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Command log functions 
+
+GfxCommandLog* gfx_command_log_create(const AllocateMemoryFn& alloc_fn) {
+  GfxCommandLog* log = (GfxCommandLog*)alloc_fn(sizeof(GfxCommandLog));
+  new (log) GfxCommandLog{};
+
+  return log;
+}
+
+void gfx_command_log_destroy(GfxCommandLog* log, const FreeMemoryFn& free_fn) {
+  if(!log) {
+    return;
+  }
+
+  log->~GfxCommandLog();
+  free_fn(log);
+}
+
+void gfx_command_log_clear(GfxCommandLog* log) {
+  NIKOLA_ASSERT(log, "Invalid GfxCommandLog struct passed");
+
+  log->commands.clear();
+  log->payload.clear();
+  log->stats = {};
+}
+
+const GfxCommandStats& gfx_command_log_get_stats(GfxCommandLog* log) {
+  NIKOLA_ASSERT(log, "Invalid GfxCommandLog struct passed");
+
+  return log->stats;
+}
+
+const bool gfx_command_log_dump(GfxCommandLog* log, const char* path) {
+  NIKOLA_ASSERT(log, "Invalid GfxCommandLog struct passed");
+
+  const GfxCommandStats& stats = log->stats;
+  char buffer[256];
+
+  snprintf(buffer, sizeof(buffer), 
+           "# commands=%zu draw_calls=%zu state_changes=%zu bytes_uploaded=%zu resources_created=%zu resources_destroyed=%zu\n", 
+           stats.commands_count, 
+           stats.draw_calls, 
+           stats.state_changes, 
+           stats.bytes_uploaded, 
+           stats.resources_created, 
+           stats.resources_destroyed);
+  String out = buffer;
+
+  HashMap<const void*, u32> names;
+  for(sizei i = 0; i < log->commands.size(); i++) {
+    const GfxCommand& command = log->commands[i];
+    append_command(out, names, i, command, log->payload.data() + command.payload_offset);
+  }
+
+  File file;
+  if(!file_open(&file, path, (i32)FILE_OPEN_WRITE)) {
+    NIKOLA_LOG_ERROR("Failed to open command log file \'%s\'", path);
+    return false;
+  }
+
+  file_write_bytes(file, out);
+  file_close(file);
+
+  return true;
+}
+
+void gfx_command_log_replay(GfxCommandLog* log, GfxContext* gfx) {
+  NIKOLA_ASSERT(log, "Invalid GfxCommandLog struct passed");
+  NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
+  NIKOLA_ASSERT((log->commands.empty() || log->gfx == gfx), "A GfxCommandLog can only be replayed on the context it was recorded on");
+
+  log->is_replaying = true;
+
+  for(const GfxCommand& command : log->commands) {
+    const u8* payload = log->payload.data() + command.payload_offset;
+
+    GfxContext* resource_gfx = get_resource_context(command);
+    NIKOLA_ASSERT((!resource_gfx || resource_gfx == gfx), "Replaying a command of a resource from another GfxContext");
+
+    switch(command.type) {
+      case GFX_COMMAND_CONTEXT_SET_STATE: {
+        const SetStatePayload* args = (const SetStatePayload*)payload;
+        gfx_context_set_state(gfx, args->state, args->value);
+      } break;
+      case GFX_COMMAND_CONTEXT_SET_TARGET:
+        gfx_context_set_target(gfx, (GfxFramebuffer*)command.resource);
+        break;
+      case GFX_COMMAND_CONTEXT_CLEAR: {
+        const f32* color = (const f32*)payload;
+        gfx_context_clear(gfx, color[0], color[1], color[2], color[3]);
+      } break;
+      case GFX_COMMAND_FRAMEBUFFER_COPY: {
+        const FramebufferCopyPayload* args = (const FramebufferCopyPayload*)payload;
+        gfx_framebuffer_copy((const GfxFramebuffer*)command.resource, args->dest_frame, 
+                             args->src_x, args->src_y, 
+                             args->src_width, args->src_height, 
+                             args->dest_x, args->dest_y, 
+                             args->dest_width, args->dest_height, 
+                             args->buffer_mask);
+      } break;
+      case GFX_COMMAND_BUFFER_UPDATE: {
+        // The data lives in the log, so the desc of the buffer must never point to it
+        const BufferUpdatePayload* args = (const BufferUpdatePayload*)payload;
+        write_buffer((GfxBuffer*)command.resource, args->offset, args->size, payload + sizeof(BufferUpdatePayload));
+      } break;
+      case GFX_COMMAND_BUFFER_COPY: {
+        const BufferCopyPayload* args = (const BufferCopyPayload*)payload;
+        gfx_buffer_copy((GfxBuffer*)command.resource, args->dest_offset, args->src, args->src_offset, args->size);
+      } break;
+      case GFX_COMMAND_SHADER_USE:
+        gfx_shader_use((GfxShader*)command.resource);
+        break;
+      case GFX_COMMAND_SHADER_ATTACH_UNIFORM: {
+        const AttachUniformPayload* args = (const AttachUniformPayload*)payload;
+        gfx_shader_attach_uniform((GfxShader*)command.resource, args->type, args->buffer, args->bind_point);
+      } break;
+      case GFX_COMMAND_SHADER_UPLOAD_UNIFORM: {
+        const UploadUniformPayload* args = (const UploadUniformPayload*)payload;
+        gfx_shader_upload_uniform_array((GfxShader*)command.resource, args->location, args->count, args->type, payload + sizeof(UploadUniformPayload));
+      } break;
+      case GFX_COMMAND_TEXTURE_USE:
+        gfx_texture_use((GfxTexture**)payload, command.payload_size / sizeof(GfxTexture*));
+        break;
+      case GFX_COMMAND_CUBEMAP_USE:
+        gfx_cubemap_use((GfxCubemap**)payload, command.payload_size / sizeof(GfxCubemap*));
+        break;
+      case GFX_COMMAND_PIPELINE_UPDATE:
+        gfx_pipeline_update((GfxPipeline*)command.resource, *(const GfxPipelineDesc*)payload);
+        break;
+      case GFX_COMMAND_PIPELINE_DRAW_VERTEX:
+        gfx_pipeline_draw_vertex((GfxPipeline*)command.resource);
+        break;
+      case GFX_COMMAND_PIPELINE_DRAW_INDEX:
+        gfx_pipeline_draw_index((GfxPipeline*)command.resource);
+        break;
+      case GFX_COMMAND_PIPELINE_DRAW_INDEX_INSTANCED: {
+        const DrawInstancedPayload* args = (const DrawInstancedPayload*)payload;
+        gfx_pipeline_draw_index_instanced((GfxPipeline*)command.resource, args->instances_count, args->base_instance);
+      } break;
+      case GFX_COMMAND_PIPELINE_DRAW_INDIRECT: {
+        const DrawIndirectPayload* args = (const DrawIndirectPayload*)payload;
+        gfx_pipeline_draw_indirect((GfxPipeline*)command.resource, args->commands, args->draws_count, args->offset);
+      } break;
+      case GFX_COMMAND_QUERY_BEGIN:
+        gfx_query_begin((GfxQuery*)command.resource);
+        break;
+      case GFX_COMMAND_QUERY_END:
+        gfx_query_end((GfxQuery*)command.resource);
+        break;
+      case GFX_COMMAND_QUERY_TIMESTAMP:
+        gfx_query_timestamp((GfxQuery*)command.resource);
+        break;
+      case GFX_COMMAND_FENCE_INSERT:
+        gfx_fence_insert((GfxFence*)command.resource);
+        break;
+      default: // Everything else is only recorded
+        break;
+    }
+  }
+
+  log->is_replaying = false;
+}
+
+/// Command log functions 
+///---------------------------------------------------------------------------------------------------------------------
+
 /// *** Graphics ***
 /// ---------------------------------------------------------------------
 
@@ -0,0 +1,250 @@
+#include "nikola/nikola_base.h"
+#include "nikola/nikola_math.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define NIKOLA_BOUNDS_SSE 1
+  #include <emmintrin.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace nikola { // Start of nikola
+
+/// ----------------------------------------------------------------------
+/// *** Math bounds ***
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The amount of planes in a frustum.
+const sizei FRUSTUM_PLANES_MAX = 6;
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static Vec4 normalize_plane(const Vec4& plane) {
+  f32 length = (f32)nikola::sqrt((plane.x * plane.x) + (plane.y * plane.y) + (plane.z * plane.z));
+  return length > 0.0f ? (plane / length) : plane;
+}
+
+static bool is_aabb_outside(const Vec4& plane, const Vec3& center, const Vec3& extents) {
+  // The distance of the center from the plane, and how far the box reaches towards it
+  f32 distance = (plane.x * center.x) + (plane.y * center.y) + (plane.z * center.z) + plane.w;
+  f32 radius   = (nikola::abs(plane.x) * extents.x) + (nikola::abs(plane.y) * extents.y) + (nikola::abs(plane.z) * extents.z);
+
+  return (distance + radius) < 0.0f;
+}
+
+#if NIKOLA_BOUNDS_SSE
+
+static u32 cull_aabbs_sse(const Frustum& frustum, const AABB* aabbs) {
+  // Structure-of-arrays lanes, where every lane is one of the 4 boxes
+  __m128 half = _mm_set1_ps(0.5f);
+
+  __m128 min_x = _mm_setr_ps(aabbs[0].min.x, aabbs[1].min.x, aabbs[2].min.x, aabbs[3].min.x);
+  __m128 min_y = _mm_setr_ps(aabbs[0].min.y, aabbs[1].min.y, aabbs[2].min.y, aabbs[3].min.y);
+  __m128 min_z = _mm_setr_ps(aabbs[0].min.z, aabbs[1].min.z, aabbs[2].min.z, aabbs[3].min.z);
+
+  __m128 max_x = _mm_setr_ps(aabbs[0].max.x, aabbs[1].max.x, aabbs[2].max.x, aabbs[3].max.x);
+  __m128 max_y = _mm_setr_ps(aabbs[0].max.y, aabbs[1].max.y, aabbs[2].max.y, aabbs[3].max.y);
+  __m128 max_z = _mm_setr_ps(aabbs[0].max.z, aabbs[1].max.z, aabbs[2].max.z, aabbs[3].max.z);
+
+  __m128 center_x = _mm_mul_ps(_mm_add_ps(min_x, max_x), half);
+  __m128 center_y = _mm_mul_ps(_mm_add_ps(min_y, max_y), half);
+  __m128 center_z = _mm_mul_ps(_mm_add_ps(min_z, max_z), half);
+
+  __m128 extent_x = _mm_mul_ps(_mm_sub_ps(max_x, min_x), half);
+  __m128 extent_y = _mm_mul_ps(_mm_sub_ps(max_y, min_y), half);
+  __m128 extent_z = _mm_mul_ps(_mm_sub_ps(max_z, min_z), half);
+
+  __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+  __m128 zero    = _mm_setzero_ps();
+
+  for(sizei i = 0; i < FRUSTUM_PLANES_MAX; i++) {
+    const Vec4& plane = frustum.planes[i];
+
+    __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), center_x),
+                                            _mm_mul_ps(_mm_set1_ps(plane.y), center_y)),
+                                 _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), center_z),
+                                            _mm_set1_ps(plane.w)));
+
+    __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(nikola::abs(plane.x)), extent_x),
+                                          _mm_mul_ps(_mm_set1_ps(nikola::abs(plane.y)), extent_y)),
+                               _mm_mul_ps(_mm_set1_ps(nikola::abs(plane.z)), extent_z));
+
+    visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+  }
+
+  // One bit per box
+  return (u32)_mm_movemask_ps(visible);
+}
+
+#endif
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Bounds functions
+
+const AABB aabb_from_vertices(const f32* vertices, const sizei floats_count, const sizei stride) {
+  NIKOLA_ASSERT((stride >= 3), "A vertex must have at least a position to be bounded");
+
+  if(!vertices || floats_count < 3) {
+    return AABB{};
+  }
+
+  AABB aabb = {
+    .min = Vec3(vertices[0], vertices[1], vertices[2]),
+    .max = Vec3(vertices[0], vertices[1], vertices[2]),
+  };
+
+  for(sizei i = stride; (i + 2) < floats_count; i += stride) {
+    Vec3 position(vertices[i + 0], vertices[i + 1], vertices[i + 2]);
+
+    aabb.min = vec3_min(aabb.min, position);
+    aabb.max = vec3_max(aabb.max, position);
+  }
+
+  return aabb;
+}
+
+const AABB aabb_merge(const AABB& a, const AABB& b) {
+  return AABB {
+    .min = vec3_min(a.min, b.min),
+    .max = vec3_max(a.max, b.max),
+  };
+}
+
+const AABB aabb_transform(const AABB& aabb, const Mat4& matrix) {
+  Vec3 center  = (aabb.min + aabb.max) * 0.5f;
+  Vec3 extents = (aabb.max - aabb.min) * 0.5f;
+
+  // Every axis of the new box reaches as far as the absolute rotated (and scaled) extents do
+  Vec3 new_center = Vec3(matrix[3]);
+  Vec3 new_extents(0.0f);
+
+  for(i32 col = 0; col < 3; col++) {
+    for(i32 row = 0; row < 3; row++) {
+      new_center[row]  += matrix[col][row] * center[col];
+      new_extents[row] += nikola::abs(matrix[col][row]) * extents[col];
+    }
+  }
+
+  return AABB {
+    .min = new_center - new_extents,
+    .max = new_center + new_extents,
+  };
+}
+
+const BoundingSphere bounding_sphere_from_vertices(const f32* vertices, const sizei floats_count, const sizei stride) {
+  AABB aabb = aabb_from_vertices(vertices, floats_count, stride);
+
+  BoundingSphere sphere = {
+    .center = (aabb.min + aabb.max) * 0.5f,
+    .radius = 0.0f,
+  };
+
+  // Tighter than the corners of the box, since only the actual vertices count
+  f32 radius_squared = 0.0f;
+  for(sizei i = 0; (i + 2) < floats_count; i += stride) {
+    Vec3 diff = Vec3(vertices[i + 0], vertices[i + 1], vertices[i + 2]) - sphere.center;
+    f32 dist  = (diff.x * diff.x) + (diff.y * diff.y) + (diff.z * diff.z);
+
+    radius_squared = dist > radius_squared ? dist : radius_squared;
+  }
+
+  sphere.radius = (f32)nikola::sqrt(radius_squared);
+  return sphere;
+}
+
+const BoundingSphere bounding_sphere_merge(const BoundingSphere& a, const BoundingSphere& b) {
+  Vec3 diff = b.center - a.center;
+  f32 dist  = (f32)nikola::sqrt((diff.x * diff.x) + (diff.y * diff.y) + (diff.z * diff.z));
+
+  // One of the spheres already encloses the other
+  if((dist + b.radius) <= a.radius) {
+    return a;
+  }
+  else if((dist + a.radius) <= b.radius) {
+    return b;
+  }
+
+  f32 radius = (dist + a.radius + b.radius) * 0.5f;
+  return BoundingSphere {
+    .center = a.center + (diff * ((radius - a.radius) / dist)),
+    .radius = radius,
+  };
+}
+
+const Frustum frustum_from_matrix(const Mat4& view_projection) {
+  // The rows of the matrix (which is stored in columns)
+  const Mat4& m = view_projection;
+
+  Vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+  Vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+  Vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+  Vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+  Frustum frustum;
+  frustum.planes[0] = normalize_plane(row3 + row0); // Left
+  frustum.planes[1] = normalize_plane(row3 - row0); // Right
+  frustum.planes[2] = normalize_plane(row3 + row1); // Bottom
+  frustum.planes[3] = normalize_plane(row3 - row1); // Top
+  frustum.planes[4] = normalize_plane(row3 + row2); // Near
+  frustum.planes[5] = normalize_plane(row3 - row2); // Far
+
+  return frustum;
+}
+
+const bool frustum_intersects_aabb(const Frustum& frustum, const AABB& aabb) {
+  Vec3 center  = (aabb.min + aabb.max) * 0.5f;
+  Vec3 extents = (aabb.max - aabb.min) * 0.5f;
+
+  for(sizei i = 0; i < FRUSTUM_PLANES_MAX; i++) {
+    if(is_aabb_outside(frustum.planes[i], center, extents)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+const sizei frustum_cull_aabbs(const Frustum& frustum, const AABB* aabbs, const sizei count, u8* out_visible) {
+  NIKOLA_ASSERT(((aabbs && out_visible) || count == 0), "Invalid arrays given to frustum_cull_aabbs");
+
+  sizei visible_count = 0;
+  sizei i             = 0;
+
+#if NIKOLA_BOUNDS_SSE
+  for(; (i + 4) <= count; i += 4) {
+    u32 mask = cull_aabbs_sse(frustum, &aabbs[i]);
+
+    for(sizei j = 0; j < 4; j++) {
+      out_visible[i + j] = (mask >> j) & 1;
+      visible_count     += out_visible[i + j];
+    }
+  }
+#endif
+
+  // Leftovers
+  for(; i < count; i++) {
+    out_visible[i] = frustum_intersects_aabb(frustum, aabbs[i]) ? 1 : 0;
+    visible_count += out_visible[i];
+  }
+
+  return visible_count;
+}
+
+/// Bounds functions
+/// ----------------------------------------------------------------------
+
+/// *** Math ***
+/// ----------------------------------------------------------------------
+
+} // End of nikola
+
+//////////////////////////////////////////////////////////////////////////
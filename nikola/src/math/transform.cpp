@@ -1,6 +1,11 @@
 #include "nikola/nikola_base.h"
 #include "nikola/nikola_math.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define NIKOLA_TRANSFORM_SSE 1
+  #include <emmintrin.h>
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 
 namespace nikola { // Start of nikola
@@ -8,13 +13,112 @@ namespace nikola { // Start of nikola
 /// ----------------------------------------------------------------------
 /// *** Math transform ***
 
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The amount of transforms the SIMD kernel rebuilds at once.
+const sizei TRANSFORM_BATCH_WIDTH = 4;
+
+/// Consts
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// Private functions
+
 static void update_transform(Transform& trans) {
-  trans.transform = mat4_translate(trans.position) *
-                    quat_to_mat4(trans.rotation)   *
-                    mat4_scale(trans.scale);
+  // The same as `translate * rotate * scale`, but without the three full matrix multiplies.
+  const Quat& q = trans.rotation;
+
+  f32 xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+  f32 xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+  f32 wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+  Mat4& m = trans.transform;
+
+  m[0] = Vec4((1.0f - 2.0f * (yy + zz)) * trans.scale.x,
+              (2.0f * (xy + wz))        * trans.scale.x,
+              (2.0f * (xz - wy))        * trans.scale.x,
+              0.0f);
+
+  m[1] = Vec4((2.0f * (xy - wz))        * trans.scale.y,
+              (1.0f - 2.0f * (xx + zz)) * trans.scale.y,
+              (2.0f * (yz + wx))        * trans.scale.y,
+              0.0f);
+
+  m[2] = Vec4((2.0f * (xz + wy))        * trans.scale.z,
+              (2.0f * (yz - wx))        * trans.scale.z,
+              (1.0f - 2.0f * (xx + yy)) * trans.scale.z,
+              0.0f);
+
+  m[3] = Vec4(trans.position, 1.0f);
+
+  trans.is_dirty = false;
 }
+
+#if NIKOLA_TRANSFORM_SSE
+
+static void update_transforms_sse(Transform** batch) {
+  // Structure-of-arrays lanes, where every lane is one of the transforms in `batch`
+  __m128 qx = _mm_setr_ps(batch[0]->rotation.x, batch[1]->rotation.x, batch[2]->rotation.x, batch[3]->rotation.x);
+  __m128 qy = _mm_setr_ps(batch[0]->rotation.y, batch[1]->rotation.y, batch[2]->rotation.y, batch[3]->rotation.y);
+  __m128 qz = _mm_setr_ps(batch[0]->rotation.z, batch[1]->rotation.z, batch[2]->rotation.z, batch[3]->rotation.z);
+  __m128 qw = _mm_setr_ps(batch[0]->rotation.w, batch[1]->rotation.w, batch[2]->rotation.w, batch[3]->rotation.w);
+
+  __m128 sx = _mm_setr_ps(batch[0]->scale.x, batch[1]->scale.x, batch[2]->scale.x, batch[3]->scale.x);
+  __m128 sy = _mm_setr_ps(batch[0]->scale.y, batch[1]->scale.y, batch[2]->scale.y, batch[3]->scale.y);
+  __m128 sz = _mm_setr_ps(batch[0]->scale.z, batch[1]->scale.z, batch[2]->scale.z, batch[3]->scale.z);
+
+  __m128 px = _mm_setr_ps(batch[0]->position.x, batch[1]->position.x, batch[2]->position.x, batch[3]->position.x);
+  __m128 py = _mm_setr_ps(batch[0]->position.y, batch[1]->position.y, batch[2]->position.y, batch[3]->position.y);
+  __m128 pz = _mm_setr_ps(batch[0]->position.z, batch[1]->position.z, batch[2]->position.z, batch[3]->position.z);
+
+  __m128 one  = _mm_set1_ps(1.0f);
+  __m128 two  = _mm_set1_ps(2.0f);
+  __m128 zero = _mm_setzero_ps();
+
+  // Rotation
+  __m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz);
+  __m128 xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), yz = _mm_mul_ps(qy, qz);
+  __m128 wx = _mm_mul_ps(qw, qx), wy = _mm_mul_ps(qw, qy), wz = _mm_mul_ps(qw, qz);
+
+  __m128 m00 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz)));
+  __m128 m01 = _mm_mul_ps(two, _mm_add_ps(xy, wz));
+  __m128 m02 = _mm_mul_ps(two, _mm_sub_ps(xz, wy));
+
+  __m128 m10 = _mm_mul_ps(two, _mm_sub_ps(xy, wz));
+  __m128 m11 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz)));
+  __m128 m12 = _mm_mul_ps(two, _mm_add_ps(yz, wx));
+
+  __m128 m20 = _mm_mul_ps(two, _mm_add_ps(xz, wy));
+  __m128 m21 = _mm_mul_ps(two, _mm_sub_ps(yz, wx));
+  __m128 m22 = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy)));
+
+  // Scale
+  __m128 col0[4] = {_mm_mul_ps(m00, sx), _mm_mul_ps(m01, sx), _mm_mul_ps(m02, sx), zero};
+  __m128 col1[4] = {_mm_mul_ps(m10, sy), _mm_mul_ps(m11, sy), _mm_mul_ps(m12, sy), zero};
+  __m128 col2[4] = {_mm_mul_ps(m20, sz), _mm_mul_ps(m21, sz), _mm_mul_ps(m22, sz), zero};
+  __m128 col3[4] = {px, py, pz, one};
+
+  // Back to an array-of-structures layout, where every register is a column of a single transform
+  _MM_TRANSPOSE4_PS(col0[0], col0[1], col0[2], col0[3]);
+  _MM_TRANSPOSE4_PS(col1[0], col1[1], col1[2], col1[3]);
+  _MM_TRANSPOSE4_PS(col2[0], col2[1], col2[2], col2[3]);
+  _MM_TRANSPOSE4_PS(col3[0], col3[1], col3[2], col3[3]);
+
+  for(sizei i = 0; i < TRANSFORM_BATCH_WIDTH; i++) {
+    Mat4& m = batch[i]->transform;
+
+    _mm_storeu_ps(&m[0][0], col0[i]);
+    _mm_storeu_ps(&m[1][0], col1[i]);
+    _mm_storeu_ps(&m[2][0], col2[i]);
+    _mm_storeu_ps(&m[3][0], col3[i]);
+
+    batch[i]->is_dirty = false;
+  }
+}
+
+#endif
+
 /// Private functions
 /// ----------------------------------------------------------------------
 
@@ -22,12 +126,12 @@ static void update_transform(Transform& trans) {
 /// Transform functions
 
 void transform_translate(Transform& trans, const Vec3& pos) {
-  trans.position = pos; 
+  trans.position = pos;
   update_transform(trans);
 }
 
 void transform_rotate(Transform& trans, const Quat& rot) {
-  trans.rotation = quat_normalize(rot); 
+  trans.rotation = quat_normalize(rot);
   update_transform(trans);
 }
 
@@ -40,10 +144,62 @@ void transform_rotate(Transform& trans, const Vec3& axis, const f32 angle) {
 }
 
 void transform_scale(Transform& trans, const Vec3& scale) {
-  trans.scale = scale; 
+  trans.scale = scale;
   update_transform(trans);
 }
 
+void transform_set_position(Transform& trans, const Vec3& pos) {
+  trans.position = pos;
+  trans.is_dirty = true;
+}
+
+void transform_set_rotation(Transform& trans, const Quat& rot) {
+  trans.rotation = quat_normalize(rot);
+  trans.is_dirty = true;
+}
+
+void transform_set_scale(Transform& trans, const Vec3& scale) {
+  trans.scale    = scale;
+  trans.is_dirty = true;
+}
+
+void transform_update(Transform& trans) {
+  if(trans.is_dirty) {
+    update_transform(trans);
+  }
+}
+
+void transform_update_batch(Transform* transforms, const sizei count) {
+  NIKOLA_ASSERT((transforms || count == 0), "Invalid transforms array given to transform_update_batch");
+
+#if NIKOLA_TRANSFORM_SSE
+  // Gather the dirty transforms, and rebuild them once there are enough to fill up the lanes
+  Transform* batch[TRANSFORM_BATCH_WIDTH];
+  sizei batch_size = 0;
+
+  for(sizei i = 0; i < count; i++) {
+    if(!transforms[i].is_dirty) {
+      continue;
+    }
+
+    batch[batch_size++] = &transforms[i];
+    if(batch_size == TRANSFORM_BATCH_WIDTH) {
+      update_transforms_sse(batch);
+      batch_size = 0;
+    }
+  }
+
+  // Not worth filling up the lanes for the leftovers
+  for(sizei i = 0; i < batch_size; i++) {
+    update_transform(*batch[i]);
+  }
+#else
+  for(sizei i = 0; i < count; i++) {
+    transform_update(transforms[i]);
+  }
+#endif
+}
+
 /// Transform functions
 /// ----------------------------------------------------------------------
 
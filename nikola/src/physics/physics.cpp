@@ -3,6 +3,8 @@
 #include "nikola/nikola_math.h"
 #include "nikola/nikola_containers.h"
 
+#include <new>
+
 #include <q3.h>
 #include <dynamics/q3Contact.h>
 
@@ -190,8 +192,9 @@ static Transform q3transform_to_transform(const q3Transform& trans) {
   Mat3 rot = q3mat_to_mat(trans.rotation);
 
   Transform transform; 
-  transform_translate(transform, pos);
-  transform_rotate(transform, quat_set_mat3(rot));
+  transform_set_position(transform, pos);
+  transform_set_rotation(transform, quat_set_mat3(rot));
+  transform_update(transform);
 
   return transform;
 }
@@ -252,13 +255,14 @@ void physics_world_shutdown() {
  
   // Clearing all bodies
   for(auto& [id, body] : s_world.bodies) {
-    delete body; 
+    memory_free(body); 
   }
-  s_world.bodies.clear();
+  s_world.bodies.destroy();
   
   // Clearing all colliders
   for(auto& collider : s_world.colliders) {
-    delete collider; 
+    collider->~Collider();
+    memory_free(collider); 
   }
   s_world.colliders.clear();
 
@@ -317,7 +321,7 @@ Vec3 physics_world_get_gravity() {
 
 PhysicsBody* physics_body_create(const PhysicsBodyDesc& desc) {
   // Allocate a new body
-  PhysicsBody* body = new PhysicsBody{};
+  PhysicsBody* body = new (NIKOLA_MEMORY_ALLOCATE(sizeof(PhysicsBody), MEMORY_TAG_PHYSICS)) PhysicsBody{};
 
   // q3Body init
   q3BodyDef def; 
@@ -348,14 +352,14 @@ void physics_body_destroy(PhysicsBody* body) {
   s_world.scene->RemoveBody(body->body);
   s_world.bodies.erase(body->id);
 
-  delete body;
+  memory_free(body);
 }
 
 Collider* physics_body_add_collider(PhysicsBody* body, const ColliderDesc& desc) {
   NIKOLA_ASSERT(body, "Invalid body given to physics_body_add_collider");
 
   // Allocate a new collider
-  Collider* coll = new Collider{};
+  Collider* coll = new (NIKOLA_MEMORY_ALLOCATE(sizeof(Collider), MEMORY_TAG_PHYSICS)) Collider{};
 
   // Transform init
   q3Transform trans; 
@@ -395,7 +399,8 @@ void physics_body_remove_collider(PhysicsBody* body, Collider* coll) {
   body->body->RemoveBox(coll->box);
   s_world.colliders.erase(s_world.colliders.begin() + coll->world_index);
 
-  delete coll;
+  coll->~Collider();
+  memory_free(coll);
 }
 
 void physics_body_apply_force(PhysicsBody* body, const Vec3& force) {
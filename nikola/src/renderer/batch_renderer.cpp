@@ -2,6 +2,7 @@
 #include "nikola/nikola_base.h"
 #include "nikola/nikola_gfx.h"
 #include "nikola/nikola_resources.h"
+#include "nikola/nikola_profiler.h"
 
 #include "render_shaders.h"
 
@@ -70,6 +71,9 @@ struct BatchRenderer {
   HashMap<GfxTexture*, i32> textures_cache;
   
   Mat4 ortho = Mat4(1.0f);
+
+  GfxQuery* query     = nullptr;
+  RenderTiming timing = {};
 };
 
 static BatchRenderer s_batch;
@@ -209,25 +213,24 @@ static void flush_batch(BatchCall& batch, GfxShader* shader) {
   batch.vertices.clear();
 }
 
-static void texture_lookup(GfxTexture* texture) {
-  if(s_batch.textures_cache.find(texture) == s_batch.textures_cache.end()) {
-    s_batch.textures_cache[texture] = s_batch.textures_cache.size();
-
+static i32 texture_lookup(GfxTexture* texture) {
+  auto [entry, is_new] = s_batch.textures_cache.emplace(texture, (i32)s_batch.textures_cache.size());
+  
+  if(is_new) {
     BatchCall new_batch = {
       .vertices_count = 0, 
       .texture        = texture,
     };
     s_batch.batches.push_back(new_batch);
   }
+
+  return entry->second;
 }
 
 static BatchCall* prepare_texture_batch(GfxTexture* texture) {
   // Looks up the texture in the cache and pushes a 
   // new batch if the given `texture` is new
-  texture_lookup(texture); 
-
-  // Retrieve the texture index from the cache
-  i32 index        = s_batch.textures_cache[texture];
+  i32 index        = texture_lookup(texture); 
   BatchCall* batch = &s_batch.batches[index]; 
 
   // We cannot render more than the maximum number of vertices
@@ -264,19 +267,30 @@ void batch_renderer_init() {
   };
   s_batch.batches.push_back(default_batch);
 
+  // Timing init
+  s_batch.query       = gfx_query_create(s_batch.context, GfxQueryDesc{.type = GFX_QUERY_TIME_ELAPSED}, gfx_query_pool_allocate);
+  s_batch.timing.name = "Batch renderer";
+
   NIKOLA_LOG_INFO("Successfully initialized the batch renderer");
 }
 
 void batch_renderer_shutdown() {
   gfx_pipeline_destroy(s_batch.pipeline);
   gfx_shader_destroy(s_batch.shader);
+  gfx_query_destroy(s_batch.query, gfx_query_pool_free);
   
   s_batch.batches.clear();
+  s_batch.textures_cache.destroy();
   
   NIKOLA_LOG_INFO("Batch renderer was successfully shutdown");
 }
 
 void batch_renderer_begin() {
+  // There is no window to take the size from on a headless context
+  if(!s_batch.ctx_desc.window) {
+    return;
+  }
+
   // Get the size of the window 
   i32 width, height; 
   window_get_size(s_batch.ctx_desc.window, &width, &height);
@@ -286,10 +300,21 @@ void batch_renderer_begin() {
 }
 
 void batch_renderer_end() {
+  NIKOLA_PROFILE_FUNCTION();
+
   // Render all of the batches 
+  gfx_query_begin(s_batch.query);
   for(auto& batch : s_batch.batches) {
     flush_batch(batch, s_batch.shader);
   }
+  gfx_query_end(s_batch.query);
+
+  // Read back any finished timings (from a few frames ago)
+  s_batch.timing.gpu_time = (f64)gfx_query_get_result(s_batch.query) / 1000000.0;
+}
+
+const RenderTiming& batch_renderer_get_timing() {
+  return s_batch.timing;
 }
 
 void batch_render_texture(GfxTexture* texture, const Rect& src, const Rect& dest, const Vec4& tint) {
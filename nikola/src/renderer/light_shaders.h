@@ -10,10 +10,14 @@ inline nikola::GfxShaderDesc generate_blinn_phong_shader() {
     "layout (location = 1) in vec3 aNormal;"
     "layout (location = 2) in vec2 aTextureCoords;"
     "\n"
+    "layout (location = 8)  in mat4 aInstanceModel;"
+    "layout (location = 12) in vec4 aInstanceColor;"
+    "\n"
     "out VS_OUT {"
     "  vec2 tex_coords;"
     "  vec3 normal;"
     "  vec3 pixel_pos;"
+    "  vec4 color;"
     "} vs_out;"
     "\n"
     "layout (std140, binding = 0) uniform Matrices {"
@@ -21,15 +25,15 @@ inline nikola::GfxShaderDesc generate_blinn_phong_shader() {
     "  mat4 u_projection;"
     "};"
     "\n"
-    "uniform mat4 u_model;"
     "uniform vec2 u_screen_size;"
     "\n"
     "void main() {"
-    "  vec4 model_space = u_model * vec4(aPos, 1.0f);"
+    "  vec4 model_space = aInstanceModel * vec4(aPos, 1.0f);"
     "\n"
     "  vs_out.tex_coords = aTextureCoords;"
-    "  vs_out.normal     = mat3(transpose(inverse(u_model))) * aNormal; "
+    "  vs_out.normal     = mat3(transpose(inverse(aInstanceModel))) * aNormal; "
     "  vs_out.pixel_pos  = vec3(model_space);"
+    "  vs_out.color      = aInstanceColor;"
     "\n"
     "  gl_Position       = u_projection * u_view * model_space;"
     "}",
@@ -42,6 +46,7 @@ inline nikola::GfxShaderDesc generate_blinn_phong_shader() {
     "  vec2 tex_coords;"
     "  vec3 normal;" 
     "  vec3 pixel_pos;"
+    "  vec4 color;"
     "} fs_in;"
     "\n"
     "#define POINT_LIGHTS_MAX 32"
@@ -81,7 +86,7 @@ inline nikola::GfxShaderDesc generate_blinn_phong_shader() {
     "vec3 spot_light();"
     "\n"
     "void main() {"
-    "  vec4 diffuse  = texture(u_material.diffuse_map, fs_in.tex_coords) * u_material.color;"
+    "  vec4 diffuse  = texture(u_material.diffuse_map, fs_in.tex_coords) * fs_in.color;"
     "  vec4 specular = texture(u_material.specular_map, fs_in.tex_coords);"
     "\n"
     "  vec3 point_lights_factor = vec3(0.0f);"
@@ -10,9 +10,13 @@ inline nikola::GfxShaderDesc generate_default_shader() {
     "layout (location = 1) in vec3 aNormal;"
     "layout (location = 2) in vec2 aTextureCoords;"
     "\n"
+    "layout (location = 8)  in mat4 aInstanceModel;"
+    "layout (location = 12) in vec4 aInstanceColor;"
+    "\n"
     "out VS_OUT {"
     "  vec2 tex_coords;"
     "  vec3 normal;"
+    "  vec4 color;"
     "} vs_out;"
     "\n"
     "layout (std140, binding = 0) uniform Matrices {"
@@ -20,13 +24,12 @@ inline nikola::GfxShaderDesc generate_default_shader() {
     "  mat4 u_projection;"
     "};"
     "\n"
-    "uniform mat4 u_model;"
-    "\n"
     "void main() {"
     "  vs_out.tex_coords = aTextureCoords;"
     "  vs_out.normal     = aNormal;"
+    "  vs_out.color      = aInstanceColor;"
     "\n"
-    "  vec4 world_pos = u_model * vec4(aPos, 1.0);"
+    "  vec4 world_pos = aInstanceModel * vec4(aPos, 1.0);"
     "  gl_Position    = u_projection * u_view * world_pos;"
     "}\n", 
 
@@ -37,20 +40,11 @@ inline nikola::GfxShaderDesc generate_default_shader() {
     "in VS_OUT {"
     "  vec2 tex_coords;"
     "  vec3 normal;"
-    "} fs_in;"
-    "\n"
-    "struct Material {"
-    "  sampler2D diffuse_map;" 
-    "  sampler2D specular_map;" 
-    "\n"
     "  vec4 color;"
-    "  float shininess;"
-    "};"
-    "\n"
-    "uniform Material u_material;"
+    "} fs_in;"
     "\n"
     "void main() {"
-    "  frag_color = u_material.color;"
+    "  frag_color = fs_in.color;"
     "}"
   };
 }
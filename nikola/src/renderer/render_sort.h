@@ -0,0 +1,55 @@
+#pragma once
+
+#include "nikola/nikola_base.h"
+#include "nikola/nikola_containers.h"
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace nikola { // Start of nikola
+
+/// ----------------------------------------------------------------------
+/// *** Render sort ***
+
+/// @NOTE: These are internal to the renderer. They only live in a header
+/// (and get exported) so the tests can get to them.
+
+/// ----------------------------------------------------------------------
+/// CommandPass
+enum CommandPass {
+  COMMAND_PASS_SCENE = 0,
+  COMMAND_PASS_DEBUG = 1,
+};
+/// CommandPass
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// SortEntry
+struct SortEntry {
+  u64 key;
+  u32 index;
+};
+/// SortEntry
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Render sort functions
+
+/// Return the sort key of a command in the given `pass`, using the given `ctx_id`, `mat_id`, and `mesh_id`,
+/// where `depth` goes from the near plane (`0`) to the far plane (`1`).
+///
+/// @NOTE: Sorting by the key draws every pass in order. Opaque commands come first, grouped by their state
+/// and front-to-back within the same state. Then come the translucent commands, back-to-front.
+NIKOLA_API const u64 render_sort_key(const CommandPass pass, const bool is_translucent, const f32 depth, const u64 ctx_id, const u64 mat_id, const u64 mesh_id);
+
+/// Stable sort the given `entries` by their keys, using `scratch` as the intermediate buffer.
+NIKOLA_API void render_radix_sort(DynamicArray<SortEntry>& entries, DynamicArray<SortEntry>& scratch);
+
+/// Render sort functions
+/// ----------------------------------------------------------------------
+
+/// *** Render sort ***
+/// ----------------------------------------------------------------------
+
+} // End of nikola
+
+//////////////////////////////////////////////////////////////////////////
@@ -3,14 +3,118 @@
 #include "nikola/nikola_gfx.h"
 #include "nikola/nikola_math.h"
 #include "nikola/nikola_physics.h"
+#include "nikola/nikola_profiler.h"
 
 #include "render_shaders.h"
 #include "light_shaders.h"
+#include "render_sort.h"
+
 
 //////////////////////////////////////////////////////////////////////////
 
 namespace nikola { // Start of nikola
 
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The maximum number of point lights the light shaders can take.
+///
+/// @NOTE: This must match `POINT_LIGHTS_MAX` in `light_shaders.h`.
+const sizei POINT_LIGHTS_MAX = 32;
+
+/// The maximum number of instances every segment of the instance buffer can hold.
+///
+/// @NOTE: Once a segment is full, the renderer moves on to the next one, even in the middle of a frame.
+const sizei INSTANCES_MAX = 65536;
+
+/// The amount of segments the instance buffer is split into. 
+/// The CPU writes into one segment while the GPU can still be reading from the others.
+const sizei INSTANCE_SEGMENTS_MAX = 3;
+
+/// The maximum number of indirect draws every segment of the indirect buffer can hold. 
+/// The indirect buffer is split into the same segments as the instance buffer.
+const sizei INDIRECT_DRAWS_MAX = 16384;
+
+/// The size (in bytes) of the vertex and index buffers of every geometry pool.
+const sizei GEOMETRY_POOL_VERTICES_SIZE = 32 * 1024 * 1024;
+const sizei GEOMETRY_POOL_INDICES_SIZE  = 16 * 1024 * 1024;
+
+/// The amount of bits each field takes up in the sort key of a `MeshRenderCommand`.
+/// From the most significant field to the least significant, the key is laid out as follows:
+///
+/// Opaque:      | pass | translucent (0) | shader context | material | mesh | depth |
+/// Translucent: | pass | translucent (1) | inverse depth | shader context | material | mesh |
+///
+/// @NOTE: Opaque meshes are drawn with as little state changes as possible, and front-to-back within 
+/// the same state. Translucent meshes, on the other hand, must be drawn back-to-front to blend correctly.
+const u64 SORT_KEY_PASS_BITS        = 2;
+const u64 SORT_KEY_TRANSLUCENT_BITS = 1;
+const u64 SORT_KEY_CONTEXT_BITS     = 8;
+const u64 SORT_KEY_MATERIAL_BITS    = 16;
+const u64 SORT_KEY_MESH_BITS        = 16;
+const u64 SORT_KEY_DEPTH_BITS       = 21;
+
+/// The amount of bits the radix sort goes through on every pass.
+const u64 RADIX_SORT_BITS = 8;
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Uniform names 
+
+/// Hashed at compile time, so setting them per draw doesn't build or hash any strings.
+/// The ones set once per frame are resolved into `UniformHandle`s at init.
+constexpr StringID UNIFORM_MODEL_MATRIX = string_id_literal(MATERIAL_UNIFORM_MODEL_MATRIX);
+constexpr StringID UNIFORM_COLOR        = string_id_literal(MATERIAL_UNIFORM_COLOR);
+
+constexpr StringID UNIFORM_AMBIENT            = string_id_literal("u_ambient");
+constexpr StringID UNIFORM_POINT_LIGHTS_COUNT = string_id_literal("u_point_lights_count");
+constexpr StringID UNIFORM_VIEW_POS           = string_id_literal("u_view_pos");
+constexpr StringID UNIFORM_EXPOSURE           = string_id_literal("u_exposure");
+
+constexpr StringID UNIFORM_DIR_LIGHT_DIRECTION = string_id_literal("u_dir_light.direction");
+constexpr StringID UNIFORM_DIR_LIGHT_COLOR     = string_id_literal("u_dir_light.color");
+
+/// Uniform names 
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// PointLightUniforms
+
+/// The handles of every member of a point light in the light shaders.
+/// Resolved once at init instead of looked up every frame. 
+struct PointLightUniforms {
+  UniformHandle position; 
+  UniformHandle color; 
+  UniformHandle linear; 
+  UniformHandle quadratic; 
+};
+/// PointLightUniforms
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// FrameUniforms
+
+/// The handles of every uniform the renderer sets once per frame.
+struct FrameUniforms {
+  UniformHandle ambient; 
+  UniformHandle point_lights_count; 
+  UniformHandle view_pos; 
+  UniformHandle exposure; 
+
+  UniformHandle dir_light_direction; 
+  UniformHandle dir_light_color; 
+
+  PointLightUniforms point_lights[POINT_LIGHTS_MAX];
+
+  /// The generations of the light and HDR contexts the handles were resolved at.
+  u32 blinn_generation = 0;
+  u32 hdr_generation   = 0;
+};
+/// FrameUniforms
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// ShaderContextID
 enum ShaderContextID {
@@ -30,29 +134,95 @@ struct RenderPassEntry {
   RenderPass pass; 
   RenderPassFn func; 
   void* user_data  = nullptr;
+
+  GfxQuery* query  = nullptr;
 };
 /// RenderPassEntry
 /// ----------------------------------------------------------------------
 
 /// ----------------------------------------------------------------------
 /// MeshRenderCommand
-struct MeshRenderCommand {
-  Transform transform = {};
 
+/// A compact draw packet. The model matrix lives in the renderer's frame-local 
+/// `transforms` array, so commands sharing a transform (like the meshes of a model) 
+/// only store it once.
+struct MeshRenderCommand {
   Mesh* mesh                    = nullptr; 
   Material* material            = nullptr; 
   ShaderContext* shader_context = nullptr;
 
+  u32 transform_index = 0;
+  CommandPass pass    = COMMAND_PASS_SCENE;
+
   // @TODO (Renderer): Temporary
   Vec4 color;
-
-  MeshRenderCommand(Mesh* mesh, const Transform& trans, Material* mat, ShaderContext* ctx, const Vec4& color = Vec4(1.0f)) 
-    :mesh(mesh), transform(trans), material(mat), shader_context(ctx), color(color)
-  {}
 };
 /// MeshRenderCommand
 /// ----------------------------------------------------------------------
 
+/// ----------------------------------------------------------------------
+/// InstanceData
+
+/// The per-instance data of the renderer's own shaders.
+///
+/// @NOTE: This must match the per-instance elements in `renderer_attach_instance_layout`.
+struct InstanceData {
+  Mat4 model;
+  Vec4 color;
+};
+/// InstanceData
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// InstanceBatch
+struct InstanceBatch {
+  MeshRenderCommand* command = nullptr; 
+
+  sizei count         = 0;
+  sizei base_instance = 0;
+
+  /// If `draws_count` is not `0`, the batch is a multi-draw of that many 
+  /// commands in the indirect buffer, starting at `first_draw`.
+  sizei first_draw  = 0;
+  sizei draws_count = 0;
+};
+/// InstanceBatch
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// PoolRange
+
+/// A range of a geometry pool's buffer, in bytes.
+struct PoolRange {
+  sizei offset = 0;
+  sizei size   = 0;
+};
+/// PoolRange
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// GeometryPool
+
+/// The geometry of every mesh sharing the same vertex format, copied into one 
+/// vertex buffer and one index buffer. Since they can all be read through the same 
+/// pipeline, any run of these meshes can be drawn using a single multi-draw indirect call.
+struct GeometryPool {
+  GfxPipelineDesc pipe_desc = {};
+  GfxPipeline* pipe         = nullptr;
+
+  sizei vertex_stride = 0;
+
+  /// How far into the buffers anything was placed, in bytes.
+  sizei vertices_size = 0;
+  sizei indices_size  = 0;
+
+  /// The ranges (below the sizes above) given back by destroyed meshes, sorted by their offset.
+  DynamicArray<PoolRange> free_vertices;
+  DynamicArray<PoolRange> free_indices;
+};
+/// GeometryPool
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// Renderer
 struct Renderer {
@@ -68,9 +238,50 @@ struct Renderer {
   
   FrameData* frame_data;
   DynamicArray<RenderPassEntry> render_passes;
+  DynamicArray<RenderTiming> timings;
 
+  /// Every queued command of the frame (debug meshes included), and the model matrices they point to.
   DynamicArray<MeshRenderCommand> render_queue;
-  DynamicArray<MeshRenderCommand> debug_queue;
+  DynamicArray<Mat4> transforms;
+
+  /// Scratch space for culling, kept around to not re-allocate every frame.
+  DynamicArray<AABB> world_bounds;
+  DynamicArray<u8> visibility;
+
+  /// The order the commands of the queue are flushed in, and the scratch space of the sort.
+  DynamicArray<SortEntry> sorted_commands;
+  DynamicArray<SortEntry> sort_scratch;
+
+  /// Small per-frame IDs of every resource that makes it into a sort key.
+  HashMap<const void*, u32> context_ids;
+  HashMap<const void*, u32> material_ids;
+  HashMap<const void*, u32> mesh_ids;
+
+  /// The state last used while flushing the queue, so it does not get bound twice.
+  ShaderContext* bound_context = nullptr;
+  Material* bound_material     = nullptr;
+
+  /// The persistently mapped memory of the instance buffer, and a fence for every one of its segments.
+  InstanceData* instances_mapped = nullptr;
+  GfxFence* instance_fences[INSTANCE_SEGMENTS_MAX];
+
+  /// The segment currently written to, and how many instances were written into it.
+  sizei instance_segment = 0;
+  sizei instances_count  = 0;
+
+  /// The instanced draw calls reading from the current segment, which were not issued yet.
+  DynamicArray<InstanceBatch> instance_batches;
+
+  /// The persistently mapped indirect buffer, and how many draws were written into its current segment.
+  GfxBuffer* indirect_buffer              = nullptr;
+  GfxDrawIndirectCommand* indirect_mapped = nullptr;
+  sizei indirect_count                    = 0;
+
+  DynamicArray<GeometryPool> geometry_pools;
+
+  RendererStats stats = {};
+
+  FrameUniforms uniforms;
 };
 
 static Renderer s_renderer{};
@@ -80,11 +291,12 @@ static Renderer s_renderer{};
 /// ----------------------------------------------------------------------
 /// Private functions
 
-static void init_context(Window* window) { 
+static void init_context(Window* window, const bool is_headless) { 
   GfxContextDesc gfx_desc = {
     .window       = window,
     .states       = GFX_STATE_DEPTH | GFX_STATE_STENCIL | GFX_STATE_BLEND,
     .has_vsync    = false,
+    .is_headless  = is_headless,
   };
   
   s_renderer.context = gfx_context_init(gfx_desc);
@@ -121,6 +333,33 @@ static void init_defaults() {
   // Material init
   s_renderer.defaults.material = resources_get_material(resources_push_material(RESOURCE_CACHE_ID, default_texture_id));
 
+  // Instance buffer init
+  //
+  // @NOTE: This must come before any mesh is created, 
+  // so they can all pick it up.
+  GfxBufferDesc instance_desc = {
+    .data  = nullptr, 
+    .size  = sizeof(InstanceData) * INSTANCES_MAX * INSTANCE_SEGMENTS_MAX,
+    .type  = GFX_BUFFER_VERTEX,
+    .usage = GFX_BUFFER_USAGE_PERSISTENT_MAP,
+  };
+  s_renderer.defaults.instance_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, instance_desc));
+  s_renderer.instances_mapped         = (InstanceData*)gfx_buffer_map(s_renderer.defaults.instance_buffer);
+
+  for(sizei i = 0; i < INSTANCE_SEGMENTS_MAX; i++) {
+    s_renderer.instance_fences[i] = gfx_fence_create(s_renderer.context);
+  }
+
+  // Indirect buffer init
+  GfxBufferDesc indirect_desc = {
+    .data  = nullptr, 
+    .size  = sizeof(GfxDrawIndirectCommand) * INDIRECT_DRAWS_MAX * INSTANCE_SEGMENTS_MAX,
+    .type  = GFX_BUFFER_DRAW_INDIRECT,
+    .usage = GFX_BUFFER_USAGE_PERSISTENT_MAP,
+  };
+  s_renderer.indirect_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, indirect_desc));
+  s_renderer.indirect_mapped = (GfxDrawIndirectCommand*)gfx_buffer_map(s_renderer.indirect_buffer);
+
   // Cube mesh init
   s_renderer.defaults.cube_mesh = resources_get_mesh(resources_push_mesh(RESOURCE_CACHE_ID, GEOMETRY_CUBE));
 
@@ -139,6 +378,47 @@ static void init_defaults() {
   s_renderer.shader_contexts[SHADER_CONTEXT_BLINN]       = resources_push_shader_context(RESOURCE_CACHE_ID, blinn_phong_shader);
 }
 
+static void init_uniform_handles() {
+  ShaderContext* blinn_ctx = resources_get_shader_context(s_renderer.shader_contexts[SHADER_CONTEXT_BLINN]);
+  ShaderContext* hdr_ctx   = resources_get_shader_context(s_renderer.shader_contexts[SHADER_CONTEXT_HDR]);
+
+  FrameUniforms& uniforms = s_renderer.uniforms;
+
+  uniforms.blinn_generation = blinn_ctx->generation;
+  uniforms.hdr_generation   = hdr_ctx->generation;
+
+  uniforms.ambient            = shader_context_resolve_uniform(blinn_ctx, UNIFORM_AMBIENT);
+  uniforms.point_lights_count = shader_context_resolve_uniform(blinn_ctx, UNIFORM_POINT_LIGHTS_COUNT);
+  uniforms.view_pos           = shader_context_resolve_uniform(blinn_ctx, UNIFORM_VIEW_POS);
+  uniforms.exposure           = shader_context_resolve_uniform(hdr_ctx, UNIFORM_EXPOSURE);
+
+  uniforms.dir_light_direction = shader_context_resolve_uniform(blinn_ctx, UNIFORM_DIR_LIGHT_DIRECTION);
+  uniforms.dir_light_color     = shader_context_resolve_uniform(blinn_ctx, UNIFORM_DIR_LIGHT_COLOR);
+
+  for(sizei i = 0; i < POINT_LIGHTS_MAX; i++) {
+    String point_index = "u_point_lights[" + std::to_string(i) + "].";
+
+    uniforms.point_lights[i] = PointLightUniforms {
+      .position  = shader_context_resolve_uniform(blinn_ctx, string_id_intern((point_index + "position").c_str())),
+      .color     = shader_context_resolve_uniform(blinn_ctx, string_id_intern((point_index + "color").c_str())),
+      .linear    = shader_context_resolve_uniform(blinn_ctx, string_id_intern((point_index + "linear").c_str())),
+      .quadratic = shader_context_resolve_uniform(blinn_ctx, string_id_intern((point_index + "quadratic").c_str())),
+    };
+  }
+}
+
+static void refresh_uniform_handles() {
+  ShaderContext* blinn_ctx = resources_get_shader_context(s_renderer.shader_contexts[SHADER_CONTEXT_BLINN]);
+  ShaderContext* hdr_ctx   = resources_get_shader_context(s_renderer.shader_contexts[SHADER_CONTEXT_HDR]);
+
+  // Nothing got reloaded since the handles were resolved
+  if(blinn_ctx->generation == s_renderer.uniforms.blinn_generation && hdr_ctx->generation == s_renderer.uniforms.hdr_generation) {
+    return;
+  }
+
+  init_uniform_handles();
+}
+
 static void init_pipeline() {
   f32 vertices[] = {
     // Position    // Texture coords
@@ -184,16 +464,27 @@ static void init_pipeline() {
   s_renderer.pipeline = gfx_pipeline_create(s_renderer.context, s_renderer.pipe_desc);
 }
 
+static void use_command_state(const MeshRenderCommand& command) {
+  // Only switch whatever changed since the last draw
+
+  if(command.shader_context != s_renderer.bound_context) {
+    shader_context_use(command.shader_context);
+    s_renderer.bound_context = command.shader_context;
+  }
+
+  if(command.material != s_renderer.bound_material) {
+    material_use(command.material);  
+    s_renderer.bound_material = command.material;
+  }
+}
+
 static void render_mesh(MeshRenderCommand& command) {
   // Setting uniforms 
-  shader_context_set_uniform(command.shader_context, MATERIAL_UNIFORM_MODEL_MATRIX, command.transform.transform);
-  shader_context_set_uniform(command.shader_context, MATERIAL_UNIFORM_COLOR, command.color);
+  shader_context_set_uniform(command.shader_context, UNIFORM_MODEL_MATRIX, s_renderer.transforms[command.transform_index]);
+  shader_context_set_uniform(command.shader_context, UNIFORM_COLOR, command.color);
 
-  // Using the shader 
-  shader_context_use(command.shader_context);
-
-  // Using the internal material data
-  material_use(command.material);  
+  // Using the shader and the internal material data
+  use_command_state(command);
 
   // Draw the mesh
   gfx_pipeline_draw_index(command.mesh->pipe);
@@ -279,39 +570,439 @@ static void end_pass(RenderPass& pass) {
   gfx_pipeline_draw_index(s_renderer.pipeline);
 }
 
+static bool is_same_batch(const MeshRenderCommand& a, const MeshRenderCommand& b) {
+  return a.shader_context == b.shader_context && 
+         a.material == b.material && 
+         a.mesh == b.mesh;
+}
+
+static bool is_instanced_batch(const MeshRenderCommand& command, const ShaderContext* default_ctx, const ShaderContext* blinn_ctx) {
+  // Only the renderer's own shaders know about the per-instance data
+  bool is_builtin_context = command.shader_context == default_ctx || command.shader_context == blinn_ctx;
+  return is_builtin_context && command.mesh->pipe_desc.instance_buffer;
+}
+
+static bool is_same_layout(const GfxPipelineDesc& a, const GfxPipelineDesc& b) {
+  if(a.layout_count != b.layout_count || a.draw_mode != b.draw_mode) {
+    return false;
+  }
+
+  for(sizei i = 0; i < a.layout_count; i++) {
+    if(a.layout[i].type != b.layout[i].type || a.layout[i].instance_rate != b.layout[i].instance_rate) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static i32 get_geometry_pool(const GfxPipelineDesc& desc) {
+  for(sizei i = 0; i < s_renderer.geometry_pools.size(); i++) {
+    if(is_same_layout(s_renderer.geometry_pools[i].pipe_desc, desc)) {
+      return (i32)i;
+    }
+  }
+
+  // A new vertex format
+  GeometryPool pool = {
+    .pipe_desc     = desc,
+    .vertex_stride = gfx_pipeline_get_vertex_stride(desc),
+  };
+
+  GfxBufferDesc buff_desc = {
+    .data  = nullptr, 
+    .size  = GEOMETRY_POOL_VERTICES_SIZE,
+    .type  = GFX_BUFFER_VERTEX,
+    .usage = GFX_BUFFER_USAGE_STATIC_DRAW,
+  };
+  pool.pipe_desc.vertex_buffer  = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
+  pool.pipe_desc.vertices_count = 0;
+
+  buff_desc.size = GEOMETRY_POOL_INDICES_SIZE;
+  buff_desc.type = GFX_BUFFER_INDEX;
+
+  pool.pipe_desc.index_buffer  = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
+  pool.pipe_desc.indices_count = 0;
+
+  pool.pipe = gfx_pipeline_create(s_renderer.context, pool.pipe_desc);
+
+  s_renderer.geometry_pools.push_back(pool);
+  return (i32)(s_renderer.geometry_pools.size() - 1);
+}
+
+static bool pool_range_allocate(DynamicArray<PoolRange>& free_ranges, sizei& end, const sizei capacity, const sizei size, sizei* offset) {
+  // Anything given back comes first. Every range is made of whole vertices (or indices), 
+  // so whatever is left of a range is still usable.
+  for(sizei i = 0; i < free_ranges.size(); i++) {
+    PoolRange& range = free_ranges[i];
+    if(range.size < size) {
+      continue;
+    }
+
+    *offset       = range.offset;
+    range.offset += size;
+    range.size   -= size;
+
+    if(range.size == 0) {
+      free_ranges.erase(free_ranges.begin() + i);
+    }
+
+    return true;
+  }
+
+  if((end + size) > capacity) {
+    return false;
+  }
+
+  *offset = end;
+  end    += size;
+
+  return true;
+}
+
+static void pool_range_free(DynamicArray<PoolRange>& free_ranges, sizei& end, const sizei offset, const sizei size) {
+  // Keep the ranges sorted, so neighbours can be merged
+  auto it = std::lower_bound(free_ranges.begin(), free_ranges.end(), offset, [](const PoolRange& range, const sizei value) {
+    return range.offset < value;
+  });
+  it = free_ranges.insert(it, PoolRange{offset, size});
+
+  auto next = it + 1;
+  if(next != free_ranges.end() && (it->offset + it->size) == next->offset) {
+    it->size += next->size;
+    free_ranges.erase(next);
+  }
+
+  if(it != free_ranges.begin()) {
+    auto prev = it - 1;
+    if((prev->offset + prev->size) == it->offset) {
+      prev->size += it->size;
+      it          = free_ranges.erase(it) - 1;
+    }
+  }
+
+  // Nothing comes after the range, so the pool just got smaller
+  if((it->offset + it->size) == end) {
+    end = it->offset;
+    free_ranges.erase(it);
+  }
+}
+
+static void push_batch(MeshRenderCommand* command, const sizei count, const sizei base_instance) {
+  Mesh* mesh = command->mesh;
+
+  // Only meshes in a pool can be drawn indirectly
+  if(mesh->geometry_pool == -1) {
+    s_renderer.instance_batches.push_back(InstanceBatch {
+      .command       = command,
+      .count         = count, 
+      .base_instance = base_instance,
+    });
+
+    return;
+  }
+
+  sizei draw = (s_renderer.instance_segment * INDIRECT_DRAWS_MAX) + s_renderer.indirect_count;
+  s_renderer.indirect_count++;
+
+  s_renderer.indirect_mapped[draw] = GfxDrawIndirectCommand {
+    .indices_count   = (u32)mesh->pipe_desc.indices_count, 
+    .instances_count = (u32)count, 
+    .first_index     = mesh->first_index,
+    .base_vertex     = mesh->base_vertex,
+    .base_instance   = (u32)base_instance,
+  };
+  gfx_buffer_mark_written(s_renderer.indirect_buffer, 
+                          draw * sizeof(GfxDrawIndirectCommand), 
+                          sizeof(GfxDrawIndirectCommand));
+
+  // Keep the whole run of meshes (of the same pool) with the same state in a single draw call
+  if(!s_renderer.instance_batches.empty()) {
+    InstanceBatch& last = s_renderer.instance_batches.back();
+
+    bool can_merge = last.draws_count > 0 && 
+                     last.command->shader_context == command->shader_context && 
+                     last.command->material == command->material && 
+                     last.command->mesh->geometry_pool == mesh->geometry_pool;
+
+    if(can_merge) {
+      last.draws_count++;
+      return;
+    }
+  }
+
+  s_renderer.instance_batches.push_back(InstanceBatch {
+    .command       = command,
+    .count         = count, 
+    .base_instance = base_instance,
+    .first_draw    = draw,
+    .draws_count   = 1,
+  });
+}
+
+static void flush_instances() {
+  // The instances (and the indirect draws) are already in their buffers, 
+  // since they were written straight into their mapped memory
+  for(auto& batch : s_renderer.instance_batches) {
+    use_command_state(*batch.command);
+
+    if(batch.draws_count == 0) {
+      gfx_pipeline_draw_index_instanced(batch.command->mesh->pipe, batch.count, batch.base_instance);
+      continue;
+    }
+
+    GeometryPool& pool = s_renderer.geometry_pools[batch.command->mesh->geometry_pool];
+    gfx_pipeline_draw_indirect(pool.pipe, 
+                               s_renderer.indirect_buffer, 
+                               batch.draws_count, 
+                               batch.first_draw * sizeof(GfxDrawIndirectCommand));
+  }
+
+  s_renderer.instance_batches.clear();
+}
+
+static void next_instance_segment() {
+  // Let the GPU tell us when it is done with the segment we are leaving
+  gfx_fence_insert(s_renderer.instance_fences[s_renderer.instance_segment]);
+
+  s_renderer.instance_segment = (s_renderer.instance_segment + 1) % INSTANCE_SEGMENTS_MAX;
+  s_renderer.instances_count  = 0;
+  s_renderer.indirect_count   = 0;
+
+  // The GPU might still be reading from the new segment 
+  NIKOLA_PROFILE_SCOPE("Wait for instance segment");
+  if(!gfx_fence_wait(s_renderer.instance_fences[s_renderer.instance_segment], 1000000000)) {
+    NIKOLA_LOG_WARN("The GPU took more than a second to finish with an instance segment");
+  }
+}
+
+static void push_instances(DynamicArray<MeshRenderCommand>& queue, const sizei first, const sizei count) {
+  sizei pushed = 0;
+
+  while(pushed < count) {
+    // The current segment is full, so draw whatever is in it and move on
+    if(s_renderer.instances_count == INSTANCES_MAX || s_renderer.indirect_count == INDIRECT_DRAWS_MAX) {
+      flush_instances();
+      next_instance_segment();
+
+      continue;
+    }
+
+    sizei space_left  = INSTANCES_MAX - s_renderer.instances_count;
+    sizei batch_count = (count - pushed) < space_left ? (count - pushed) : space_left;
+    sizei base        = (s_renderer.instance_segment * INSTANCES_MAX) + s_renderer.instances_count;
+
+    push_batch(&queue[s_renderer.sorted_commands[first + pushed].index], batch_count, base);
+
+    // Written linearly into the mapped memory. The GPU finds them through the base instance of the draw call.
+    InstanceData* out = &s_renderer.instances_mapped[base];
+    for(sizei i = 0; i < batch_count; i++) {
+      MeshRenderCommand& command = queue[s_renderer.sorted_commands[first + pushed + i].index];
+
+      out[i].model = s_renderer.transforms[command.transform_index];
+      out[i].color = command.color;
+    }
+    gfx_buffer_mark_written(s_renderer.defaults.instance_buffer, 
+                            base * sizeof(InstanceData), 
+                            batch_count * sizeof(InstanceData));
+
+    s_renderer.instances_count += batch_count;
+    pushed                     += batch_count;
+  }
+}
+
 static void flush_queue(DynamicArray<MeshRenderCommand>& queue) {
-  for(auto& command : queue) {
-    render_mesh(command);
+  NIKOLA_PROFILE_FUNCTION();
+
+  if(queue.empty()) {
+    return;
+  }
+
+  // Anything could have been bound before the queue
+  s_renderer.bound_context  = nullptr;
+  s_renderer.bound_material = nullptr;
+
+  ShaderContext* default_ctx = resources_get_shader_context(s_renderer.shader_contexts[SHADER_CONTEXT_DEFAULT]);
+  ShaderContext* blinn_ctx   = resources_get_shader_context(s_renderer.shader_contexts[SHADER_CONTEXT_BLINN]);
+
+  // Every run of similar commands (which the sort already put next to each other) becomes a batch
+  DynamicArray<SortEntry>& sorted = s_renderer.sorted_commands;
+
+  for(sizei i = 0; i < sorted.size();) {
+    MeshRenderCommand& first = queue[sorted[i].index];
+
+    sizei count = 1;
+    while((i + count) < sorted.size() && is_same_batch(first, queue[sorted[i + count].index])) {
+      count++;
+    }
+
+    if(is_instanced_batch(first, default_ctx, blinn_ctx)) {
+      push_instances(queue, i, count);
+    }
+    else {
+      // Keep the draw calls in order
+      flush_instances();
+
+      for(sizei j = 0; j < count; j++) {
+        render_mesh(queue[sorted[i + j].index]);
+      }
+    }
+
+    i += count;
+  }
+
+  flush_instances();
+}
+
+static u64 get_sort_id(HashMap<const void*, u32>& ids, const void* resource, const u64 bits) {
+  // Every new resource gets the next ID. Wrapping around only makes the sort a little less ideal.
+  u32 next_id = (u32)ids.size();
+  u32 id      = ids.emplace(resource, next_id).first->second;
+
+  return (u64)id & ((1ull << bits) - 1);
+}
+
+static u64 make_sort_key(const MeshRenderCommand& command, const Camera& camera) {
+  u64 ctx_id  = get_sort_id(s_renderer.context_ids, command.shader_context, SORT_KEY_CONTEXT_BITS);
+  u64 mat_id  = get_sort_id(s_renderer.material_ids, command.material, SORT_KEY_MATERIAL_BITS);
+  u64 mesh_id = get_sort_id(s_renderer.mesh_ids, command.mesh, SORT_KEY_MESH_BITS);
+
+  // How far into the view the mesh is, from the near plane (`0`) to the far plane (`1`)
+  const Mat4& model = s_renderer.transforms[command.transform_index];
+  const Mat4& view  = camera.view;
+
+  f32 view_depth = -((view[0][2] * model[3][0]) + (view[1][2] * model[3][1]) + (view[2][2] * model[3][2]) + view[3][2]);
+  f32 depth      = (view_depth - camera.near) / (camera.far - camera.near);
+
+  bool is_translucent = command.color.a < 1.0f || command.material->color.a < 1.0f;
+  return render_sort_key(command.pass, is_translucent, depth, ctx_id, mat_id, mesh_id);
+}
+
+static void sort_queue(DynamicArray<MeshRenderCommand>& queue, const Camera& camera) {
+  NIKOLA_PROFILE_FUNCTION();
+
+  DynamicArray<SortEntry>& sorted = s_renderer.sorted_commands;
+  sorted.resize(queue.size());
+
+  for(sizei i = 0; i < queue.size(); i++) {
+    sorted[i] = SortEntry {
+      .key   = make_sort_key(queue[i], camera),
+      .index = (u32)i,
+    };
+  }
+
+  render_radix_sort(sorted, s_renderer.sort_scratch);
+}
+
+static u32 push_transform(const Transform& transform) {
+  // Any transform that was left dirty gets its matrix rebuilt here, at the latest
+  if(transform.is_dirty) {
+    Transform updated = transform;
+    transform_update(updated);
+
+    s_renderer.transforms.push_back(updated.transform);
+  }
+  else {
+    s_renderer.transforms.push_back(transform.transform);
+  }
+
+  return (u32)(s_renderer.transforms.size() - 1);
+}
+
+static void push_command(Mesh* mesh, const u32 transform_index, Material* mat, ShaderContext* ctx, const CommandPass pass, const Vec4& color = Vec4(1.0f)) {
+  s_renderer.render_queue.push_back(MeshRenderCommand {
+    .mesh            = mesh, 
+    .material        = mat, 
+    .shader_context  = ctx,
+    .transform_index = transform_index,
+    .pass            = pass,
+    .color           = color,
+  });
+}
+
+static void cull_queue(DynamicArray<MeshRenderCommand>& queue, const Camera& camera) {
+  NIKOLA_PROFILE_FUNCTION();
+
+  s_renderer.stats.meshes_queued = 0;
+  s_renderer.stats.meshes_culled = 0;
+
+  if(queue.empty()) {
+    return;
+  }
+
+  // Bring every mesh's bounds into world space
+  s_renderer.world_bounds.resize(queue.size());
+  s_renderer.visibility.resize(queue.size());
+
+  for(sizei i = 0; i < queue.size(); i++) {
+    s_renderer.world_bounds[i] = aabb_transform(queue[i].mesh->bounds, s_renderer.transforms[queue[i].transform_index]);
+  }
+
+  Frustum frustum     = frustum_from_matrix(camera.view_projection);
+  sizei visible_count = frustum_cull_aabbs(frustum, s_renderer.world_bounds.data(), queue.size(), s_renderer.visibility.data());
+
+  // Debug meshes are always drawn
+  for(sizei i = 0; i < queue.size(); i++) {
+    if(queue[i].pass == COMMAND_PASS_DEBUG) {
+      visible_count           += s_renderer.visibility[i] ? 0 : 1;
+      s_renderer.visibility[i] = 1;
+
+      continue;
+    }
+
+    s_renderer.stats.meshes_queued++;
   }
+
+  // Nothing to take out
+  if(visible_count == queue.size()) {
+    return;
+  }
+
+  // Keep the visible commands in the order they were queued
+  sizei new_size = 0;
+  for(sizei i = 0; i < queue.size(); i++) {
+    if(!s_renderer.visibility[i]) {
+      continue;
+    }
+
+    if(new_size != i) {
+      queue[new_size] = queue[i];
+    }
+    new_size++;
+  }
+
+  s_renderer.stats.meshes_culled = queue.size() - new_size;
+  queue.erase(queue.begin() + new_size, queue.end());
 }
 
 static void use_directional_light(DirectionalLight& light, ShaderContext* ctx) {
-  shader_context_set_uniform(ctx, "u_dir_light.direction", light.direction); 
-  shader_context_set_uniform(ctx, "u_dir_light.color", light.color); 
+  shader_context_set_uniform(ctx, s_renderer.uniforms.dir_light_direction, light.direction); 
+  shader_context_set_uniform(ctx, s_renderer.uniforms.dir_light_color, light.color); 
 }
 
 static void use_point_lights(DynamicArray<PointLight>& lights, ShaderContext* ctx) {
-  i32 index = 0;
+  sizei count = lights.size() < POINT_LIGHTS_MAX ? lights.size() : POINT_LIGHTS_MAX;
 
-  for(auto& point : lights) {
-    String point_index = "u_point_lights[" + std::to_string(index) + "].";
+  for(sizei i = 0; i < count; i++) {
+    PointLight& point            = lights[i];
+    PointLightUniforms& uniforms = s_renderer.uniforms.point_lights[i];
 
-    shader_context_set_uniform(ctx, (point_index + "position"), point.position); 
-    shader_context_set_uniform(ctx, (point_index + "color"), point.color); 
+    shader_context_set_uniform(ctx, uniforms.position, point.position); 
+    shader_context_set_uniform(ctx, uniforms.color, point.color); 
 
-    shader_context_set_uniform(ctx, (point_index + "linear"), point.linear); 
-    shader_context_set_uniform(ctx, (point_index + "quadratic"), point.quadratic); 
-  
-    index++;
+    shader_context_set_uniform(ctx, uniforms.linear, point.linear); 
+    shader_context_set_uniform(ctx, uniforms.quadratic, point.quadratic); 
   }
 }
 
 static void setup_light_enviornment(FrameData& data) {
   ShaderContext* ctx = resources_get_shader_context(s_renderer.shader_contexts[SHADER_CONTEXT_BLINN]);
   
-  shader_context_set_uniform(ctx, "u_ambient", data.ambient); 
-  shader_context_set_uniform(ctx, "u_point_lights_count", (i32)data.point_lights.size()); 
-  shader_context_set_uniform(ctx, "u_view_pos", data.camera.direction); 
+  i32 point_lights_count = (i32)(data.point_lights.size() < POINT_LIGHTS_MAX ? data.point_lights.size() : POINT_LIGHTS_MAX);
+
+  shader_context_set_uniform(ctx, s_renderer.uniforms.ambient, data.ambient); 
+  shader_context_set_uniform(ctx, s_renderer.uniforms.point_lights_count, point_lights_count); 
+  shader_context_set_uniform(ctx, s_renderer.uniforms.view_pos, data.camera.direction); 
 
   use_directional_light(data.dir_light, ctx);
   use_point_lights(data.point_lights, ctx);
@@ -329,15 +1020,12 @@ static void light_pass_fn(const RenderPass* previous, RenderPass* current, void*
     render_skybox(s_renderer.frame_data->skybox_id);
   }
 
-  // Render the frame with the light data 
+  // Render the frame with the light data. 
+  // The debug meshes come last, since their sort keys start with a later pass.
   flush_queue(s_renderer.render_queue);
 
-  // @TODO (Renderer): Probably better not to flush 
-  // the debug queue here. But, oh well. 
-  flush_queue(s_renderer.debug_queue);
-
   // Updating some HDR uniforms
-  shader_context_set_uniform(resources_get_shader_context(s_renderer.shader_contexts[SHADER_CONTEXT_HDR]), "u_exposure", s_renderer.frame_data->camera.exposure);
+  shader_context_set_uniform(resources_get_shader_context(s_renderer.shader_contexts[SHADER_CONTEXT_HDR]), s_renderer.uniforms.exposure, s_renderer.frame_data->camera.exposure);
 }
 
 /// Callbacks 
@@ -346,19 +1034,16 @@ static void light_pass_fn(const RenderPass* previous, RenderPass* current, void*
 ///---------------------------------------------------------------------------------------------------------------------
 /// Renderer functions
 
-void renderer_init(Window* window) {
-  // Context init 
-  init_context(window);
-  
-  i32 width, height;
-  window_get_size(window, &width, &height); 
-
+static void init_renderer(const i32 width, const i32 height) {
   // Defaults init
   init_defaults();
 
   // Pipeline init
   init_pipeline();
 
+  // Uniform handles init
+  init_uniform_handles();
+
   // Light pass init
   nikola::RenderPassDesc light_pass = {
     .frame_size        = Vec2(width, height), 
@@ -374,18 +1059,48 @@ void renderer_init(Window* window) {
       .type = GFX_TEXTURE_DEPTH_STENCIL_TARGET, 
       .format = GFX_TEXTURE_FORMAT_DEPTH_STENCIL_24_8
   });
+  light_pass.name = "Light pass";
   renderer_push_pass(light_pass, light_pass_fn, nullptr);
+}
+
+void renderer_init(Window* window) {
+  // Context init 
+  init_context(window, false);
   
+  i32 width, height;
+  window_get_size(window, &width, &height); 
+
+  init_renderer(width, height);
   NIKOLA_LOG_INFO("Successfully initialized the renderer context");
 }
 
+void renderer_init_headless(const i32 width, const i32 height) {
+  // Context init 
+  init_context(nullptr, true);
+  
+  init_renderer(width, height);
+  NIKOLA_LOG_INFO("Successfully initialized a headless renderer context");
+}
+
 void renderer_shutdown() {
   for(auto& entry : s_renderer.render_passes) {
     gfx_framebuffer_destroy(entry.pass.frame);
+    gfx_query_destroy(entry.query, gfx_query_pool_free);
+  }
+
+  for(sizei i = 0; i < INSTANCE_SEGMENTS_MAX; i++) {
+    gfx_fence_destroy(s_renderer.instance_fences[i]);
   }
 
+  // The buffers of the pools belong to the resource cache
+  for(auto& pool : s_renderer.geometry_pools) {
+    gfx_pipeline_destroy(pool.pipe);
+  }
   gfx_pipeline_destroy(s_renderer.pipeline);
   gfx_context_shutdown(s_renderer.context);
+
+  // Start over from nothing, so the renderer can be initialized again
+  s_renderer = Renderer{};
   
   NIKOLA_LOG_INFO("Successfully shutdown the renderer context");
 }
@@ -398,6 +1113,90 @@ const RendererDefaults& renderer_get_defaults() {
   return s_renderer.defaults;
 }
 
+void renderer_attach_instance_layout(GfxPipelineDesc& desc) {
+  // The renderer is not initialized yet
+  if(!s_renderer.defaults.instance_buffer) {
+    return;
+  }
+
+  NIKOLA_ASSERT(((desc.layout_count + 2) <= LAYOUT_ELEMENTS_MAX), "Not enough room left in the layout for the per-instance elements");
+
+  desc.layout[desc.layout_count++] = GfxLayoutDesc{"INSTANCE_MODEL", GFX_LAYOUT_MAT4, 1};
+  desc.layout[desc.layout_count++] = GfxLayoutDesc{"INSTANCE_COLOR", GFX_LAYOUT_FLOAT4, 1};
+
+  desc.instance_buffer = s_renderer.defaults.instance_buffer;
+}
+
+void renderer_share_mesh_geometry(Mesh* mesh) {
+  NIKOLA_ASSERT(mesh, "Invalid Mesh given to renderer_share_mesh_geometry");
+
+  // Only instanced meshes ever get drawn indirectly
+  GfxPipelineDesc& desc = mesh->pipe_desc;
+  if(!desc.instance_buffer || !desc.index_buffer) {
+    return;
+  }
+
+  GeometryPool& pool = s_renderer.geometry_pools[get_geometry_pool(desc)];
+
+  sizei vertices_size = gfx_buffer_get_desc(desc.vertex_buffer).size;
+  sizei indices_size  = desc.indices_count * sizeof(u32);
+
+  // Anything but whole vertices would throw off every mesh after it
+  if(pool.vertex_stride == 0 || (vertices_size % pool.vertex_stride) != 0) {
+    return;
+  }
+
+  sizei vertices_offset, indices_offset;
+  if(!pool_range_allocate(pool.free_vertices, pool.vertices_size, GEOMETRY_POOL_VERTICES_SIZE, vertices_size, &vertices_offset)) {
+    NIKOLA_LOG_WARN("A geometry pool ran out of space. The mesh will be drawn on its own");
+    return;
+  }
+
+  if(!pool_range_allocate(pool.free_indices, pool.indices_size, GEOMETRY_POOL_INDICES_SIZE, indices_size, &indices_offset)) {
+    pool_range_free(pool.free_vertices, pool.vertices_size, vertices_offset, vertices_size);
+
+    NIKOLA_LOG_WARN("A geometry pool ran out of space. The mesh will be drawn on its own");
+    return;
+  }
+
+  // Every copy starts on a whole vertex, so the indices only need to be offset by `base_vertex`
+  gfx_buffer_copy(pool.pipe_desc.vertex_buffer, vertices_offset, desc.vertex_buffer, 0, vertices_size);
+  gfx_buffer_copy(pool.pipe_desc.index_buffer, indices_offset, desc.index_buffer, 0, indices_size);
+
+  mesh->geometry_pool = (i32)(&pool - s_renderer.geometry_pools.data());
+  mesh->base_vertex   = (i32)(vertices_offset / pool.vertex_stride);
+  mesh->first_index   = (u32)(indices_offset / sizeof(u32));
+
+  // The buffers of the mesh can still change size later on, but this is what the pool gave out
+  mesh->pool_vertices_size = vertices_size;
+  mesh->pool_indices_size  = indices_size;
+
+  s_renderer.stats.geometry_pools_used += vertices_size + indices_size;
+}
+
+void renderer_release_mesh_geometry(Mesh* mesh) {
+  NIKOLA_ASSERT(mesh, "Invalid Mesh given to renderer_release_mesh_geometry");
+
+  // The pools are already gone if the renderer was shutdown first
+  if(mesh->geometry_pool == -1 || mesh->geometry_pool >= (i32)s_renderer.geometry_pools.size()) {
+    mesh->geometry_pool = -1;
+    return;
+  }
+
+  GeometryPool& pool = s_renderer.geometry_pools[mesh->geometry_pool];
+
+  pool_range_free(pool.free_vertices, pool.vertices_size, (sizei)mesh->base_vertex * pool.vertex_stride, mesh->pool_vertices_size);
+  pool_range_free(pool.free_indices, pool.indices_size, (sizei)mesh->first_index * sizeof(u32), mesh->pool_indices_size);
+
+  s_renderer.stats.geometry_pools_used -= mesh->pool_vertices_size + mesh->pool_indices_size;
+
+  mesh->geometry_pool      = -1;
+  mesh->base_vertex        = 0;
+  mesh->first_index        = 0;
+  mesh->pool_vertices_size = 0;
+  mesh->pool_indices_size  = 0;
+}
+
 void renderer_set_clear_color(const Vec4& clear_color) {
   s_renderer.clear_color = clear_color;
 }
@@ -410,9 +1209,14 @@ void renderer_push_pass(const RenderPassDesc& desc, const RenderPassFn& func, co
   RenderPassEntry entry;
   entry.func      = func; 
   entry.user_data = (void*)user_data;
+  entry.query     = gfx_query_create(s_renderer.context, GfxQueryDesc{.type = GFX_QUERY_TIME_ELAPSED}, gfx_query_pool_allocate);
   create_render_pass(&entry.pass, desc);
 
+  RenderTiming timing;
+  timing.name = desc.name.empty() ? ("Render pass " + std::to_string(s_renderer.render_passes.size())) : desc.name;
+
   s_renderer.render_passes.push_back(entry);
+  s_renderer.timings.push_back(timing);
 }
 
 void renderer_queue_mesh(const ResourceID& mesh_id, const Transform& transform, const ResourceID& mat_id, const ResourceID& shader_context_id) {
@@ -420,25 +1224,43 @@ void renderer_queue_mesh(const ResourceID& mesh_id, const Transform& transform,
   Material* mat      = RESOURCE_IS_VALID(mat_id) ? resources_get_material(mat_id) : s_renderer.defaults.material; 
   ShaderContext* ctx = RESOURCE_IS_VALID(shader_context_id) ? resources_get_shader_context(shader_context_id) : resources_get_shader_context(s_renderer.shader_contexts[SHADER_CONTEXT_BLINN]);
 
-  s_renderer.render_queue.emplace_back(mesh, transform, mat, ctx);
+  push_command(mesh, push_transform(transform), mat, ctx, COMMAND_PASS_SCENE);
+}
+
+void renderer_queue_mesh_instanced(const ResourceID& mesh_id, const Transform* transforms, const sizei count, const ResourceID& mat_id, const ResourceID& shader_context_id) {
+  NIKOLA_ASSERT((transforms || count == 0), "Invalid transforms array given to renderer_queue_mesh_instanced");
+
+  Mesh* mesh         = resources_get_mesh(mesh_id);
+  Material* mat      = RESOURCE_IS_VALID(mat_id) ? resources_get_material(mat_id) : s_renderer.defaults.material; 
+  ShaderContext* ctx = RESOURCE_IS_VALID(shader_context_id) ? resources_get_shader_context(shader_context_id) : resources_get_shader_context(s_renderer.shader_contexts[SHADER_CONTEXT_BLINN]);
+
+  // Every instance still gets its own command, so it can be culled on its own
+  s_renderer.render_queue.reserve(s_renderer.render_queue.size() + count);
+  s_renderer.transforms.reserve(s_renderer.transforms.size() + count);
+
+  for(sizei i = 0; i < count; i++) {
+    push_command(mesh, push_transform(transforms[i]), mat, ctx, COMMAND_PASS_SCENE);
+  }
 }
 
 void renderer_queue_model(const ResourceID& model_id, const Transform& transform, const ResourceID& shader_context_id) {
   Model* model       = resources_get_model(model_id);
   ShaderContext* ctx = RESOURCE_IS_VALID(shader_context_id) ? resources_get_shader_context(shader_context_id) : resources_get_shader_context(s_renderer.shader_contexts[SHADER_CONTEXT_BLINN]);
 
-  // Breaking up the model into multiple mesh render commands
+  // Breaking up the model into multiple mesh render commands, all sharing the same transform
+  u32 transform_index = push_transform(transform);
+
   for(sizei i = 0; i < model->meshes.size(); i++) {
     Mesh* mesh    = model->meshes[i];
     Material* mat = model->materials[model->material_indices[i]]; 
 
-    s_renderer.render_queue.emplace_back(mesh, transform, mat, ctx);
+    push_command(mesh, transform_index, mat, ctx, COMMAND_PASS_SCENE);
   }
 }
 
 void renderer_debug_cube(const Transform& transform, const Vec4& color) {
   ShaderContext* shader_context = resources_get_shader_context(s_renderer.shader_contexts[SHADER_CONTEXT_DEFAULT]);
-  s_renderer.debug_queue.emplace_back(s_renderer.defaults.cube_mesh, transform, s_renderer.defaults.material, shader_context, color);
+  push_command(s_renderer.defaults.cube_mesh, push_transform(transform), s_renderer.defaults.material, shader_context, COMMAND_PASS_DEBUG, color);
 }
 
 void renderer_debug_collider(const Collider* coll, const Vec3& color) {
@@ -456,11 +1278,22 @@ void renderer_begin(FrameData& data) {
   gfx_buffer_update(matrix_buffer, 0, sizeof(Mat4), mat4_raw_data(data.camera.view));
   gfx_buffer_update(matrix_buffer, sizeof(Mat4), sizeof(Mat4), mat4_raw_data(data.camera.projection));
 
+  // Any shader reloaded since the last frame leaves stale handles behind
+  refresh_uniform_handles();
+
   // Setup some lighting
   setup_light_enviornment(data);
 }
 
 void renderer_end() {
+  NIKOLA_PROFILE_FUNCTION();
+
+  // Nothing outside of the camera's view should ever reach the GPU
+  cull_queue(s_renderer.render_queue, s_renderer.frame_data->camera);
+
+  // Bring the commands sharing the same state next to each other
+  sort_queue(s_renderer.render_queue, s_renderer.frame_data->camera);
+
   /* @NOTE (16/4/2025, Mohamed):
   *
   * Since the first entry of the render passes will almost always 
@@ -471,27 +1304,131 @@ void renderer_end() {
   RenderPassEntry* light_entry  = &s_renderer.render_passes[0];
   light_entry->pass.clear_color = s_renderer.clear_color; // Update the default clear color
 
+  gfx_query_begin(light_entry->query);
   begin_pass(light_entry->pass);
   light_entry->func(nullptr, &light_entry->pass, light_entry->user_data);
   end_pass(light_entry->pass);
+  gfx_query_end(light_entry->query);
 
   // Initiate all of the custrom render passes 
   for(sizei i = 1; i < s_renderer.render_passes.size(); i++) {
     RenderPassEntry* entry = &s_renderer.render_passes[i];
   
+    gfx_query_begin(entry->query);
     begin_pass(entry->pass);
     entry->func(&s_renderer.render_passes[i - 1].pass, &entry->pass, entry->user_data);
     end_pass(entry->pass);
+    gfx_query_end(entry->query);
   } 
+
+  // Read back any finished timings (from a few frames ago)
+  for(sizei i = 0; i < s_renderer.render_passes.size(); i++) {
+    s_renderer.timings[i].gpu_time = (f64)gfx_query_get_result(s_renderer.render_passes[i].query) / 1000000.0;
+  }
   
-  // Clear the queues
+  // Every frame starts off in a fresh instance segment
+  next_instance_segment();
+
+  // Clear the queue and anything it left behind
   s_renderer.render_queue.clear();
-  s_renderer.debug_queue.clear();
+  s_renderer.transforms.clear();
+  s_renderer.sorted_commands.clear();
+
+  s_renderer.context_ids.clear();
+  s_renderer.material_ids.clear();
+  s_renderer.mesh_ids.clear();
+}
+
+const DynamicArray<RenderTiming>& renderer_get_timings() {
+  return s_renderer.timings;
+}
+
+const RendererStats& renderer_get_stats() {
+  return s_renderer.stats;
 }
 
 /// Renderer functions
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Render sort functions
+
+const u64 render_sort_key(const CommandPass pass, const bool is_translucent, const f32 depth, const u64 ctx_id, const u64 mat_id, const u64 mesh_id) {
+  f32 clamped_depth = depth < 0.0f ? 0.0f : (depth > 1.0f ? 1.0f : depth);
+
+  u64 depth_max  = (1ull << SORT_KEY_DEPTH_BITS) - 1;
+  u64 depth_bits = (u64)(clamped_depth * (f32)depth_max);
+
+  u64 key   = (u64)pass;
+  key       = (key << SORT_KEY_TRANSLUCENT_BITS) | (is_translucent ? 1 : 0);
+
+  if(is_translucent) {
+    key = (key << SORT_KEY_DEPTH_BITS) | (depth_max - depth_bits);
+    key = (key << SORT_KEY_CONTEXT_BITS) | ctx_id;
+    key = (key << SORT_KEY_MATERIAL_BITS) | mat_id;
+    key = (key << SORT_KEY_MESH_BITS) | mesh_id;
+  }
+  else {
+    key = (key << SORT_KEY_CONTEXT_BITS) | ctx_id;
+    key = (key << SORT_KEY_MATERIAL_BITS) | mat_id;
+    key = (key << SORT_KEY_MESH_BITS) | mesh_id;
+    key = (key << SORT_KEY_DEPTH_BITS) | depth_bits;
+  }
+
+  return key;
+}
+
+void render_radix_sort(DynamicArray<SortEntry>& entries, DynamicArray<SortEntry>& scratch) {
+  const sizei buckets_count = (sizei)1 << RADIX_SORT_BITS;
+  const u64 digit_mask      = buckets_count - 1;
+
+  if(entries.empty()) {
+    return;
+  }
+
+  scratch.resize(entries.size());
+
+  SortEntry* src = entries.data();
+  SortEntry* dst = scratch.data();
+
+  // Least significant digit first, keeping every pass stable
+  for(u64 shift = 0; shift < 64; shift += RADIX_SORT_BITS) {
+    sizei offsets[buckets_count] = {};
+
+    for(sizei i = 0; i < entries.size(); i++) {
+      offsets[(src[i].key >> shift) & digit_mask]++;
+    }
+
+    // Every key has the same digit, so nothing would move
+    if(offsets[(src[0].key >> shift) & digit_mask] == entries.size()) {
+      continue;
+    }
+
+    sizei total = 0;
+    for(sizei i = 0; i < buckets_count; i++) {
+      sizei count = offsets[i];
+      offsets[i]  = total;
+      total      += count;
+    }
+
+    for(sizei i = 0; i < entries.size(); i++) {
+      dst[offsets[(src[i].key >> shift) & digit_mask]++] = src[i];
+    }
+
+    SortEntry* temp = src;
+    src             = dst;
+    dst             = temp;
+  }
+
+  // The last pass ended up in the scratch array
+  if(src != entries.data()) {
+    entries.swap(scratch);
+  }
+}
+
+/// Render sort functions
+///---------------------------------------------------------------------------------------------------------------------
+
 } // End of nikola
 
 //////////////////////////////////////////////////////////////////////////
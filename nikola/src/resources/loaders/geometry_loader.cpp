@@ -10,7 +10,7 @@ namespace nikola { // Start of nikola
 /// ----------------------------------------------------------------------
 /// Private functions  
 
-static void create_cube_geo(const ResourceGroupID& group_id, GfxPipelineDesc* pipe_desc) {
+static void create_cube_geo(const ResourceGroupID& group_id, GfxPipelineDesc* pipe_desc, AABB* out_bounds, BoundingSphere* out_sphere) {
   f32 vertices[] = {
      // Position          Normal              UV coords
     
@@ -102,9 +102,13 @@ static void create_cube_geo(const ResourceGroupID& group_id, GfxPipelineDesc* pi
 
   // Draw mode init
   pipe_desc->draw_mode = GFX_DRAW_MODE_TRIANGLE;
+
+  // Bounds init
+  *out_bounds = aabb_from_vertices(vertices, sizeof(vertices) / sizeof(f32), 8);
+  *out_sphere = bounding_sphere_from_vertices(vertices, sizeof(vertices) / sizeof(f32), 8);
 }
 
-static void create_skybox_geo(const ResourceGroupID& group_id, GfxPipelineDesc* pipe_desc) {
+static void create_skybox_geo(const ResourceGroupID& group_id, GfxPipelineDesc* pipe_desc, AABB* out_bounds, BoundingSphere* out_sphere) {
   // Vertices
   float vertices[] = {
     -1.0f,  1.0f, -1.0f,
@@ -166,13 +170,17 @@ static void create_skybox_geo(const ResourceGroupID& group_id, GfxPipelineDesc*
 
   // Draw mode init
   pipe_desc->draw_mode = GFX_DRAW_MODE_TRIANGLE;
+
+  // Bounds init
+  *out_bounds = aabb_from_vertices(vertices, sizeof(vertices) / sizeof(f32), 3);
+  *out_sphere = bounding_sphere_from_vertices(vertices, sizeof(vertices) / sizeof(f32), 3);
 }
 
-static void create_plane_geo(const ResourceGroupID& group_id, GfxPipelineDesc* pipe_desc) {
+static void create_plane_geo(const ResourceGroupID& group_id, GfxPipelineDesc* pipe_desc, AABB* out_bounds, BoundingSphere* out_sphere) {
   // @TODO (Geometry): Create a plane geo
 }
 
-static void create_circle_geo(const ResourceGroupID& group_id, GfxPipelineDesc* pipe_desc) {
+static void create_circle_geo(const ResourceGroupID& group_id, GfxPipelineDesc* pipe_desc, AABB* out_bounds, BoundingSphere* out_sphere) {
   // @TODO (Geometry): Create a circle geo
 }
 
@@ -182,19 +190,26 @@ static void create_circle_geo(const ResourceGroupID& group_id, GfxPipelineDesc*
 /// ----------------------------------------------------------------------
 /// Mesh loader functions
 
-void geometry_loader_load(const ResourceGroupID& group_id, GfxPipelineDesc* pipe_desc, const GeometryType type) {
+void geometry_loader_load(const ResourceGroupID& group_id, GfxPipelineDesc* pipe_desc, const GeometryType type, AABB* out_bounds, BoundingSphere* out_sphere) {
+  // The bounds are optional
+  AABB bounds;
+  BoundingSphere sphere;
+
+  out_bounds = out_bounds ? out_bounds : &bounds;
+  out_sphere = out_sphere ? out_sphere : &sphere;
+
   switch(type) {
     case GEOMETRY_CUBE:
-      create_cube_geo(group_id, pipe_desc);
+      create_cube_geo(group_id, pipe_desc, out_bounds, out_sphere);
       break;
     case GEOMETRY_PLANE:
-      create_plane_geo(group_id, pipe_desc);
+      create_plane_geo(group_id, pipe_desc, out_bounds, out_sphere);
       break;
     case GEOMETRY_SKYBOX:
-      create_skybox_geo(group_id, pipe_desc);
+      create_skybox_geo(group_id, pipe_desc, out_bounds, out_sphere);
       break;
     case GEOMETRY_CIRCLE:
-      create_circle_geo(group_id, pipe_desc);
+      create_circle_geo(group_id, pipe_desc, out_bounds, out_sphere);
       break;
     default:
       NIKOLA_LOG_ERROR("Invalid geometry shape given");
@@ -6,7 +6,7 @@
 
 namespace nikola { // Start of nikola
 
-void geometry_loader_load(const ResourceGroupID& group_id, GfxPipelineDesc* pipe_desc, const GeometryType type);
+void geometry_loader_load(const ResourceGroupID& group_id, GfxPipelineDesc* pipe_desc, const GeometryType type, AABB* out_bounds = nullptr, BoundingSphere* out_sphere = nullptr);
 
 } // End of nikola
 
@@ -47,6 +47,48 @@ static bool open_for_save(NBRFile& nbr, const FilePath& path) {
   return true;
 }
 
+static void compute_mesh_bounds(NBRMesh* mesh) {
+  sizei stride = vertex_type_size((VertexType)mesh->vertex_type) / sizeof(f32);
+
+  AABB aabb             = aabb_from_vertices(mesh->vertices, mesh->vertices_count, stride);
+  BoundingSphere sphere = bounding_sphere_from_vertices(mesh->vertices, mesh->vertices_count, stride);
+
+  for(sizei i = 0; i < 3; i++) {
+    mesh->aabb_min[i]      = aabb.min[i];
+    mesh->aabb_max[i]      = aabb.max[i];
+    mesh->sphere_center[i] = sphere.center[i];
+  }
+  mesh->sphere_radius = sphere.radius;
+}
+
+static void merge_model_bounds(NBRModel* model) {
+  AABB aabb             = {};
+  BoundingSphere sphere = {};
+
+  for(sizei i = 0; i < model->meshes_count; i++) {
+    NBRMesh* mesh = &model->meshes[i];
+
+    AABB mesh_aabb = {
+      .min = Vec3(mesh->aabb_min[0], mesh->aabb_min[1], mesh->aabb_min[2]),
+      .max = Vec3(mesh->aabb_max[0], mesh->aabb_max[1], mesh->aabb_max[2]),
+    };
+    BoundingSphere mesh_sphere = {
+      .center = Vec3(mesh->sphere_center[0], mesh->sphere_center[1], mesh->sphere_center[2]),
+      .radius = mesh->sphere_radius,
+    };
+
+    aabb   = (i == 0) ? mesh_aabb : aabb_merge(aabb, mesh_aabb);
+    sphere = (i == 0) ? mesh_sphere : bounding_sphere_merge(sphere, mesh_sphere);
+  }
+
+  for(sizei i = 0; i < 3; i++) {
+    model->aabb_min[i]      = aabb.min[i];
+    model->aabb_max[i]      = aabb.max[i];
+    model->sphere_center[i] = sphere.center[i];
+  }
+  model->sphere_radius = sphere.radius;
+}
+
 static void write_texture(NBRFile& nbr, const NBRTexture& texture) {
   // Save width and height
   file_write_bytes(nbr.file_handle, &texture.width, sizeof(texture.width));
@@ -121,6 +163,12 @@ static void write_mesh(NBRFile& nbr, const NBRMesh& mesh) {
 
   // Save the material index
   file_write_bytes(nbr.file_handle, &mesh.material_index, sizeof(u8));
+
+  // Save the bounds
+  file_write_bytes(nbr.file_handle, mesh.aabb_min, sizeof(f32) * 3);
+  file_write_bytes(nbr.file_handle, mesh.aabb_max, sizeof(f32) * 3);
+  file_write_bytes(nbr.file_handle, mesh.sphere_center, sizeof(f32) * 3);
+  file_write_bytes(nbr.file_handle, &mesh.sphere_radius, sizeof(f32));
 }
 
 static void write_model(NBRFile& nbr, const NBRModel& model) {
@@ -130,6 +178,12 @@ static void write_model(NBRFile& nbr, const NBRModel& model) {
     write_mesh(nbr, model.meshes[i]);
   }
 
+  // Save the bounds of all the meshes
+  file_write_bytes(nbr.file_handle, model.aabb_min, sizeof(f32) * 3);
+  file_write_bytes(nbr.file_handle, model.aabb_max, sizeof(f32) * 3);
+  file_write_bytes(nbr.file_handle, model.sphere_center, sizeof(f32) * 3);
+  file_write_bytes(nbr.file_handle, &model.sphere_radius, sizeof(f32));
+
   // Save the materials
   file_write_bytes(nbr.file_handle, &model.materials_count, sizeof(u8));
   for(sizei i = 0; i < model.materials_count; i++) {
@@ -207,7 +261,7 @@ static void read_texture(NBRFile& nbr, NBRTexture* texture) {
 
   // Load the pixels
   sizei data_size = (texture->width * texture->height) * texture->channels;
-  texture->pixels = memory_allocate(data_size);
+  texture->pixels = NIKOLA_MEMORY_ALLOCATE(data_size, MEMORY_TAG_RESOURCES);
   file_read_bytes(nbr.file_handle, texture->pixels, data_size);
 }
 
@@ -225,7 +279,7 @@ static void read_cubemap(NBRFile& nbr, NBRCubemap* cubemap) {
   // Load the pixels
   sizei data_size = (cubemap->width * cubemap->height) * cubemap->channels;
   for(sizei i = 0; i < cubemap->faces_count; i++) {
-    cubemap->pixels[i] = (u8*)memory_allocate(data_size);
+    cubemap->pixels[i] = (u8*)NIKOLA_MEMORY_ALLOCATE(data_size, MEMORY_TAG_RESOURCES);
     file_read_bytes(nbr.file_handle, cubemap->pixels[i], data_size);
   }
 }
@@ -236,7 +290,7 @@ static void read_shader(NBRFile& nbr, NBRShader* shader) {
   shader->vertex_length += 1;
 
   // Load the vertex source string
-  shader->vertex_source = (i8*)memory_allocate(shader->vertex_length); 
+  shader->vertex_source = (i8*)NIKOLA_MEMORY_ALLOCATE(shader->vertex_length, MEMORY_TAG_RESOURCES); 
   file_read_bytes(nbr.file_handle, shader->vertex_source, shader->vertex_length - 1);
   shader->vertex_source[shader->vertex_length - 1] = '\0';
  
@@ -245,7 +299,7 @@ static void read_shader(NBRFile& nbr, NBRShader* shader) {
   shader->pixel_length += 1;
 
   // Load the pixel source string
-  shader->pixel_source = (i8*)memory_allocate(shader->pixel_length); 
+  shader->pixel_source = (i8*)NIKOLA_MEMORY_ALLOCATE(shader->pixel_length, MEMORY_TAG_RESOURCES); 
   file_read_bytes(nbr.file_handle, shader->pixel_source, shader->pixel_length - 1);
   shader->pixel_source[shader->pixel_length - 1] = '\0';
 }
@@ -271,36 +325,58 @@ static void read_mesh(NBRFile& nbr, NBRMesh* mesh) {
 
   // Load the vertices
   file_read_bytes(nbr.file_handle, &mesh->vertices_count, sizeof(u32));
-  mesh->vertices = (f32*)memory_allocate(sizeof(f32) * mesh->vertices_count); 
+  mesh->vertices = (f32*)NIKOLA_MEMORY_ALLOCATE(sizeof(f32) * mesh->vertices_count, MEMORY_TAG_RESOURCES); 
   file_read_bytes(nbr.file_handle, mesh->vertices, sizeof(f32) * mesh->vertices_count);
 
   // Load the indices
   file_read_bytes(nbr.file_handle, &mesh->indices_count, sizeof(u32));
-  mesh->indices = (u32*)memory_allocate(sizeof(u32) * mesh->indices_count); 
+  mesh->indices = (u32*)NIKOLA_MEMORY_ALLOCATE(sizeof(u32) * mesh->indices_count, MEMORY_TAG_RESOURCES); 
   file_read_bytes(nbr.file_handle, mesh->indices, sizeof(u32) * mesh->indices_count);
 
   // Load the material index
   file_read_bytes(nbr.file_handle, &mesh->material_index, sizeof(u8));
+
+  // Older files never had any bounds saved. They get computed with the whole model instead.
+  if(nbr.minor_version < NBR_BOUNDS_MINOR_VERSION) {
+    return;
+  }
+
+  // Load the bounds
+  file_read_bytes(nbr.file_handle, mesh->aabb_min, sizeof(f32) * 3);
+  file_read_bytes(nbr.file_handle, mesh->aabb_max, sizeof(f32) * 3);
+  file_read_bytes(nbr.file_handle, mesh->sphere_center, sizeof(f32) * 3);
+  file_read_bytes(nbr.file_handle, &mesh->sphere_radius, sizeof(f32));
 }
 
 static void read_model(NBRFile& nbr, NBRModel* model) {
   // Load the meshes
   file_read_bytes(nbr.file_handle, &model->meshes_count, sizeof(u16));
-  model->meshes = (NBRMesh*)memory_allocate(sizeof(NBRMesh) * model->meshes_count); 
+  model->meshes = (NBRMesh*)NIKOLA_MEMORY_ALLOCATE(sizeof(NBRMesh) * model->meshes_count, MEMORY_TAG_RESOURCES); 
   for(sizei i = 0; i < model->meshes_count; i++) {
     read_mesh(nbr, &model->meshes[i]);
   }
 
+  // Load the bounds of all the meshes
+  if(nbr.minor_version < NBR_BOUNDS_MINOR_VERSION) {
+    nbr_model_compute_bounds(model);
+  }
+  else {
+    file_read_bytes(nbr.file_handle, model->aabb_min, sizeof(f32) * 3);
+    file_read_bytes(nbr.file_handle, model->aabb_max, sizeof(f32) * 3);
+    file_read_bytes(nbr.file_handle, model->sphere_center, sizeof(f32) * 3);
+    file_read_bytes(nbr.file_handle, &model->sphere_radius, sizeof(f32));
+  }
+
   // Load the materials 
   file_read_bytes(nbr.file_handle, &model->materials_count, sizeof(u8));
-  model->materials = (NBRMaterial*)memory_allocate(sizeof(NBRMaterial) * model->materials_count); 
+  model->materials = (NBRMaterial*)NIKOLA_MEMORY_ALLOCATE(sizeof(NBRMaterial) * model->materials_count, MEMORY_TAG_RESOURCES); 
   for(sizei i = 0; i < model->materials_count; i++) {
     read_material(nbr, &model->materials[i]); 
   }
 
   // Load the textures 
   file_read_bytes(nbr.file_handle, &model->textures_count, sizeof(u8));
-  model->textures = (NBRTexture*)memory_allocate(sizeof(NBRTexture) * model->textures_count); 
+  model->textures = (NBRTexture*)NIKOLA_MEMORY_ALLOCATE(sizeof(NBRTexture) * model->textures_count, MEMORY_TAG_RESOURCES); 
   for(sizei i = 0; i < model->textures_count; i++) {
     read_texture(nbr, &model->textures[i]);
   }
@@ -309,7 +385,7 @@ static void read_model(NBRFile& nbr, NBRModel* model) {
 static void read_font(NBRFile& nbr, NBRFont* font) {
   // Load the glyphs 
   file_read_bytes(nbr.file_handle, &font->glyphs_count, sizeof(font->glyphs_count));
-  font->glyphs = (NBRGlyph*)memory_allocate(sizeof(NBRGlyph) * font->glyphs_count);
+  font->glyphs = (NBRGlyph*)NIKOLA_MEMORY_ALLOCATE(sizeof(NBRGlyph) * font->glyphs_count, MEMORY_TAG_RESOURCES);
 
   for(u32 i = 0; i < font->glyphs_count; i++) {
     // Load the unicode
@@ -336,7 +412,7 @@ static void read_font(NBRFile& nbr, NBRFont* font) {
   
     // Load the pixels
     sizei pixels_size      = font->glyphs[i].width * font->glyphs[i].height;
-    font->glyphs[i].pixels = (u8*)memory_allocate(pixels_size); 
+    font->glyphs[i].pixels = (u8*)NIKOLA_MEMORY_ALLOCATE(pixels_size, MEMORY_TAG_RESOURCES); 
 
     file_read_bytes(nbr.file_handle, font->glyphs[i].pixels, pixels_size);
   }
@@ -361,7 +437,7 @@ static void read_audio(NBRFile& nbr, NBRAudio* audio) {
   file_read_bytes(nbr.file_handle, &audio->size, sizeof(audio->size));
   
   // Load the samples
-  audio->samples = (i16*)memory_allocate(audio->size); 
+  audio->samples = (i16*)NIKOLA_MEMORY_ALLOCATE(audio->size, MEMORY_TAG_RESOURCES); 
   file_read_bytes(nbr.file_handle, audio->samples, audio->size);
 }
 
@@ -371,7 +447,7 @@ static void load_texture(NBRFile& nbr) {
   read_texture(nbr, &texture); 
 
   // Allocate some space for the resource and assign it
-  nbr.body_data = memory_allocate(sizeof(texture));
+  nbr.body_data = NIKOLA_MEMORY_ALLOCATE(sizeof(texture), MEMORY_TAG_RESOURCES);
   memory_copy(nbr.body_data, &texture, sizeof(texture)); 
 }
 
@@ -381,7 +457,7 @@ static void load_cubemap(NBRFile& nbr) {
   read_cubemap(nbr, &cubemap); 
   
   // Allocate some space for the resource and assign it
-  nbr.body_data = memory_allocate(sizeof(cubemap));
+  nbr.body_data = NIKOLA_MEMORY_ALLOCATE(sizeof(cubemap), MEMORY_TAG_RESOURCES);
   memory_copy(nbr.body_data, &cubemap, sizeof(cubemap)); 
 }
 
@@ -391,7 +467,7 @@ static void load_shader(NBRFile& nbr) {
   read_shader(nbr, &shader); 
 
   // Allocate some space for the resource and assign it
-  nbr.body_data = memory_allocate(sizeof(NBRShader));
+  nbr.body_data = NIKOLA_MEMORY_ALLOCATE(sizeof(NBRShader), MEMORY_TAG_RESOURCES);
   memory_copy(nbr.body_data, &shader, sizeof(NBRShader));
 }
 
@@ -401,7 +477,7 @@ static void load_model(NBRFile& nbr) {
   read_model(nbr, &model);
 
   // Allocate some space for the resource and assign it
-  nbr.body_data = memory_allocate(sizeof(model));
+  nbr.body_data = NIKOLA_MEMORY_ALLOCATE(sizeof(model), MEMORY_TAG_RESOURCES);
   memory_copy(nbr.body_data, &model, sizeof(model)); 
 }
 
@@ -411,7 +487,7 @@ static void load_font(NBRFile& nbr) {
   read_font(nbr, &font);
 
   // Allocate some space for the resource and assign it
-  nbr.body_data = memory_allocate(sizeof(font));
+  nbr.body_data = NIKOLA_MEMORY_ALLOCATE(sizeof(font), MEMORY_TAG_RESOURCES);
   memory_copy(nbr.body_data, &font, sizeof(font)); 
 }
 
@@ -421,7 +497,7 @@ static void load_audio(NBRFile& nbr) {
   read_audio(nbr, &audio);
 
   // Allocate some space for the resource and assign it
-  nbr.body_data = memory_allocate(sizeof(audio));
+  nbr.body_data = NIKOLA_MEMORY_ALLOCATE(sizeof(audio), MEMORY_TAG_RESOURCES);
   memory_copy(nbr.body_data, &audio, sizeof(audio)); 
 }
 
@@ -741,6 +817,16 @@ void nbr_file_save(NBRFile& nbr, const NBRAudio& audio, const FilePath& path) {
   file_close(nbr.file_handle);
 }
 
+void nbr_model_compute_bounds(NBRModel* model) {
+  NIKOLA_ASSERT(model, "Cannot compute the bounds of an invalid NBRModel");
+
+  for(sizei i = 0; i < model->meshes_count; i++) {
+    compute_mesh_bounds(&model->meshes[i]);
+  }
+
+  merge_model_bounds(model);
+}
+
 /// NBR (Nikola Binary Resource) functions
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -82,6 +82,13 @@ void nbr_import_mesh(NBRMesh* nbr, const ResourceGroupID& group_id, Mesh* mesh)
   // Layout init
   vertex_type_layout((VertexType)nbr->vertex_type, mesh->pipe_desc.layout, &mesh->pipe_desc.layout_count);
   
+  // Bounds init
+  mesh->bounds.min = Vec3(nbr->aabb_min[0], nbr->aabb_min[1], nbr->aabb_min[2]);
+  mesh->bounds.max = Vec3(nbr->aabb_max[0], nbr->aabb_max[1], nbr->aabb_max[2]);
+
+  mesh->bounds_sphere.center = Vec3(nbr->sphere_center[0], nbr->sphere_center[1], nbr->sphere_center[2]);
+  mesh->bounds_sphere.radius = nbr->sphere_radius;
+  
   // Draw mode init
   mesh->pipe_desc.draw_mode = GFX_DRAW_MODE_TRIANGLE;
 }
@@ -139,6 +146,13 @@ void nbr_import_model(NBRModel* nbr, const ResourceGroupID& group_id, Model* mod
     // Add a new index
     model->material_indices.push_back(nbr->meshes[i].material_index);
   }
+
+  // Convert the bounds
+  model->bounds.min = Vec3(nbr->aabb_min[0], nbr->aabb_min[1], nbr->aabb_min[2]);
+  model->bounds.max = Vec3(nbr->aabb_max[0], nbr->aabb_max[1], nbr->aabb_max[2]);
+
+  model->bounds_sphere.center = Vec3(nbr->sphere_center[0], nbr->sphere_center[1], nbr->sphere_center[2]);
+  model->bounds_sphere.radius = nbr->sphere_radius;
 }
 
 void nbr_import_font(NBRFont* nbr, const ResourceGroupID& group_id, Font* font) {
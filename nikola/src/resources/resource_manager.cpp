@@ -30,7 +30,7 @@ struct ResourceGroup {
   DynamicArray<Model*> models;
   DynamicArray<Font*> fonts;
 
-  HashMap<String, ResourceID> named_ids;
+  HashMap<StringID, ResourceID> named_ids;
 };
 /// ResourceGroup 
 /// ----------------------------------------------------------------------
@@ -40,8 +40,21 @@ struct ResourceGroup {
 struct ResourceManager {
   GfxContext* gfx_context = nullptr;
   HashMap<ResourceGroupID, ResourceGroup> groups;
+
+  MemoryPool* meshes_pool          = nullptr;
+  MemoryPool* materials_pool       = nullptr;
+  MemoryPool* shader_contexts_pool = nullptr;
+  MemoryPool* skyboxes_pool        = nullptr;
+  MemoryPool* models_pool          = nullptr;
+  MemoryPool* fonts_pool           = nullptr;
 };
 
+/// How many blocks each resource pool will grow by when it runs out.
+const sizei RESOURCE_POOL_BLOCKS_PER_CHUNK = 256;
+
+/// The name of the default entry returned when a named resource is not found.
+constexpr StringID INVALID_RESOURCE_NAME = string_id_literal("invalid");
+
 static ResourceManager s_manager;
 /// ResourceManager 
 /// ----------------------------------------------------------------------
@@ -49,16 +62,16 @@ static ResourceManager s_manager;
 /// ----------------------------------------------------------------------
 /// Macros (Unfortunately)
 
-#define DESTROY_CORE_RESOURCE_MAP(group, map, clear_func) { \
-  for(auto& res : group->map) {                             \
-    clear_func(res);                                        \
-  }                                                         \
+#define DESTROY_CORE_RESOURCE_MAP(group, map, clear_func, ...) { \
+  for(auto& res : group->map) {                                  \
+    clear_func(res, ##__VA_ARGS__);                              \
+  }                                                              \
 }
 
-#define DESTROY_COMP_RESOURCE_MAP(group, map) { \
-  for(auto& res : group->map) {                 \
-    delete res;                                 \
-  }                                             \
+#define DESTROY_COMP_RESOURCE_MAP(group, map, pool) { \
+  for(auto& res : group->map) {                       \
+    pool_delete(pool, res);                           \
+  }                                                   \
 }
 
 #define PUSH_RESOURCE(group, resources, res, type, res_id) { \
@@ -76,6 +89,17 @@ static ResourceManager s_manager;
 /// ----------------------------------------------------------------------
 /// Private functions 
 
+template<typename T>
+static T* pool_new(MemoryPool* pool) {
+  return new (memory_pool_allocate(pool)) T{};
+}
+
+template<typename T>
+static void pool_delete(MemoryPool* pool, T* res) {
+  res->~T();
+  memory_pool_free(pool, res);
+}
+
 static const char* buffer_type_str(const GfxBufferType type) {
   switch(type) {
     case GFX_BUFFER_VERTEX: 
@@ -84,6 +108,8 @@ static const char* buffer_type_str(const GfxBufferType type) {
       return "GFX_BUFFER_INDEX";
     case GFX_BUFFER_UNIFORM: 
       return "GFX_BUFFER_UNIFORM";
+    case GFX_BUFFER_DRAW_INDIRECT: 
+      return "GFX_BUFFER_DRAW_INDIRECT";
     default:
       return "INVALID BUFFER TYPE";
   }
@@ -211,6 +237,15 @@ static void reload_shader(NBRFile& file, const ResourceID& id) {
   
   // Update the shader
   gfx_shader_update(shader, shader_desc);
+
+  // The uniforms could have moved around, so every context of the shader has to look them up again
+  for(auto& [group_id, group] : s_manager.groups) {
+    for(auto& ctx : group.shader_contexts) {
+      if(ctx->shader == shader) {
+        shader_context_invalidate_uniforms(ctx);
+      }
+    }
+  }
 }
 
 static void reload_core_resource(const ResourceGroup* group, const ResourceID& id, const FilePath& nbr_path) {
@@ -255,22 +290,22 @@ static void resource_entry_iterate(const FilePath& base, const FilePath& path, v
 
   switch (type) {
     case RESOURCE_TYPE_TEXTURE:
-      group->named_ids[filename] = resources_push_texture(group->id, path);
+      group->named_ids[string_id_intern(filename.c_str())] = resources_push_texture(group->id, path);
       break;
     case RESOURCE_TYPE_CUBEMAP:
-      group->named_ids[filename] = resources_push_cubemap(group->id, path);
+      group->named_ids[string_id_intern(filename.c_str())] = resources_push_cubemap(group->id, path);
       break;
     case RESOURCE_TYPE_SHADER:
-      group->named_ids[filename] = resources_push_shader(group->id, path);
+      group->named_ids[string_id_intern(filename.c_str())] = resources_push_shader(group->id, path);
       break;
     case RESOURCE_TYPE_MODEL:
-      group->named_ids[filename] = resources_push_model(group->id, path);
+      group->named_ids[string_id_intern(filename.c_str())] = resources_push_model(group->id, path);
       break;
     case RESOURCE_TYPE_FONT:
-      group->named_ids[filename] = resources_push_font(group->id, path);
+      group->named_ids[string_id_intern(filename.c_str())] = resources_push_font(group->id, path);
       break;
     case RESOURCE_TYPE_AUDIO_BUFFER:
-      group->named_ids[filename] = resources_push_audio_buffer(group->id, path);
+      group->named_ids[string_id_intern(filename.c_str())] = resources_push_audio_buffer(group->id, path);
       break;
     default:
       NIKOLA_LOG_ERROR("Invalid resource type \'%s\'", path.c_str());
@@ -288,7 +323,15 @@ static void resource_entry_update(const FileStatus status, const FilePath& path,
   FilePath filename = filepath_filename(path); 
   filepath_set_extension(filename, "");
 
-  ResourceGroup* group = (ResourceGroup*)user_data;
+  // The groups move around inside the map, so only the ID is kept around
+  ResourceGroupID group_id = (ResourceGroupID)(uintptr_t)user_data;
+
+  auto group_it = s_manager.groups.find(group_id);
+  if(group_it == s_manager.groups.end()) {
+    return;
+  }
+
+  ResourceGroup* group = &group_it->second;
   ResourceID res_id    = resources_get_id(group->id, filename);
 
   switch (res_id._type) {
@@ -319,6 +362,14 @@ static void resource_entry_update(const FileStatus status, const FilePath& path,
 /// Resource manager functions
 
 void resource_manager_init() {
+  // Pools init
+  s_manager.meshes_pool          = memory_pool_create(sizeof(Mesh), RESOURCE_POOL_BLOCKS_PER_CHUNK, MEMORY_TAG_RESOURCES);
+  s_manager.materials_pool       = memory_pool_create(sizeof(Material), RESOURCE_POOL_BLOCKS_PER_CHUNK, MEMORY_TAG_RESOURCES);
+  s_manager.shader_contexts_pool = memory_pool_create(sizeof(ShaderContext), RESOURCE_POOL_BLOCKS_PER_CHUNK, MEMORY_TAG_RESOURCES);
+  s_manager.skyboxes_pool        = memory_pool_create(sizeof(Skybox), RESOURCE_POOL_BLOCKS_PER_CHUNK, MEMORY_TAG_RESOURCES);
+  s_manager.models_pool          = memory_pool_create(sizeof(Model), RESOURCE_POOL_BLOCKS_PER_CHUNK, MEMORY_TAG_RESOURCES);
+  s_manager.fonts_pool           = memory_pool_create(sizeof(Font), RESOURCE_POOL_BLOCKS_PER_CHUNK, MEMORY_TAG_RESOURCES);
+
   s_manager.groups[RESOURCE_CACHE_ID] = ResourceGroup {
     .name       = "cache", 
     .parent_dir = "resource_cache",
@@ -331,7 +382,16 @@ void resource_manager_init() {
 void resource_manager_shutdown() {
   // Get rid of any cache group
   resources_destroy_group(RESOURCE_CACHE_ID);
+  s_manager.groups.destroy();
   
+  // Get rid of the pools
+  memory_pool_destroy(s_manager.meshes_pool);
+  memory_pool_destroy(s_manager.materials_pool);
+  memory_pool_destroy(s_manager.shader_contexts_pool);
+  memory_pool_destroy(s_manager.skyboxes_pool);
+  memory_pool_destroy(s_manager.models_pool);
+  memory_pool_destroy(s_manager.fonts_pool);
+
   NIKOLA_LOG_INFO("Successfully shutdown the resource manager");
 }
 
@@ -345,7 +405,7 @@ u16 resources_create_group(const String& name, const FilePath& parent_dir) {
 
   // A default resource for later
   ResourceGroup* group = &s_manager.groups[group_id]; 
-  group->named_ids["invalid"] = ResourceID{}; 
+  group->named_ids[INVALID_RESOURCE_NAME] = ResourceID{}; 
 
   // Create the parent directory if it doesn't exist
   if(!nikola::filesystem_exists(parent_dir)) {
@@ -353,7 +413,10 @@ u16 resources_create_group(const String& name, const FilePath& parent_dir) {
   }
 
   // Add a file watcher to the parent directory
-  filewatcher_add_dir(parent_dir, resource_entry_update, group);
+  //
+  // @NOTE: The group itself can move once another group is created or destroyed, 
+  // so the watcher only gets its ID.
+  filewatcher_add_dir(parent_dir, resource_entry_update, (void*)(uintptr_t)group_id);
 
   NIKOLA_LOG_INFO("Successfully created a resource group \'%s\'", name.c_str());
   return group_id;
@@ -387,19 +450,28 @@ void resources_destroy_group(const ResourceGroupID& group_id) {
 
   ResourceGroup* group = &s_manager.groups[group_id];
 
+  // Destroy the pipelines of compound resources
+  for(auto& mesh : group->meshes) {
+    renderer_release_mesh_geometry(mesh);
+    gfx_pipeline_destroy(mesh->pipe, gfx_pipeline_pool_free);
+  }
+  for(auto& skybox : group->skyboxes) {
+    gfx_pipeline_destroy(skybox->pipe, gfx_pipeline_pool_free);
+  }
+
   // Destroy compound resources
-  DESTROY_COMP_RESOURCE_MAP(group, meshes);
-  DESTROY_COMP_RESOURCE_MAP(group, materials);
-  DESTROY_COMP_RESOURCE_MAP(group, shader_contexts);
-  DESTROY_COMP_RESOURCE_MAP(group, skyboxes);
-  DESTROY_COMP_RESOURCE_MAP(group, models);
-  DESTROY_COMP_RESOURCE_MAP(group, fonts);
+  DESTROY_COMP_RESOURCE_MAP(group, meshes, s_manager.meshes_pool);
+  DESTROY_COMP_RESOURCE_MAP(group, materials, s_manager.materials_pool);
+  DESTROY_COMP_RESOURCE_MAP(group, shader_contexts, s_manager.shader_contexts_pool);
+  DESTROY_COMP_RESOURCE_MAP(group, skyboxes, s_manager.skyboxes_pool);
+  DESTROY_COMP_RESOURCE_MAP(group, models, s_manager.models_pool);
+  DESTROY_COMP_RESOURCE_MAP(group, fonts, s_manager.fonts_pool);
 
   // Destroy core resources
-  DESTROY_CORE_RESOURCE_MAP(group, buffers, gfx_buffer_destroy);
-  DESTROY_CORE_RESOURCE_MAP(group, textures, gfx_texture_destroy);
-  DESTROY_CORE_RESOURCE_MAP(group, cubemaps, gfx_cubemap_destroy);
-  DESTROY_CORE_RESOURCE_MAP(group, shaders, gfx_shader_destroy);
+  DESTROY_CORE_RESOURCE_MAP(group, buffers, gfx_buffer_destroy, gfx_buffer_pool_free);
+  DESTROY_CORE_RESOURCE_MAP(group, textures, gfx_texture_destroy, gfx_texture_pool_free);
+  DESTROY_CORE_RESOURCE_MAP(group, cubemaps, gfx_cubemap_destroy, gfx_cubemap_pool_free);
+  DESTROY_CORE_RESOURCE_MAP(group, shaders, gfx_shader_destroy, gfx_shader_pool_free);
   DESTROY_CORE_RESOURCE_MAP(group, audio_buffers, audio_buffer_destroy);
 
   NIKOLA_LOG_INFO("Resource group \'%s\' was successfully destroyed", group->name.c_str());
@@ -412,7 +484,7 @@ ResourceID resources_push_buffer(const ResourceGroupID& group_id, const GfxBuffe
 
   // Create the buffer
   ResourceID id; 
-  GfxBuffer* buffer = gfx_buffer_create(renderer_get_context(), buff_desc);
+  GfxBuffer* buffer = gfx_buffer_create(renderer_get_context(), buff_desc, gfx_buffer_pool_allocate);
   PUSH_RESOURCE(group, buffers, buffer, RESOURCE_TYPE_BUFFER, id);
 
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed buffer:", group->name.c_str());
@@ -427,7 +499,7 @@ ResourceID resources_push_texture(const ResourceGroupID& group_id, const GfxText
 
   // Create the texture
   ResourceID id; 
-  GfxTexture* texture = gfx_texture_create(renderer_get_context(), desc);
+  GfxTexture* texture = gfx_texture_create(renderer_get_context(), desc, gfx_texture_pool_allocate);
   PUSH_RESOURCE(group, textures, texture, RESOURCE_TYPE_TEXTURE, id);
 
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed texture:", group->name.c_str());
@@ -462,7 +534,7 @@ ResourceID resources_push_texture(const ResourceGroupID& group_id,
 
   // Create the texture 
   ResourceID id; 
-  GfxTexture* texture = gfx_texture_create(renderer_get_context(), tex_desc);
+  GfxTexture* texture = gfx_texture_create(renderer_get_context(), tex_desc, gfx_texture_pool_allocate);
   PUSH_RESOURCE(group, textures, texture, RESOURCE_TYPE_TEXTURE, id);
 
   // Remember to close the NBR
@@ -471,7 +543,7 @@ ResourceID resources_push_texture(const ResourceGroupID& group_id,
   // Add the resource to the named resources
   FilePath filename_without_ext = filepath_filename(nbr_path);
   filepath_set_extension(filename_without_ext, "");
-  group->named_ids[filename_without_ext] = id;
+  group->named_ids[string_id_intern(filename_without_ext.c_str())] = id;
 
   // New texture added!
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed texture:", group->name.c_str());
@@ -487,7 +559,7 @@ ResourceID resources_push_cubemap(const ResourceGroupID& group_id, const GfxCube
 
   // Create the cubemap
   ResourceID id; 
-  GfxCubemap* cubemap = gfx_cubemap_create(renderer_get_context(), cubemap_desc);
+  GfxCubemap* cubemap = gfx_cubemap_create(renderer_get_context(), cubemap_desc, gfx_cubemap_pool_allocate);
   PUSH_RESOURCE(group, cubemaps, cubemap, RESOURCE_TYPE_CUBEMAP, id);
   
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed cubemap:", group->name.c_str());
@@ -521,7 +593,7 @@ ResourceID resources_push_cubemap(const ResourceGroupID& group_id,
 
   // Create the cubemap
   ResourceID id; 
-  GfxCubemap* cubemap = gfx_cubemap_create(renderer_get_context(), cube_desc);
+  GfxCubemap* cubemap = gfx_cubemap_create(renderer_get_context(), cube_desc, gfx_cubemap_pool_allocate);
   PUSH_RESOURCE(group, cubemaps, cubemap, RESOURCE_TYPE_CUBEMAP, id);
 
   // Remember to close the NBR
@@ -530,7 +602,7 @@ ResourceID resources_push_cubemap(const ResourceGroupID& group_id,
   // Add the resource to the named resources
   FilePath filename_without_ext = filepath_filename(nbr_path);
   filepath_set_extension(filename_without_ext, "");
-  group->named_ids[filename_without_ext] = id;
+  group->named_ids[string_id_intern(filename_without_ext.c_str())] = id;
 
   // New cubemap added!
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed cubemap:", group->name.c_str());
@@ -546,7 +618,7 @@ ResourceID resources_push_shader(const ResourceGroupID& group_id, const GfxShade
 
   // Create the shader
   ResourceID id; 
-  GfxShader* shader = gfx_shader_create(renderer_get_context(), shader_desc);
+  GfxShader* shader = gfx_shader_create(renderer_get_context(), shader_desc, gfx_shader_pool_allocate);
   PUSH_RESOURCE(group, shaders, shader, RESOURCE_TYPE_SHADER, id);
 
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed shader:", group->name.c_str());
@@ -580,7 +652,7 @@ ResourceID resources_push_shader(const ResourceGroupID& group_id, const FilePath
   // Add the resource to the named resources
   FilePath filename_without_ext = filepath_filename(nbr_path);
   filepath_set_extension(filename_without_ext, "");
-  group->named_ids[filename_without_ext] = id;
+  group->named_ids[string_id_intern(filename_without_ext.c_str())] = id;
 
   // New shader added!
   NIKOLA_LOG_DEBUG("     Path = %s", nbr_path.c_str());
@@ -592,7 +664,7 @@ ResourceID resources_push_shader_context(const ResourceGroupID& group_id, const
   ResourceGroup* group = &s_manager.groups[group_id];
   
   // Allocate the context
-  ShaderContext* ctx = new ShaderContext{};
+  ShaderContext* ctx = pool_new<ShaderContext>(s_manager.shader_contexts_pool);
   ctx->shader        = resources_get_shader(shader_id);
   
   // Create the context
@@ -624,13 +696,19 @@ ResourceID resources_push_mesh(const ResourceGroupID& group_id, NBRMesh& nbr_mes
   ResourceGroup* group = &s_manager.groups[group_id];
 
   // Allocate the mesh
-  Mesh* mesh = new Mesh{};
+  Mesh* mesh = pool_new<Mesh>(s_manager.meshes_pool);
 
   // Convert the NBR mesh into the engine's mesh format 
   nbr_import_mesh(&nbr_mesh, group_id, mesh);
 
+  // Every mesh can be part of an instanced draw
+  renderer_attach_instance_layout(mesh->pipe_desc);
+
   // Create the pipeline
-  mesh->pipe = gfx_pipeline_create(renderer_get_context(), mesh->pipe_desc);
+  mesh->pipe = gfx_pipeline_create(renderer_get_context(), mesh->pipe_desc, gfx_pipeline_pool_allocate);
+
+  // Meshes of the same vertex format can be drawn together
+  renderer_share_mesh_geometry(mesh);
 
   // Create the mesh
   ResourceID id; 
@@ -649,17 +727,23 @@ ResourceID resources_push_mesh(const ResourceGroupID& group_id, const GeometryTy
   ResourceGroup* group = &s_manager.groups[group_id];
   
   // Allocate the mesh
-  Mesh* mesh = new Mesh{};
+  Mesh* mesh = pool_new<Mesh>(s_manager.meshes_pool);
 
   // Use the loader to set up the mesh
-  geometry_loader_load(group_id, &mesh->pipe_desc, type);
+  geometry_loader_load(group_id, &mesh->pipe_desc, type, &mesh->bounds, &mesh->bounds_sphere);
+
+  // Every mesh can be part of an instanced draw
+  renderer_attach_instance_layout(mesh->pipe_desc);
 
   // Setting the buffers
   mesh->vertex_buffer = mesh->pipe_desc.vertex_buffer;
   mesh->index_buffer  = mesh->pipe_desc.index_buffer;
 
   // Create the pipeline
-  mesh->pipe = gfx_pipeline_create(renderer_get_context(), mesh->pipe_desc);
+  mesh->pipe = gfx_pipeline_create(renderer_get_context(), mesh->pipe_desc, gfx_pipeline_pool_allocate);
+
+  // Meshes of the same vertex format can be drawn together
+  renderer_share_mesh_geometry(mesh);
 
   // Create the mesh
   ResourceID id; 
@@ -678,7 +762,7 @@ ResourceID resources_push_material(const ResourceGroupID& group_id, const Resour
   ResourceGroup* group = &s_manager.groups[group_id];
   
   // Allocate the material
-  Material* material = new Material{};
+  Material* material = pool_new<Material>(s_manager.materials_pool);
 
   // Set default values for the material
   material->color     = Vec4(1.0f); 
@@ -716,7 +800,7 @@ ResourceID resources_push_skybox(const ResourceGroupID& group_id, const Resource
   ResourceGroup* group = &s_manager.groups[group_id];
 
   // Allocate the skybox
-  Skybox* skybox = new Skybox{};
+  Skybox* skybox = pool_new<Skybox>(s_manager.skyboxes_pool);
   
   // Use the loader to set up the skybox
   geometry_loader_load(group_id, &skybox->pipe_desc, GEOMETRY_SKYBOX);
@@ -725,7 +809,7 @@ ResourceID resources_push_skybox(const ResourceGroupID& group_id, const Resource
   skybox->cubemap = resources_get_cubemap(cubemap_id);
 
   // Create the pipeline 
-  skybox->pipe = gfx_pipeline_create(renderer_get_context(), skybox->pipe_desc);
+  skybox->pipe = gfx_pipeline_create(renderer_get_context(), skybox->pipe_desc, gfx_pipeline_pool_allocate);
 
   // Create skybox
   ResourceID id;
@@ -755,7 +839,7 @@ ResourceID resources_push_model(const ResourceGroupID& group_id, const FilePath&
   nbr_file_load(&nbr, filepath_append(group->parent_dir, nbr_path));
 
   // Allocate the model
-  Model* model = new Model{};
+  Model* model = pool_new<Model>(s_manager.models_pool);
   
   // Convert the NBR format to a valid model
   NBRModel* nbr_model = (NBRModel*)nbr.body_data; 
@@ -771,7 +855,7 @@ ResourceID resources_push_model(const ResourceGroupID& group_id, const FilePath&
   // Add the resource to the named resources
   FilePath filename_without_ext = filepath_filename(nbr_path);
   filepath_set_extension(filename_without_ext, "");
-  group->named_ids[filename_without_ext] = id;
+  group->named_ids[string_id_intern(filename_without_ext.c_str())] = id;
 
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed model:", group->name.c_str());
   NIKOLA_LOG_DEBUG("     Meshes    = %zu", model->meshes.size());
@@ -790,7 +874,7 @@ ResourceID resources_push_font(const ResourceGroupID& group_id, const FilePath&
   nbr_file_load(&nbr, filepath_append(group->parent_dir, nbr_path));
 
   // Allocate the model
-  Font* font = new Font{};
+  Font* font = pool_new<Font>(s_manager.fonts_pool);
   
   // Convert the NBR format to a valid model
   NBRFont* nbr_font = (NBRFont*)nbr.body_data; 
@@ -806,7 +890,7 @@ ResourceID resources_push_font(const ResourceGroupID& group_id, const FilePath&
   // Add the resource to the named resources
   FilePath filename_without_ext = filepath_filename(nbr_path);
   filepath_set_extension(filename_without_ext, "");
-  group->named_ids[filename_without_ext] = id;
+  group->named_ids[string_id_intern(filename_without_ext.c_str())] = id;
 
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed font:", group->name.c_str());
   NIKOLA_LOG_DEBUG("     Glyphs   = %zu", font->glyphs.size());
@@ -858,7 +942,7 @@ ResourceID resources_push_audio_buffer(const ResourceGroupID& group_id, const Fi
   // Add the resource to the named resources
   FilePath filename_without_ext = filepath_filename(nbr_path);
   filepath_set_extension(filename_without_ext, "");
-  group->named_ids[filename_without_ext] = id;
+  group->named_ids[string_id_intern(filename_without_ext.c_str())] = id;
   
   NIKOLA_LOG_DEBUG("     Name        = %s", filename_without_ext.c_str());
   return id;
@@ -872,17 +956,22 @@ void resources_push_dir(const ResourceGroupID& group_id, const FilePath& dir) {
   filesystem_directory_iterate(filepath_append(group->parent_dir, dir), resource_entry_iterate, group);
 }
 
-ResourceID& resources_get_id(const ResourceGroupID& group_id, const nikola::String& filename) {
+ResourceID resources_get_id(const ResourceGroupID& group_id, const nikola::String& filename) {
+  return resources_get_id(group_id, StringID(filename.c_str(), filename.size()));
+}
+
+ResourceID resources_get_id(const ResourceGroupID& group_id, const StringID& filename) {
   GROUP_CHECK(group_id);
   ResourceGroup* group = &s_manager.groups[group_id];
  
   // The resource was not found
-  if(group->named_ids.find(filename) == group->named_ids.end()) {
-    NIKOLA_LOG_ERROR("Could not find resource \'%s\' in resource group \'%s\'", filename.c_str(), group->name.c_str());
-    return group->named_ids["invalid"];
+  auto entry = group->named_ids.find(filename);
+  if(entry == group->named_ids.end()) {
+    NIKOLA_LOG_ERROR("Could not find resource \'%s\' in resource group \'%s\'", string_id_str(filename), group->name.c_str());
+    return group->named_ids[INVALID_RESOURCE_NAME];
   }
 
-  return group->named_ids[filename];
+  return entry->second;
 }
 
 GfxBuffer* resources_get_buffer(const ResourceID& id) {
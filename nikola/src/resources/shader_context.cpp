@@ -9,34 +9,48 @@ namespace nikola {
 ///---------------------------------------------------------------------------------------------------------------------
 /// Private functions
 
-static void cache_uniform(ShaderContext* ctx, const String& name) {
+static i32 cache_uniform(ShaderContext* ctx, const StringID& name) {
   GfxShader* shader = ctx->shader; 
   
   // Get the new uniform location, first
-  i32 location = gfx_shader_uniform_lookup(shader, name.c_str());
+  i32 location = gfx_shader_uniform_lookup(shader, name.str);
   
-  // The uniform just does not exist in the shader at all 
+  // The uniform just does not exist in the shader at all. Cache it anyways 
+  // as an invalid location so we don't have to look it up (and warn) every time.
   if(location == -1) {
-    NIKOLA_LOG_WARN("Could not find uniform \'%s\' in ShaderContext", name.c_str());
-    return;
+    NIKOLA_LOG_WARN("Could not find uniform \'%s\' in ShaderContext", name.str);
   }
   
-  ctx->uniforms_cache[name] = location; 
-  NIKOLA_LOG_DEBUG("Cache uniform \'%s\' with location \'%i\' in ShaderContext...", name.c_str(), location);
+  // Keep the name around for debugging
+  ctx->uniforms_cache[string_id_intern(name.str)] = location; 
+  NIKOLA_LOG_DEBUG("Cache uniform \'%s\' with location \'%i\' in ShaderContext...", name.str, location);
+
+  return location;
 }
 
-static void check_and_send_uniform(ShaderContext* ctx, const String& name, GfxLayoutType type, const void* data) {
-  GfxShader* shader = ctx->shader; 
+static i32 resolve_uniform(ShaderContext* ctx, const StringID& name) {
+  // Uniform isn't cached yet. So, cache it.
+  auto uniform = ctx->uniforms_cache.find(name);
+  if(uniform != ctx->uniforms_cache.end()) {
+    return uniform->second;
+  }
+
+  return cache_uniform(ctx, name); 
+}
 
+static void send_uniform(ShaderContext* ctx, const i32 location, GfxLayoutType type, const void* data) {
   // Send the uniform (only if it is valid)
-  if(ctx->uniforms_cache.find(name) != ctx->uniforms_cache.end()) {
-    gfx_shader_upload_uniform(shader, ctx->uniforms_cache[name], type, data);
-    return;
+  if(location != UNIFORM_HANDLE_INVALID) {
+    gfx_shader_upload_uniform(ctx->shader, location, type, data);
   }
-  
-  // Uniform exists but isn't cached. So, cache it.
-  cache_uniform(ctx, name); 
-  gfx_shader_upload_uniform(shader, ctx->uniforms_cache[name], type, data);
+}
+
+static void check_and_send_uniform(ShaderContext* ctx, const StringID& name, GfxLayoutType type, const void* data) {
+  send_uniform(ctx, resolve_uniform(ctx, name), type, data);
+}
+
+static StringID string_to_id(const String& str) {
+  return StringID(str.c_str(), str.size());
 }
 
 /// Private functions
@@ -46,54 +60,142 @@ static void check_and_send_uniform(ShaderContext* ctx, const String& name, GfxLa
 /// ShaderContext functions
 
 void shader_context_cache_uniform(ShaderContext* ctx, const String& uniform_name) {
-  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
-  NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
+  shader_context_cache_uniform(ctx, string_to_id(uniform_name));
+}
+
+void shader_context_cache_uniform(ShaderContext* ctx, const StringID& uniform_name) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_cache_uniform");
+  NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_cache_uniform");
+  NIKOLA_ASSERT(uniform_name.str, "Cannot cache a uniform without a name");
   
-  cache_uniform(ctx, uniform_name);
+  if(ctx->uniforms_cache.find(uniform_name) == ctx->uniforms_cache.end()) {
+    cache_uniform(ctx, uniform_name);
+  }
 }
 
 void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const i32 value) {
+  shader_context_set_uniform(ctx, string_to_id(uniform_name), value);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const f32 value) {
+  shader_context_set_uniform(ctx, string_to_id(uniform_name), value);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const Vec2& value) {
+  shader_context_set_uniform(ctx, string_to_id(uniform_name), value);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const Vec3& value) {
+  shader_context_set_uniform(ctx, string_to_id(uniform_name), value);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const Vec4& value) {
+  shader_context_set_uniform(ctx, string_to_id(uniform_name), value);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const Mat4& value) {
+  shader_context_set_uniform(ctx, string_to_id(uniform_name), value);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const StringID& uniform_name, const i32 value) {
   NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
   NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
 
   check_and_send_uniform(ctx, uniform_name, GFX_LAYOUT_INT1, &value);
 }
 
-void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const f32 value) {
+void shader_context_set_uniform(ShaderContext* ctx, const StringID& uniform_name, const f32 value) {
   NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
   NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
 
   check_and_send_uniform(ctx, uniform_name, GFX_LAYOUT_FLOAT1, &value);
 }
 
-void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const Vec2& value) {
+void shader_context_set_uniform(ShaderContext* ctx, const StringID& uniform_name, const Vec2& value) {
   NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
   NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
 
   check_and_send_uniform(ctx, uniform_name, GFX_LAYOUT_FLOAT2, &value);
 }
 
-void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const Vec3& value) {
+void shader_context_set_uniform(ShaderContext* ctx, const StringID& uniform_name, const Vec3& value) {
   NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
   NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
 
   check_and_send_uniform(ctx, uniform_name, GFX_LAYOUT_FLOAT3, &value);
 }
 
-void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const Vec4& value) {
+void shader_context_set_uniform(ShaderContext* ctx, const StringID& uniform_name, const Vec4& value) {
   NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
   NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
 
   check_and_send_uniform(ctx, uniform_name, GFX_LAYOUT_FLOAT4, &value);
 }
 
-void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const Mat4& value) {
+void shader_context_set_uniform(ShaderContext* ctx, const StringID& uniform_name, const Mat4& value) {
   NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
   NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
 
   check_and_send_uniform(ctx, uniform_name, GFX_LAYOUT_MAT4, &value);
 }
 
+UniformHandle shader_context_resolve_uniform(ShaderContext* ctx, const StringID& uniform_name) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_resolve_uniform");
+  NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_resolve_uniform");
+  NIKOLA_ASSERT(uniform_name.str, "Cannot resolve a uniform without a name");
+
+  return resolve_uniform(ctx, uniform_name);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const UniformHandle handle, const i32 value) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
+  NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
+
+  send_uniform(ctx, handle, GFX_LAYOUT_INT1, &value);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const UniformHandle handle, const f32 value) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
+  NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
+
+  send_uniform(ctx, handle, GFX_LAYOUT_FLOAT1, &value);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const UniformHandle handle, const Vec2& value) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
+  NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
+
+  send_uniform(ctx, handle, GFX_LAYOUT_FLOAT2, &value);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const UniformHandle handle, const Vec3& value) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
+  NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
+
+  send_uniform(ctx, handle, GFX_LAYOUT_FLOAT3, &value);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const UniformHandle handle, const Vec4& value) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
+  NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
+
+  send_uniform(ctx, handle, GFX_LAYOUT_FLOAT4, &value);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const UniformHandle handle, const Mat4& value) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
+  NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
+
+  send_uniform(ctx, handle, GFX_LAYOUT_MAT4, &value);
+}
+
+void shader_context_invalidate_uniforms(ShaderContext* ctx) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_invalidate_uniforms");
+
+  ctx->uniforms_cache.clear();
+  ctx->generation++;
+}
+
 void shader_context_set_uniform_buffer(ShaderContext* ctx, const sizei index, const GfxBuffer* buffer) {
   NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform_buffer");
   NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform_buffer");
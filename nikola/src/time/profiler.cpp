@@ -0,0 +1,288 @@
+#include "nikola/nikola_profiler.h"
+#include "nikola/nikola_base.h"
+#include "nikola/nikola_containers.h"
+#include "nikola/nikola_file.h"
+
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstdio>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace nikola { // Start of nikola
+
+/// ---------------------------------------------------------------------
+/// ProfileEventType
+enum ProfileEventType {
+  PROFILE_EVENT_ZONE = 0,
+  PROFILE_EVENT_FRAME,
+};
+/// ProfileEventType
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// ProfileEvent
+struct ProfileEvent {
+  const char* name = nullptr;
+
+  u64 begin_ns    = 0;
+  u64 duration_ns = 0;
+
+  u32 type  = PROFILE_EVENT_ZONE;
+  u32 frame = 0;
+};
+/// ProfileEvent
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// ProfileThread
+
+/// A ring buffer of events owned by a single thread. Only the owning thread
+/// writes into it, so recording an event never takes a lock.
+struct ProfileThread {
+  ProfileEvent events[PROFILER_EVENTS_PER_THREAD];
+
+  std::atomic<u64> write_index = 0;
+  std::atomic<u64> clear_index = 0;
+
+  u32 id = 0;
+  char name[64];
+};
+/// ProfileThread
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// Profiler
+struct Profiler {
+  std::mutex mutex;
+
+  ProfileThread* threads[PROFILER_THREADS_MAX];
+  u32 threads_count = 0;
+
+  /// Bumped on every shutdown so threads know their buffer is gone.
+  std::atomic<u32> generation = 1;
+  std::atomic<u32> frame      = 0;
+
+  std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+static Profiler s_profiler;
+
+static thread_local ProfileThread* s_thread   = nullptr;
+static thread_local u32 s_thread_generation   = 0;
+/// Profiler
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// Private functions
+
+static ProfileThread* get_thread() {
+  u32 generation = s_profiler.generation.load(std::memory_order_acquire);
+  if(s_thread && s_thread_generation == generation) {
+    return s_thread;
+  }
+
+  std::lock_guard<std::mutex> lock(s_profiler.mutex);
+
+  if(s_profiler.threads_count >= PROFILER_THREADS_MAX) {
+    return nullptr;
+  }
+
+  ProfileThread* thread = (ProfileThread*)memory_allocate(sizeof(ProfileThread));
+  new (thread) ProfileThread{};
+
+  thread->id = s_profiler.threads_count + 1;
+  snprintf(thread->name, sizeof(thread->name), "Thread %u", thread->id);
+
+  s_profiler.threads[s_profiler.threads_count++] = thread;
+
+  s_thread            = thread;
+  s_thread_generation = generation;
+
+  return thread;
+}
+
+static void push_event(const ProfileEvent& event) {
+  ProfileThread* thread = get_thread();
+  if(!thread) {
+    return;
+  }
+
+  u64 index = thread->write_index.load(std::memory_order_relaxed);
+  thread->events[index & (PROFILER_EVENTS_PER_THREAD - 1)] = event;
+
+  thread->write_index.store(index + 1, std::memory_order_release);
+}
+
+static void append_escaped(String& out, const char* str) {
+  for(const char* ch = str; *ch; ch++) {
+    if(*ch == '\"' || *ch == '\\') {
+      out += '\\';
+    }
+
+    out += *ch;
+  }
+}
+
+static void append_event(String& out, const ProfileThread* thread, const ProfileEvent& event, bool* is_first) {
+  char buffer[128];
+
+  if(!*is_first) {
+    out += ",\n";
+  }
+  *is_first = false;
+
+  switch(event.type) {
+    case PROFILE_EVENT_ZONE:
+      out += "{\"name\":\"";
+      append_escaped(out, event.name);
+      snprintf(buffer, sizeof(buffer),
+               "\",\"cat\":\"nikola\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+               thread->id,
+               (f64)event.begin_ns / 1000.0,
+               (f64)event.duration_ns / 1000.0);
+      out += buffer;
+      break;
+    case PROFILE_EVENT_FRAME:
+      snprintf(buffer, sizeof(buffer),
+               "{\"name\":\"Frame %u\",\"cat\":\"nikola\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+               event.frame,
+               thread->id,
+               (f64)event.begin_ns / 1000.0);
+      out += buffer;
+      break;
+  }
+}
+
+/// Private functions
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// ProfileZone functions
+
+ProfileZone::ProfileZone(const char* zone_name)
+  :name(zone_name), begin_ns(profiler_get_time_ns())
+{}
+
+ProfileZone::~ProfileZone() {
+  profiler_record_zone(name, begin_ns, profiler_get_time_ns());
+}
+
+/// ProfileZone functions
+/// ---------------------------------------------------------------------
+
+/// ---------------------------------------------------------------------
+/// Profiler functions
+
+void profiler_record_zone(const char* name, const u64 begin_ns, const u64 end_ns) {
+  push_event(ProfileEvent {
+    .name        = name,
+    .begin_ns    = begin_ns,
+    .duration_ns = end_ns - begin_ns,
+    .type        = PROFILE_EVENT_ZONE,
+  });
+}
+
+void profiler_frame_mark() {
+  push_event(ProfileEvent {
+    .name     = "Frame",
+    .begin_ns = profiler_get_time_ns(),
+    .type     = PROFILE_EVENT_FRAME,
+    .frame    = s_profiler.frame.fetch_add(1, std::memory_order_relaxed),
+  });
+}
+
+void profiler_set_thread_name(const char* name) {
+  ProfileThread* thread = get_thread();
+  if(!thread) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(s_profiler.mutex);
+  snprintf(thread->name, sizeof(thread->name), "%s", name);
+}
+
+const u64 profiler_get_time_ns() {
+  auto duration = std::chrono::steady_clock::now() - s_profiler.epoch;
+  return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+const bool profiler_dump(const char* path) {
+  String out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+  bool is_first     = true;
+  sizei events_count = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(s_profiler.mutex);
+
+    for(u32 i = 0; i < s_profiler.threads_count; i++) {
+      ProfileThread* thread = s_profiler.threads[i];
+
+      // The name of the thread
+      if(!is_first) {
+        out += ",\n";
+      }
+      is_first = false;
+
+      out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(thread->id) + ",\"args\":{\"name\":\"";
+      append_escaped(out, thread->name);
+      out += "\"}}";
+
+      // Only the newest events survive a full buffer
+      u64 end   = thread->write_index.load(std::memory_order_acquire);
+      u64 begin = thread->clear_index.load(std::memory_order_acquire);
+      if((end - begin) > PROFILER_EVENTS_PER_THREAD) {
+        begin = end - PROFILER_EVENTS_PER_THREAD;
+      }
+
+      for(u64 j = begin; j < end; j++) {
+        append_event(out, thread, thread->events[j & (PROFILER_EVENTS_PER_THREAD - 1)], &is_first);
+      }
+
+      events_count += (end - begin);
+    }
+  }
+
+  out += "\n]}\n";
+
+  File file;
+  if(!file_open(&file, path, (i32)FILE_OPEN_WRITE)) {
+    NIKOLA_LOG_ERROR("Failed to open profiler trace file \'%s\'", path);
+    return false;
+  }
+
+  file_write_bytes(file, out);
+  file_close(file);
+
+  NIKOLA_LOG_INFO("Dumped %zu profiler events to \'%s\'", events_count, path);
+  return true;
+}
+
+void profiler_clear() {
+  std::lock_guard<std::mutex> lock(s_profiler.mutex);
+
+  for(u32 i = 0; i < s_profiler.threads_count; i++) {
+    ProfileThread* thread = s_profiler.threads[i];
+    thread->clear_index.store(thread->write_index.load(std::memory_order_acquire), std::memory_order_release);
+  }
+}
+
+void profiler_shutdown() {
+  std::lock_guard<std::mutex> lock(s_profiler.mutex);
+
+  for(u32 i = 0; i < s_profiler.threads_count; i++) {
+    s_profiler.threads[i]->~ProfileThread();
+    memory_free(s_profiler.threads[i]);
+  }
+
+  s_profiler.threads_count = 0;
+  s_profiler.generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+/// Profiler functions
+/// ---------------------------------------------------------------------
+
+} // End of nikola
+
+//////////////////////////////////////////////////////////////////////////
@@ -82,6 +82,8 @@ void gui_shutdown() {
   ImGui_ImplGlfw_Shutdown();
   ImGui_ImplOpenGL3_Shutdown();
   ImGui::DestroyContext();
+
+  s_gui.rotations.destroy();
 }
 
 void gui_begin() {
@@ -116,6 +118,14 @@ void gui_renderer_info() {
   // Stats
   // -------------------------------------------------------------------
   ImGui::SeparatorText("Stats");
+
+  // GPU timings
+  for(auto& timing : renderer_get_timings()) {
+    ImGui::Text("%s: %.3lf ms", timing.name.c_str(), timing.gpu_time);
+  }
+
+  const RenderTiming& batch_timing = batch_renderer_get_timing();
+  ImGui::Text("%s: %.3lf ms", batch_timing.name.c_str(), batch_timing.gpu_time);
   // -------------------------------------------------------------------
  
   // Editables
@@ -141,6 +151,19 @@ void gui_debug_info() {
   if(ImGui::CollapsingHeader("Frames")) {
     s_gui.fps = niclock_get_fps();
     ImGui::Text("FPS: %f", s_gui.fps);
+
+    // Frame times
+    FrameTimeStats stats = niclock_get_frame_stats();
+    ImGui::Text("Min: %.3lf ms | Avg: %.3lf ms | Max: %.3lf ms", stats.min_ms, stats.avg_ms, stats.max_ms);
+    ImGui::Text("P50: %.3lf ms | P95: %.3lf ms | P99: %.3lf ms", stats.p50_ms, stats.p95_ms, stats.p99_ms);
+    ImGui::Text("Hitches: %zu (total = %llu)", stats.hitches_count, (unsigned long long)stats.total_hitches_count);
+
+    const f32* frame_times = nullptr;
+    sizei frames_count     = 0; 
+    sizei frames_offset    = 0;
+    niclock_get_frame_history(&frame_times, &frames_count, &frames_offset);
+
+    ImGui::PlotLines("Frame times (ms)", frame_times, (i32)frames_count, (i32)frames_offset, nullptr, 0.0f, (f32)(stats.max_ms * 1.25), ImVec2(0.0f, 60.0f));
   } 
   // -------------------------------
 
@@ -172,7 +195,13 @@ void gui_debug_info() {
 
     ImGui::Text("Allocations: %zu", s_gui.allocations_count);
     ImGui::Text("Bytes allocated: %zu", s_gui.allocation_bytes);
-  } 
+
+    ImGui::SeparatorText("Tags");
+    for(sizei i = 0; i < MEMORY_TAGS_MAX; i++) {
+      MemoryTagStats stats = memory_get_tag_stats((MemoryTag)i);
+      ImGui::Text("%s: %zu bytes (peak = %zu)", memory_tag_str((MemoryTag)i), stats.live_bytes, stats.peak_bytes);
+    }
+  }
   // -------------------------------
 
   ImGui::End();
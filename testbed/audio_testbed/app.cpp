@@ -92,7 +92,7 @@ void app_update(nikola::App* app, const nikola::f64 delta_time) {
   }
 } 
 
-void app_render(nikola::App* app) {
+void app_render(nikola::App* app, const nikola::f64 alpha) {
   nikola::renderer_begin(app->frame_data);
   nikola::renderer_end();
   
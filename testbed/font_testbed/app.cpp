@@ -186,7 +186,7 @@ void app_update(nikola::App* app, const nikola::f64 delta_time) {
   nikola::camera_update(app->frame_data.camera);
 } 
 
-void app_render(nikola::App* app) {
+void app_render(nikola::App* app, const nikola::f64 alpha) {
   // 3D renderer
   nikola::renderer_begin(app->frame_data);
   nikola::renderer_queue_model(app->model_id, app->transform);
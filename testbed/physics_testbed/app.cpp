@@ -198,7 +198,7 @@ void app_update(nikola::App* app, const nikola::f64 delta_time) {
   nikola::camera_update(app->frame_data.camera);
 }
 
-void app_render(nikola::App* app) {
+void app_render(nikola::App* app, const nikola::f64 alpha) {
   // Render 3D 
   nikola::renderer_begin(app->frame_data);
 
@@ -134,7 +134,7 @@ void app_update(nikola::App* app, const nikola::f64 delta_time) {
   scenes_update(delta_time);
 } 
 
-void app_render(nikola::App* app) {
+void app_render(nikola::App* app, const nikola::f64 alpha) {
   // 3D renderer
   nikola::renderer_begin(scenes_get_current()->frame_data);
   scenes_render();
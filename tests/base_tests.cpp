@@ -0,0 +1,236 @@
+#include "tests.h"
+
+#include <nikola/nikola.h>
+
+#include <atomic>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace tests { // Start of tests
+
+/// ----------------------------------------------------------------------
+/// EventLog
+
+/// Everything the event callbacks below saw, in the order they saw it.
+struct EventLog {
+  nikola::DynamicArray<nikola::i32> calls;
+  nikola::DynamicArray<nikola::Event> events;
+
+  nikola::EventListenerID self_id;
+};
+/// EventLog
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static void increment_job(void* user_data) {
+  std::atomic<nikola::i32>* value = (std::atomic<nikola::i32>*)user_data;
+  value->fetch_add(1);
+}
+
+static void nested_job(void* user_data) {
+  // Waiting from inside a job has to run the inner jobs rather than dead-lock
+  nikola::JobCounter counter;
+  for(nikola::sizei i = 0; i < JOBS_COUNT; i++) {
+    nikola::job_dispatch(increment_job, user_data, &counter);
+  }
+
+  nikola::job_wait(counter);
+}
+
+static void mark_range(const nikola::sizei begin, const nikola::sizei end, void* user_data) {
+  std::atomic<nikola::i32>* hits = (std::atomic<nikola::i32>*)user_data;
+
+  for(nikola::sizei i = begin; i < end; i++) {
+    hits[i].fetch_add(1);
+  }
+}
+
+template<nikola::i32 ID>
+static bool log_event(const nikola::Event& event, const void* dispatcher, const void* listener) {
+  EventLog* log = (EventLog*)listener;
+
+  log->calls.push_back(ID);
+  log->events.push_back(event);
+
+  return true;
+}
+
+static bool unlisten_self(const nikola::Event& event, const void* dispatcher, const void* listener) {
+  EventLog* log = (EventLog*)listener;
+  log->calls.push_back(-1);
+
+  nikola::event_unlisten(log->self_id);
+  return true;
+}
+
+static nikola::Event make_mouse_event(const nikola::f32 x, const nikola::f32 y) {
+  nikola::Event event = {};
+  event.type          = nikola::EVENT_MOUSE_MOVED;
+  event.mouse_pos_x   = x;
+  event.mouse_pos_y   = y;
+
+  return event;
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Tests
+
+bool test_job_system() {
+  // Single jobs
+  std::atomic<nikola::i32> value = 0;
+  nikola::JobCounter counter;
+
+  for(nikola::sizei i = 0; i < JOBS_COUNT; i++) {
+    nikola::job_dispatch(increment_job, &value, &counter);
+  }
+
+  nikola::job_wait(counter);
+  TEST_CHECK(nikola::job_counter_is_done(counter));
+  TEST_CHECK(value == (nikola::i32)JOBS_COUNT);
+
+  // Batches
+  nikola::DynamicArray<nikola::JobDesc> jobs(JOBS_COUNT, nikola::JobDesc{increment_job, &value});
+  nikola::job_dispatch_batch(jobs.data(), jobs.size(), &counter);
+
+  nikola::job_wait(counter);
+  TEST_CHECK(value == (nikola::i32)(JOBS_COUNT * 2));
+
+  // Jobs waiting on their own jobs
+  value = 0;
+  for(nikola::sizei i = 0; i < JOBS_COUNT; i++) {
+    nikola::job_dispatch(nested_job, &value, &counter);
+  }
+
+  nikola::job_wait(counter);
+  TEST_CHECK(value == (nikola::i32)(JOBS_COUNT * JOBS_COUNT));
+
+  // Every index gets visited exactly once, whatever the batch size is
+  const nikola::sizei batch_sizes[] = {0, 1, 7, JOBS_COUNT, JOBS_COUNT + 1};
+  for(const nikola::sizei batch_size : batch_sizes) {
+    nikola::DynamicArray<std::atomic<nikola::i32>> hits(JOBS_COUNT);
+    nikola::job_parallel_for(JOBS_COUNT, batch_size, mark_range, hits.data());
+
+    for(nikola::sizei i = 0; i < JOBS_COUNT; i++) {
+      TEST_CHECK(hits[i] == 1);
+    }
+  }
+
+  return true;
+}
+
+bool test_event_unlisten() {
+  EventLog log;
+
+  nikola::Event event = {};
+  event.type          = nikola::EVENT_KEY_PRESSED;
+
+  // Higher priorities go first, and equal priorities keep their order
+  nikola::EventListenerID first  = nikola::event_listen(nikola::EVENT_KEY_PRESSED, log_event<1>, &log);
+  nikola::EventListenerID second = nikola::event_listen(nikola::EVENT_KEY_PRESSED, log_event<2>, &log);
+  nikola::EventListenerID high   = nikola::event_listen(nikola::EVENT_KEY_PRESSED, log_event<3>, &log, 10);
+
+  TEST_CHECK(nikola::event_dispatch(event));
+  TEST_CHECK((log.calls == nikola::DynamicArray<nikola::i32>{3, 1, 2}));
+
+  // Detaching the same listener twice does nothing the second time
+  nikola::event_unlisten(first);
+  nikola::event_unlisten(first);
+
+  log.calls.clear();
+  nikola::event_dispatch(event);
+  TEST_CHECK((log.calls == nikola::DynamicArray<nikola::i32>{3, 2}));
+
+  // A new listener can take the freed slot, which the old ID must not detach
+  nikola::EventListenerID reused = nikola::event_listen(nikola::EVENT_KEY_PRESSED, log_event<4>, &log);
+  nikola::event_unlisten(first);
+
+  log.calls.clear();
+  nikola::event_dispatch(event);
+  TEST_CHECK((log.calls == nikola::DynamicArray<nikola::i32>{3, 2, 4}));
+
+  // A listener can detach itself, while the rest still get called in the same dispatch
+  log.self_id = nikola::event_listen(nikola::EVENT_KEY_PRESSED, unlisten_self, &log, 5);
+
+  log.calls.clear();
+  nikola::event_dispatch(event);
+  TEST_CHECK((log.calls == nikola::DynamicArray<nikola::i32>{3, -1, 2, 4}));
+
+  log.calls.clear();
+  nikola::event_dispatch(event);
+  TEST_CHECK((log.calls == nikola::DynamicArray<nikola::i32>{3, 2, 4}));
+
+  nikola::event_unlisten(second);
+  nikola::event_unlisten(high);
+  nikola::event_unlisten(reused);
+
+  log.calls.clear();
+  nikola::event_dispatch(event);
+  TEST_CHECK(log.calls.empty());
+
+  return true;
+}
+
+bool test_event_queue_coalescing() {
+  EventLog log;
+  nikola::i32 dispatcher_a = 0, dispatcher_b = 0;
+
+  nikola::EventListenerID mouse_id = nikola::event_listen(nikola::EVENT_MOUSE_MOVED, log_event<1>, &log);
+  nikola::EventListenerID key_id   = nikola::event_listen(nikola::EVENT_KEY_PRESSED, log_event<2>, &log);
+
+  nikola::Event key_event = {};
+  key_event.type          = nikola::EVENT_KEY_PRESSED;
+
+  // Back-to-back moves of the same dispatcher only leave the latest one
+  TEST_CHECK(nikola::event_post(make_mouse_event(1.0f, 1.0f), &dispatcher_a));
+  TEST_CHECK(nikola::event_post(make_mouse_event(2.0f, 2.0f), &dispatcher_a));
+  TEST_CHECK(nikola::event_post(make_mouse_event(3.0f, 3.0f), &dispatcher_a));
+
+  // Nothing is dispatched until the queue is processed
+  TEST_CHECK(log.calls.empty());
+  nikola::event_process_queue();
+
+  TEST_CHECK(log.events.size() == 1);
+  TEST_CHECK(log.events[0].mouse_pos_x == 3.0f && log.events[0].mouse_pos_y == 3.0f);
+
+  // Anything in between, or another dispatcher, keeps every move in order
+  log.calls.clear();
+  log.events.clear();
+
+  nikola::event_post(make_mouse_event(1.0f, 1.0f), &dispatcher_a);
+  nikola::event_post(key_event, &dispatcher_a);
+  nikola::event_post(make_mouse_event(2.0f, 2.0f), &dispatcher_a);
+  nikola::event_post(make_mouse_event(3.0f, 3.0f), &dispatcher_b);
+  nikola::event_process_queue();
+
+  TEST_CHECK((log.calls == nikola::DynamicArray<nikola::i32>{1, 2, 1, 1}));
+  TEST_CHECK(log.events[0].mouse_pos_x == 1.0f);
+  TEST_CHECK(log.events[2].mouse_pos_x == 2.0f);
+  TEST_CHECK(log.events[3].mouse_pos_x == 3.0f);
+
+  // Key events are never merged
+  log.calls.clear();
+  log.events.clear();
+
+  nikola::event_post(key_event, &dispatcher_a);
+  nikola::event_post(key_event, &dispatcher_a);
+  nikola::event_process_queue();
+
+  TEST_CHECK(log.calls.size() == 2);
+
+  nikola::event_unlisten(mouse_id);
+  nikola::event_unlisten(key_id);
+
+  return true;
+}
+
+/// Tests
+/// ----------------------------------------------------------------------
+
+} // End of tests
+
+//////////////////////////////////////////////////////////////////////////
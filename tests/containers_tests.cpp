@@ -0,0 +1,173 @@
+#include "tests.h"
+
+#include <nikola/nikola.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace tests { // Start of tests
+
+/// ----------------------------------------------------------------------
+/// CollidingHash
+
+/// Sends every key into one of only 4 slots, so every probe chain
+/// ends up long and wrapped around the table.
+struct CollidingHash {
+  nikola::sizei operator()(const nikola::u64 key) const {
+    return (nikola::sizei)(key & 3);
+  }
+};
+/// CollidingHash
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+template<typename Map>
+static bool has_exact_keys(const Map& map, const nikola::DynamicArray<bool>& expected) {
+  nikola::DynamicArray<bool> seen(expected.size(), false);
+  nikola::sizei seen_count = 0;
+
+  for(const auto& entry : map) {
+    nikola::sizei key = (nikola::sizei)entry.first;
+    if(key >= expected.size() || !expected[key] || seen[key]) {
+      return false;
+    }
+
+    seen[key] = true;
+    seen_count++;
+  }
+
+  return seen_count == map.size();
+}
+
+template<typename Map>
+static bool insert_erase_reinsert(Map& map) {
+  nikola::DynamicArray<bool> expected(HASH_MAP_KEYS_COUNT, false);
+
+  // Insert, growing through a few rehashes
+  nikola::sizei last_capacity = map.capacity;
+  nikola::sizei rehashes      = 0;
+
+  for(nikola::u64 i = 0; i < HASH_MAP_KEYS_COUNT; i++) {
+    auto [it, inserted] = map.emplace(i, i * 10);
+    TEST_CHECK(inserted && it->first == i && it->second == (i * 10));
+
+    expected[i] = true;
+
+    if(map.capacity != last_capacity) {
+      last_capacity = map.capacity;
+      rehashes++;
+    }
+  }
+
+  TEST_CHECK(rehashes > 1);
+  TEST_CHECK(map.size() == HASH_MAP_KEYS_COUNT);
+  TEST_CHECK((map.size() * 8) <= (map.capacity * 7));
+  TEST_CHECK(has_exact_keys(map, expected));
+
+  // An existing key is never overwritten
+  auto [existing, inserted] = map.emplace((nikola::u64)7, (nikola::u64)0);
+  TEST_CHECK(!inserted && existing->first == 7 && existing->second == 70);
+  TEST_CHECK(map.size() == HASH_MAP_KEYS_COUNT);
+
+  // Erase every even key, then make sure the odd ones can all still be found
+  for(nikola::u64 i = 0; i < HASH_MAP_KEYS_COUNT; i += 2) {
+    TEST_CHECK(map.erase(i) == 1);
+    TEST_CHECK(map.erase(i) == 0);
+
+    expected[i] = false;
+  }
+
+  TEST_CHECK(map.size() == (HASH_MAP_KEYS_COUNT / 2));
+  TEST_CHECK(has_exact_keys(map, expected));
+
+  for(nikola::u64 i = 0; i < HASH_MAP_KEYS_COUNT; i++) {
+    auto it = map.find(i);
+
+    if((i % 2) == 0) {
+      TEST_CHECK(it == map.end() && !map.contains(i));
+    }
+    else {
+      TEST_CHECK(it != map.end() && it->second == (i * 10));
+    }
+  }
+
+  // Re-insert the erased keys, which have to take their new values this time
+  for(nikola::u64 i = 0; i < HASH_MAP_KEYS_COUNT; i += 2) {
+    TEST_CHECK(map.emplace(i, i * 100).second);
+    expected[i] = true;
+  }
+
+  TEST_CHECK(map.size() == HASH_MAP_KEYS_COUNT);
+  TEST_CHECK(has_exact_keys(map, expected));
+
+  for(nikola::u64 i = 0; i < HASH_MAP_KEYS_COUNT; i++) {
+    TEST_CHECK(map[i] == (((i % 2) == 0) ? (i * 100) : (i * 10)));
+  }
+
+  return true;
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Tests
+
+bool test_hash_map() {
+  nikola::HashMap<nikola::u64, nikola::u64> map;
+  TEST_CHECK(insert_erase_reinsert(map));
+
+  // Clearing keeps the slots around
+  nikola::sizei capacity = map.capacity;
+  map.clear();
+
+  TEST_CHECK(map.empty() && map.capacity == capacity);
+  TEST_CHECK(map.begin() == map.end());
+
+  // Copies are deep
+  map[1] = 2;
+
+  nikola::HashMap<nikola::u64, nikola::u64> copy = map;
+  copy[1] = 3;
+
+  TEST_CHECK(map[1] == 2 && copy[1] == 3);
+  return true;
+}
+
+bool test_hash_map_collisions() {
+  nikola::HashMap<nikola::u64, nikola::u64, CollidingHash> map;
+  TEST_CHECK(insert_erase_reinsert(map));
+
+  // Non-trivial entries have to survive being shifted back on every erase
+  nikola::HashMap<nikola::String, nikola::String> strings;
+  for(nikola::sizei i = 0; i < HASH_MAP_KEYS_COUNT; i++) {
+    nikola::String key = "key_" + std::to_string(i);
+    strings.emplace(key, key + "_value");
+  }
+
+  for(nikola::sizei i = 0; i < HASH_MAP_KEYS_COUNT; i += 3) {
+    TEST_CHECK(strings.erase("key_" + std::to_string(i)) == 1);
+  }
+
+  for(nikola::sizei i = 0; i < HASH_MAP_KEYS_COUNT; i++) {
+    nikola::String key = "key_" + std::to_string(i);
+    auto it            = strings.find(key);
+
+    if((i % 3) == 0) {
+      TEST_CHECK(it == strings.end());
+    }
+    else {
+      TEST_CHECK(it != strings.end() && it->second == (key + "_value"));
+    }
+  }
+
+  return true;
+}
+
+/// Tests
+/// ----------------------------------------------------------------------
+
+} // End of tests
+
+//////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,123 @@
+#include "tests.h"
+
+#include <nikola/nikola.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace tests { // Start of tests
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static void render_frame(nikola::FrameData& frame_data, const nikola::ResourceID& mesh_id) {
+  nikola::renderer_begin(frame_data);
+
+  for(nikola::sizei i = 0; i < 4; i++) {
+    nikola::Transform transform;
+    nikola::transform_translate(transform, nikola::Vec3((nikola::f32)i * 2.0f, 0.0f, 0.0f));
+
+    nikola::renderer_queue_mesh(mesh_id, transform);
+  }
+
+  nikola::renderer_end();
+}
+
+static bool read_dump(const nikola::FilePath& path, nikola::String* out) {
+  nikola::File file;
+  if(!nikola::file_open(&file, path, (nikola::i32)nikola::FILE_OPEN_READ)) {
+    return false;
+  }
+
+  out->resize(nikola::filesystem_get_size(path));
+  nikola::file_read_bytes(file, out->data(), out->size());
+  nikola::file_close(file);
+
+  return true;
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Tests
+
+bool test_command_log_replay() {
+  nikola::resource_manager_init();
+  nikola::renderer_init_headless(FRAME_WIDTH, FRAME_HEIGHT);
+
+  nikola::FilePath res_dir      = nikola::filepath_append(nikola::filesystem_current_path(), "gfx_res");
+  nikola::ResourceGroupID group = nikola::resources_create_group("gfx", res_dir);
+  nikola::ResourceID mesh_id    = nikola::resources_push_mesh(group, nikola::GEOMETRY_CUBE);
+
+  nikola::FrameData frame_data = {};
+  nikola::CameraDesc cam_desc  = {
+    .position     = nikola::Vec3(0.0f, 0.0f, 10.0f),
+    .target       = nikola::Vec3(0.0f, 0.0f, -1.0f),
+    .up_axis      = nikola::Vec3(0.0f, 1.0f, 0.0f),
+    .aspect_ratio = (nikola::f32)FRAME_WIDTH / (nikola::f32)FRAME_HEIGHT,
+    .move_func    = nullptr,
+  };
+  nikola::camera_create(&frame_data.camera, cam_desc);
+  nikola::camera_update(frame_data.camera);
+
+  // Anything created lazily gets created before the recording
+  render_frame(frame_data, mesh_id);
+
+  // Record a few frames
+  nikola::GfxContext* gfx        = nikola::renderer_get_context();
+  nikola::GfxCommandLog* log     = nikola::gfx_command_log_create();
+  nikola::gfx_context_set_command_log(gfx, log);
+
+  for(nikola::sizei i = 0; i < RECORDED_FRAMES_COUNT; i++) {
+    render_frame(frame_data, mesh_id);
+  }
+  nikola::gfx_context_set_command_log(gfx, nullptr);
+
+  nikola::GfxCommandStats stats = nikola::gfx_command_log_get_stats(log);
+  TEST_CHECK(stats.draw_calls > 0);
+  TEST_CHECK(stats.state_changes > 0);
+  TEST_CHECK(stats.bytes_uploaded > 0);
+  TEST_CHECK(stats.resources_created == 0);
+
+  // Replay them into another log, which has to end up with the exact same commands
+  nikola::GfxCommandLog* replayed = nikola::gfx_command_log_create();
+  nikola::gfx_context_set_command_log(gfx, replayed);
+  nikola::gfx_command_log_replay(log, gfx);
+  nikola::gfx_context_set_command_log(gfx, nullptr);
+
+  const nikola::GfxCommandStats& replayed_stats = nikola::gfx_command_log_get_stats(replayed);
+  TEST_CHECK(replayed_stats.commands_count == stats.commands_count);
+  TEST_CHECK(replayed_stats.draw_calls == stats.draw_calls);
+  TEST_CHECK(replayed_stats.state_changes == stats.state_changes);
+  TEST_CHECK(replayed_stats.bytes_uploaded == stats.bytes_uploaded);
+
+  for(nikola::sizei i = 0; i < nikola::GFX_COMMANDS_MAX; i++) {
+    TEST_CHECK(replayed_stats.counts[i] == stats.counts[i]);
+  }
+
+  nikola::FilePath log_path      = nikola::filepath_append(res_dir, "recorded.txt");
+  nikola::FilePath replayed_path = nikola::filepath_append(res_dir, "replayed.txt");
+  TEST_CHECK(nikola::gfx_command_log_dump(log, log_path.c_str()));
+  TEST_CHECK(nikola::gfx_command_log_dump(replayed, replayed_path.c_str()));
+
+  nikola::String log_dump, replayed_dump;
+  TEST_CHECK(read_dump(log_path, &log_dump));
+  TEST_CHECK(read_dump(replayed_path, &replayed_dump));
+  TEST_CHECK(!log_dump.empty() && log_dump == replayed_dump);
+
+  nikola::gfx_command_log_destroy(replayed);
+  nikola::gfx_command_log_destroy(log);
+
+  nikola::resources_destroy_group(group);
+  nikola::resource_manager_shutdown();
+  nikola::renderer_shutdown();
+
+  return true;
+}
+
+/// Tests
+/// ----------------------------------------------------------------------
+
+} // End of tests
+
+//////////////////////////////////////////////////////////////////////////
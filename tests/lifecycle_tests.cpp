@@ -0,0 +1,101 @@
+#include "tests.h"
+
+#include <nikola/nikola.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace tests { // Start of tests
+
+/// ----------------------------------------------------------------------
+/// Tests
+
+bool test_engine_lifecycle() {
+  nikola::resource_manager_init();
+  nikola::renderer_init_headless(FRAME_WIDTH, FRAME_HEIGHT);
+  nikola::batch_renderer_init();
+
+  // Load
+  nikola::FilePath res_dir       = nikola::filepath_append(nikola::filesystem_current_path(), "lifecycle_res");
+  nikola::ResourceGroupID group  = nikola::resources_create_group("lifecycle", res_dir);
+  nikola::ResourceID mesh_id     = nikola::resources_push_mesh(group, nikola::GEOMETRY_CUBE);
+
+  TEST_CHECK(nikola::resources_get_mesh(mesh_id));
+
+  // Draw a single frame
+  nikola::FrameData frame_data = {};
+  nikola::CameraDesc cam_desc  = {
+    .position     = nikola::Vec3(0.0f, 0.0f, 10.0f),
+    .target       = nikola::Vec3(0.0f, 0.0f, -1.0f),
+    .up_axis      = nikola::Vec3(0.0f, 1.0f, 0.0f),
+    .aspect_ratio = (nikola::f32)FRAME_WIDTH / (nikola::f32)FRAME_HEIGHT,
+    .move_func    = nullptr,
+  };
+  nikola::camera_create(&frame_data.camera, cam_desc);
+  nikola::camera_update(frame_data.camera);
+
+  nikola::Transform transform;
+  nikola::transform_translate(transform, nikola::Vec3(0.0f));
+
+  nikola::renderer_begin(frame_data);
+  nikola::renderer_queue_mesh(mesh_id, transform);
+  nikola::renderer_end();
+
+  TEST_CHECK(nikola::renderer_get_stats().meshes_queued == 1);
+
+  // Shutdown, resources first since they still need the graphics context
+  nikola::resources_destroy_group(group);
+
+  nikola::batch_renderer_shutdown();
+  nikola::resource_manager_shutdown();
+  nikola::renderer_shutdown();
+
+  // The graphics pools die with the context, so nothing of the GPU side can be left behind
+  TEST_CHECK(nikola::memory_get_tag_stats(nikola::MEMORY_TAG_GFX).live_blocks == 0);
+  return true;
+}
+
+bool test_geometry_pool_reuse() {
+  nikola::resource_manager_init();
+  nikola::renderer_init_headless(FRAME_WIDTH, FRAME_HEIGHT);
+
+  nikola::FilePath res_dir = nikola::filepath_append(nikola::filesystem_current_path(), "lifecycle_res");
+  nikola::sizei pools_used = 0;
+
+  // The renderer already shares some of its own meshes
+  nikola::sizei renderer_used = nikola::renderer_get_stats().geometry_pools_used;
+
+  for(nikola::sizei i = 0; i < GROUP_RELOADS_COUNT; i++) {
+    nikola::ResourceGroupID group = nikola::resources_create_group("pool_reuse", res_dir);
+    nikola::Mesh* first           = nikola::resources_get_mesh(nikola::resources_push_mesh(group, nikola::GEOMETRY_CUBE));
+    nikola::Mesh* second          = nikola::resources_get_mesh(nikola::resources_push_mesh(group, nikola::GEOMETRY_CUBE));
+
+    // Every load has to make it into a pool, and take up the same space as the one before it
+    TEST_CHECK(first->geometry_pool != -1);
+    TEST_CHECK(second->geometry_pool == first->geometry_pool);
+    TEST_CHECK(second->base_vertex != first->base_vertex);
+    TEST_CHECK(second->first_index != first->first_index);
+    
+    nikola::sizei used = nikola::renderer_get_stats().geometry_pools_used;
+    TEST_CHECK(used > renderer_used);
+    TEST_CHECK(i == 0 || used == pools_used);
+    pools_used = used;
+
+    // A partial update changes the size of the buffer's desc, which must not change what gets given back
+    nikola::f32 vertex[3] = {0.0f, 0.0f, 0.0f};
+    nikola::gfx_buffer_update(first->vertex_buffer, 0, sizeof(vertex), vertex);
+
+    nikola::resources_destroy_group(group);
+    TEST_CHECK(nikola::renderer_get_stats().geometry_pools_used == renderer_used);
+  }
+
+  nikola::resource_manager_shutdown();
+  nikola::renderer_shutdown();
+  return true;
+}
+
+/// Tests
+/// ----------------------------------------------------------------------
+
+} // End of tests
+
+//////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,82 @@
+#include "tests.h"
+
+#include <nikola/nikola.h>
+
+#include <cstring>
+
+/// ----------------------------------------------------------------------
+/// TestEntry
+struct TestEntry {
+  const char* name;
+  bool (*func)();
+};
+/// TestEntry
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+static const TestEntry TESTS[] = {
+  {"engine_lifecycle", tests::test_engine_lifecycle},
+  {"geometry_pool_reuse", tests::test_geometry_pool_reuse},
+  {"command_log_replay", tests::test_command_log_replay},
+  {"transform_update_batch", tests::test_transform_update_batch},
+  {"frustum_cull_aabbs", tests::test_frustum_cull_aabbs},
+  {"aabb_transform", tests::test_aabb_transform},
+  {"cull_queue", tests::test_cull_queue},
+  {"radix_sort", tests::test_radix_sort},
+  {"sort_key_order", tests::test_sort_key_order},
+  {"hash_map", tests::test_hash_map},
+  {"hash_map_collisions", tests::test_hash_map_collisions},
+  {"job_system", tests::test_job_system},
+  {"event_unlisten", tests::test_event_unlisten},
+  {"event_queue_coalescing", tests::test_event_queue_coalescing},
+  {"shader_context_invalidate", tests::test_shader_context_invalidate},
+};
+
+const nikola::sizei TESTS_COUNT = sizeof(TESTS) / sizeof(TESTS[0]);
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// Usage: nikola_tests [<test name>]
+///
+/// Runs only the test called `test name`, or all of them if none is given.
+/// Exits with `1` if any of the tests failed.
+int main(int argc, char** argv) {
+  const char* test_name = argc > 1 ? argv[1] : nullptr;
+
+  // Initialze the library
+  if(!nikola::init()) {
+    return -1;
+  }
+
+  nikola::sizei ran_count    = 0;
+  nikola::sizei failed_count = 0;
+
+  for(nikola::sizei i = 0; i < TESTS_COUNT; i++) {
+    if(test_name && std::strcmp(test_name, TESTS[i].name) != 0) {
+      continue;
+    }
+
+    bool passed = TESTS[i].func();
+    if(passed) {
+      NIKOLA_LOG_INFO("[PASSED] %s", TESTS[i].name);
+    }
+    else {
+      NIKOLA_LOG_ERROR("[FAILED] %s", TESTS[i].name);
+      failed_count++;
+    }
+
+    ran_count++;
+  }
+
+  if(ran_count == 0) {
+    NIKOLA_LOG_ERROR("No test is called \'%s\'", test_name);
+    failed_count++;
+  }
+
+  // De-initialze the library
+  nikola::shutdown();
+  return failed_count == 0 ? 0 : 1;
+}
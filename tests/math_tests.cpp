@@ -0,0 +1,210 @@
+#include "tests.h"
+
+#include <nikola/nikola.h>
+
+#include <cfloat>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace tests { // Start of tests
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static bool mat4_near(const nikola::Mat4& a, const nikola::Mat4& b) {
+  for(nikola::i32 col = 0; col < 4; col++) {
+    for(nikola::i32 row = 0; row < 4; row++) {
+      if(nikola::abs(a[col][row] - b[col][row]) > MATH_EPSILON) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+static bool mat4_equal(const nikola::Mat4& a, const nikola::Mat4& b) {
+  for(nikola::i32 col = 0; col < 4; col++) {
+    for(nikola::i32 row = 0; row < 4; row++) {
+      if(a[col][row] != b[col][row]) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+static nikola::Vec3 random_vec3(const nikola::f32 min, const nikola::f32 max) {
+  return nikola::Vec3(nikola::random_f32(min, max),
+                      nikola::random_f32(min, max),
+                      nikola::random_f32(min, max));
+}
+
+static nikola::Quat random_rotation() {
+  nikola::Vec3 axis = random_vec3(-1.0f, 1.0f);
+  if(nikola::vec3_dot(axis, axis) < 0.0001f) {
+    axis = nikola::Vec3(0.0f, 1.0f, 0.0f);
+  }
+
+  return nikola::quat_angle_axis(nikola::vec3_normalize(axis), nikola::random_f32(-3.14f, 3.14f));
+}
+
+static bool aabb_near(const nikola::AABB& a, const nikola::AABB& b) {
+  for(nikola::i32 i = 0; i < 3; i++) {
+    if(nikola::abs(a.min[i] - b.min[i]) > MATH_EPSILON || nikola::abs(a.max[i] - b.max[i]) > MATH_EPSILON) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static nikola::AABB make_aabb(const nikola::Vec3& center, const nikola::f32 half_size) {
+  return nikola::AABB {
+    .min = center - nikola::Vec3(half_size),
+    .max = center + nikola::Vec3(half_size),
+  };
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Tests
+
+bool test_transform_update_batch() {
+  // Every count below, above, and around a multiple of the batch width
+  const nikola::sizei counts[] = {1, 2, 3, 4, 5, 7, 8, 9, 13, 64, 67};
+
+  // Any matrix a clean transform could never be rebuilt into
+  const nikola::Mat4 sentinel = nikola::Mat4(7.0f);
+
+  for(const nikola::sizei count : counts) {
+    nikola::DynamicArray<nikola::Transform> transforms(count);
+
+    for(nikola::sizei i = 0; i < count; i++) {
+      nikola::Transform& trans = transforms[i];
+
+      // Every third transform stays clean, so the dirty ones end up in uneven batches
+      if((i % 3) == 1) {
+        trans.position  = random_vec3(-100.0f, 100.0f);
+        trans.scale     = random_vec3(0.1f, 10.0f);
+        trans.rotation  = random_rotation();
+        trans.transform = sentinel;
+        continue;
+      }
+
+      nikola::transform_set_position(trans, random_vec3(-100.0f, 100.0f));
+      nikola::transform_set_scale(trans, random_vec3(0.1f, 10.0f));
+      nikola::transform_set_rotation(trans, random_rotation());
+      TEST_CHECK(trans.is_dirty);
+    }
+
+    nikola::transform_update_batch(transforms.data(), count);
+
+    for(nikola::sizei i = 0; i < count; i++) {
+      const nikola::Transform& trans = transforms[i];
+      TEST_CHECK(!trans.is_dirty);
+
+      if((i % 3) == 1) {
+        TEST_CHECK(mat4_equal(trans.transform, sentinel));
+        continue;
+      }
+
+      nikola::Mat4 expected = nikola::mat4_translate(trans.position) *
+                              nikola::quat_to_mat4(trans.rotation) *
+                              nikola::mat4_scale(trans.scale);
+      TEST_CHECK(mat4_near(trans.transform, expected));
+    }
+  }
+
+  return true;
+}
+
+bool test_frustum_cull_aabbs() {
+  // A frustum of the `[-10, 10]` box on every axis
+  nikola::Frustum frustum = nikola::frustum_from_matrix(nikola::mat4_scale(nikola::Vec3(0.1f)));
+
+  // One box inside, one outside of each plane, and one straddling the right plane
+  const nikola::AABB boxes[] = {
+    make_aabb(nikola::Vec3(0.0f), 1.0f),
+    make_aabb(nikola::Vec3(-20.0f, 0.0f, 0.0f), 1.0f),
+    make_aabb(nikola::Vec3(20.0f, 0.0f, 0.0f), 1.0f),
+    make_aabb(nikola::Vec3(0.0f, -20.0f, 0.0f), 1.0f),
+    make_aabb(nikola::Vec3(0.0f, 20.0f, 0.0f), 1.0f),
+    make_aabb(nikola::Vec3(0.0f, 0.0f, -20.0f), 1.0f),
+    make_aabb(nikola::Vec3(0.0f, 0.0f, 20.0f), 1.0f),
+    make_aabb(nikola::Vec3(10.0f, 0.0f, 0.0f), 1.0f),
+  };
+  const nikola::u8 expected[] = {1, 0, 0, 0, 0, 0, 0, 1};
+  const nikola::sizei boxes_count = sizeof(boxes) / sizeof(boxes[0]);
+
+  for(nikola::sizei i = 0; i < boxes_count; i++) {
+    TEST_CHECK(nikola::frustum_intersects_aabb(frustum, boxes[i]) == (expected[i] == 1));
+  }
+
+  // Every count that takes the SIMD path, the leftovers path, or both, 
+  // starting at every box so each one ends up in every lane
+  for(nikola::sizei count = 1; count < boxes_count; count++) {
+    for(nikola::sizei first = 0; first < boxes_count; first++) {
+      nikola::AABB aabbs[boxes_count];
+      nikola::u8 visible[boxes_count];
+      nikola::sizei expected_count = 0;
+
+      for(nikola::sizei i = 0; i < count; i++) {
+        aabbs[i]        = boxes[(first + i) % boxes_count];
+        visible[i]      = 0xff;
+        expected_count += expected[(first + i) % boxes_count];
+      }
+
+      TEST_CHECK(nikola::frustum_cull_aabbs(frustum, aabbs, count, visible) == expected_count);
+
+      for(nikola::sizei i = 0; i < count; i++) {
+        TEST_CHECK(visible[i] == expected[(first + i) % boxes_count]);
+      }
+    }
+  }
+
+  return true;
+}
+
+bool test_aabb_transform() {
+  for(nikola::sizei i = 0; i < AABB_TRANSFORMS_COUNT; i++) {
+    nikola::AABB aabb = {
+      .min = random_vec3(-10.0f, 0.0f),
+      .max = random_vec3(0.0f, 10.0f),
+    };
+
+    nikola::Mat4 matrix = nikola::mat4_translate(random_vec3(-100.0f, 100.0f)) *
+                          nikola::quat_to_mat4(random_rotation()) *
+                          nikola::mat4_scale(random_vec3(0.1f, 10.0f));
+
+    // The tightest box around every transformed corner
+    nikola::AABB expected = {
+      .min = nikola::Vec3(FLT_MAX),
+      .max = nikola::Vec3(-FLT_MAX),
+    };
+
+    for(nikola::i32 corner = 0; corner < 8; corner++) {
+      nikola::Vec3 point((corner & 1) ? aabb.max.x : aabb.min.x,
+                         (corner & 2) ? aabb.max.y : aabb.min.y,
+                         (corner & 4) ? aabb.max.z : aabb.min.z);
+      nikola::Vec3 transformed = nikola::Vec3(matrix * nikola::Vec4(point, 1.0f));
+
+      expected.min = nikola::vec3_min(expected.min, transformed);
+      expected.max = nikola::vec3_max(expected.max, transformed);
+    }
+
+    TEST_CHECK(aabb_near(nikola::aabb_transform(aabb, matrix), expected));
+  }
+
+  return true;
+}
+
+/// Tests
+/// ----------------------------------------------------------------------
+
+} // End of tests
+
+//////////////////////////////////////////////////////////////////////////
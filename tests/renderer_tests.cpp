@@ -0,0 +1,191 @@
+#include "tests.h"
+
+#include <nikola/nikola.h>
+
+#include <renderer/render_sort.h>
+
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace tests { // Start of tests
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static void create_camera(nikola::FrameData& frame_data) {
+  nikola::CameraDesc cam_desc = {
+    .position     = nikola::Vec3(0.0f, 0.0f, 10.0f),
+    .target       = nikola::Vec3(0.0f, 0.0f, -1.0f),
+    .up_axis      = nikola::Vec3(0.0f, 1.0f, 0.0f),
+    .aspect_ratio = (nikola::f32)FRAME_WIDTH / (nikola::f32)FRAME_HEIGHT,
+    .move_func    = nullptr,
+  };
+
+  nikola::camera_create(&frame_data.camera, cam_desc);
+  nikola::camera_update(frame_data.camera);
+}
+
+static nikola::Transform make_transform(const nikola::Vec3& position) {
+  nikola::Transform transform;
+  nikola::transform_translate(transform, position);
+
+  return transform;
+}
+
+static bool sorts_like_stable_sort(nikola::DynamicArray<nikola::SortEntry>& entries, nikola::DynamicArray<nikola::SortEntry>& scratch) {
+  nikola::DynamicArray<nikola::SortEntry> expected = entries;
+  std::stable_sort(expected.begin(), expected.end(), [](const nikola::SortEntry& a, const nikola::SortEntry& b) {
+    return a.key < b.key;
+  });
+
+  nikola::render_radix_sort(entries, scratch);
+
+  // Equal keys have to stay in the order they came in, which the indices give away
+  for(nikola::sizei i = 0; i < entries.size(); i++) {
+    if(entries[i].key != expected[i].key || entries[i].index != expected[i].index) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Tests
+
+bool test_cull_queue() {
+  nikola::resource_manager_init();
+  nikola::renderer_init_headless(FRAME_WIDTH, FRAME_HEIGHT);
+
+  nikola::FilePath res_dir      = nikola::filepath_append(nikola::filesystem_current_path(), "renderer_res");
+  nikola::ResourceGroupID group = nikola::resources_create_group("renderer", res_dir);
+  nikola::ResourceID mesh_id    = nikola::resources_push_mesh(group, nikola::GEOMETRY_CUBE);
+
+  nikola::FrameData frame_data = {};
+  create_camera(frame_data);
+
+  // Way behind the camera
+  const nikola::Vec3 outside = nikola::Vec3(0.0f, 0.0f, 1000.0f);
+
+  // Anything created lazily gets created before the recording
+  nikola::renderer_begin(frame_data);
+  nikola::renderer_end();
+
+  nikola::GfxContext* gfx    = nikola::renderer_get_context();
+  nikola::GfxCommandLog* log = nikola::gfx_command_log_create();
+  nikola::gfx_context_set_command_log(gfx, log);
+
+  // Only the scene mesh outside of the frustum is taken out
+  nikola::renderer_begin(frame_data);
+  nikola::renderer_queue_mesh(mesh_id, make_transform(nikola::Vec3(0.0f)));
+  nikola::renderer_queue_mesh(mesh_id, make_transform(outside));
+  nikola::renderer_end();
+
+  TEST_CHECK(nikola::renderer_get_stats().meshes_queued == 2);
+  TEST_CHECK(nikola::renderer_get_stats().meshes_culled == 1);
+
+  nikola::sizei scene_draws = nikola::gfx_command_log_get_stats(log).draw_calls;
+  nikola::gfx_command_log_clear(log);
+
+  // The same frame, along with a debug cube outside of the frustum, which is never culled (nor counted)
+  nikola::renderer_begin(frame_data);
+  nikola::renderer_queue_mesh(mesh_id, make_transform(nikola::Vec3(0.0f)));
+  nikola::renderer_queue_mesh(mesh_id, make_transform(outside));
+  nikola::renderer_debug_cube(make_transform(outside), nikola::Vec4(1.0f));
+  nikola::renderer_end();
+
+  TEST_CHECK(nikola::renderer_get_stats().meshes_queued == 2);
+  TEST_CHECK(nikola::renderer_get_stats().meshes_culled == 1);
+  TEST_CHECK(nikola::gfx_command_log_get_stats(log).draw_calls > scene_draws);
+
+  nikola::gfx_context_set_command_log(gfx, nullptr);
+  nikola::gfx_command_log_destroy(log);
+
+  nikola::resources_destroy_group(group);
+  nikola::resource_manager_shutdown();
+  nikola::renderer_shutdown();
+
+  return true;
+}
+
+bool test_radix_sort() {
+  const nikola::sizei counts[] = {0, 1, 2, 3, 255, 256, 257, 4096};
+
+  nikola::DynamicArray<nikola::SortEntry> entries;
+  nikola::DynamicArray<nikola::SortEntry> scratch;
+
+  for(const nikola::sizei count : counts) {
+    // Fully random keys, keys with plenty of duplicates, keys that only differ in a 
+    // single digit (so every other pass gets skipped), and keys that are all the same
+    for(nikola::i32 kind = 0; kind < 4; kind++) {
+      entries.resize(count);
+
+      for(nikola::sizei i = 0; i < count; i++) {
+        nikola::u64 key = 0;
+        switch(kind) {
+          case 0:
+            key = nikola::random_u64();
+            break;
+          case 1:
+            key = nikola::random_u64(0, 15) << 40;
+            break;
+          case 2:
+            key = 0xab00ab00ab00ab00ull | (nikola::random_u64(0, 255) << 16);
+            break;
+          case 3:
+            key = 0x1234567812345678ull;
+            break;
+        }
+
+        entries[i] = nikola::SortEntry {
+          .key   = key,
+          .index = (nikola::u32)i,
+        };
+      }
+
+      TEST_CHECK(sorts_like_stable_sort(entries, scratch));
+    }
+  }
+
+  return true;
+}
+
+bool test_sort_key_order() {
+  const nikola::CommandPass scene = nikola::COMMAND_PASS_SCENE;
+  const nikola::CommandPass debug = nikola::COMMAND_PASS_DEBUG;
+
+  // Opaque meshes sharing the same state go front-to-back
+  TEST_CHECK(nikola::render_sort_key(scene, false, 0.2f, 1, 1, 1) < nikola::render_sort_key(scene, false, 0.8f, 1, 1, 1));
+
+  // ...but the state comes before the depth
+  TEST_CHECK(nikola::render_sort_key(scene, false, 1.0f, 0, 1, 1) < nikola::render_sort_key(scene, false, 0.0f, 1, 0, 0));
+  TEST_CHECK(nikola::render_sort_key(scene, false, 1.0f, 1, 0, 1) < nikola::render_sort_key(scene, false, 0.0f, 1, 1, 0));
+  TEST_CHECK(nikola::render_sort_key(scene, false, 1.0f, 1, 1, 0) < nikola::render_sort_key(scene, false, 0.0f, 1, 1, 1));
+
+  // Translucent meshes go back-to-front, whatever their state is
+  TEST_CHECK(nikola::render_sort_key(scene, true, 0.8f, 1, 1, 1) < nikola::render_sort_key(scene, true, 0.2f, 1, 1, 1));
+  TEST_CHECK(nikola::render_sort_key(scene, true, 0.8f, 9, 9, 9) < nikola::render_sort_key(scene, true, 0.2f, 0, 0, 0));
+
+  // Translucent meshes come after every opaque mesh
+  TEST_CHECK(nikola::render_sort_key(scene, false, 1.0f, 255, 65535, 65535) < nikola::render_sort_key(scene, true, 1.0f, 0, 0, 0));
+
+  // The debug pass comes after everything in the scene
+  TEST_CHECK(nikola::render_sort_key(scene, true, 0.0f, 255, 65535, 65535) < nikola::render_sort_key(debug, false, 0.0f, 0, 0, 0));
+
+  // Anything outside of the near and far planes is clamped to them
+  TEST_CHECK(nikola::render_sort_key(scene, false, -1.0f, 1, 1, 1) == nikola::render_sort_key(scene, false, 0.0f, 1, 1, 1));
+  TEST_CHECK(nikola::render_sort_key(scene, false, 2.0f, 1, 1, 1) == nikola::render_sort_key(scene, false, 1.0f, 1, 1, 1));
+
+  return true;
+}
+
+/// Tests
+/// ----------------------------------------------------------------------
+
+} // End of tests
+
+//////////////////////////////////////////////////////////////////////////
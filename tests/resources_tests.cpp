@@ -0,0 +1,62 @@
+#include "tests.h"
+
+#include <nikola/nikola.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace tests { // Start of tests
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+constexpr nikola::StringID UNIFORM_TINT = nikola::string_id_literal("u_tint");
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Tests
+
+bool test_shader_context_invalidate() {
+  nikola::resource_manager_init();
+  nikola::renderer_init_headless(FRAME_WIDTH, FRAME_HEIGHT);
+
+  nikola::FilePath res_dir      = nikola::filepath_append(nikola::filesystem_current_path(), "resources_res");
+  nikola::ResourceGroupID group = nikola::resources_create_group("resources", res_dir);
+
+  nikola::GfxShaderDesc shader_desc = {
+    .vertex_source = "#version 460 core\nvoid main() {gl_Position = vec4(0.0);}",
+    .pixel_source  = "#version 460 core\nuniform vec4 u_tint;\nout vec4 frag_color;\nvoid main() {frag_color = u_tint;}",
+  };
+  nikola::ResourceID shader_id = nikola::resources_push_shader(group, shader_desc);
+  nikola::ResourceID ctx_id    = nikola::resources_push_shader_context(group, shader_id);
+
+  nikola::ShaderContext* ctx = nikola::resources_get_shader_context(ctx_id);
+  TEST_CHECK(ctx->generation == 0);
+
+  nikola::UniformHandle handle = nikola::shader_context_resolve_uniform(ctx, UNIFORM_TINT);
+  TEST_CHECK(handle != nikola::UNIFORM_HANDLE_INVALID);
+  TEST_CHECK(ctx->uniforms_cache.contains(UNIFORM_TINT));
+
+  // Every cached uniform is gone, and anyone holding a handle can tell
+  nikola::shader_context_invalidate_uniforms(ctx);
+  TEST_CHECK(ctx->uniforms_cache.empty());
+  TEST_CHECK(ctx->generation == 1);
+
+  // Setting the uniform by its name looks it up all over again
+  nikola::shader_context_set_uniform(ctx, UNIFORM_TINT, nikola::Vec4(1.0f));
+  TEST_CHECK(ctx->uniforms_cache.contains(UNIFORM_TINT));
+
+  nikola::resources_destroy_group(group);
+  nikola::resource_manager_shutdown();
+  nikola::renderer_shutdown();
+
+  return true;
+}
+
+/// Tests
+/// ----------------------------------------------------------------------
+
+} // End of tests
+
+//////////////////////////////////////////////////////////////////////////
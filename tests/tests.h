@@ -0,0 +1,124 @@
+#pragma once
+
+#include <nikola/nikola.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace tests { // Start of tests
+
+/// ----------------------------------------------------------------------
+/// *** Tests ***
+
+/// ----------------------------------------------------------------------
+/// Macros
+
+/// Fail the current test (returning `false` from it) if `expr` does not hold.
+#define TEST_CHECK(expr)                                                      \
+  if(!(expr)) {                                                               \
+    NIKOLA_LOG_ERROR("%s:%i: Check failed: %s", __FILE__, __LINE__, #expr);   \
+    return false;                                                             \
+  }
+
+/// Macros
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The size of the headless frame every test initializes the renderer with.
+const nikola::i32 FRAME_WIDTH  = 1280;
+const nikola::i32 FRAME_HEIGHT = 720;
+
+/// How many times a resource group gets loaded and unloaded by `test_geometry_pool_reuse`.
+const nikola::sizei GROUP_RELOADS_COUNT = 64;
+
+/// How many frames get recorded (and replayed) by `test_command_log_replay`.
+const nikola::sizei RECORDED_FRAMES_COUNT = 3;
+
+/// How far apart two matrix entries can be while still counting as the same.
+const nikola::f32 MATH_EPSILON = 0.001f;
+
+/// How many random boxes get transformed by `test_aabb_transform`.
+const nikola::sizei AABB_TRANSFORMS_COUNT = 256;
+
+/// How many keys get inserted, erased, and re-inserted by the `HashMap` tests.
+const nikola::sizei HASH_MAP_KEYS_COUNT = 1000;
+
+/// How many jobs (and indices) every part of `test_job_system` goes through.
+const nikola::sizei JOBS_COUNT = 64;
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Tests
+
+/// Bring the headless renderer and the resource manager up, load and draw a mesh, 
+/// and take everything down again in the same order as `engine_shutdown`.
+bool test_engine_lifecycle();
+
+/// Load and unload the same resource group (of two meshes sharing a pool) over and over, 
+/// making sure the geometry pools get back every range its meshes took.
+bool test_geometry_pool_reuse();
+
+/// Record a few frames of the headless renderer into a command log, replay it 
+/// on the same context into a second log, and make sure both logs match.
+bool test_command_log_replay();
+
+/// Rebuild batches of dirty transforms of every count around the SIMD batch width, making sure 
+/// each one matches `translate * rotate * scale` and that clean transforms are left untouched.
+bool test_transform_update_batch();
+
+/// Cull a box inside, a box outside of each of the 6 planes, and a box straddling one of them, 
+/// in every count and lane arrangement that goes through the SIMD path, the leftovers, or both.
+bool test_frustum_cull_aabbs();
+
+/// Transform random boxes by random matrices, making sure the result is the tightest 
+/// box around all 8 transformed corners.
+bool test_aabb_transform();
+
+/// Draw frames with meshes outside of the camera's frustum, making sure only the scene 
+/// meshes get culled, while debug meshes are always drawn.
+bool test_cull_queue();
+
+/// Sort random keys, keys with plenty of duplicates, keys differing in a single digit, and keys 
+/// that are all the same, making sure the render queue's radix sort agrees with `std::stable_sort`.
+bool test_radix_sort();
+
+/// Make sure the render queue's sort keys draw opaque meshes by state and then front-to-back, 
+/// translucent meshes back-to-front after them, and the debug pass last.
+bool test_sort_key_order();
+
+/// Insert keys through a few rehashes, erase half of them, and re-insert them, making sure 
+/// lookups, iteration, and `emplace` on existing keys all hold up along the way.
+bool test_hash_map();
+
+/// The same as `test_hash_map`, but with every key hashing into the same few slots, 
+/// along with non-trivial keys and values getting shifted around by erasures.
+bool test_hash_map_collisions();
+
+/// Dispatch single jobs, batches, jobs waiting on their own jobs, and parallel loops 
+/// of every batch size, making sure every job runs exactly once.
+bool test_job_system();
+
+/// Attach and detach event listeners (including from inside their own callbacks), making sure 
+/// they are called by priority and that stale listener IDs never detach anything.
+bool test_event_unlisten();
+
+/// Post events into the event queue, making sure only back-to-back moves of the same 
+/// dispatcher are merged, and that everything else is dispatched in order.
+bool test_event_queue_coalescing();
+
+/// Resolve a uniform of a shader context and invalidate its cache (like a hot reload does), 
+/// making sure the cache is emptied, the generation is bumped, and the uniform is looked up again.
+bool test_shader_context_invalidate();
+
+/// Tests
+/// ----------------------------------------------------------------------
+
+/// *** Tests ***
+/// ----------------------------------------------------------------------
+
+} // End of tests
+
+//////////////////////////////////////////////////////////////////////////